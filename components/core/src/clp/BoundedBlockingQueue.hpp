@@ -0,0 +1,103 @@
+#ifndef CLP_BOUNDEDBLOCKINGQUEUE_HPP
+#define CLP_BOUNDEDBLOCKINGQUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace clp {
+/**
+ * A FIFO queue with a fixed capacity that can be shared between producer and consumer threads.
+ *
+ * Producers block while the queue is full and consumers block while the queue is empty, which
+ * bounds the amount of work (and memory) that can be in flight between two stages of a pipeline.
+ * Once the queue is closed, producers can no longer add items, while consumers can still drain any
+ * items that remain in the queue.
+ * @tparam T The type of item in the queue
+ */
+template <typename T>
+class BoundedBlockingQueue {
+public:
+    // Constructors
+    /**
+     * @param capacity The maximum number of items the queue can hold. A capacity of 0 is treated as
+     * a capacity of 1.
+     */
+    explicit BoundedBlockingQueue(size_t capacity) : m_capacity{0 == capacity ? 1 : capacity} {}
+
+    // Delete copy & move constructors and assignment operators
+    BoundedBlockingQueue(BoundedBlockingQueue const&) = delete;
+    BoundedBlockingQueue(BoundedBlockingQueue&&) = delete;
+    auto operator=(BoundedBlockingQueue const&) -> BoundedBlockingQueue& = delete;
+    auto operator=(BoundedBlockingQueue&&) -> BoundedBlockingQueue& = delete;
+
+    // Destructor
+    ~BoundedBlockingQueue() = default;
+
+    // Methods
+    /**
+     * Adds an item to the back of the queue, blocking while the queue is full.
+     * @param item
+     * @return Whether the item was added, i.e., false if the queue was closed.
+     */
+    [[nodiscard]] auto push(T item) -> bool {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_not_full_cv.wait(lock, [this] { return m_is_closed || m_items.size() < m_capacity; });
+        if (m_is_closed) {
+            return false;
+        }
+        m_items.emplace_back(std::move(item));
+        lock.unlock();
+        m_not_empty_cv.notify_one();
+        return true;
+    }
+
+    /**
+     * Removes an item from the front of the queue, blocking while the queue is empty and open.
+     * @return The item, or std::nullopt if the queue is closed and has been drained.
+     */
+    [[nodiscard]] auto pop() -> std::optional<T> {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_not_empty_cv.wait(lock, [this] { return m_is_closed || false == m_items.empty(); });
+        if (m_items.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> item{std::move(m_items.front())};
+        m_items.pop_front();
+        lock.unlock();
+        m_not_full_cv.notify_one();
+        return item;
+    }
+
+    /**
+     * Closes the queue, waking up every blocked producer and consumer.
+     */
+    auto close() -> void {
+        {
+            std::lock_guard<std::mutex> const lock{m_mutex};
+            m_is_closed = true;
+        }
+        m_not_full_cv.notify_all();
+        m_not_empty_cv.notify_all();
+    }
+
+    [[nodiscard]] auto is_closed() const -> bool {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        return m_is_closed;
+    }
+
+private:
+    // Variables
+    size_t m_capacity;
+    std::deque<T> m_items;
+    bool m_is_closed{false};
+    mutable std::mutex m_mutex;
+    std::condition_variable m_not_full_cv;
+    std::condition_variable m_not_empty_cv;
+};
+}  // namespace clp
+
+#endif  // CLP_BOUNDEDBLOCKINGQUEUE_HPP
@@ -1,7 +1,6 @@
 #ifndef CLP_DICTIONARYENTRY_HPP
 #define CLP_DICTIONARYENTRY_HPP
 
-#include <set>
 #include <string>
 
 #include "Defs.h"
@@ -24,20 +23,10 @@ public:
 
     std::string const& get_value() const { return m_value; }
 
-    std::set<segment_id_t> const& get_ids_of_segments_containing_entry() const {
-        return m_ids_of_segments_containing_entry;
-    }
-
-    void add_segment_containing_entry(segment_id_t segment_id) {
-        m_ids_of_segments_containing_entry.emplace(segment_id);
-    }
-
 protected:
     // Variables
     DictionaryIdType m_id;
     std::string m_value;
-
-    std::set<segment_id_t> m_ids_of_segments_containing_entry;
 };
 }  // namespace clp
 
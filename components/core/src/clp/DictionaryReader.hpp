@@ -1,6 +1,8 @@
 #ifndef CLP_DICTIONARYREADER_HPP
 #define CLP_DICTIONARYREADER_HPP
 
+#include <algorithm>
+#include <initializer_list>
 #include <iterator>
 #include <string>
 #include <string_view>
@@ -13,6 +15,7 @@
 #include "dictionary_utils.hpp"
 #include "DictionaryEntry.hpp"
 #include "FileReader.hpp"
+#include "SegmentIdBitmap.hpp"
 #include "streaming_compression/passthrough/Decompressor.hpp"
 #include "streaming_compression/zstd/Decompressor.hpp"
 #include "Utils.hpp"
@@ -104,6 +107,24 @@ public:
             std::unordered_set<EntryType const*>& entries
     ) const;
 
+    /**
+     * Gets the IDs of the segments containing the entry with the given ID
+     * @param id
+     * @return The IDs of the segments
+     */
+    SegmentIdBitmap get_ids_of_segments_containing_entry(DictionaryIdType id) const {
+        return get_ids_of_segments_containing_entries(std::initializer_list<DictionaryIdType>{id});
+    }
+
+    /**
+     * Gets the IDs of the segments containing any of the entries with the given IDs
+     * @tparam DictionaryIdContainer
+     * @param ids
+     * @return The IDs of the segments
+     */
+    template <typename DictionaryIdContainer>
+    SegmentIdBitmap get_ids_of_segments_containing_entries(DictionaryIdContainer const& ids) const;
+
 protected:
     // Methods
     /**
@@ -126,6 +147,11 @@ protected:
 #endif
     size_t m_num_segments_read_from_index;
     std::vector<EntryType> m_entries;
+
+    // The segment index, stored as the sorted IDs of the entries in each segment rather than the
+    // segments of each entry, since it's only needed for the few entries that a query touches
+    std::vector<segment_id_t> m_indexed_segment_ids;
+    std::vector<std::vector<DictionaryIdType>> m_ids_in_indexed_segments;
 };
 
 template <typename DictionaryIdType, typename EntryType>
@@ -170,6 +196,8 @@ void DictionaryReader<DictionaryIdType, EntryType>::close() {
 
     m_num_segments_read_from_index = 0;
     m_entries.clear();
+    m_indexed_segment_ids.clear();
+    m_ids_in_indexed_segments.clear();
 
     m_is_open = false;
 }
@@ -213,6 +241,8 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_new_entries() {
         for (size_t i = m_num_segments_read_from_index; i < num_segments; ++i) {
             read_segment_ids();
         }
+        // Remember the segments read so that the next call only reads the ones added since
+        m_num_segments_read_from_index = num_segments;
     }
 }
 
@@ -289,6 +319,24 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
     }
 }
 
+template <typename DictionaryIdType, typename EntryType>
+template <typename DictionaryIdContainer>
+SegmentIdBitmap DictionaryReader<DictionaryIdType, EntryType>::
+        get_ids_of_segments_containing_entries(DictionaryIdContainer const& ids) const {
+    SegmentIdBitmap segment_ids;
+    for (size_t i = 0; i < m_indexed_segment_ids.size(); ++i) {
+        auto const& ids_in_segment = m_ids_in_indexed_segments[i];
+        // Stop searching the segment as soon as it's known to contain one of the entries
+        if (std::any_of(ids.begin(), ids.end(), [&](DictionaryIdType id) {
+                return std::binary_search(ids_in_segment.cbegin(), ids_in_segment.cend(), id);
+            }))
+        {
+            segment_ids.insert(m_indexed_segment_ids[i]);
+        }
+    }
+    return segment_ids;
+}
+
 template <typename DictionaryIdType, typename EntryType>
 void DictionaryReader<DictionaryIdType, EntryType>::read_segment_ids() {
     segment_id_t segment_id;
@@ -296,6 +344,8 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_segment_ids() {
 
     uint64_t num_ids;
     m_segment_index_decompressor.read_numeric_value(num_ids, false);
+    std::vector<DictionaryIdType> ids;
+    ids.reserve(num_ids);
     for (uint64_t i = 0; i < num_ids; ++i) {
         DictionaryIdType id;
         m_segment_index_decompressor.read_numeric_value(id, false);
@@ -303,8 +353,16 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_segment_ids() {
             throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
         }
 
-        m_entries[id].add_segment_containing_entry(segment_id);
+        ids.push_back(id);
     }
+    // The writer stores IDs in ascending order, but sort them in case an index wasn't written that
+    // way
+    if (false == std::is_sorted(ids.cbegin(), ids.cend())) {
+        std::sort(ids.begin(), ids.end());
+    }
+
+    m_indexed_segment_ids.push_back(segment_id);
+    m_ids_in_indexed_segments.emplace_back(std::move(ids));
 }
 }  // namespace clp
 
@@ -0,0 +1,291 @@
+#ifndef CLP_KNOWNTIMESTAMPPATTERNMATCHER_HPP
+#define CLP_KNOWNTIMESTAMPPATTERNMATCHER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clp {
+/**
+ * Matcher compiled from the known timestamp patterns which narrows them down, in one pass over a
+ * line's prefix, to the patterns that could parse a timestamp from the line.
+ *
+ * Each pattern's format is compiled into the set of characters it accepts at each position of its
+ * fixed-width prefix (e.g., "%Y-" accepts four digits followed by '-'). The candidates for a line
+ * are then the intersection, over every position, of the patterns accepting the line's character
+ * at that position. Since the known patterns mostly differ in their separators, ISO-8601, relative
+ * and epoch timestamps are narrowed down to the one or two patterns of their shape, so that we only
+ * have to fully parse those.
+ *
+ * The matcher is shared by the timestamp patterns of clp, clp-s and glt, so it understands the
+ * union of their format specifiers. A specifier that a pattern type can't parse only makes the
+ * matcher less selective, since such patterns never match anyway.
+ *
+ * @tparam TimestampPatternType A timestamp pattern type providing `get_format` and
+ * `get_num_spaces_before_ts`.
+ */
+template <typename TimestampPatternType>
+class KnownTimestampPatternMatcher {
+public:
+    // Types
+    // Bitmap where bit i is set if the i-th known pattern is a candidate
+    using PatternSet = uint64_t;
+
+    // Constants
+    static constexpr size_t cMaxNumPatterns = 64;
+
+    // Methods
+    /**
+     * Compiles the given patterns, replacing any previously compiled patterns. Only the first
+     * `cMaxNumPatterns` patterns are compiled.
+     * @param patterns
+     * @param num_patterns
+     */
+    void compile(TimestampPatternType const* patterns, size_t num_patterns);
+
+    /**
+     * @param line
+     * @return The set of compiled patterns that could parse a timestamp from the given line. Any
+     * pattern outside the set is guaranteed to not match the line.
+     */
+    [[nodiscard]] auto get_candidates(std::string_view line) const -> PatternSet;
+
+private:
+    // Constants
+    // Number of positions (after the spaces before the timestamp) checked by the matcher
+    static constexpr size_t cPrefixLength = 20;
+    // Character value used for positions past the end of the line
+    static constexpr size_t cEndOfLine = 256;
+    static constexpr size_t cNumCharValues = cEndOfLine + 1;
+    // Length of the fixed-width prefix of day and month names
+    static constexpr size_t cNamePrefixLength = 3;
+    // Abbreviated day and month names, which are also the prefixes of the full month names
+    static constexpr std::array<std::string_view, 7> cAbbrevDaysOfWeek
+            = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static constexpr std::array<std::string_view, 12> cAbbrevMonthNames
+            = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+    // Types
+    using CharSet = std::bitset<cNumCharValues>;
+
+    // Methods
+    /**
+     * Computes the set of characters the given format accepts at each position of its fixed-width
+     * prefix. Positions after the fixed-width prefix accept any character.
+     * @param format
+     * @return The character set for each position
+     */
+    [[nodiscard]] static auto get_accepted_chars(std::string_view format)
+            -> std::array<CharSet, cPrefixLength>;
+
+    // Variables
+    // Patterns accepting each character value at each position
+    std::array<std::array<PatternSet, cNumCharValues>, cPrefixLength> m_accepting_patterns{};
+    // Patterns grouped by their number of spaces before the timestamp, in ascending order
+    std::vector<std::pair<uint8_t, PatternSet>> m_patterns_by_num_spaces;
+};
+
+template <typename TimestampPatternType>
+void KnownTimestampPatternMatcher<TimestampPatternType>::compile(
+        TimestampPatternType const* patterns,
+        size_t num_patterns
+) {
+    for (auto& accepting_patterns : m_accepting_patterns) {
+        accepting_patterns.fill(0);
+    }
+    m_patterns_by_num_spaces.clear();
+
+    num_patterns = std::min(num_patterns, cMaxNumPatterns);
+    for (size_t i = 0; i < num_patterns; ++i) {
+        auto const& pattern = patterns[i];
+        PatternSet const pattern_bit = PatternSet{1} << i;
+
+        auto const accepted_chars = get_accepted_chars(pattern.get_format());
+        for (size_t pos = 0; pos < cPrefixLength; ++pos) {
+            for (size_t c = 0; c < cNumCharValues; ++c) {
+                if (accepted_chars[pos].test(c)) {
+                    m_accepting_patterns[pos][c] |= pattern_bit;
+                }
+            }
+        }
+
+        uint8_t const num_spaces = pattern.get_num_spaces_before_ts();
+        auto it = std::lower_bound(
+                m_patterns_by_num_spaces.begin(),
+                m_patterns_by_num_spaces.end(),
+                num_spaces,
+                [](auto const& group, uint8_t value) { return group.first < value; }
+        );
+        if (m_patterns_by_num_spaces.end() == it || it->first != num_spaces) {
+            it = m_patterns_by_num_spaces.emplace(it, num_spaces, 0);
+        }
+        it->second |= pattern_bit;
+    }
+}
+
+template <typename TimestampPatternType>
+auto KnownTimestampPatternMatcher<TimestampPatternType>::get_candidates(std::string_view line
+) const -> PatternSet {
+    size_t const line_length = line.length();
+    PatternSet candidates = 0;
+    size_t line_ix = 0;
+    int num_spaces_found = 0;
+    for (auto const& [num_spaces, patterns] : m_patterns_by_num_spaces) {
+        // Find the beginning of the timestamp the same way as `parse_timestamp`
+        for (; num_spaces_found < num_spaces && line_ix < line_length; ++line_ix) {
+            if (' ' == line[line_ix]) {
+                ++num_spaces_found;
+            }
+        }
+        if (num_spaces_found < num_spaces) {
+            break;
+        }
+
+        PatternSet group_candidates = patterns;
+        for (size_t pos = 0; pos < cPrefixLength && 0 != group_candidates; ++pos) {
+            size_t const ix = line_ix + pos;
+            size_t const c
+                    = ix < line_length ? static_cast<unsigned char>(line[ix]) : cEndOfLine;
+            group_candidates &= m_accepting_patterns[pos][c];
+        }
+        candidates |= group_candidates;
+    }
+    return candidates;
+}
+
+template <typename TimestampPatternType>
+auto KnownTimestampPatternMatcher<TimestampPatternType>::get_accepted_chars(
+        std::string_view format
+) -> std::array<CharSet, cPrefixLength> {
+    std::array<CharSet, cPrefixLength> accepted_chars;
+    CharSet digits;
+    for (char c = '0'; c <= '9'; ++c) {
+        digits.set(static_cast<unsigned char>(c));
+    }
+    CharSet digits_or_space = digits;
+    digits_or_space.set(' ');
+
+    size_t pos = 0;
+    auto const append = [&](CharSet const& chars) {
+        if (pos < cPrefixLength) {
+            accepted_chars[pos] = chars;
+        }
+        ++pos;
+    };
+    auto const append_char = [&](char c) {
+        CharSet chars;
+        chars.set(static_cast<unsigned char>(c));
+        append(chars);
+    };
+    auto const append_names = [&](auto const& names) {
+        for (size_t i = 0; i < cNamePrefixLength; ++i) {
+            CharSet chars;
+            for (auto const name : names) {
+                chars.set(static_cast<unsigned char>(name[i]));
+            }
+            append(chars);
+        }
+    };
+
+    // Stop at the first field with a variable width, after which any character is accepted
+    bool is_fixed_width = true;
+    for (size_t format_ix = 0; is_fixed_width && format_ix < format.length(); ++format_ix) {
+        if ('%' != format[format_ix]) {
+            append_char(format[format_ix]);
+            continue;
+        }
+        ++format_ix;
+        if (format_ix >= format.length()) {
+            break;
+        }
+        switch (format[format_ix]) {
+            case '%':
+                append_char('%');
+                break;
+            case 'Y':
+                append(digits);
+                append(digits);
+                append(digits);
+                append(digits);
+                break;
+            case 'y':
+            case 'm':
+            case 'd':
+            case 'H':
+            case 'I':
+            case 'M':
+            case 'S':
+                append(digits);
+                append(digits);
+                break;
+            case '3':
+                append(digits);
+                append(digits);
+                append(digits);
+                break;
+            case 'T':
+                // Milliseconds without trailing zeroes have a variable length
+                is_fixed_width = false;
+                break;
+            case 'e':
+            case 'k':
+            case 'l':
+                append(digits_or_space);
+                append(digits_or_space);
+                break;
+            case 'a':
+                append_names(cAbbrevDaysOfWeek);
+                break;
+            case 'b':
+                append_names(cAbbrevMonthNames);
+                break;
+            case 'B':
+                // Month names have a variable length but begin with their abbreviation
+                append_names(cAbbrevMonthNames);
+                is_fixed_width = false;
+                break;
+            case 'p': {
+                CharSet chars;
+                chars.set('A');
+                chars.set('P');
+                append(chars);
+                append_char('M');
+                break;
+            }
+            case '#': {
+                // Relative timestamps have a variable length and no leading zeroes
+                CharSet nonzero_digits = digits;
+                nonzero_digits.reset('0');
+                append(nonzero_digits);
+                is_fixed_width = false;
+                break;
+            }
+            case 'E':
+            case 'F': {
+                // Epoch timestamps are variable-length integers which may be negative
+                CharSet digits_or_sign = digits;
+                digits_or_sign.set('-');
+                append(digits_or_sign);
+                is_fixed_width = false;
+                break;
+            }
+            default:
+                is_fixed_width = false;
+                break;
+        }
+    }
+
+    // The line may end or continue with anything after the fixed-width prefix
+    for (; pos < cPrefixLength; ++pos) {
+        accepted_chars[pos].set();
+    }
+    return accepted_chars;
+}
+}  // namespace clp
+
+#endif  // CLP_KNOWNTIMESTAMPPATTERNMATCHER_HPP
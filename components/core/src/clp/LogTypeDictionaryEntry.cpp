@@ -29,8 +29,7 @@ size_t LogTypeDictionaryEntry::get_data_size() const {
     // NOTE: sizeof(vector[0]) is executed at compile time so there's no risk of an exception at
     // runtime
     return sizeof(m_id) + m_value.length()
-           + m_placeholder_positions.size() * sizeof(m_placeholder_positions[0])
-           + m_ids_of_segments_containing_entry.size() * sizeof(segment_id_t);
+           + m_placeholder_positions.size() * sizeof(m_placeholder_positions[0]);
 }
 
 void LogTypeDictionaryEntry::add_constant(
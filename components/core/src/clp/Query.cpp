@@ -1,37 +1,14 @@
 #include "Query.hpp"
 
 #include <functional>
-#include <set>
 #include <string>
 #include <unordered_set>
 
 #include "Defs.h"
 
-using std::set;
 using std::string;
 using std::unordered_set;
 
-// Local function prototypes
-/**
- * Performs a set intersection of a & b, storing the result in b
- * @tparam SetType
- * @param a
- * @param b
- */
-template <typename SetType>
-static void inplace_set_intersection(SetType const& a, SetType& b);
-
-template <typename SetType>
-static void inplace_set_intersection(SetType const& a, SetType& b) {
-    for (auto ix = b.cbegin(); ix != b.cend();) {
-        if (a.count(*ix) == 0) {
-            ix = b.erase(ix);
-        } else {
-            ++ix;
-        }
-    }
-}
-
 namespace clp {
 QueryVar::QueryVar(encoded_variable_t precise_non_dict_var) {
     m_precise_var = precise_non_dict_var;
@@ -69,9 +46,9 @@ bool QueryVar::matches(encoded_variable_t var) const {
 }
 
 void QueryVar::remove_segments_that_dont_contain_dict_var(
-        set<segment_id_t>& segment_ids,
-        std::function<std::set<segment_id_t> const&(variable_dictionary_id_t)> const&
-                get_segments_containing_var_dict_id
+        SegmentIdBitmap& segment_ids,
+        std::function<SegmentIdBitmap(unordered_set<variable_dictionary_id_t> const&)> const&
+                get_segments_containing_var_dict_ids
 ) const {
     if (false == m_is_dict_var) {
         // Not a dictionary variable, so do nothing
@@ -79,19 +56,9 @@ void QueryVar::remove_segments_that_dont_contain_dict_var(
     }
 
     if (m_is_precise_var) {
-        auto& ids_of_segments_containing_query_var
-                = get_segments_containing_var_dict_id(m_var_dict_id);
-        inplace_set_intersection(ids_of_segments_containing_query_var, segment_ids);
+        segment_ids.intersect_with(get_segments_containing_var_dict_ids({m_var_dict_id}));
     } else {
-        set<segment_id_t> ids_of_segments_containing_query_var;
-        for (auto var_dict_id : m_possible_var_dict_ids) {
-            auto& ids_of_segments_containing_var = get_segments_containing_var_dict_id(var_dict_id);
-            ids_of_segments_containing_query_var.insert(
-                    ids_of_segments_containing_var.cbegin(),
-                    ids_of_segments_containing_var.cend()
-            );
-        }
-        inplace_set_intersection(ids_of_segments_containing_query_var, segment_ids);
+        segment_ids.intersect_with(get_segments_containing_var_dict_ids(m_possible_var_dict_ids));
     }
 }
 
@@ -113,6 +80,14 @@ void SubQuery::add_imprecise_dict_var(
 
 void SubQuery::set_possible_logtypes(unordered_set<logtype_dictionary_id_t> const& logtype_ids) {
     m_possible_logtypes = logtype_ids;
+
+    m_possible_logtypes_bitmap.clear();
+    for (auto const logtype_id : m_possible_logtypes) {
+        if (logtype_id >= m_possible_logtypes_bitmap.size()) {
+            m_possible_logtypes_bitmap.resize(logtype_id + 1, false);
+        }
+        m_possible_logtypes_bitmap[logtype_id] = true;
+    }
 }
 
 void SubQuery::mark_wildcard_match_required() {
@@ -120,27 +95,22 @@ void SubQuery::mark_wildcard_match_required() {
 }
 
 void SubQuery::calculate_ids_of_matching_segments(
-        std::function<std::set<segment_id_t> const&(logtype_dictionary_id_t)> const&
-                get_segments_containing_logtype_dict_id,
-        std::function<std::set<segment_id_t> const&(variable_dictionary_id_t)> const&
-                get_segments_containing_var_dict_id
+        std::function<SegmentIdBitmap(unordered_set<logtype_dictionary_id_t> const&)> const&
+                get_segments_containing_logtype_dict_ids,
+        std::function<SegmentIdBitmap(unordered_set<variable_dictionary_id_t> const&)> const&
+                get_segments_containing_var_dict_ids
 ) {
     // Get IDs of segments containing logtypes
-    m_ids_of_matching_segments.clear();
-    for (auto logtype_id : m_possible_logtypes) {
-        auto const& ids_of_segments_containing_logtype
-                = get_segments_containing_logtype_dict_id(logtype_id);
-        m_ids_of_matching_segments.insert(
-                ids_of_segments_containing_logtype.cbegin(),
-                ids_of_segments_containing_logtype.cend()
-        );
-    }
+    m_ids_of_matching_segments = get_segments_containing_logtype_dict_ids(m_possible_logtypes);
 
     // Intersect with IDs of segments containing variables
     for (auto& query_var : m_vars) {
+        if (m_ids_of_matching_segments.empty()) {
+            break;
+        }
         query_var.remove_segments_that_dont_contain_dict_var(
                 m_ids_of_matching_segments,
-                get_segments_containing_var_dict_id
+                get_segments_containing_var_dict_ids
         );
     }
 }
@@ -148,13 +118,10 @@ void SubQuery::calculate_ids_of_matching_segments(
 void SubQuery::clear() {
     m_vars.clear();
     m_possible_logtypes.clear();
+    m_possible_logtypes_bitmap.clear();
     m_wildcard_match_required = false;
 }
 
-bool SubQuery::matches_logtype(logtype_dictionary_id_t const logtype) const {
-    return m_possible_logtypes.count(logtype) > 0;
-}
-
 Query::Query(
         epochtime_t search_begin_timestamp,
         epochtime_t search_end_timestamp,
@@ -178,24 +145,31 @@ void Query::make_sub_queries_relevant_to_segment(segment_id_t segment_id) {
 
     // Make sub-queries relevant to segment
     m_relevant_sub_queries.clear();
+    m_relevant_logtypes_bitmap.clear();
     for (auto& sub_query : m_sub_queries) {
-        if (sub_query.get_ids_of_matching_segments().count(segment_id)) {
+        if (sub_query.get_ids_of_matching_segments().contains(segment_id)) {
             m_relevant_sub_queries.push_back(&sub_query);
+            for (auto const logtype_id : sub_query.get_possible_logtypes()) {
+                if (logtype_id >= m_relevant_logtypes_bitmap.size()) {
+                    m_relevant_logtypes_bitmap.resize(logtype_id + 1, false);
+                }
+                m_relevant_logtypes_bitmap[logtype_id] = true;
+            }
         }
     }
     m_prev_segment_id = segment_id;
 }
 
 void Query::calculate_ids_of_matching_segments(
-        std::function<std::set<segment_id_t> const&(logtype_dictionary_id_t)> const&
-                get_segments_containing_logtype_dict_id,
-        std::function<std::set<segment_id_t> const&(variable_dictionary_id_t)> const&
-                get_segments_containing_var_dict_id
+        std::function<SegmentIdBitmap(unordered_set<logtype_dictionary_id_t> const&)> const&
+                get_segments_containing_logtype_dict_ids,
+        std::function<SegmentIdBitmap(unordered_set<variable_dictionary_id_t> const&)> const&
+                get_segments_containing_var_dict_ids
 ) {
     for (auto& sub_query : m_sub_queries) {
         sub_query.calculate_ids_of_matching_segments(
-                get_segments_containing_logtype_dict_id,
-                get_segments_containing_var_dict_id
+                get_segments_containing_logtype_dict_ids,
+                get_segments_containing_var_dict_ids
         );
     }
 }
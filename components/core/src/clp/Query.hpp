@@ -2,12 +2,12 @@
 #define CLP_QUERY_HPP
 
 #include <functional>
-#include <set>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
 #include "Defs.h"
+#include "SegmentIdBitmap.hpp"
 
 namespace clp {
 /**
@@ -35,12 +35,14 @@ public:
     /**
      * Removes segments from the given set that don't contain the given variable
      * @param segment_ids
-     * @param get_segments_containing_var_dict_id
+     * @param get_segments_containing_var_dict_ids Gets the segments containing any of the given
+     * variable dictionary IDs
      */
     void remove_segments_that_dont_contain_dict_var(
-            std::set<segment_id_t>& segment_ids,
-            std::function<std::set<segment_id_t> const&(variable_dictionary_id_t)> const&
-                    get_segments_containing_var_dict_id
+            SegmentIdBitmap& segment_ids,
+            std::function<SegmentIdBitmap(
+                    std::unordered_set<variable_dictionary_id_t> const&
+            )> const& get_segments_containing_var_dict_ids
     ) const;
 
     bool is_precise_var() const { return m_is_precise_var; }
@@ -106,14 +108,18 @@ public:
     /**
      * Calculates the segment IDs that should contain a match for the subquery's current logtypes
      * and QueryVars.
-     * @param get_segments_containing_logtype_dict_id
-     * @param get_segments_containing_var_dict_id
+     * @param get_segments_containing_logtype_dict_ids Gets the segments containing any of the given
+     * logtype dictionary IDs
+     * @param get_segments_containing_var_dict_ids Gets the segments containing any of the given
+     * variable dictionary IDs
      */
     void calculate_ids_of_matching_segments(
-            std::function<std::set<segment_id_t> const&(logtype_dictionary_id_t)> const&
-                    get_segments_containing_logtype_dict_id,
-            std::function<std::set<segment_id_t> const&(variable_dictionary_id_t)> const&
-                    get_segments_containing_var_dict_id
+            std::function<SegmentIdBitmap(
+                    std::unordered_set<logtype_dictionary_id_t> const&
+            )> const& get_segments_containing_logtype_dict_ids,
+            std::function<SegmentIdBitmap(
+                    std::unordered_set<variable_dictionary_id_t> const&
+            )> const& get_segments_containing_var_dict_ids
     );
 
     void clear();
@@ -130,7 +136,7 @@ public:
 
     std::vector<QueryVar> const& get_vars() const { return m_vars; }
 
-    std::set<segment_id_t> const& get_ids_of_matching_segments() const {
+    SegmentIdBitmap const& get_ids_of_matching_segments() const {
         return m_ids_of_matching_segments;
     }
 
@@ -139,7 +145,9 @@ public:
      * @param logtype
      * @return true if matched, false otherwise
      */
-    bool matches_logtype(logtype_dictionary_id_t logtype) const;
+    bool matches_logtype(logtype_dictionary_id_t logtype) const {
+        return logtype < m_possible_logtypes_bitmap.size() && m_possible_logtypes_bitmap[logtype];
+    }
     /**
      * Whether the given variables contain the subquery's variables in order (but not necessarily
      * contiguously)
@@ -153,7 +161,9 @@ public:
 private:
     // Variables
     std::unordered_set<logtype_dictionary_id_t> m_possible_logtypes;
-    std::set<segment_id_t> m_ids_of_matching_segments;
+    // Dense version of `m_possible_logtypes`, indexed by logtype ID, for matching messages quickly
+    std::vector<bool> m_possible_logtypes_bitmap;
+    SegmentIdBitmap m_ids_of_matching_segments;
     std::vector<QueryVar> m_vars;
     bool m_wildcard_match_required;
 };
@@ -210,17 +220,30 @@ public:
         return m_relevant_sub_queries;
     }
 
+    /**
+     * @param logtype
+     * @return Whether the given logtype ID matches one of the possible logtypes of any relevant
+     * sub-query
+     */
+    bool matches_relevant_logtype(logtype_dictionary_id_t logtype) const {
+        return logtype < m_relevant_logtypes_bitmap.size() && m_relevant_logtypes_bitmap[logtype];
+    }
+
     /**
      * Calculates the segment IDs that should contain a match for each subquery's logtypes and
      * QueryVars.
-     * @param get_segments_containing_logtype_dict_id
-     * @param get_segments_containing_var_dict_id
+     * @param get_segments_containing_logtype_dict_ids Gets the segments containing any of the given
+     * logtype dictionary IDs
+     * @param get_segments_containing_var_dict_ids Gets the segments containing any of the given
+     * variable dictionary IDs
      */
     void calculate_ids_of_matching_segments(
-            std::function<std::set<segment_id_t> const&(logtype_dictionary_id_t)> const&
-                    get_segments_containing_logtype_dict_id,
-            std::function<std::set<segment_id_t> const&(variable_dictionary_id_t)> const&
-                    get_segments_containing_var_dict_id
+            std::function<SegmentIdBitmap(
+                    std::unordered_set<logtype_dictionary_id_t> const&
+            )> const& get_segments_containing_logtype_dict_ids,
+            std::function<SegmentIdBitmap(
+                    std::unordered_set<variable_dictionary_id_t> const&
+            )> const& get_segments_containing_var_dict_ids
     );
 
 private:
@@ -234,6 +257,8 @@ private:
     bool m_search_string_matches_all{true};
     std::vector<SubQuery> m_sub_queries;
     std::vector<SubQuery const*> m_relevant_sub_queries;
+    // The union of the possible logtypes of the relevant sub-queries, indexed by logtype ID
+    std::vector<bool> m_relevant_logtypes_bitmap;
     segment_id_t m_prev_segment_id{cInvalidSegmentId};
 };
 
@@ -0,0 +1,138 @@
+#include "ReadAheadReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "ErrorCode.hpp"
+#include "ReaderInterface.hpp"
+
+namespace clp {
+ReadAheadReader::ReadAheadReader(
+        std::shared_ptr<ReaderInterface> source_reader,
+        size_t chunk_size,
+        size_t max_num_buffered_chunks
+)
+        : m_source_reader{std::move(source_reader)},
+          m_chunk_size{std::max<size_t>(chunk_size, 1)},
+          m_chunks{max_num_buffered_chunks} {
+    if (ErrorCode_Success != m_source_reader->try_get_pos(m_pos)) {
+        m_pos = 0;
+    }
+    m_reader_thread = std::make_unique<ReaderThread>(*this);
+    m_reader_thread->start();
+}
+
+ReadAheadReader::~ReadAheadReader() {
+    // Unblock the reader thread if it's waiting for space in the queue
+    m_chunks.close();
+    m_reader_thread->join();
+}
+
+auto ReadAheadReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> ErrorCode {
+    if (nullptr == buf && num_bytes_to_read > 0) {
+        return ErrorCode_BadParam;
+    }
+    return read_from_chunks(buf, num_bytes_to_read, num_bytes_read);
+}
+
+auto ReadAheadReader::try_seek_from_begin(size_t pos) -> ErrorCode {
+    if (pos < m_pos) {
+        return ErrorCode_Unsupported;
+    }
+    if (pos == m_pos) {
+        return ErrorCode_Success;
+    }
+    size_t num_bytes_read{};
+    auto const num_bytes_to_read{pos - m_pos};
+    auto const err{read_from_chunks(nullptr, num_bytes_to_read, num_bytes_read)};
+    if (ErrorCode_EndOfFile == err
+        || (ErrorCode_Success == err && num_bytes_read < num_bytes_to_read))
+    {
+        return ErrorCode_OutOfBounds;
+    }
+    return err;
+}
+
+auto ReadAheadReader::read_from_chunks(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> ErrorCode {
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read) {
+        if (false == m_current_chunk.has_value()
+            || m_current_chunk_pos == m_current_chunk->data.size())
+        {
+            if (m_current_chunk.has_value() && ErrorCode_Success != m_current_chunk->error_code) {
+                // The read ahead has stopped, so there's no more data
+                break;
+            }
+            m_current_chunk = m_chunks.pop();
+            m_current_chunk_pos = 0;
+            if (false == m_current_chunk.has_value()) {
+                // Only possible if the queue was closed, which only happens on destruction
+                return ErrorCode_Failure;
+            }
+            continue;
+        }
+
+        auto const num_bytes_to_copy{std::min(
+                num_bytes_to_read - num_bytes_read,
+                m_current_chunk->data.size() - m_current_chunk_pos
+        )};
+        if (nullptr != buf) {
+            std::memcpy(
+                    buf + num_bytes_read,
+                    m_current_chunk->data.data() + m_current_chunk_pos,
+                    num_bytes_to_copy
+            );
+        }
+        m_current_chunk_pos += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+    }
+    m_pos += num_bytes_read;
+
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        if (nullptr != m_current_chunk->exception) {
+            std::rethrow_exception(m_current_chunk->exception);
+        }
+        return m_current_chunk->error_code;
+    }
+    return ErrorCode_Success;
+}
+
+auto ReadAheadReader::ReaderThread::thread_method() -> void {
+    auto& source_reader{*m_reader.m_source_reader};
+    while (true) {
+        Chunk chunk;
+        chunk.data.resize(m_reader.m_chunk_size);
+        size_t num_bytes_read{};
+        ErrorCode error_code{};
+        try {
+            error_code
+                    = source_reader.try_read(chunk.data.data(), chunk.data.size(), num_bytes_read);
+        } catch (...) {
+            // Nothing above `thread_method` catches exceptions, so forward the exception to the
+            // consumer to be rethrown there. Any bytes read before the exception are discarded
+            // since the source reader's state is unknown.
+            std::ignore = m_reader.m_chunks.push(
+                    Chunk{{}, ErrorCode_Failure, std::current_exception()}
+            );
+            return;
+        }
+        chunk.data.resize(num_bytes_read);
+        if (num_bytes_read > 0 && false == m_reader.m_chunks.push(std::move(chunk))) {
+            return;
+        }
+
+        if (ErrorCode_Success != error_code) {
+            // Mark the end of the data with an empty chunk containing the error
+            std::ignore = m_reader.m_chunks.push(Chunk{{}, error_code, nullptr});
+            return;
+        }
+    }
+}
+}  // namespace clp
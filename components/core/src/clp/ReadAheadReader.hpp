@@ -0,0 +1,139 @@
+#ifndef CLP_READAHEADREADER_HPP
+#define CLP_READAHEADREADER_HPP
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "BoundedBlockingQueue.hpp"
+#include "ErrorCode.hpp"
+#include "ReaderInterface.hpp"
+#include "Thread.hpp"
+
+namespace clp {
+/**
+ * A reader that reads ahead from another `ReaderInterface` (referred to as the source reader) on a
+ * background thread. This allows expensive reads from the source reader (e.g., decompression or
+ * network I/O) to overlap with the caller's processing of the data that has already been read.
+ *
+ * At most `max_num_buffered_chunks` chunks of `chunk_size` bytes are buffered ahead of the caller.
+ *
+ * NOTE: Since data is read ahead, this class only supports streaming; it cannot seek backwards.
+ * The source reader must not be used by anything else while this reader is alive.
+ */
+class ReadAheadReader : public ReaderInterface {
+public:
+    // Constants
+    static constexpr size_t cDefaultChunkSize{1024ULL * 1024};  // 1 MiB
+    static constexpr size_t cDefaultMaxNumBufferedChunks{4};
+
+    // Constructors
+    /**
+     * Starts reading ahead from the source reader's current position.
+     * @param source_reader
+     * @param chunk_size The number of bytes to read from the source reader at a time.
+     * @param max_num_buffered_chunks
+     */
+    explicit ReadAheadReader(
+            std::shared_ptr<ReaderInterface> source_reader,
+            size_t chunk_size = cDefaultChunkSize,
+            size_t max_num_buffered_chunks = cDefaultMaxNumBufferedChunks
+    );
+
+    // Destructor
+    ~ReadAheadReader() override;
+
+    // Delete copy & move constructors and assignment operators
+    ReadAheadReader(ReadAheadReader const&) = delete;
+    ReadAheadReader(ReadAheadReader&&) = delete;
+    auto operator=(ReadAheadReader const&) -> ReadAheadReader& = delete;
+    auto operator=(ReadAheadReader&&) -> ReadAheadReader& = delete;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of bytes, blocking until that many bytes have been read
+     * ahead or the source reader has been exhausted.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_EndOfFile if there is no more data to read.
+     * @return The error returned by the source reader if it failed before any bytes were read.
+     * @return ErrorCode_Success on success.
+     * @throw The exception thrown by the source reader if it threw before any bytes were read.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> ErrorCode override;
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the data.
+     * @param pos
+     * @return ErrorCode_Unsupported if the given position is lower than the current position.
+     * @return ErrorCode_OutOfBounds if the given pos is past the end of the data.
+     * @return Same as `try_read` otherwise.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the read head.
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> ErrorCode override {
+        pos = m_pos;
+        return ErrorCode_Success;
+    }
+
+private:
+    // Types
+    /**
+     * A chunk of data read from the source reader. The last chunk is empty and records the error
+     * that stopped the read ahead (ErrorCode_EndOfFile once the source reader has been exhausted),
+     * along with the exception if the source reader threw one. Since the exception is thrown on
+     * the background thread, it's rethrown to the consumer rather than escaping the thread.
+     */
+    struct Chunk {
+        std::vector<char> data;
+        ErrorCode error_code{ErrorCode_Success};
+        std::exception_ptr exception;
+    };
+
+    /**
+     * This class implements clp::Thread to read ahead from the source reader.
+     */
+    class ReaderThread : public Thread {
+    public:
+        // Constructor
+        explicit ReaderThread(ReadAheadReader& reader) : m_reader{reader} {}
+
+    private:
+        // Methods implementing `clp::Thread`
+        auto thread_method() -> void final;
+
+        ReadAheadReader& m_reader;
+    };
+
+    /**
+     * Reads from the buffered chunks, skipping the data if `buf` is nullptr.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return Same as `try_read`.
+     * @throw Same as `try_read`.
+     */
+    [[nodiscard]] auto read_from_chunks(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> ErrorCode;
+
+    std::shared_ptr<ReaderInterface> m_source_reader;
+    size_t m_chunk_size;
+    BoundedBlockingQueue<Chunk> m_chunks;
+    std::unique_ptr<ReaderThread> m_reader_thread;
+
+    // Only accessed by the consumer
+    std::optional<Chunk> m_current_chunk;
+    size_t m_current_chunk_pos{0};
+    size_t m_pos{0};
+};
+}  // namespace clp
+
+#endif  // CLP_READAHEADREADER_HPP
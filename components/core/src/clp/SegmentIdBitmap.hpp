@@ -0,0 +1,155 @@
+#ifndef CLP_SEGMENTIDBITMAP_HPP
+#define CLP_SEGMENTIDBITMAP_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "Defs.h"
+
+namespace clp {
+/**
+ * A set of segment IDs stored as a bitmap. Segment IDs within an archive are assigned sequentially
+ * from 0, so the bitmap stays small and set operations are done a word at a time.
+ */
+class SegmentIdBitmap {
+public:
+    // Types
+    /**
+     * Iterator over the segment IDs in the bitmap, in ascending order
+     */
+    class Iterator {
+    public:
+        // Types
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = segment_id_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = segment_id_t const*;
+        using reference = segment_id_t;
+
+        // Constructors
+        Iterator(std::vector<uint64_t> const& words, size_t word_ix)
+                : m_words{&words},
+                  m_word_ix{word_ix} {
+            if (m_word_ix < m_words->size()) {
+                m_word = (*m_words)[m_word_ix];
+                skip_empty_words();
+            }
+        }
+
+        // Methods
+        segment_id_t operator*() const {
+            return m_word_ix * cNumBitsPerWord + std::countr_zero(m_word);
+        }
+
+        Iterator& operator++() {
+            m_word &= m_word - 1;
+            skip_empty_words();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto prev{*this};
+            ++(*this);
+            return prev;
+        }
+
+        bool operator==(Iterator const& rhs) const {
+            return m_word_ix == rhs.m_word_ix && m_word == rhs.m_word;
+        }
+
+    private:
+        // Methods
+        void skip_empty_words() {
+            while (0 == m_word && ++m_word_ix < m_words->size()) {
+                m_word = (*m_words)[m_word_ix];
+            }
+            if (m_word_ix >= m_words->size()) {
+                m_word_ix = m_words->size();
+                m_word = 0;
+            }
+        }
+
+        // Variables
+        std::vector<uint64_t> const* m_words;
+        size_t m_word_ix;
+        uint64_t m_word{0};
+    };
+
+    // Methods
+    Iterator begin() const { return {m_words, 0}; }
+
+    Iterator end() const { return {m_words, m_words.size()}; }
+
+    bool empty() const {
+        return std::all_of(m_words.cbegin(), m_words.cend(), [](uint64_t word) {
+            return 0 == word;
+        });
+    }
+
+    /**
+     * @return The number of segment IDs in the bitmap
+     */
+    size_t size() const {
+        size_t size{0};
+        for (auto const word : m_words) {
+            size += std::popcount(word);
+        }
+        return size;
+    }
+
+    bool contains(segment_id_t segment_id) const {
+        auto const word_ix{segment_id / cNumBitsPerWord};
+        return word_ix < m_words.size()
+               && 0 != (m_words[word_ix] & (uint64_t{1} << (segment_id % cNumBitsPerWord)));
+    }
+
+    void insert(segment_id_t segment_id) {
+        auto const word_ix{segment_id / cNumBitsPerWord};
+        if (word_ix >= m_words.size()) {
+            m_words.resize(word_ix + 1, 0);
+        }
+        m_words[word_ix] |= uint64_t{1} << (segment_id % cNumBitsPerWord);
+    }
+
+    /**
+     * Inserts all segment IDs from the given bitmap (i.e., a union)
+     * @param other
+     */
+    void insert_all(SegmentIdBitmap const& other) {
+        if (other.m_words.size() > m_words.size()) {
+            m_words.resize(other.m_words.size(), 0);
+        }
+        for (size_t i = 0; i < other.m_words.size(); ++i) {
+            m_words[i] |= other.m_words[i];
+        }
+    }
+
+    /**
+     * Removes all segment IDs that aren't in the given bitmap (i.e., an intersection)
+     * @param other
+     */
+    void intersect_with(SegmentIdBitmap const& other) {
+        if (m_words.size() > other.m_words.size()) {
+            m_words.resize(other.m_words.size());
+        }
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            m_words[i] &= other.m_words[i];
+        }
+    }
+
+    void clear() { m_words.clear(); }
+
+private:
+    // Constants
+    static constexpr size_t cNumBitsPerWord{64};
+
+    // Variables
+    std::vector<uint64_t> m_words;
+};
+}  // namespace clp
+
+#endif  // CLP_SEGMENTIDBITMAP_HPP
@@ -2,8 +2,7 @@
 
 namespace clp {
 size_t VariableDictionaryEntry::get_data_size() const {
-    return sizeof(m_id) + m_value.length()
-           + m_ids_of_segments_containing_entry.size() * sizeof(segment_id_t);
+    return sizeof(m_id) + m_value.length();
 }
 
 void VariableDictionaryEntry::write_to_file(streaming_compression::Compressor& compressor) const {
@@ -71,6 +71,19 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                     ->value_name("CHAR")
                     ->default_value(output_method_input),
             "Use output method specified by CHAR (s - stdout, b - binary)"
+    )(
+            "unordered-output",
+            po::bool_switch(&m_unordered_output),
+            "When searching archives concurrently, output each archive's results as soon as its"
+            " search completes, rather than in the order the archives are listed"
+    );
+
+    // Define performance options
+    po::options_description options_performance("Performance Options");
+    options_performance.add_options()(
+            "num-threads",
+            po::value<size_t>(&m_num_threads)->value_name("NUM")->default_value(m_num_threads),
+            "Number of archives to search concurrently"
     );
 
     // Define match controls
@@ -107,6 +120,7 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
     visible_options.add(options_input);
     visible_options.add(options_output);
     visible_options.add(options_match_control);
+    visible_options.add(options_performance);
 
     // Define hidden positional options (not shown in Boost's program options help message)
     po::options_description hidden_positional_options;
@@ -133,6 +147,7 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
     all_options.add(options_input);
     all_options.add(options_output);
     all_options.add(options_match_control);
+    all_options.add(options_performance);
     all_options.add(hidden_positional_options);
 
     // Parse options
@@ -261,6 +276,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             }
         }
 
+        if (0 == m_num_threads) {
+            throw invalid_argument("num-threads must be non-zero.");
+        }
+
         switch (output_method_input) {
             case (char)OutputMethod::StdoutText:
             case (char)OutputMethod::StdoutBinary:
@@ -0,0 +1,58 @@
+#include "ResultsSink.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace clp::clg {
+void ResultsSink::write(size_t archive_ix, std::string results) {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (false == m_ordered) {
+        fwrite(results.data(), sizeof(char), results.size(), m_output_stream);
+        return;
+    }
+
+    m_results_written.wait(lock, [&] {
+        return m_cancelled || m_next_archive_ix == archive_ix
+               || m_num_buffered_bytes + results.size() <= m_max_num_buffered_bytes;
+    });
+    if (m_cancelled) {
+        return;
+    }
+
+    if (m_next_archive_ix != archive_ix) {
+        m_num_buffered_bytes += results.size();
+        m_pending_results.emplace(archive_ix, std::move(results));
+        return;
+    }
+
+    fwrite(results.data(), sizeof(char), results.size(), m_output_stream);
+    ++m_next_archive_ix;
+    write_pending_results();
+    lock.unlock();
+    m_results_written.notify_all();
+}
+
+void ResultsSink::cancel() {
+    {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        m_cancelled = true;
+        m_pending_results.clear();
+        m_num_buffered_bytes = 0;
+    }
+    m_results_written.notify_all();
+}
+
+void ResultsSink::write_pending_results() {
+    for (auto it = m_pending_results.begin();
+         m_pending_results.end() != it && it->first == m_next_archive_ix;
+         it = m_pending_results.erase(it))
+    {
+        fwrite(it->second.data(), sizeof(char), it->second.size(), m_output_stream);
+        m_num_buffered_bytes -= it->second.size();
+        ++m_next_archive_ix;
+    }
+}
+}  // namespace clp::clg
@@ -0,0 +1,75 @@
+#ifndef CLP_CLG_RESULTSSINK_HPP
+#define CLP_CLG_RESULTSSINK_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace clp::clg {
+/**
+ * Writes the results of archives searched concurrently to an output stream, either in the order the
+ * archives are listed or as soon as each archive's search completes.
+ *
+ * In ordered mode, the results of an archive that completes before the archives preceding it are
+ * buffered. To bound the memory used, a writer whose results don't fit in the buffer blocks until
+ * its archive is the next one to be written or enough buffered results have been written. The
+ * writer of the next archive never blocks, so writers always make progress.
+ */
+class ResultsSink {
+public:
+    // Constants
+    static constexpr size_t cDefaultMaxNumBufferedBytes{64ULL * 1024 * 1024};
+
+    // Constructors
+    /**
+     * @param output_stream
+     * @param ordered Whether to write results in the order of the archives
+     * @param max_num_buffered_bytes The maximum number of bytes of results to buffer in ordered
+     * mode
+     */
+    ResultsSink(
+            FILE* output_stream,
+            bool ordered,
+            size_t max_num_buffered_bytes = cDefaultMaxNumBufferedBytes
+    )
+            : m_output_stream{output_stream},
+              m_ordered{ordered},
+              m_max_num_buffered_bytes{max_num_buffered_bytes} {}
+
+    // Methods
+    /**
+     * Writes the results of an archive, or buffers them until the results of all preceding
+     * archives have been written. Blocks while the results can't be written or buffered.
+     * @param archive_ix The index of the archive in the list of archives being searched
+     * @param results
+     */
+    void write(size_t archive_ix, std::string results);
+
+    /**
+     * Cancels the sink, discarding any buffered results and unblocking any writers, e.g., when an
+     * archive's search failed and its results will never be written.
+     */
+    void cancel();
+
+private:
+    /**
+     * Writes the buffered results of the archives that are next in order.
+     */
+    void write_pending_results();
+
+    FILE* m_output_stream;
+    bool m_ordered;
+    size_t m_max_num_buffered_bytes;
+    size_t m_next_archive_ix{0};
+    std::map<size_t, std::string> m_pending_results;
+    size_t m_num_buffered_bytes{0};
+    bool m_cancelled{false};
+    std::mutex m_mutex;
+    std::condition_variable m_results_written;
+};
+}  // namespace clp::clg
+
+#endif  // CLP_CLG_RESULTSSINK_HPP
@@ -1,8 +1,18 @@
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <log_surgeon/Lexer.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -15,10 +25,13 @@
 #include "../Profiler.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/Constants.hpp"
+#include "../Thread.hpp"
 #include "../Utils.hpp"
 #include "CommandLineArguments.hpp"
+#include "ResultsSink.hpp"
 
 using clp::clg::CommandLineArguments;
+using clp::clg::ResultsSink;
 using clp::CommandLineArgumentsBase;
 using clp::epochtime_t;
 using clp::ErrorCode;
@@ -70,6 +83,7 @@ static bool open_compressed_file(
  * Searches all files referenced by a given database cursor
  * @param queries
  * @param output_method
+ * @param output_stream The stream to write results to, or nullptr to write them to stdout
  * @param archive
  * @param file_metadata_ix
  * @return The total number of matches found across all files
@@ -77,15 +91,16 @@ static bool open_compressed_file(
 static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod output_method,
+        FILE* output_stream,
         Archive& archive,
         MetadataDB::FileIterator& file_metadata_ix
 );
 /**
- * Prints search result to stdout in text format
+ * Prints search result in text format
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg The stream (FILE*) to write to, or nullptr to write to stdout
  */
 static void print_result_text(
         string const& orig_file_path,
@@ -94,11 +109,11 @@ static void print_result_text(
         void* custom_arg
 );
 /**
- * Prints search result to stdout in binary format
+ * Prints search result in binary format
  * @param orig_file_path
  * @param compressed_msg
  * @param decompressed_msg
- * @param custom_arg Unused
+ * @param custom_arg The stream (FILE*) to write to, or nullptr to write to stdout
  */
 static void print_result_binary(
         string const& orig_file_path,
@@ -197,6 +212,7 @@ static bool open_archive(string const& archive_path, Archive& archive_reader) {
 static bool search(
         vector<string> const& search_strings,
         CommandLineArguments& command_line_args,
+        FILE* output_stream,
         Archive& archive,
         log_surgeon::lexers::ByteLexer& lexer,
         bool use_heuristic
@@ -239,21 +255,20 @@ static bool search(
                 }
 
                 // Calculate the IDs of the segments that may contain results for each sub-query.
-                auto get_segments_containing_logtype_dict_id
+                auto get_segments_containing_logtype_dict_ids
                         = [&logtype_dict](
-                                  logtype_dictionary_id_t logtype_id
-                          ) -> std::set<segment_id_t> const& {
-                    return logtype_dict.get_entry(logtype_id)
-                            .get_ids_of_segments_containing_entry();
+                                  std::unordered_set<logtype_dictionary_id_t> const& logtype_ids
+                          ) -> clp::SegmentIdBitmap {
+                    return logtype_dict.get_ids_of_segments_containing_entries(logtype_ids);
                 };
-                auto get_segments_containing_var_dict_id = [&var_dict](
-                                                                   variable_dictionary_id_t var_id
-                                                           ) -> std::set<segment_id_t> const& {
-                    return var_dict.get_entry(var_id).get_ids_of_segments_containing_entry();
+                auto get_segments_containing_var_dict_ids
+                        = [&var_dict](std::unordered_set<variable_dictionary_id_t> const& var_ids
+                          ) -> clp::SegmentIdBitmap {
+                    return var_dict.get_ids_of_segments_containing_entries(var_ids);
                 };
                 query.calculate_ids_of_matching_segments(
-                        get_segments_containing_logtype_dict_id,
-                        get_segments_containing_var_dict_id
+                        get_segments_containing_logtype_dict_ids,
+                        get_segments_containing_var_dict_ids
                 );
 
                 queries.push_back(query);
@@ -262,8 +277,8 @@ static bool search(
                 for (auto& sub_query : query.get_sub_queries()) {
                     auto& ids_of_matching_segments = sub_query.get_ids_of_matching_segments();
                     ids_of_segments_to_search.insert(
-                            ids_of_matching_segments.cbegin(),
-                            ids_of_matching_segments.cend()
+                            ids_of_matching_segments.begin(),
+                            ids_of_matching_segments.end()
                     );
                 }
             }
@@ -281,6 +296,7 @@ static bool search(
                 num_matches = search_files(
                         queries,
                         command_line_args.get_output_method(),
+                        output_stream,
                         archive,
                         *file_metadata_ix
                 );
@@ -296,6 +312,7 @@ static bool search(
                 num_matches = search_files(
                         queries,
                         command_line_args.get_output_method(),
+                        output_stream,
                         archive,
                         file_metadata_ix
                 );
@@ -304,6 +321,7 @@ static bool search(
                     num_matches += search_files(
                             queries,
                             command_line_args.get_output_method(),
+                            output_stream,
                             archive,
                             file_metadata_ix
                     );
@@ -361,6 +379,7 @@ static bool open_compressed_file(
 static size_t search_files(
         vector<Query>& queries,
         CommandLineArguments::OutputMethod const output_method,
+        FILE* output_stream,
         Archive& archive,
         MetadataDB::FileIterator& file_metadata_ix
 ) {
@@ -373,11 +392,11 @@ static size_t search_files(
     switch (output_method) {
         case CommandLineArguments::OutputMethod::StdoutText:
             output_func = print_result_text;
-            output_func_arg = nullptr;
+            output_func_arg = output_stream;
             break;
         case CommandLineArguments::OutputMethod::StdoutBinary:
             output_func = print_result_binary;
-            output_func_arg = nullptr;
+            output_func_arg = output_stream;
             break;
         default:
             SPDLOG_ERROR("Unknown output method - {}", (char)output_method);
@@ -413,7 +432,8 @@ static void print_result_text(
         string const& decompressed_msg,
         void* custom_arg
 ) {
-    printf("%s:%s", orig_file_path.c_str(), decompressed_msg.c_str());
+    auto* output_stream = nullptr == custom_arg ? stdout : static_cast<FILE*>(custom_arg);
+    fprintf(output_stream, "%s:%s", orig_file_path.c_str(), decompressed_msg.c_str());
 }
 
 static void print_result_binary(
@@ -422,6 +442,7 @@ static void print_result_binary(
         string const& decompressed_msg,
         void* custom_arg
 ) {
+    auto* output_stream = nullptr == custom_arg ? stdout : static_cast<FILE*>(custom_arg);
     bool write_successful = true;
     do {
         size_t length;
@@ -429,12 +450,12 @@ static void print_result_binary(
 
         // Write file path
         length = orig_file_path.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
+        num_elems_written = fwrite(&length, sizeof(length), 1, output_stream);
         if (num_elems_written < 1) {
             write_successful = false;
             break;
         }
-        num_elems_written = fwrite(orig_file_path.c_str(), sizeof(char), length, stdout);
+        num_elems_written = fwrite(orig_file_path.c_str(), sizeof(char), length, output_stream);
         if (num_elems_written < length) {
             write_successful = false;
             break;
@@ -442,7 +463,7 @@ static void print_result_binary(
 
         // Write timestamp
         epochtime_t timestamp = compressed_msg.get_ts_in_milli();
-        num_elems_written = fwrite(&timestamp, sizeof(timestamp), 1, stdout);
+        num_elems_written = fwrite(&timestamp, sizeof(timestamp), 1, output_stream);
         if (num_elems_written < 1) {
             write_successful = false;
             break;
@@ -450,7 +471,7 @@ static void print_result_binary(
 
         // Write logtype ID
         auto logtype_id = compressed_msg.get_logtype_id();
-        num_elems_written = fwrite(&logtype_id, sizeof(logtype_id), 1, stdout);
+        num_elems_written = fwrite(&logtype_id, sizeof(logtype_id), 1, output_stream);
         if (num_elems_written < 1) {
             write_successful = false;
             break;
@@ -458,12 +479,12 @@ static void print_result_binary(
 
         // Write message
         length = decompressed_msg.length();
-        num_elems_written = fwrite(&length, sizeof(length), 1, stdout);
+        num_elems_written = fwrite(&length, sizeof(length), 1, output_stream);
         if (num_elems_written < 1) {
             write_successful = false;
             break;
         }
-        num_elems_written = fwrite(decompressed_msg.c_str(), sizeof(char), length, stdout);
+        num_elems_written = fwrite(decompressed_msg.c_str(), sizeof(char), length, output_stream);
         if (num_elems_written < length) {
             write_successful = false;
             break;
@@ -474,10 +495,192 @@ static void print_result_binary(
     }
 }
 
+namespace {
+/**
+ * Searches archives, reusing the lexers generated for archives with the same schema.
+ */
+class ArchiveSearcher {
+public:
+    // Constructors
+    ArchiveSearcher(vector<string> const& search_strings, CommandLineArguments& command_line_args)
+            : m_search_strings{search_strings},
+              m_command_line_args{command_line_args} {}
+
+    // Methods
+    /**
+     * Opens, searches, and closes the given archive
+     * @param archive_path
+     * @param output_stream The stream to write results to, or nullptr to write them to stdout
+     * @return true on success, false otherwise
+     */
+    bool search_archive(std::filesystem::path const& archive_path, FILE* output_stream);
+
+private:
+    // Constants
+    static constexpr uint32_t cMaxMapSchemaLength{100'000};
+
+    // Methods
+    /**
+     * Gets the lexer for the given schema file, generating it if necessary
+     * @param schema_file_path
+     * @return The lexer
+     */
+    log_surgeon::lexers::ByteLexer& get_lexer(std::filesystem::path const& schema_file_path);
+
+    // Variables
+    vector<string> const& m_search_strings;
+    CommandLineArguments& m_command_line_args;
+    Archive m_archive_reader;
+    // TODO: if performance is too slow, can make this more efficient by only diffing files with
+    // the same checksum
+    std::map<std::string, log_surgeon::lexers::ByteLexer> m_lexer_map;
+    log_surgeon::lexers::ByteLexer m_one_time_use_lexer;
+};
+
+/**
+ * Thread that searches archives from a shared list until none are left or a search fails
+ */
+class SearchThread : public clp::Thread {
+public:
+    // Constructors
+    SearchThread(
+            vector<string> const& search_strings,
+            CommandLineArguments& command_line_args,
+            vector<std::filesystem::path> const& archive_paths,
+            std::atomic_size_t& next_archive_ix,
+            std::atomic_bool& search_failed,
+            ResultsSink& results_sink
+    )
+            : m_archive_searcher{search_strings, command_line_args},
+              m_archive_paths{archive_paths},
+              m_next_archive_ix{next_archive_ix},
+              m_search_failed{search_failed},
+              m_results_sink{results_sink} {}
+
+protected:
+    // Methods implementing `Thread`
+    void thread_method() override;
+
+private:
+    /**
+     * Searches the given archive, buffering its results before writing them to the sink
+     * @param archive_ix
+     * @return true on success, false otherwise
+     */
+    bool search_archive(size_t archive_ix);
+
+    ArchiveSearcher m_archive_searcher;
+    vector<std::filesystem::path> const& m_archive_paths;
+    std::atomic_size_t& m_next_archive_ix;
+    std::atomic_bool& m_search_failed;
+    ResultsSink& m_results_sink;
+};
+
+bool ArchiveSearcher::search_archive(
+        std::filesystem::path const& archive_path,
+        FILE* output_stream
+) {
+    // Open archive
+    if (!open_archive(archive_path.string(), m_archive_reader)) {
+        return false;
+    }
+
+    // Generate lexer if schema file exists
+    auto schema_file_path = archive_path / clp::streaming_archive::cSchemaFileName;
+    bool use_heuristic = true;
+    log_surgeon::lexers::ByteLexer* lexer_ptr = &m_one_time_use_lexer;
+    if (std::filesystem::exists(schema_file_path)) {
+        use_heuristic = false;
+        lexer_ptr = &get_lexer(schema_file_path);
+    }
+
+    // Perform search
+    if (!search(
+                m_search_strings,
+                m_command_line_args,
+                output_stream,
+                m_archive_reader,
+                *lexer_ptr,
+                use_heuristic
+        ))
+    {
+        return false;
+    }
+    m_archive_reader.close();
+    return true;
+}
+
+log_surgeon::lexers::ByteLexer&
+ArchiveSearcher::get_lexer(std::filesystem::path const& schema_file_path) {
+    std::string schema(cMaxMapSchemaLength, '\0');
+    FileReader file_reader{schema_file_path};
+
+    size_t num_bytes_read;
+    file_reader.read(schema.data(), cMaxMapSchemaLength, num_bytes_read);
+    if (num_bytes_read >= cMaxMapSchemaLength) {
+        load_lexer_from_file(schema_file_path, m_one_time_use_lexer);
+        return m_one_time_use_lexer;
+    }
+    schema.resize(num_bytes_read);
+
+    auto lexer_map_it = m_lexer_map.find(schema);
+    // if there is a chance there might be a difference make a new lexer as it's pretty fast to
+    // create
+    if (lexer_map_it == m_lexer_map.end()) {
+        auto insert_result = m_lexer_map.emplace(schema, log_surgeon::lexers::ByteLexer());
+        auto& lexer = insert_result.first->second;
+        load_lexer_from_file(schema_file_path, lexer);
+        return lexer;
+    }
+    return lexer_map_it->second;
+}
+
+void SearchThread::thread_method() {
+    for (size_t archive_ix = m_next_archive_ix++;
+         archive_ix < m_archive_paths.size() && false == m_search_failed;
+         archive_ix = m_next_archive_ix++)
+    {
+        bool succeeded = false;
+        try {
+            succeeded = search_archive(archive_ix);
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Search failed: {}", e.what());
+        }
+        if (false == succeeded) {
+            m_search_failed = true;
+            // The archive's results will never be written, so unblock any writers waiting on it
+            m_results_sink.cancel();
+            return;
+        }
+    }
+}
+
+bool SearchThread::search_archive(size_t archive_ix) {
+    char* results = nullptr;
+    size_t results_size = 0;
+    auto* results_stream = open_memstream(&results, &results_size);
+    if (nullptr == results_stream) {
+        SPDLOG_ERROR("Failed to open stream for search results, errno={}", errno);
+        return false;
+    }
+    bool const succeeded
+            = m_archive_searcher.search_archive(m_archive_paths[archive_ix], results_stream);
+    fclose(results_stream);
+    std::string archive_results{results, results_size};
+    free(results);
+    if (false == succeeded) {
+        return false;
+    }
+
+    m_results_sink.write(archive_ix, std::move(archive_results));
+    return true;
+}
+}  // namespace
+
 int main(int argc, char const* argv[]) {
     // Program-wide initialization
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S,%e [%l] %v");
     } catch (std::exception& e) {
@@ -541,15 +744,9 @@ int main(int argc, char const* argv[]) {
     }
     global_metadata_db->open();
 
-    // TODO: if performance is too slow, can make this more efficient by only diffing files with the
-    // same checksum
-    uint32_t const max_map_schema_length = 100'000;
-    std::map<std::string, log_surgeon::lexers::ByteLexer> lexer_map;
-    log_surgeon::lexers::ByteLexer one_time_use_lexer;
-    log_surgeon::lexers::ByteLexer* lexer_ptr;
-
+    // Collect the archives to search
+    vector<std::filesystem::path> archive_paths;
     string archive_id;
-    Archive archive_reader;
     for (auto archive_ix = std::unique_ptr<GlobalMetadataDB::ArchiveIterator>(get_archive_iterator(
                  *global_metadata_db,
                  command_line_args.get_file_path(),
@@ -570,49 +767,45 @@ int main(int argc, char const* argv[]) {
             );
             continue;
         }
+        archive_paths.emplace_back(std::move(archive_path));
+    }
 
-        // Open archive
-        if (!open_archive(archive_path.string(), archive_reader)) {
-            return -1;
-        }
+    global_metadata_db->close();
 
-        // Generate lexer if schema file exists
-        auto schema_file_path = archive_path / clp::streaming_archive::cSchemaFileName;
-        bool use_heuristic = true;
-        if (std::filesystem::exists(schema_file_path)) {
-            use_heuristic = false;
-
-            char buf[max_map_schema_length];
-            FileReader file_reader{schema_file_path};
-
-            size_t num_bytes_read;
-            file_reader.read(buf, max_map_schema_length, num_bytes_read);
-            if (num_bytes_read < max_map_schema_length) {
-                auto lexer_map_it = lexer_map.find(buf);
-                // if there is a chance there might be a difference make a new lexer as it's pretty
-                // fast to create
-                if (lexer_map_it == lexer_map.end()) {
-                    auto insert_result = lexer_map.emplace(buf, log_surgeon::lexers::ByteLexer());
-                    lexer_ptr = &insert_result.first->second;
-                    load_lexer_from_file(schema_file_path, *lexer_ptr);
-                } else {
-                    lexer_ptr = &lexer_map_it->second;
-                }
-            } else {
-                lexer_ptr = &one_time_use_lexer;
-                load_lexer_from_file(schema_file_path, one_time_use_lexer);
+    auto const num_threads = std::min(command_line_args.get_num_threads(), archive_paths.size());
+    if (num_threads <= 1) {
+        ArchiveSearcher archive_searcher{search_strings, command_line_args};
+        for (auto const& archive_path : archive_paths) {
+            if (false == archive_searcher.search_archive(archive_path, nullptr)) {
+                return -1;
             }
         }
-
-        // Perform search
-        if (!search(search_strings, command_line_args, archive_reader, *lexer_ptr, use_heuristic)) {
+    } else {
+        // Each thread owns an archive reader and takes the next archive to search from the list;
+        // results are buffered per archive and written by the sink.
+        ResultsSink results_sink{stdout, false == command_line_args.unordered_output()};
+        std::atomic_size_t next_archive_ix{0};
+        std::atomic_bool search_failed{false};
+        vector<std::unique_ptr<SearchThread>> search_threads;
+        for (size_t i = 0; i < num_threads; ++i) {
+            search_threads.emplace_back(std::make_unique<SearchThread>(
+                    search_strings,
+                    command_line_args,
+                    archive_paths,
+                    next_archive_ix,
+                    search_failed,
+                    results_sink
+            ));
+            search_threads.back()->start();
+        }
+        for (auto& search_thread : search_threads) {
+            search_thread->join();
+        }
+        if (search_failed) {
             return -1;
         }
-        archive_reader.close();
     }
 
-    global_metadata_db->close();
-
     Profiler::stop_continuous_measurement<Profiler::ContinuousMeasurementIndex::Search>();
     LOG_CONTINUOUS_MEASUREMENT(Profiler::ContinuousMeasurementIndex::Search)
 
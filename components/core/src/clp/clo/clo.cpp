@@ -3,6 +3,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_set>
 
 #include <mongocxx/instance.hpp>
 #include <nlohmann/json.hpp>
@@ -518,17 +519,19 @@ static bool search_archive(
 
     auto& query = query_processing_result.value();
     // Calculate the IDs of the segments that may contain results for each sub-query.
-    auto get_segments_containing_logtype_dict_id
-            = [&logtype_dict](logtype_dictionary_id_t logtype_id) -> std::set<segment_id_t> const& {
-        return logtype_dict.get_entry(logtype_id).get_ids_of_segments_containing_entry();
+    auto get_segments_containing_logtype_dict_ids
+            = [&logtype_dict](std::unordered_set<logtype_dictionary_id_t> const& logtype_ids
+              ) -> clp::SegmentIdBitmap {
+        return logtype_dict.get_ids_of_segments_containing_entries(logtype_ids);
     };
-    auto get_segments_containing_var_dict_id
-            = [&var_dict](variable_dictionary_id_t var_id) -> std::set<segment_id_t> const& {
-        return var_dict.get_entry(var_id).get_ids_of_segments_containing_entry();
+    auto get_segments_containing_var_dict_ids
+            = [&var_dict](std::unordered_set<variable_dictionary_id_t> const& var_ids
+              ) -> clp::SegmentIdBitmap {
+        return var_dict.get_ids_of_segments_containing_entries(var_ids);
     };
     query.calculate_ids_of_matching_segments(
-            get_segments_containing_logtype_dict_id,
-            get_segments_containing_var_dict_id
+            get_segments_containing_logtype_dict_ids,
+            get_segments_containing_var_dict_ids
     );
 
     // Get all segments potentially containing query results
@@ -536,8 +539,8 @@ static bool search_archive(
     for (auto& sub_query : query.get_sub_queries()) {
         auto& ids_of_matching_segments = sub_query.get_ids_of_matching_segments();
         ids_of_segments_to_search.insert(
-                ids_of_matching_segments.cbegin(),
-                ids_of_matching_segments.cend()
+                ids_of_matching_segments.begin(),
+                ids_of_matching_segments.end()
         );
     }
 
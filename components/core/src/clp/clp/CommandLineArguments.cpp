@@ -347,6 +347,13 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->value_name("LEVEL")
                             ->default_value(m_compression_level),
                     "1 (fast/low compression) to 19 (slow/high compression)"
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_threads),
+                    "Number of threads to compress files with. Each thread compresses files into"
+                    " its own archives."
             )(
                     "print-archive-stats-progress",
                     po::bool_switch(&m_print_archive_stats_progress),
@@ -416,6 +423,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                 throw invalid_argument("target-data-size-of-dictionaries must be non-zero.");
             }
 
+            if (m_num_threads < 1) {
+                throw invalid_argument("num-threads must be non-zero.");
+            }
+
             if (false == m_path_prefix_to_remove.empty()) {
                 if (false == boost::filesystem::exists(m_path_prefix_to_remove)) {
                     throw invalid_argument("Specified prefix to remove does not exist.");
@@ -62,6 +62,8 @@ public:
 
     int get_compression_level() const { return m_compression_level; }
 
+    size_t get_num_threads() const { return m_num_threads; }
+
     Command get_command() const { return m_command; }
 
     std::string const& get_archives_dir() const { return m_archives_dir; }
@@ -100,6 +102,7 @@ private:
     size_t m_target_segment_uncompressed_size;
     size_t m_target_data_size_of_dictionaries;
     int m_compression_level;
+    size_t m_num_threads{1};
     Command m_command;
     std::string m_archives_dir;
     std::vector<std::string> m_input_paths;
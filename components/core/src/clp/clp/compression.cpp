@@ -1,7 +1,14 @@
 #include "compression.hpp"
 
+#include <algorithm>
+#include <exception>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <archive_entry.h>
 #include <boost/filesystem/operations.hpp>
@@ -11,6 +18,8 @@
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/writer/Archive.hpp"
 #include "../streaming_archive/writer/utils.hpp"
+#include "../Thread.hpp"
+#include "../TraceableException.hpp"
 #include "../Utils.hpp"
 #include "FileCompressor.hpp"
 #include "utils.hpp"
@@ -53,6 +62,183 @@ file_gt_last_write_time_comparator(FileToCompress const& lhs, FileToCompress con
            > boost::filesystem::last_write_time(rhs.get_path());
 }
 
+namespace {
+/**
+ * A range of files that must be compressed into the same archive, in order.
+ */
+struct FileBatch {
+    vector<FileToCompress>::const_iterator begin;
+    vector<FileToCompress>::const_iterator end;
+};
+
+/**
+ * Hands out batches of files to the threads compressing them and tracks their progress.
+ */
+class CompressionCoordinator {
+public:
+    // Constructors
+    CompressionCoordinator(vector<FileBatch> batches, bool show_progress, size_t num_files)
+            : m_batches{std::move(batches)},
+              m_show_progress{show_progress},
+              m_num_files_to_compress{num_files} {}
+
+    // Methods
+    /**
+     * @return The next batch of files to compress, or std::nullopt if there are none left.
+     */
+    [[nodiscard]] auto get_next_batch() -> std::optional<FileBatch> {
+        std::lock_guard const lock{m_mutex};
+        if (m_next_batch_ix >= m_batches.size()) {
+            return std::nullopt;
+        }
+        return m_batches[m_next_batch_ix++];
+    }
+
+    /**
+     * Records that a file was compressed.
+     */
+    auto report_file_compressed() -> void {
+        if (false == m_show_progress) {
+            return;
+        }
+        std::lock_guard const lock{m_mutex};
+        ++m_num_files_compressed;
+        cerr << "Compressed " << m_num_files_compressed << '/' << m_num_files_to_compress
+             << " files" << '\r';
+    }
+
+private:
+    vector<FileBatch> m_batches;
+    size_t m_next_batch_ix{0};
+    bool m_show_progress;
+    size_t m_num_files_to_compress;
+    size_t m_num_files_compressed{0};
+    std::mutex m_mutex;
+};
+
+/**
+ * Thread that compresses batches of files handed out by a `CompressionCoordinator` into its own
+ * archives. Each thread has its own dictionaries and segments, so threads don't need to
+ * synchronize while compressing.
+ */
+class CompressionThread : public Thread {
+public:
+    // Constructors
+    CompressionThread(
+            CommandLineArguments const& command_line_args,
+            streaming_archive::writer::Archive::UserConfig const& archive_user_config,
+            std::unique_ptr<log_surgeon::ReaderParser> reader_parser,
+            size_t target_encoded_file_size,
+            bool use_heuristic,
+            CompressionCoordinator& coordinator
+    )
+            : m_archive_user_config{archive_user_config},
+              m_file_compressor{m_uuid_generator, std::move(reader_parser)},
+              m_target_data_size_of_dictionaries{
+                      command_line_args.get_target_data_size_of_dictionaries()
+              },
+              m_target_encoded_file_size{target_encoded_file_size},
+              m_use_heuristic{use_heuristic},
+              m_coordinator{coordinator} {
+        // Set schema file if specified by user
+        if (false == command_line_args.get_use_heuristic()) {
+            m_archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
+        }
+    }
+
+    // Methods
+    /**
+     * Compresses batches of files until there are none left.
+     * @param empty_directory_paths Empty directories to add to the first archive. If non-null,
+     * an archive is created even if no files are compressed.
+     * @throw TraceableException on failure
+     */
+    auto compress(vector<string> const* empty_directory_paths) -> void;
+
+    /**
+     * @return Whether all files given to this thread were compressed successfully.
+     */
+    [[nodiscard]] auto all_files_compressed_successfully() const -> bool {
+        return m_all_files_compressed_successfully;
+    }
+
+protected:
+    // Methods implementing `Thread`
+    auto thread_method() -> void override;
+
+private:
+    boost::uuids::random_generator m_uuid_generator;
+    streaming_archive::writer::Archive::UserConfig m_archive_user_config;
+    streaming_archive::writer::Archive m_archive_writer;
+    FileCompressor m_file_compressor;
+    size_t m_target_data_size_of_dictionaries;
+    size_t m_target_encoded_file_size;
+    bool m_use_heuristic;
+    CompressionCoordinator& m_coordinator;
+    bool m_all_files_compressed_successfully{true};
+};
+
+auto CompressionThread::compress(vector<string> const* empty_directory_paths) -> void {
+    bool archive_is_open{false};
+    if (nullptr != empty_directory_paths) {
+        m_archive_writer.open(m_archive_user_config);
+        archive_is_open = true;
+        m_archive_writer.add_empty_directories(*empty_directory_paths);
+    }
+
+    for (auto batch = m_coordinator.get_next_batch(); batch.has_value();
+         batch = m_coordinator.get_next_batch())
+    {
+        if (false == archive_is_open) {
+            m_archive_writer.open(m_archive_user_config);
+            archive_is_open = true;
+        }
+        for (auto it = batch->begin; it != batch->end; ++it) {
+            if (m_archive_writer.get_data_size_of_dictionaries()
+                >= m_target_data_size_of_dictionaries)
+            {
+                split_archive(m_archive_user_config, m_archive_writer);
+            }
+            if (false
+                == m_file_compressor.compress_file(
+                        m_target_data_size_of_dictionaries,
+                        m_archive_user_config,
+                        m_target_encoded_file_size,
+                        *it,
+                        m_archive_writer,
+                        m_use_heuristic
+                ))
+            {
+                m_all_files_compressed_successfully = false;
+            }
+            m_coordinator.report_file_compressed();
+        }
+    }
+
+    if (archive_is_open) {
+        m_archive_writer.close();
+    }
+}
+
+auto CompressionThread::thread_method() -> void {
+    try {
+        compress(nullptr);
+    } catch (TraceableException& e) {
+        SPDLOG_ERROR(
+                "Compression failed: {}:{} {}, error_code={}",
+                e.get_filename(),
+                e.get_line_number(),
+                e.what(),
+                e.get_error_code()
+        );
+        m_all_files_compressed_successfully = false;
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Compression failed: {}", e.what());
+        m_all_files_compressed_successfully = false;
+    }
+}
+}  // namespace
+
 bool compress(
         CommandLineArguments& command_line_args,
         vector<FileToCompress>& files_to_compress,
@@ -78,6 +264,8 @@ bool compress(
     }
 
     auto uuid_generator = boost::uuids::random_generator();
+    auto const num_threads = command_line_args.get_num_threads();
+    std::mutex global_metadata_db_mutex;
 
     // Setup config
     streaming_archive::writer::Archive::UserConfig archive_user_config;
@@ -91,87 +279,94 @@ bool compress(
     archive_user_config.global_metadata_db = global_metadata_db.get();
     archive_user_config.print_archive_stats_progress
             = command_line_args.print_archive_stats_progress();
-
-    // Open Archive
-    streaming_archive::writer::Archive archive_writer;
-    // Set schema file if specified by user
-    if (false == command_line_args.get_use_heuristic()) {
-        archive_writer.m_schema_file_path = command_line_args.get_schema_file_path();
+    if (num_threads > 1) {
+        archive_user_config.global_metadata_db_mutex = &global_metadata_db_mutex;
     }
-    // Open archive
-    archive_writer.open(archive_user_config);
 
-    archive_writer.add_empty_directories(empty_directory_paths);
-
-    bool all_files_compressed_successfully = true;
-    FileCompressor file_compressor(uuid_generator, std::move(reader_parser));
-    auto target_data_size_of_dictionaries
-            = command_line_args.get_target_data_size_of_dictionaries();
-
-    // Compress all files
-    size_t num_files_compressed = 0;
-    size_t num_files_to_compress = 0;
-    if (command_line_args.show_progress()) {
-        num_files_to_compress = files_to_compress.size() + grouped_files_to_compress.size();
-    }
+    // Batch the files, in the order they should be compressed
     if (command_line_args.sort_input_files()) {
         sort(files_to_compress.begin(),
              files_to_compress.end(),
              file_gt_last_write_time_comparator);
     }
-    for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
-        }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    *it,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
-            all_files_compressed_successfully = false;
-        }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
-    }
-
     // Sort files by group ID to avoid spreading groups over multiple segments
     sort(grouped_files_to_compress.begin(),
          grouped_files_to_compress.end(),
          file_group_id_comparator);
-    // Compress grouped files
-    for (auto const& file_to_compress : grouped_files_to_compress) {
-        if (archive_writer.get_data_size_of_dictionaries() >= target_data_size_of_dictionaries) {
-            split_archive(archive_user_config, archive_writer);
+    vector<FileBatch> batches;
+    for (auto it = files_to_compress.cbegin(); it != files_to_compress.cend(); ++it) {
+        batches.push_back({it, it + 1});
+    }
+    // Each group is compressed into the same archive
+    for (auto it = grouped_files_to_compress.cbegin(); it != grouped_files_to_compress.cend();) {
+        auto const group_id = it->get_group_id();
+        auto const group_end = std::find_if(
+                it,
+                grouped_files_to_compress.cend(),
+                [&](FileToCompress const& file) { return file.get_group_id() != group_id; }
+        );
+        batches.push_back({it, group_end});
+        it = group_end;
+    }
+    CompressionCoordinator coordinator{
+            std::move(batches),
+            command_line_args.show_progress(),
+            files_to_compress.size() + grouped_files_to_compress.size()
+    };
+
+    if (1 == num_threads) {
+        CompressionThread compressor{
+                command_line_args,
+                archive_user_config,
+                std::move(reader_parser),
+                target_encoded_file_size,
+                use_heuristic,
+                coordinator
+        };
+        compressor.compress(&empty_directory_paths);
+        return compressor.all_files_compressed_successfully();
+    }
+
+    // Each thread compresses files into its own archives, with its own creator ID so that the
+    // archives' creation numbers are unique. The first thread (the calling thread) also creates the
+    // archive containing the empty directories.
+    vector<unique_ptr<CompressionThread>> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+        std::unique_ptr<log_surgeon::ReaderParser> thread_reader_parser;
+        if (0 == i) {
+            thread_reader_parser = std::move(reader_parser);
+        } else {
+            archive_user_config.id = uuid_generator();
+            archive_user_config.creator_id = uuid_generator();
+            if (false == use_heuristic) {
+                thread_reader_parser = make_unique<log_surgeon::ReaderParser>(
+                        command_line_args.get_schema_file_path()
+                );
+            }
         }
-        if (false
-            == file_compressor.compress_file(
-                    target_data_size_of_dictionaries,
-                    archive_user_config,
-                    target_encoded_file_size,
-                    file_to_compress,
-                    archive_writer,
-                    use_heuristic
-            ))
-        {
+        threads.emplace_back(make_unique<CompressionThread>(
+                command_line_args,
+                archive_user_config,
+                std::move(thread_reader_parser),
+                target_encoded_file_size,
+                use_heuristic,
+                coordinator
+        ));
+    }
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads[i]->start();
+    }
+    // NOTE: If this throws, the other threads are joined when they're destroyed
+    threads[0]->compress(&empty_directory_paths);
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads[i]->join();
+    }
+    bool all_files_compressed_successfully = true;
+    for (auto const& thread : threads) {
+        if (false == thread->all_files_compressed_successfully()) {
             all_files_compressed_successfully = false;
         }
-        if (command_line_args.show_progress()) {
-            ++num_files_compressed;
-            cerr << "Compressed " << num_files_compressed << '/' << num_files_to_compress
-                 << " files" << '\r';
-        }
     }
-
-    archive_writer.close();
-
     return all_files_compressed_successfully;
 }
 
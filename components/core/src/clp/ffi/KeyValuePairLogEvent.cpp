@@ -1,5 +1,9 @@
 #include "KeyValuePairLogEvent.hpp"
 
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <stack>
@@ -15,9 +19,12 @@
 #include <nlohmann/json_fwd.hpp>
 #include <ystdlib/error_handling/Result.hpp>
 
+#include "../ir/types.hpp"
 #include "../time_types.hpp"
 #include "EncodedTextAst.hpp"
+#include "encoding_methods.hpp"
 #include "SchemaTree.hpp"
+#include "utils.hpp"
 #include "Value.hpp"
 
 using std::string;
@@ -204,6 +211,66 @@ private:
         vector<bool> const& schema_subtree_bitmap
 ) -> ystdlib::error_handling::Result<nlohmann::json>;
 
+/**
+ * Appends the given float to the JSON string, formatted the same way as `nlohmann::json::dump`:
+ * - Finite values are formatted by `nlohmann::detail::to_chars` (the formatter `dump` uses), which
+ *   produces the shortest representation that round-trips, using scientific notation only for
+ *   exponents outside [-4, 15), and appends ".0" to values that would otherwise be read back as
+ *   integers.
+ * - NaN and infinite values are serialized as `null`.
+ * @param value
+ * @param json_str
+ */
+auto append_float_as_json_str(value_float_t value, string& json_str) -> void;
+
+/**
+ * Decodes the given encoded text AST and appends it to the JSON string as an escaped string
+ * literal (including the enclosing quotes).
+ * @tparam encoded_variable_t
+ * @param encoded_text_ast
+ * @param json_str
+ * @return Whether the text AST was successfully decoded into a valid UTF-8 string.
+ */
+template <ir::EncodedVariableTypeReq encoded_variable_t>
+[[nodiscard]] auto append_encoded_text_ast_as_json_str(
+        EncodedTextAst<encoded_variable_t> const& encoded_text_ast,
+        string& json_str
+) -> bool;
+
+/**
+ * Appends the given value to the JSON string according to the type of its schema tree node.
+ * @param node The schema tree node of the value's key.
+ * @param optional_val
+ * @param json_str
+ * @return Whether the value was successfully serialized.
+ */
+[[nodiscard]] auto append_value_as_json_str(
+        SchemaTree::Node const& node,
+        std::optional<Value> const& optional_val,
+        string& json_str
+) -> bool;
+
+/**
+ * Serializes the given node-ID-value pairs into a JSON object string and appends it to the given
+ * buffer.
+ *
+ * Unlike `serialize_node_id_value_pairs_to_json`, the keys of each object are written in the order
+ * of their schema tree nodes rather than in sorted order.
+ * @param schema_tree
+ * @param node_id_value_pairs
+ * @param schema_subtree_bitmap
+ * @param json_str
+ * @return A void result on success, or an error code indicating the failure:
+ * - std::errc::protocol_error if a key or value in the log event couldn't be decoded or isn't a
+ *   valid UTF-8 string.
+ */
+[[nodiscard]] auto append_node_id_value_pairs_as_json_str(
+        SchemaTree const& schema_tree,
+        KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+        vector<bool> const& schema_subtree_bitmap,
+        string& json_str
+) -> ystdlib::error_handling::Result<void>;
+
 /**
  * @param node A non-root schema tree node.
  * @param parent_node_id_to_key_names
@@ -507,6 +574,179 @@ auto serialize_node_id_value_pairs_to_json(
     return root_json_obj;
 }
 
+auto append_float_as_json_str(value_float_t value, string& json_str) -> void {
+    if (false == std::isfinite(value)) {
+        json_str += "null";
+        return;
+    }
+
+    // Same size as the buffer `nlohmann::json::dump` formats numbers into
+    constexpr size_t cBufSize{64};
+    std::array<char, cBufSize> buf{};
+    auto const* const end{nlohmann::detail::to_chars(buf.data(), buf.data() + buf.size(), value)};
+    json_str.append(buf.data(), static_cast<size_t>(end - buf.data()));
+}
+
+template <ir::EncodedVariableTypeReq encoded_variable_t>
+auto append_encoded_text_ast_as_json_str(
+        EncodedTextAst<encoded_variable_t> const& encoded_text_ast,
+        string& json_str
+) -> bool {
+    // Variables are delimited by ASCII characters, so validating each component separately is
+    // equivalent to validating the entire decoded string.
+    bool is_valid_utf8{true};
+    auto const append_escaped = [&](std::string_view component) -> void {
+        if (is_valid_utf8) {
+            is_valid_utf8 = validate_and_append_escaped_utf8_string(component, json_str);
+        }
+    };
+
+    json_str.push_back('"');
+    auto const result{encoded_text_ast.template decode<true>(
+            append_escaped,
+            [&](encoded_variable_t int_var) { json_str += decode_integer_var(int_var); },
+            [&](encoded_variable_t float_var) { json_str += decode_float_var(float_var); },
+            append_escaped
+    )};
+    json_str.push_back('"');
+    return false == result.has_error() && is_valid_utf8;
+}
+
+auto append_value_as_json_str(
+        SchemaTree::Node const& node,
+        std::optional<Value> const& optional_val,
+        string& json_str
+) -> bool {
+    if (false == optional_val.has_value()) {
+        json_str += "{}";
+        return true;
+    }
+
+    try {
+        auto const& val{optional_val.value()};
+        switch (node.get_type()) {
+            case SchemaTree::Node::Type::Int: {
+                // Large enough for any 64-bit integer
+                constexpr size_t cBufSize{24};
+                std::array<char, cBufSize> buf{};
+                auto const [end, ec]{std::to_chars(
+                        buf.data(),
+                        buf.data() + buf.size(),
+                        val.get_immutable_view<value_int_t>()
+                )};
+                json_str.append(buf.data(), end);
+                break;
+            }
+            case SchemaTree::Node::Type::Float:
+                append_float_as_json_str(val.get_immutable_view<value_float_t>(), json_str);
+                break;
+            case SchemaTree::Node::Type::Bool:
+                json_str += val.get_immutable_view<bool>() ? "true" : "false";
+                break;
+            case SchemaTree::Node::Type::Str:
+                if (val.is<string>()) {
+                    json_str.push_back('"');
+                    if (false
+                        == validate_and_append_escaped_utf8_string(
+                                val.get_immutable_view<string>(),
+                                json_str
+                        ))
+                    {
+                        return false;
+                    }
+                    json_str.push_back('"');
+                    return true;
+                }
+                if (val.is<FourByteEncodedTextAst>()) {
+                    return append_encoded_text_ast_as_json_str(
+                            val.get_immutable_view<FourByteEncodedTextAst>(),
+                            json_str
+                    );
+                }
+                return append_encoded_text_ast_as_json_str(
+                        val.get_immutable_view<EightByteEncodedTextAst>(),
+                        json_str
+                );
+            case SchemaTree::Node::Type::UnstructuredArray: {
+                // The decoded array is already serialized as JSON, so it only needs validating
+                auto const decoded_result{decode_as_encoded_text_ast(val)};
+                if (false == decoded_result.has_value()) {
+                    return false;
+                }
+                auto const& decoded_array{decoded_result.value()};
+                if (false == nlohmann::json::accept(decoded_array)) {
+                    return false;
+                }
+                json_str += decoded_array;
+                break;
+            }
+            case SchemaTree::Node::Type::Obj:
+                json_str += "null";
+                break;
+            default:
+                return false;
+        }
+    } catch (Value::OperationFailed const& ex) {
+        return false;
+    }
+
+    return true;
+}
+
+auto append_node_id_value_pairs_as_json_str(
+        SchemaTree const& schema_tree,
+        KeyValuePairLogEvent::NodeIdValuePairs const& node_id_value_pairs,
+        vector<bool> const& schema_subtree_bitmap,
+        string& json_str
+) -> ystdlib::error_handling::Result<void> {
+    // Traverse the schema tree in DFS order, but only traverse the nodes that are set in
+    // `schema_subtree_bitmap`. Each stack entry is a non-leaf node whose JSON object is open,
+    // paired with the index of its next child to visit.
+    vector<std::pair<SchemaTree::Node const*, size_t>> dfs_stack;
+    dfs_stack.emplace_back(&schema_tree.get_root(), 0);
+    json_str.push_back('{');
+    while (false == dfs_stack.empty()) {
+        auto& [node, next_child_idx]{dfs_stack.back()};
+        auto const& children_ids{node->get_children_ids()};
+        while (next_child_idx < children_ids.size()
+               && false == schema_subtree_bitmap[children_ids[next_child_idx]])
+        {
+            ++next_child_idx;
+        }
+        if (next_child_idx == children_ids.size()) {
+            json_str.push_back('}');
+            dfs_stack.pop_back();
+            continue;
+        }
+        auto const child_node_id{children_ids[next_child_idx++]};
+        auto const& child_node{schema_tree.get_node(child_node_id)};
+
+        // The last character is only '{' if this is the first member of the current object
+        if ('{' != json_str.back()) {
+            json_str.push_back(',');
+        }
+        json_str.push_back('"');
+        if (false == validate_and_append_escaped_utf8_string(child_node.get_key_name(), json_str))
+        {
+            return std::errc::protocol_error;
+        }
+        json_str += "\":";
+
+        auto const node_id_value_pair_it{node_id_value_pairs.find(child_node_id)};
+        if (node_id_value_pairs.cend() != node_id_value_pair_it) {
+            if (false
+                == append_value_as_json_str(child_node, node_id_value_pair_it->second, json_str))
+            {
+                return std::errc::protocol_error;
+            }
+        } else {
+            json_str.push_back('{');
+            dfs_stack.emplace_back(&child_node, 0);
+        }
+    }
+    return ystdlib::error_handling::success();
+}
+
 auto check_key_uniqueness_among_sibling_nodes(
         SchemaTree::Node const& node,
         std::unordered_map<SchemaTree::Node::id_t, std::unordered_set<std::string_view>>&
@@ -613,4 +853,24 @@ auto KeyValuePairLogEvent::serialize_to_json() const
     return {std::move(serialized_auto_gen_kv_pairs_result.value()),
             std::move(serialized_user_gen_kv_pairs_result.value())};
 }
+
+auto KeyValuePairLogEvent::append_auto_gen_kv_pairs_as_json_str(std::string& json_str) const
+        -> ystdlib::error_handling::Result<void> {
+    return append_node_id_value_pairs_as_json_str(
+            *m_auto_gen_keys_schema_tree,
+            m_auto_gen_node_id_value_pairs,
+            YSTDLIB_ERROR_HANDLING_TRYX(get_auto_gen_keys_schema_subtree_bitmap()),
+            json_str
+    );
+}
+
+auto KeyValuePairLogEvent::append_user_gen_kv_pairs_as_json_str(std::string& json_str) const
+        -> ystdlib::error_handling::Result<void> {
+    return append_node_id_value_pairs_as_json_str(
+            *m_user_gen_keys_schema_tree,
+            m_user_gen_node_id_value_pairs,
+            YSTDLIB_ERROR_HANDLING_TRYX(get_user_gen_keys_schema_subtree_bitmap()),
+            json_str
+    );
+}
 }  // namespace clp::ffi
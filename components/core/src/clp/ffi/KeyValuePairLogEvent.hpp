@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -113,6 +114,30 @@ public:
     [[nodiscard]] auto serialize_to_json() const
             -> ystdlib::error_handling::Result<std::pair<nlohmann::json, nlohmann::json>>;
 
+    /**
+     * Serializes the auto-generated key-value pairs into a JSON object string and appends it to
+     * the given buffer, without constructing any intermediate `nlohmann::json` objects.
+     * @param json_str Returns the buffer with the serialized JSON object appended. NOTE: On
+     * failure, `json_str` may still be modified.
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `get_auto_gen_keys_schema_subtree_bitmap`'s return values on failure.
+     * - Forwards `append_node_id_value_pairs_as_json_str`'s return values on failure.
+     */
+    [[nodiscard]] auto append_auto_gen_kv_pairs_as_json_str(std::string& json_str) const
+            -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Serializes the user-generated key-value pairs into a JSON object string and appends it to
+     * the given buffer, without constructing any intermediate `nlohmann::json` objects.
+     * @param json_str Returns the buffer with the serialized JSON object appended. NOTE: On
+     * failure, `json_str` may still be modified.
+     * @return A void result on success, or an error code indicating the failure:
+     * - Forwards `get_user_gen_keys_schema_subtree_bitmap`'s return values on failure.
+     * - Forwards `append_node_id_value_pairs_as_json_str`'s return values on failure.
+     */
+    [[nodiscard]] auto append_user_gen_kv_pairs_as_json_str(std::string& json_str) const
+            -> ystdlib::error_handling::Result<void>;
+
 private:
     // Constructor
     KeyValuePairLogEvent(
@@ -0,0 +1,268 @@
+#include "CheckpointIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <ystdlib/error_handling/Result.hpp>
+
+#include "../../time_types.hpp"
+#include "../SchemaTree.hpp"
+
+namespace clp::ffi::ir_stream {
+namespace {
+/*
+ * The serialized index is a msgpack map (which, unlike JSON, can hold key names that aren't valid
+ * UTF-8) containing:
+ * - the version of the format;
+ * - each schema tree as an array of `[parent ID, type, key name]` entries for every non-root node,
+ *   ordered by node ID;
+ * - an array of checkpoints, each as an array of its fields in declaration order.
+ */
+constexpr uint64_t cVersion{1};
+constexpr char cVersionKey[]{"version"};
+constexpr char cAutoGenKeysSchemaTreeKey[]{"auto_gen_keys_schema_tree"};
+constexpr char cUserGenKeysSchemaTreeKey[]{"user_gen_keys_schema_tree"};
+constexpr char cCheckpointsKey[]{"checkpoints"};
+constexpr size_t cNumSchemaTreeNodeFields{3};
+constexpr size_t cNumCheckpointFields{5};
+
+/**
+ * @param schema_tree
+ * @return The schema tree's non-root nodes serialized as an array of `[parent ID, type, key name]`
+ * entries.
+ */
+[[nodiscard]] auto serialize_schema_tree(SchemaTree const& schema_tree) -> nlohmann::json;
+
+/**
+ * Deserializes a schema tree serialized by `serialize_schema_tree`.
+ * @param serialized_schema_tree
+ * @return A result containing the deserialized schema tree on success, or an error code indicating
+ * the failure:
+ * - std::errc::protocol_error if any node is malformed, has a non-object parent, or duplicates
+ *   an existing node.
+ */
+[[nodiscard]] auto deserialize_schema_tree(nlohmann::json const& serialized_schema_tree)
+        -> ystdlib::error_handling::Result<SchemaTree>;
+
+/**
+ * @param json
+ * @return The value of the given JSON number if it's an unsigned integer, or std::nullopt
+ * otherwise.
+ */
+[[nodiscard]] auto get_unsigned_value(nlohmann::json const& json) -> std::optional<size_t>;
+
+auto serialize_schema_tree(SchemaTree const& schema_tree) -> nlohmann::json {
+    auto serialized_schema_tree{nlohmann::json::array()};
+    for (size_t node_id{SchemaTree::cRootId + 1}; node_id < schema_tree.get_size(); ++node_id) {
+        auto const& node{schema_tree.get_node(static_cast<SchemaTree::Node::id_t>(node_id))};
+        serialized_schema_tree.push_back(
+                {node.get_parent_id_unsafe(),
+                 static_cast<uint8_t>(node.get_type()),
+                 std::string{node.get_key_name()}}
+        );
+    }
+    return serialized_schema_tree;
+}
+
+auto deserialize_schema_tree(nlohmann::json const& serialized_schema_tree)
+        -> ystdlib::error_handling::Result<SchemaTree> {
+    if (false == serialized_schema_tree.is_array()) {
+        return std::errc::protocol_error;
+    }
+
+    SchemaTree schema_tree;
+    for (auto const& serialized_node : serialized_schema_tree) {
+        if (false == serialized_node.is_array()
+            || cNumSchemaTreeNodeFields != serialized_node.size())
+        {
+            return std::errc::protocol_error;
+        }
+        auto const optional_parent_id{get_unsigned_value(serialized_node[0])};
+        auto const optional_type{get_unsigned_value(serialized_node[1])};
+        auto const& key_name{serialized_node[2]};
+        if (false == optional_parent_id.has_value() || false == optional_type.has_value()
+            || false == key_name.is_string())
+        {
+            return std::errc::protocol_error;
+        }
+
+        // Validate the node before inserting it since `SchemaTree::insert_node` doesn't check that
+        // the parent exists.
+        auto const parent_id{optional_parent_id.value()};
+        if (parent_id >= schema_tree.get_size()
+            || optional_type.value() > static_cast<size_t>(SchemaTree::Node::Type::Obj))
+        {
+            return std::errc::protocol_error;
+        }
+        auto const& parent_node{
+                schema_tree.get_node(static_cast<SchemaTree::Node::id_t>(parent_id))
+        };
+        if (SchemaTree::Node::Type::Obj != parent_node.get_type()) {
+            return std::errc::protocol_error;
+        }
+        SchemaTree::NodeLocator const locator{
+                parent_node.get_id(),
+                key_name.get_ref<nlohmann::json::string_t const&>(),
+                static_cast<SchemaTree::Node::Type>(optional_type.value())
+        };
+        if (schema_tree.has_node(locator)) {
+            return std::errc::protocol_error;
+        }
+        schema_tree.insert_node(locator);
+    }
+    return schema_tree;
+}
+
+auto get_unsigned_value(nlohmann::json const& json) -> std::optional<size_t> {
+    if (false == json.is_number_unsigned()) {
+        return std::nullopt;
+    }
+    return json.get<size_t>();
+}
+}  // namespace
+
+auto CheckpointIndex::deserialize(std::span<uint8_t const> serialized_index)
+        -> ystdlib::error_handling::Result<CheckpointIndex> {
+    auto const index_json{nlohmann::json::from_msgpack(
+            serialized_index.begin(),
+            serialized_index.end(),
+            true,
+            false
+    )};
+    if (index_json.is_discarded() || false == index_json.is_object()) {
+        return std::errc::protocol_error;
+    }
+
+    try {
+        auto const optional_version{get_unsigned_value(index_json.at(cVersionKey))};
+        if (false == optional_version.has_value()) {
+            return std::errc::protocol_error;
+        }
+        if (cVersion != optional_version.value()) {
+            return std::errc::protocol_not_supported;
+        }
+
+        auto auto_gen_keys_schema_tree{YSTDLIB_ERROR_HANDLING_TRYX(
+                deserialize_schema_tree(index_json.at(cAutoGenKeysSchemaTreeKey))
+        )};
+        auto user_gen_keys_schema_tree{YSTDLIB_ERROR_HANDLING_TRYX(
+                deserialize_schema_tree(index_json.at(cUserGenKeysSchemaTreeKey))
+        )};
+
+        auto const& serialized_checkpoints{index_json.at(cCheckpointsKey)};
+        if (false == serialized_checkpoints.is_array()) {
+            return std::errc::protocol_error;
+        }
+        std::vector<Checkpoint> checkpoints;
+        checkpoints.reserve(serialized_checkpoints.size());
+        for (auto const& serialized_checkpoint : serialized_checkpoints) {
+            if (false == serialized_checkpoint.is_array()
+                || cNumCheckpointFields != serialized_checkpoint.size()
+                || false == serialized_checkpoint[2].is_number_integer())
+            {
+                return std::errc::protocol_error;
+            }
+            auto const optional_log_event_idx{get_unsigned_value(serialized_checkpoint[0])};
+            auto const optional_stream_pos{get_unsigned_value(serialized_checkpoint[1])};
+            auto const optional_auto_gen_keys_schema_tree_size{
+                    get_unsigned_value(serialized_checkpoint[3])
+            };
+            auto const optional_user_gen_keys_schema_tree_size{
+                    get_unsigned_value(serialized_checkpoint[4])
+            };
+            if (false == optional_log_event_idx.has_value()
+                || false == optional_stream_pos.has_value()
+                || false == optional_auto_gen_keys_schema_tree_size.has_value()
+                || false == optional_user_gen_keys_schema_tree_size.has_value())
+            {
+                return std::errc::protocol_error;
+            }
+            Checkpoint const checkpoint{
+                    .log_event_idx = optional_log_event_idx.value(),
+                    .stream_pos = optional_stream_pos.value(),
+                    .utc_offset = UtcOffset{serialized_checkpoint[2].get<int64_t>()},
+                    .auto_gen_keys_schema_tree_size
+                    = optional_auto_gen_keys_schema_tree_size.value(),
+                    .user_gen_keys_schema_tree_size
+                    = optional_user_gen_keys_schema_tree_size.value()
+            };
+
+            // Checkpoints must be ordered, and each must refer to a non-empty prefix of the
+            // schema trees.
+            if (checkpoint.auto_gen_keys_schema_tree_size > auto_gen_keys_schema_tree.get_size()
+                || checkpoint.user_gen_keys_schema_tree_size > user_gen_keys_schema_tree.get_size()
+                || 0 == checkpoint.auto_gen_keys_schema_tree_size
+                || 0 == checkpoint.user_gen_keys_schema_tree_size)
+            {
+                return std::errc::protocol_error;
+            }
+            if (false == checkpoints.empty()) {
+                auto const& prev_checkpoint{checkpoints.back()};
+                if (checkpoint.log_event_idx < prev_checkpoint.log_event_idx
+                    || checkpoint.stream_pos < prev_checkpoint.stream_pos
+                    || checkpoint.auto_gen_keys_schema_tree_size
+                               < prev_checkpoint.auto_gen_keys_schema_tree_size
+                    || checkpoint.user_gen_keys_schema_tree_size
+                               < prev_checkpoint.user_gen_keys_schema_tree_size)
+                {
+                    return std::errc::protocol_error;
+                }
+            }
+            checkpoints.push_back(checkpoint);
+        }
+
+        return CheckpointIndex{
+                std::move(checkpoints),
+                std::move(auto_gen_keys_schema_tree),
+                std::move(user_gen_keys_schema_tree)
+        };
+    } catch (nlohmann::json::exception const&) {
+        return std::errc::protocol_error;
+    }
+}
+
+auto CheckpointIndex::serialize(
+        std::span<Checkpoint const> checkpoints,
+        SchemaTree const& auto_gen_keys_schema_tree,
+        SchemaTree const& user_gen_keys_schema_tree
+) -> std::vector<uint8_t> {
+    auto serialized_checkpoints{nlohmann::json::array()};
+    for (auto const& checkpoint : checkpoints) {
+        serialized_checkpoints.push_back(
+                {checkpoint.log_event_idx,
+                 checkpoint.stream_pos,
+                 checkpoint.utc_offset.count(),
+                 checkpoint.auto_gen_keys_schema_tree_size,
+                 checkpoint.user_gen_keys_schema_tree_size}
+        );
+    }
+
+    nlohmann::json index_json;
+    index_json.emplace(cVersionKey, cVersion);
+    index_json.emplace(cAutoGenKeysSchemaTreeKey, serialize_schema_tree(auto_gen_keys_schema_tree));
+    index_json.emplace(cUserGenKeysSchemaTreeKey, serialize_schema_tree(user_gen_keys_schema_tree));
+    index_json.emplace(cCheckpointsKey, std::move(serialized_checkpoints));
+    return nlohmann::json::to_msgpack(index_json);
+}
+
+auto CheckpointIndex::find_checkpoint(size_t log_event_idx) const -> std::optional<Checkpoint> {
+    auto const it{std::upper_bound(
+            m_checkpoints.cbegin(),
+            m_checkpoints.cend(),
+            log_event_idx,
+            [](size_t idx, Checkpoint const& checkpoint) { return idx < checkpoint.log_event_idx; }
+    )};
+    if (m_checkpoints.cbegin() == it) {
+        return std::nullopt;
+    }
+    return *(it - 1);
+}
+}  // namespace clp::ffi::ir_stream
@@ -0,0 +1,118 @@
+#ifndef CLP_FFI_IR_STREAM_CHECKPOINTINDEX_HPP
+#define CLP_FFI_IR_STREAM_CHECKPOINTINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <ystdlib/error_handling/Result.hpp>
+
+#include "../../time_types.hpp"
+#include "../SchemaTree.hpp"
+
+namespace clp::ffi::ir_stream {
+/**
+ * An index of checkpoints in a kv-pair IR stream, stored separately from the stream as a sidecar.
+ *
+ * A checkpoint captures all the state that's needed to start deserializing the stream from a
+ * position other than its beginning: the index of the next log event, the current UTC offset, and
+ * the schema trees built so far. Since the schema trees only grow by appending nodes, the schema
+ * trees at any checkpoint are prefixes of the stream's final schema trees. So the index stores the
+ * final schema trees once, and each checkpoint refers to its schema trees by their sizes.
+ *
+ * Consecutive checkpoints delimit disjoint ranges of log events, so multiple deserializers created
+ * with `Deserializer::create_from_checkpoint` can deserialize the ranges concurrently.
+ */
+class CheckpointIndex {
+public:
+    // Types
+    struct Checkpoint {
+        [[nodiscard]] auto operator==(Checkpoint const& rhs) const -> bool = default;
+
+        // The index of the first log event after the checkpoint
+        size_t log_event_idx{0};
+        // The position in the stream of the first IR unit after the checkpoint
+        size_t stream_pos{0};
+        UtcOffset utc_offset{0};
+        size_t auto_gen_keys_schema_tree_size{0};
+        size_t user_gen_keys_schema_tree_size{0};
+    };
+
+    // Factory functions
+    /**
+     * Deserializes a checkpoint index serialized by `serialize`.
+     * @param serialized_index
+     * @return A result containing the deserialized checkpoint index on success, or an error code
+     * indicating the failure:
+     * - std::errc::protocol_error if the serialized index is corrupted or inconsistent.
+     * - std::errc::protocol_not_supported if the serialized index's version is unsupported.
+     */
+    [[nodiscard]] static auto deserialize(std::span<uint8_t const> serialized_index)
+            -> ystdlib::error_handling::Result<CheckpointIndex>;
+
+    // Disable copy constructor and assignment operator
+    CheckpointIndex(CheckpointIndex const&) = delete;
+    auto operator=(CheckpointIndex const&) -> CheckpointIndex& = delete;
+
+    // Default move constructor and assignment operator
+    CheckpointIndex(CheckpointIndex&&) = default;
+    auto operator=(CheckpointIndex&&) -> CheckpointIndex& = default;
+
+    // Destructor
+    ~CheckpointIndex() = default;
+
+    // Methods
+    /**
+     * Serializes a checkpoint index into its binary sidecar format.
+     * @param checkpoints
+     * @param auto_gen_keys_schema_tree The stream's schema tree for auto-generated keys.
+     * @param user_gen_keys_schema_tree The stream's schema tree for user-generated keys.
+     * @return The serialized checkpoint index.
+     */
+    [[nodiscard]] static auto serialize(
+            std::span<Checkpoint const> checkpoints,
+            SchemaTree const& auto_gen_keys_schema_tree,
+            SchemaTree const& user_gen_keys_schema_tree
+    ) -> std::vector<uint8_t>;
+
+    [[nodiscard]] auto get_checkpoints() const -> std::vector<Checkpoint> const& {
+        return m_checkpoints;
+    }
+
+    [[nodiscard]] auto get_auto_gen_keys_schema_tree() const -> SchemaTree const& {
+        return m_auto_gen_keys_schema_tree;
+    }
+
+    [[nodiscard]] auto get_user_gen_keys_schema_tree() const -> SchemaTree const& {
+        return m_user_gen_keys_schema_tree;
+    }
+
+    /**
+     * @param log_event_idx
+     * @return The last checkpoint at or before the log event with the given index, or
+     * std::nullopt if there's no such checkpoint.
+     */
+    [[nodiscard]] auto find_checkpoint(size_t log_event_idx) const -> std::optional<Checkpoint>;
+
+private:
+    // Constructor
+    CheckpointIndex(
+            std::vector<Checkpoint> checkpoints,
+            SchemaTree auto_gen_keys_schema_tree,
+            SchemaTree user_gen_keys_schema_tree
+    )
+            : m_checkpoints{std::move(checkpoints)},
+              m_auto_gen_keys_schema_tree{std::move(auto_gen_keys_schema_tree)},
+              m_user_gen_keys_schema_tree{std::move(user_gen_keys_schema_tree)} {}
+
+    // Variables
+    std::vector<Checkpoint> m_checkpoints;
+    SchemaTree m_auto_gen_keys_schema_tree;
+    SchemaTree m_user_gen_keys_schema_tree;
+};
+}  // namespace clp::ffi::ir_stream
+
+#endif  // CLP_FFI_IR_STREAM_CHECKPOINTINDEX_HPP
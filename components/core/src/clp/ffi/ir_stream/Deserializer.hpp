@@ -16,6 +16,7 @@
 #include "../../ReaderInterface.hpp"
 #include "../../time_types.hpp"
 #include "../SchemaTree.hpp"
+#include "CheckpointIndex.hpp"
 #include "ir_unit_deserialization_methods.hpp"
 #include "IrUnitHandlerReq.hpp"
 #include "IrUnitType.hpp"
@@ -83,6 +84,66 @@ public:
         return create_generic(reader, std::move(ir_unit_handler), std::move(query_handler));
     }
 
+    /**
+     * Creates a deserializer with an empty query handler that resumes deserializing the stream from
+     * the given checkpoint, rather than from the stream's first IR unit.
+     * @param reader
+     * @param ir_unit_handler
+     * @param checkpoint_index
+     * @param checkpoint A checkpoint from `checkpoint_index`.
+     * @return A result containing the deserializer on success, or an error code indicating the
+     * failure:
+     * - Forwards `create_generic`'s return values.
+     * - Forwards `restore_checkpoint`'s return values.
+     */
+    [[nodiscard]] static auto create_from_checkpoint(
+            ReaderInterface& reader,
+            IrUnitHandlerType ir_unit_handler,
+            CheckpointIndex const& checkpoint_index,
+            CheckpointIndex::Checkpoint const& checkpoint
+    ) -> ystdlib::error_handling::Result<Deserializer>
+    requires std::is_same_v<QueryHandlerType, search::EmptyQueryHandler>
+    {
+        auto deserializer{
+                YSTDLIB_ERROR_HANDLING_TRYX(create_generic(reader, std::move(ir_unit_handler), {}))
+        };
+        YSTDLIB_ERROR_HANDLING_TRYV(
+                deserializer.restore_checkpoint(reader, checkpoint_index, checkpoint)
+        );
+        return deserializer;
+    }
+
+    /**
+     * Creates a deserializer with a query handler that resumes deserializing the stream from the
+     * given checkpoint, rather than from the stream's first IR unit.
+     * @param reader
+     * @param ir_unit_handler
+     * @param query_handler
+     * @param checkpoint_index
+     * @param checkpoint A checkpoint from `checkpoint_index`.
+     * @return A result containing the deserializer on success, or an error code indicating the
+     * failure:
+     * - Forwards `create_generic`'s return values.
+     * - Forwards `restore_checkpoint`'s return values.
+     */
+    [[nodiscard]] static auto create_from_checkpoint(
+            ReaderInterface& reader,
+            IrUnitHandlerType ir_unit_handler,
+            QueryHandlerType query_handler,
+            CheckpointIndex const& checkpoint_index,
+            CheckpointIndex::Checkpoint const& checkpoint
+    ) -> ystdlib::error_handling::Result<Deserializer>
+    requires search::IsNonEmptyQueryHandler<QueryHandlerType>::value
+    {
+        auto deserializer{YSTDLIB_ERROR_HANDLING_TRYX(
+                create_generic(reader, std::move(ir_unit_handler), std::move(query_handler))
+        )};
+        YSTDLIB_ERROR_HANDLING_TRYV(
+                deserializer.restore_checkpoint(reader, checkpoint_index, checkpoint)
+        );
+        return deserializer;
+    }
+
     // Delete copy constructor and assignment
     Deserializer(Deserializer const&) = delete;
     auto operator=(Deserializer const&) -> Deserializer& = delete;
@@ -101,8 +162,8 @@ public:
      *
      * NOTE: If the deserialized IR unit is `IrUnitType::LogEvent` and the query handler is not
      * `search::EmptyQueryHandler`, `handle_log_event` will only be invoked if the query handler
-
-     * returns `search::AstEvaluationResult::True`.
+     * returns `search::AstEvaluationResult::True`. The query is evaluated against only the values
+     * it references, and the log event is only deserialized entirely if it matches.
      *
      * @param reader
      * @return Forwards `deserialize_tag`s return values if no tag bytes can be read to determine
@@ -114,6 +175,9 @@ public:
      * indicating the failure:
      * - Forwards `deserialize_ir_unit_kv_pair_log_event`'s return values if it failed to
      *   deserialize and construct the log event.
+     * - Forwards `DeferredKvPairLogEvent::read_ir_unit`'s and
+     *   `DeferredKvPairLogEvent::deserialize`'s return values on failure, if `QueryHandlerType` is
+     *   not `search::EmptyQueryHandler`.
      * - Forwards `handle_log_event`'s return values from the user-defined IR unit handler on
      *   unit handling failure.
      * - Forwards `search::QueryHandler::evaluate_kv_pair_log_event`'s return values on failure, if
@@ -161,7 +225,7 @@ public:
 
     /**
      * @return The number of log events (log event IR units) that have been deserialized from the
-     * current stream.
+     * current stream, including any that were skipped by resuming from a checkpoint.
      */
     [[nodiscard]] auto get_num_log_events_deserialized() const -> size_t {
         return m_next_log_event_idx;
@@ -198,6 +262,44 @@ private:
               m_ir_unit_handler{std::move(ir_unit_handler)},
               m_query_handler{std::move(query_handler)} {}
 
+    // Methods
+    /**
+     * Restores the deserializer's state to the given checkpoint and seeks the reader to the
+     * checkpoint's position in the stream. The IR unit handler is notified of every schema tree
+     * node and UTC offset change that's restored, as if they were deserialized from the stream.
+     * @param reader
+     * @param checkpoint_index
+     * @param checkpoint
+     * @return A void result on success, or an error code indicating the failure:
+     * - std::errc::invalid_argument if the checkpoint refers to schema trees larger than the ones
+     *   in the checkpoint index.
+     * - std::errc::result_out_of_range if the reader can't seek to the checkpoint's position.
+     * - Forwards `insert_schema_tree_node`'s return values on failure.
+     * - Forwards `handle_utc_offset_change`'s return values from the user-defined IR unit handler
+     *   on unit handling failure.
+     */
+    [[nodiscard]] auto restore_checkpoint(
+            ReaderInterface& reader,
+            CheckpointIndex const& checkpoint_index,
+            CheckpointIndex::Checkpoint const& checkpoint
+    ) -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Inserts a schema tree node into the corresponding schema tree, and notifies the query handler
+     * and the user-defined IR unit handler of the insertion.
+     * @param is_auto_generated
+     * @param node_locator
+     * @return A void result on success, or an error code indicating the failure:
+     * - std::errc::protocol_error if the node already exists in the schema tree.
+     * - Forwards `search::QueryHandler::update_partially_resolved_columns`'s return values on
+     *   failure, if `QueryHandlerType` is not `search::EmptyQueryHandler`.
+     * - Forwards `handle_schema_tree_node_insertion`'s return values from the user-defined IR unit
+     *   handler on unit handling failure.
+     */
+    [[nodiscard]] auto
+    insert_schema_tree_node(bool is_auto_generated, SchemaTree::NodeLocator const& node_locator)
+            -> ystdlib::error_handling::Result<void>;
+
     // Variables
     std::shared_ptr<SchemaTree> m_auto_gen_keys_schema_tree{std::make_shared<SchemaTree>()};
     std::shared_ptr<SchemaTree> m_user_gen_keys_schema_tree{std::make_shared<SchemaTree>()};
@@ -207,6 +309,8 @@ private:
     bool m_is_complete{false};
     [[no_unique_address]] QueryHandlerType m_query_handler;
     size_t m_next_log_event_idx{0};
+    // Only used to evaluate queries against log events before deserializing them entirely
+    DeferredKvPairLogEvent m_deferred_log_event;
 };
 
 /**
@@ -307,6 +411,49 @@ auto Deserializer<IrUnitHandler, QueryHandlerType>::deserialize_next_ir_unit(
     auto const ir_unit_type{optional_ir_unit_type.value()};
     switch (ir_unit_type) {
         case IrUnitType::LogEvent: {
+            if constexpr (search::IsNonEmptyQueryHandler<QueryHandlerType>::value) {
+                YSTDLIB_ERROR_HANDLING_TRYV(m_deferred_log_event.read_ir_unit(reader, tag));
+                auto const log_event_idx{m_next_log_event_idx};
+                m_next_log_event_idx += 1;
+
+                // Evaluate the query against only the values it references, so that the remaining
+                // values only need to be deserialized for log events that match.
+                auto const referenced_log_event{
+                        YSTDLIB_ERROR_HANDLING_TRYX(m_deferred_log_event.deserialize(
+                                m_auto_gen_keys_schema_tree,
+                                m_user_gen_keys_schema_tree,
+                                m_utc_offset,
+                                [&](bool is_auto_generated, SchemaTree::Node::id_t node_id) {
+                                    return m_query_handler.is_value_referenced(
+                                            is_auto_generated,
+                                            node_id
+                                    );
+                                }
+                        ))
+                };
+                if (search::AstEvaluationResult::True
+                    != YSTDLIB_ERROR_HANDLING_TRYX(
+                            m_query_handler.evaluate_kv_pair_log_event(referenced_log_event)
+                    ))
+                {
+                    break;
+                }
+
+                auto log_event{YSTDLIB_ERROR_HANDLING_TRYX(m_deferred_log_event.deserialize(
+                        m_auto_gen_keys_schema_tree,
+                        m_user_gen_keys_schema_tree,
+                        m_utc_offset
+                ))};
+                if (auto const err{
+                            m_ir_unit_handler.handle_log_event(std::move(log_event), log_event_idx)
+                    };
+                    IRErrorCode::IRErrorCode_Success != err)
+                {
+                    return ir_error_code_to_errc(err);
+                }
+                break;
+            }
+
             auto log_event{YSTDLIB_ERROR_HANDLING_TRYX(deserialize_ir_unit_kv_pair_log_event(
                     reader,
                     tag,
@@ -318,16 +465,6 @@ auto Deserializer<IrUnitHandler, QueryHandlerType>::deserialize_next_ir_unit(
             auto const log_event_idx{m_next_log_event_idx};
             m_next_log_event_idx += 1;
 
-            if constexpr (search::IsNonEmptyQueryHandler<QueryHandlerType>::value) {
-                if (search::AstEvaluationResult::True
-                    != YSTDLIB_ERROR_HANDLING_TRYX(
-                            m_query_handler.evaluate_kv_pair_log_event(log_event)
-                    ))
-                {
-                    break;
-                }
-            }
-
             if (auto const err{
                         m_ir_unit_handler.handle_log_event(std::move(log_event), log_event_idx)
                 };
@@ -343,33 +480,7 @@ auto Deserializer<IrUnitHandler, QueryHandlerType>::deserialize_next_ir_unit(
             auto const [is_auto_generated, node_locator]{YSTDLIB_ERROR_HANDLING_TRYX(
                     deserialize_ir_unit_schema_tree_node_insertion(reader, tag, key_name)
             )};
-            auto& schema_tree_to_insert{
-                    is_auto_generated ? m_auto_gen_keys_schema_tree : m_user_gen_keys_schema_tree
-            };
-
-            if (schema_tree_to_insert->has_node(node_locator)) {
-                return std::errc::protocol_error;
-            }
-
-            auto const node_id{schema_tree_to_insert->insert_node(node_locator)};
-
-            if constexpr (search::IsNonEmptyQueryHandler<QueryHandlerType>::value) {
-                YSTDLIB_ERROR_HANDLING_TRYV(m_query_handler.update_partially_resolved_columns(
-                        is_auto_generated,
-                        node_locator,
-                        node_id
-                ));
-            }
-
-            if (auto const err{m_ir_unit_handler.handle_schema_tree_node_insertion(
-                        is_auto_generated,
-                        node_locator,
-                        schema_tree_to_insert
-                )};
-                IRErrorCode::IRErrorCode_Success != err)
-            {
-                return ir_error_code_to_errc(err);
-            }
+            YSTDLIB_ERROR_HANDLING_TRYV(insert_schema_tree_node(is_auto_generated, node_locator));
             break;
         }
 
@@ -406,6 +517,99 @@ auto Deserializer<IrUnitHandler, QueryHandlerType>::deserialize_next_ir_unit(
     return ir_unit_type;
 }
 
+template <IrUnitHandlerReq IrUnitHandlerType, search::QueryHandlerReq QueryHandlerType>
+auto Deserializer<IrUnitHandlerType, QueryHandlerType>::restore_checkpoint(
+        ReaderInterface& reader,
+        CheckpointIndex const& checkpoint_index,
+        CheckpointIndex::Checkpoint const& checkpoint
+) -> ystdlib::error_handling::Result<void> {
+    auto const& auto_gen_keys_schema_tree{checkpoint_index.get_auto_gen_keys_schema_tree()};
+    auto const& user_gen_keys_schema_tree{checkpoint_index.get_user_gen_keys_schema_tree()};
+    if (checkpoint.auto_gen_keys_schema_tree_size > auto_gen_keys_schema_tree.get_size()
+        || checkpoint.user_gen_keys_schema_tree_size > user_gen_keys_schema_tree.get_size())
+    {
+        return std::errc::invalid_argument;
+    }
+
+    // Replay the schema tree nodes in ID order so that each node gets the same ID it has in the
+    // stream.
+    auto const replay_schema_tree_nodes
+            = [&](bool is_auto_generated,
+                  SchemaTree const& schema_tree,
+                  size_t schema_tree_size) -> ystdlib::error_handling::Result<void> {
+        for (size_t node_id{SchemaTree::cRootId + 1}; node_id < schema_tree_size; ++node_id) {
+            auto const& node{schema_tree.get_node(static_cast<SchemaTree::Node::id_t>(node_id))};
+            YSTDLIB_ERROR_HANDLING_TRYV(insert_schema_tree_node(
+                    is_auto_generated,
+                    {node.get_parent_id_unsafe(), node.get_key_name(), node.get_type()}
+            ));
+        }
+        return ystdlib::error_handling::success();
+    };
+    YSTDLIB_ERROR_HANDLING_TRYV(replay_schema_tree_nodes(
+            true,
+            auto_gen_keys_schema_tree,
+            checkpoint.auto_gen_keys_schema_tree_size
+    ));
+    YSTDLIB_ERROR_HANDLING_TRYV(replay_schema_tree_nodes(
+            false,
+            user_gen_keys_schema_tree,
+            checkpoint.user_gen_keys_schema_tree_size
+    ));
+
+    if (checkpoint.utc_offset != m_utc_offset) {
+        if (auto const err{
+                    m_ir_unit_handler.handle_utc_offset_change(m_utc_offset, checkpoint.utc_offset)
+            };
+            IRErrorCode::IRErrorCode_Success != err)
+        {
+            return ir_error_code_to_errc(err);
+        }
+        m_utc_offset = checkpoint.utc_offset;
+    }
+
+    if (ErrorCode_Success != reader.try_seek_from_begin(checkpoint.stream_pos)) {
+        return std::errc::result_out_of_range;
+    }
+    m_next_log_event_idx = checkpoint.log_event_idx;
+    return ystdlib::error_handling::success();
+}
+
+template <IrUnitHandlerReq IrUnitHandlerType, search::QueryHandlerReq QueryHandlerType>
+auto Deserializer<IrUnitHandlerType, QueryHandlerType>::insert_schema_tree_node(
+        bool is_auto_generated,
+        SchemaTree::NodeLocator const& node_locator
+) -> ystdlib::error_handling::Result<void> {
+    auto& schema_tree_to_insert{
+            is_auto_generated ? m_auto_gen_keys_schema_tree : m_user_gen_keys_schema_tree
+    };
+
+    if (schema_tree_to_insert->has_node(node_locator)) {
+        return std::errc::protocol_error;
+    }
+
+    auto const node_id{schema_tree_to_insert->insert_node(node_locator)};
+
+    if constexpr (search::IsNonEmptyQueryHandler<QueryHandlerType>::value) {
+        YSTDLIB_ERROR_HANDLING_TRYV(m_query_handler.update_partially_resolved_columns(
+                is_auto_generated,
+                node_locator,
+                node_id
+        ));
+    }
+
+    if (auto const err{m_ir_unit_handler.handle_schema_tree_node_insertion(
+                is_auto_generated,
+                node_locator,
+                schema_tree_to_insert
+        )};
+        IRErrorCode::IRErrorCode_Success != err)
+    {
+        return ir_error_code_to_errc(err);
+    }
+    return ystdlib::error_handling::success();
+}
+
 template <IrUnitHandlerReq IrUnitHandlerType>
 [[nodiscard]] auto make_deserializer(ReaderInterface& reader, IrUnitHandlerType ir_unit_handler)
         -> ystdlib::error_handling::Result<Deserializer<IrUnitHandlerType>> {
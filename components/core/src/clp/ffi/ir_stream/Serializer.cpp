@@ -1,6 +1,7 @@
 #include "Serializer.hpp"
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <span>
@@ -575,6 +576,8 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
         msgpack::object_map const& auto_gen_kv_pairs_map,
         msgpack::object_map const& user_gen_kv_pairs_map
 ) -> bool {
+    auto const auto_gen_keys_schema_tree_size{m_auto_gen_keys_schema_tree.get_size()};
+    auto const user_gen_keys_schema_tree_size{m_user_gen_keys_schema_tree.get_size()};
     m_auto_gen_keys_schema_tree.take_snapshot();
     m_user_gen_keys_schema_tree.take_snapshot();
     TransactionManager revert_manager{
@@ -714,6 +717,20 @@ auto Serializer<encoded_variable_t>::serialize_msgpack_map(
         }
     }
 
+    // Record a checkpoint before the log event's IR units (including any schema tree node
+    // insertions) so that a deserializer can resume from it using the schema trees as they were
+    // before this log event.
+    if (0 != m_checkpoint_interval && 0 == m_num_log_events % m_checkpoint_interval) {
+        m_checkpoints.push_back(
+                {.log_event_idx = m_num_log_events,
+                 .stream_pos = m_num_ir_bytes_cleared + m_ir_buf.size(),
+                 .utc_offset = m_curr_utc_offset,
+                 .auto_gen_keys_schema_tree_size = auto_gen_keys_schema_tree_size,
+                 .user_gen_keys_schema_tree_size = user_gen_keys_schema_tree_size}
+        );
+    }
+    ++m_num_log_events;
+
     // Copy serialized results into `m_ir_buf`
     m_ir_buf.insert(
             m_ir_buf.cend(),
@@ -1,6 +1,7 @@
 #ifndef CLP_FFI_IR_STREAM_SERIALIZER_HPP
 #define CLP_FFI_IR_STREAM_SERIALIZER_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <span>
@@ -13,6 +14,7 @@
 
 #include "../../time_types.hpp"
 #include "../SchemaTree.hpp"
+#include "CheckpointIndex.hpp"
 
 namespace clp::ffi::ir_stream {
 /**
@@ -73,7 +75,10 @@ public:
     /**
      * Clears the underlying IR buffer.
      */
-    auto clear_ir_buf() -> void { m_ir_buf.clear(); }
+    auto clear_ir_buf() -> void {
+        m_num_ir_bytes_cleared += m_ir_buf.size();
+        m_ir_buf.clear();
+    }
 
     /**
      * @return The current UTC offset.
@@ -98,6 +103,32 @@ public:
             msgpack::object_map const& user_gen_kv_pairs_map
     ) -> bool;
 
+    /**
+     * Sets the number of log events between consecutive checkpoints. Once set, a checkpoint is
+     * recorded before every log event whose index is a multiple of the interval.
+     * @param checkpoint_interval The number of log events between checkpoints, or 0 to disable
+     * recording checkpoints.
+     */
+    auto set_checkpoint_interval(size_t checkpoint_interval) -> void {
+        m_checkpoint_interval = checkpoint_interval;
+    }
+
+    /**
+     * Serializes the checkpoints recorded so far, along with the schema trees they refer to, into
+     * a checkpoint index that can be stored alongside the IR stream.
+     *
+     * NOTE: Checkpoint positions are relative to the start of the (uncompressed) IR stream,
+     * assuming all the bytes in the IR buffer are written to the stream before it's cleared.
+     * @return The serialized checkpoint index.
+     */
+    [[nodiscard]] auto serialize_checkpoint_index() const -> std::vector<uint8_t> {
+        return CheckpointIndex::serialize(
+                m_checkpoints,
+                m_auto_gen_keys_schema_tree,
+                m_user_gen_keys_schema_tree
+        );
+    }
+
 private:
     // Constructors
     Serializer() = default;
@@ -121,6 +152,11 @@ private:
     Buffer m_schema_tree_node_buf;
     Buffer m_sequential_serialization_buf;
     Buffer m_user_gen_val_group_buf;
+
+    size_t m_num_log_events{0};
+    size_t m_num_ir_bytes_cleared{0};
+    size_t m_checkpoint_interval{0};
+    std::vector<CheckpointIndex::Checkpoint> m_checkpoints;
 };
 }  // namespace clp::ffi::ir_stream
 
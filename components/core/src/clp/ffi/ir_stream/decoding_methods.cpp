@@ -24,6 +24,45 @@ using std::vector;
 
 namespace clp::ffi::ir_stream {
 namespace {
+/**
+ * Deserializes the length of a logtype from the given reader.
+ * @param reader
+ * @param encoded_tag
+ * @param logtype_length Returns the length of the logtype.
+ * @return IRErrorCode_Success on success.
+ * @return IRErrorCode_Corrupted_IR if the encoded tag is invalid.
+ * @return IRErrorCode_Incomplete_IR if the reader doesn't contain enough data to deserialize.
+ */
+[[nodiscard]] auto deserialize_logtype_length(
+        ReaderInterface& reader,
+        encoded_tag_t encoded_tag,
+        size_t& logtype_length
+) -> IRErrorCode;
+
+/**
+ * Deserializes the length of a dictionary variable from the given reader.
+ * @param reader
+ * @param encoded_tag
+ * @param dict_var_length Returns the length of the dictionary variable.
+ * @return IRErrorCode_Success on success.
+ * @return IRErrorCode_Corrupted_IR if the encoded tag is invalid.
+ * @return IRErrorCode_Incomplete_IR if the reader doesn't contain enough data to deserialize.
+ */
+[[nodiscard]] auto deserialize_dict_var_length(
+        ReaderInterface& reader,
+        encoded_tag_t encoded_tag,
+        size_t& dict_var_length
+) -> IRErrorCode;
+
+/**
+ * Advances the given reader past the given number of bytes.
+ * @param reader
+ * @param num_bytes
+ * @return IRErrorCode_Success on success.
+ * @return IRErrorCode_Incomplete_IR if the reader doesn't contain enough data to skip.
+ */
+[[nodiscard]] auto skip_bytes(ReaderInterface& reader, size_t num_bytes) -> IRErrorCode;
+
 /**
  * Deserializes a logtype from the given reader and appends it to the given string blob.
  * @param reader
@@ -54,12 +93,11 @@ namespace {
         StringBlob& string_blob
 ) -> IRErrorCode;
 
-auto deserialize_and_append_logtype(
+auto deserialize_logtype_length(
         ReaderInterface& reader,
         encoded_tag_t encoded_tag,
-        StringBlob& string_blob
+        size_t& logtype_length
 ) -> IRErrorCode {
-    size_t logtype_length{};
     switch (encoded_tag) {
         case cProtocol::Payload::LogtypeStrLenUByte: {
             uint8_t length{};
@@ -89,20 +127,14 @@ auto deserialize_and_append_logtype(
         default:
             return IRErrorCode_Corrupted_IR;
     }
-
-    auto const optional_error_code{string_blob.read_from(reader, logtype_length)};
-    if (optional_error_code.has_value()) {
-        return IRErrorCode_Incomplete_IR;
-    }
     return IRErrorCode_Success;
 }
 
-auto deserialize_and_append_dict_var(
+auto deserialize_dict_var_length(
         ReaderInterface& reader,
         encoded_tag_t encoded_tag,
-        StringBlob& string_blob
+        size_t& dict_var_length
 ) -> IRErrorCode {
-    size_t dict_var_length{};
     switch (encoded_tag) {
         case cProtocol::Payload::VarStrLenUByte: {
             uint8_t length{};
@@ -132,6 +164,49 @@ auto deserialize_and_append_dict_var(
         default:
             return IRErrorCode_Corrupted_IR;
     }
+    return IRErrorCode_Success;
+}
+
+auto skip_bytes(ReaderInterface& reader, size_t num_bytes) -> IRErrorCode {
+    size_t pos{};
+    if (ErrorCode_Success != reader.try_get_pos(pos)
+        || ErrorCode_Success != reader.try_seek_from_begin(pos + num_bytes))
+    {
+        return IRErrorCode_Incomplete_IR;
+    }
+    return IRErrorCode_Success;
+}
+
+auto deserialize_and_append_logtype(
+        ReaderInterface& reader,
+        encoded_tag_t encoded_tag,
+        StringBlob& string_blob
+) -> IRErrorCode {
+    size_t logtype_length{};
+    if (auto const error_code{deserialize_logtype_length(reader, encoded_tag, logtype_length)};
+        IRErrorCode_Success != error_code)
+    {
+        return error_code;
+    }
+
+    auto const optional_error_code{string_blob.read_from(reader, logtype_length)};
+    if (optional_error_code.has_value()) {
+        return IRErrorCode_Incomplete_IR;
+    }
+    return IRErrorCode_Success;
+}
+
+auto deserialize_and_append_dict_var(
+        ReaderInterface& reader,
+        encoded_tag_t encoded_tag,
+        StringBlob& string_blob
+) -> IRErrorCode {
+    size_t dict_var_length{};
+    if (auto const error_code{deserialize_dict_var_length(reader, encoded_tag, dict_var_length)};
+        IRErrorCode_Success != error_code)
+    {
+        return error_code;
+    }
 
     auto const optional_error_code{string_blob.read_from(reader, dict_var_length)};
     if (optional_error_code.has_value()) {
@@ -567,6 +642,37 @@ template <ir::EncodedVariableTypeReq encoded_variable_t>
     return std::move(encoded_text_ast_result.value());
 }
 
+template <ir::EncodedVariableTypeReq encoded_variable_t>
+auto skip_encoded_text_ast(ReaderInterface& reader, encoded_tag_t encoded_tag) -> IRErrorCode {
+    bool is_encoded_var{};
+    while (is_variable_tag<encoded_variable_t>(encoded_tag, is_encoded_var)) {
+        size_t var_length{sizeof(encoded_variable_t)};
+        if (false == is_encoded_var) {
+            if (auto const error_code{deserialize_dict_var_length(reader, encoded_tag, var_length)};
+                IRErrorCode_Success != error_code)
+            {
+                return error_code;
+            }
+        }
+        if (auto const error_code{skip_bytes(reader, var_length)};
+            IRErrorCode_Success != error_code)
+        {
+            return error_code;
+        }
+        if (ErrorCode_Success != reader.try_read_numeric_value(encoded_tag)) {
+            return IRErrorCode_Incomplete_IR;
+        }
+    }
+
+    size_t logtype_length{};
+    if (auto const error_code{deserialize_logtype_length(reader, encoded_tag, logtype_length)};
+        IRErrorCode_Success != error_code)
+    {
+        return error_code;
+    }
+    return skip_bytes(reader, logtype_length);
+}
+
 IRErrorCode get_encoding_type(ReaderInterface& reader, bool& is_four_bytes_encoding) {
     char buffer[cProtocol::MagicNumberLength];
     auto error_code = reader.try_read_exact_length(buffer, cProtocol::MagicNumberLength);
@@ -758,4 +864,14 @@ template auto deserialize_encoded_text_ast<eight_byte_encoded_variable_t>(
         ReaderInterface& reader,
         encoded_tag_t encoded_tag
 ) -> boost::outcome_v2::std_checked<EncodedTextAst<eight_byte_encoded_variable_t>, IRErrorCode>;
+
+template auto skip_encoded_text_ast<four_byte_encoded_variable_t>(
+        ReaderInterface& reader,
+        encoded_tag_t encoded_tag
+) -> IRErrorCode;
+
+template auto skip_encoded_text_ast<eight_byte_encoded_variable_t>(
+        ReaderInterface& reader,
+        encoded_tag_t encoded_tag
+) -> IRErrorCode;
 }  // namespace clp::ffi::ir_stream
@@ -130,6 +130,21 @@ template <ir::EncodedVariableTypeReq encoded_variable_t>
 [[nodiscard]] auto deserialize_encoded_text_ast(ReaderInterface& reader, encoded_tag_t encoded_tag)
         -> boost::outcome_v2::std_checked<EncodedTextAst<encoded_variable_t>, IRErrorCode>;
 
+/**
+ * Advances the given reader past an encoded text AST without deserializing it.
+ *
+ * NOTE: The variables and logtype are skipped by seeking forward in the reader.
+ * @tparam encoded_variable_t
+ * @param reader
+ * @param encoded_tag
+ * @return IRErrorCode_Success on success
+ * @return IRErrorCode_Corrupted_IR if `reader` contains invalid IR
+ * @return IRErrorCode_Incomplete_IR if `reader` doesn't contain enough data
+ */
+template <ir::EncodedVariableTypeReq encoded_variable_t>
+[[nodiscard]] auto skip_encoded_text_ast(ReaderInterface& reader, encoded_tag_t encoded_tag)
+        -> IRErrorCode;
+
 /**
  * Decodes the IR message calls the given methods to handle each component of the message
  * @tparam unescape_logtype Whether to remove the escape characters from the logtype before calling
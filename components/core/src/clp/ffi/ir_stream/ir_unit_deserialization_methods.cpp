@@ -12,6 +12,7 @@
 
 #include <ystdlib/error_handling/Result.hpp>
 
+#include "../../BufferReader.hpp"
 #include "../../ErrorCode.hpp"
 #include "../../ir/types.hpp"
 #include "../../ReaderInterface.hpp"
@@ -172,6 +173,88 @@ template <ir::EncodedVariableTypeReq encoded_variable_t>
         KeyValuePairLogEvent::NodeIdValuePairs& node_id_value_pairs
 ) -> IRErrorCode;
 
+/**
+ * Reader that forwards reads to an underlying reader and appends every byte read to a buffer.
+ * Seeking forward reads (and records) the bytes in between, while seeking backward is unsupported.
+ */
+class RecordingReader : public ReaderInterface {
+public:
+    // Constructor
+    RecordingReader(ReaderInterface& reader, std::vector<char>& buf)
+            : m_reader{reader},
+              m_buf{buf} {}
+
+    // Methods implementing `ReaderInterface`
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> ErrorCode override {
+        auto const error_code{m_reader.try_read(buf, num_bytes_to_read, num_bytes_read)};
+        // Readers don't set `num_bytes_read` on failure
+        if (ErrorCode_Success != error_code) {
+            return error_code;
+        }
+        m_buf.insert(m_buf.end(), buf, buf + num_bytes_read);
+        m_pos += num_bytes_read;
+        return ErrorCode_Success;
+    }
+
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> ErrorCode override {
+        if (pos < m_pos) {
+            return ErrorCode_Unsupported;
+        }
+        return try_skip(pos - m_pos);
+    }
+
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> ErrorCode override {
+        pos = m_pos;
+        return ErrorCode_Success;
+    }
+
+    // Methods
+    /**
+     * Reads the given number of bytes directly into the buffer.
+     * @param num_bytes
+     * @return ErrorCode_Success on success.
+     * @return ErrorCode_Truncated if the underlying reader doesn't contain enough data.
+     * @return Forwards the underlying reader's `try_read`'s return values on any other failure.
+     */
+    [[nodiscard]] auto try_skip(size_t num_bytes) -> ErrorCode {
+        auto const buf_size{m_buf.size()};
+        m_buf.resize(buf_size + num_bytes);
+        size_t num_bytes_read{0};
+        auto const error_code{
+                m_reader.try_read(m_buf.data() + buf_size, num_bytes, num_bytes_read)
+        };
+        if (ErrorCode_Success != error_code) {
+            m_buf.resize(buf_size);
+            return error_code;
+        }
+        m_buf.resize(buf_size + num_bytes_read);
+        m_pos += num_bytes_read;
+        if (num_bytes_read < num_bytes) {
+            return ErrorCode_Truncated;
+        }
+        return ErrorCode_Success;
+    }
+
+private:
+    ReaderInterface& m_reader;
+    std::vector<char>& m_buf;
+    size_t m_pos{0};
+};
+
+/**
+ * Reads past the next value, so that its serialized bytes get recorded by the given reader.
+ * @param reader
+ * @param tag
+ * @return IRErrorCode::IRErrorCode_Success on success.
+ * @return IRErrorCode::IRErrorCode_Incomplete_IR if the stream is truncated.
+ * @return IRErrorCode::IRErrorCode_Corrupted_IR if the tag doesn't correspond to any known value
+ * type.
+ * @return Forwards `deserialize_tag`'s return values on failure.
+ * @return Forwards `skip_encoded_text_ast`'s return values on failure.
+ */
+[[nodiscard]] auto record_value(RecordingReader& reader, encoded_tag_t tag) -> IRErrorCode;
+
 /**
  * @param tag
  * @return Whether the given tag can be a valid leading tag of a log event IR unit.
@@ -506,6 +589,81 @@ auto deserialize_value_and_construct_node_id_value_pairs(
     return IRErrorCode::IRErrorCode_Success;
 }
 
+auto record_value(RecordingReader& reader, encoded_tag_t tag) -> IRErrorCode {
+    size_t num_bytes_to_skip{0};
+    switch (tag) {
+        case cProtocol::Payload::ValueInt8:
+            num_bytes_to_skip = sizeof(int8_t);
+            break;
+        case cProtocol::Payload::ValueInt16:
+            num_bytes_to_skip = sizeof(int16_t);
+            break;
+        case cProtocol::Payload::ValueInt32:
+            num_bytes_to_skip = sizeof(int32_t);
+            break;
+        case cProtocol::Payload::ValueInt64:
+            num_bytes_to_skip = sizeof(int64_t);
+            break;
+        case cProtocol::Payload::ValueFloat:
+            num_bytes_to_skip = sizeof(uint64_t);
+            break;
+        case cProtocol::Payload::ValueTrue:
+        case cProtocol::Payload::ValueFalse:
+        case cProtocol::Payload::ValueNull:
+        case cProtocol::Payload::ValueEmpty:
+            break;
+        case cProtocol::Payload::StrLenUByte: {
+            uint8_t length{};
+            if (false == deserialize_int(reader, length)) {
+                return IRErrorCode::IRErrorCode_Incomplete_IR;
+            }
+            num_bytes_to_skip = length;
+            break;
+        }
+        case cProtocol::Payload::StrLenUShort: {
+            uint16_t length{};
+            if (false == deserialize_int(reader, length)) {
+                return IRErrorCode::IRErrorCode_Incomplete_IR;
+            }
+            num_bytes_to_skip = length;
+            break;
+        }
+        case cProtocol::Payload::StrLenUInt: {
+            uint32_t length{};
+            if (false == deserialize_int(reader, length)) {
+                return IRErrorCode::IRErrorCode_Incomplete_IR;
+            }
+            num_bytes_to_skip = length;
+            break;
+        }
+        case cProtocol::Payload::ValueEightByteEncodingClpStr:
+        case cProtocol::Payload::ValueFourByteEncodingClpStr: {
+            encoded_tag_t encoded_text_ast_tag{};
+            if (auto const err{deserialize_tag(reader, encoded_text_ast_tag)};
+                IRErrorCode::IRErrorCode_Success != err)
+            {
+                return err;
+            }
+            if (cProtocol::Payload::ValueEightByteEncodingClpStr == tag) {
+                return skip_encoded_text_ast<ir::eight_byte_encoded_variable_t>(
+                        reader,
+                        encoded_text_ast_tag
+                );
+            }
+            return skip_encoded_text_ast<ir::four_byte_encoded_variable_t>(
+                    reader,
+                    encoded_text_ast_tag
+            );
+        }
+        default:
+            return IRErrorCode::IRErrorCode_Corrupted_IR;
+    }
+    if (ErrorCode_Success != reader.try_skip(num_bytes_to_skip)) {
+        return IRErrorCode::IRErrorCode_Incomplete_IR;
+    }
+    return IRErrorCode::IRErrorCode_Success;
+}
+
 auto is_log_event_ir_unit_tag(encoded_tag_t tag) -> bool {
     if (cProtocol::Payload::ValueEmpty == tag) {
         // The log event is an empty object
@@ -531,6 +689,136 @@ auto is_encoded_key_id_tag(encoded_tag_t tag) -> bool {
 }
 }  // namespace
 
+auto DeferredKvPairLogEvent::read_ir_unit(ReaderInterface& reader, encoded_tag_t tag)
+        -> ystdlib::error_handling::Result<void> {
+    m_serialized_values.clear();
+    m_value_locations.clear();
+    RecordingReader recording_reader{reader, m_serialized_values};
+
+    // Record pairs of auto-generated node IDs and values, followed by user-generated node IDs. Node
+    // IDs are read from the underlying reader since only the values need to be recorded.
+    bool is_user_gen_schema{false};
+    size_t first_user_gen_idx{0};
+    while (is_encoded_key_id_tag(tag)) {
+        auto const schema_tree_node_id_result{deserialize_and_decode_schema_tree_node_id<
+                cProtocol::Payload::EncodedSchemaTreeNodeIdByte,
+                cProtocol::Payload::EncodedSchemaTreeNodeIdShort,
+                cProtocol::Payload::EncodedSchemaTreeNodeIdInt
+        >(tag, reader)};
+        if (schema_tree_node_id_result.has_error()) {
+            return schema_tree_node_id_result.error();
+        }
+        if (auto const err{deserialize_tag(reader, tag)}; IRErrorCode::IRErrorCode_Success != err) {
+            return ir_error_code_to_errc(err);
+        }
+
+        auto const [is_auto_generated, node_id]{schema_tree_node_id_result.value()};
+        if (is_auto_generated && is_user_gen_schema) {
+            return std::errc::protocol_error;
+        }
+        auto& location{m_value_locations.emplace_back()};
+        location.is_auto_generated = is_auto_generated;
+        location.node_id = node_id;
+        if (false == is_auto_generated) {
+            if (false == is_user_gen_schema) {
+                is_user_gen_schema = true;
+                first_user_gen_idx = m_value_locations.size() - 1;
+            }
+            continue;
+        }
+
+        location.tag = tag;
+        location.begin_pos = m_serialized_values.size();
+        if (auto const err{record_value(recording_reader, tag)};
+            IRErrorCode::IRErrorCode_Success != err)
+        {
+            return ir_error_code_to_errc(err);
+        }
+        location.end_pos = m_serialized_values.size();
+
+        if (auto const err{deserialize_tag(reader, tag)}; IRErrorCode::IRErrorCode_Success != err) {
+            return ir_error_code_to_errc(err);
+        }
+    }
+
+    if (false == is_user_gen_schema) {
+        if (cProtocol::Payload::ValueEmpty != tag) {
+            return ir_error_code_to_errc(IRErrorCode::IRErrorCode_Corrupted_IR);
+        }
+        return ystdlib::error_handling::success();
+    }
+
+    // Record the user-generated values, which follow the schema in the same order
+    for (auto idx{first_user_gen_idx}; idx < m_value_locations.size(); ++idx) {
+        if (first_user_gen_idx != idx) {
+            if (auto const err{deserialize_tag(reader, tag)};
+                IRErrorCode::IRErrorCode_Success != err)
+            {
+                return ir_error_code_to_errc(err);
+            }
+        }
+
+        auto& location{m_value_locations[idx]};
+        location.tag = tag;
+        location.begin_pos = m_serialized_values.size();
+        if (auto const err{record_value(recording_reader, tag)};
+            IRErrorCode::IRErrorCode_Success != err)
+        {
+            return ir_error_code_to_errc(err);
+        }
+        location.end_pos = m_serialized_values.size();
+    }
+    return ystdlib::error_handling::success();
+}
+
+auto DeferredKvPairLogEvent::deserialize(
+        std::shared_ptr<SchemaTree const> auto_gen_keys_schema_tree,
+        std::shared_ptr<SchemaTree const> user_gen_keys_schema_tree,
+        UtcOffset utc_offset,
+        ValueFilter const& filter
+) const -> ystdlib::error_handling::Result<KeyValuePairLogEvent> {
+    KeyValuePairLogEvent::NodeIdValuePairs auto_gen_node_id_value_pairs;
+    KeyValuePairLogEvent::NodeIdValuePairs user_gen_node_id_value_pairs;
+    for (auto const& location : m_value_locations) {
+        if (false == filter(location.is_auto_generated, location.node_id)) {
+            continue;
+        }
+
+        auto& node_id_value_pairs{
+                location.is_auto_generated ? auto_gen_node_id_value_pairs
+                                           : user_gen_node_id_value_pairs
+        };
+        if (false == location.is_auto_generated && node_id_value_pairs.contains(location.node_id))
+        {
+            // The key should be unique in a schema
+            return ir_error_code_to_errc(IRErrorCode::IRErrorCode_Corrupted_IR);
+        }
+
+        BufferReader value_reader{
+                m_serialized_values.data() + location.begin_pos,
+                location.end_pos - location.begin_pos
+        };
+        if (auto const err{deserialize_value_and_insert_to_node_id_value_pairs(
+                    value_reader,
+                    location.tag,
+                    location.node_id,
+                    node_id_value_pairs
+            )};
+            IRErrorCode::IRErrorCode_Success != err)
+        {
+            return ir_error_code_to_errc(err);
+        }
+    }
+
+    return KeyValuePairLogEvent::create(
+            std::move(auto_gen_keys_schema_tree),
+            std::move(user_gen_keys_schema_tree),
+            std::move(auto_gen_node_id_value_pairs),
+            std::move(user_gen_node_id_value_pairs),
+            utc_offset
+    );
+}
+
 auto get_ir_unit_type_from_tag(encoded_tag_t tag) -> std::optional<IrUnitType> {
     // First, we check the tags that have one-to-one IR unit mapping
     if (cProtocol::Eof == tag) {
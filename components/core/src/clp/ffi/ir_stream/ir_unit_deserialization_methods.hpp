@@ -1,10 +1,13 @@
 #ifndef CLP_FFI_IR_STREAM_IR_UNIT_DESERIALIZATION_METHODS_HPP
 #define CLP_FFI_IR_STREAM_IR_UNIT_DESERIALIZATION_METHODS_HPP
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <ystdlib/error_handling/Result.hpp>
 
@@ -16,6 +19,92 @@
 #include "IrUnitType.hpp"
 
 namespace clp::ffi::ir_stream {
+/**
+ * A key-value pair log event IR unit whose values haven't been deserialized. The serialized bytes
+ * of every value are recorded along with the ID of the value's key, so that the values can be
+ * deserialized selectively (e.g., only those a query needs in order to evaluate the log event).
+ */
+class DeferredKvPairLogEvent {
+public:
+    // Types
+    /**
+     * Predicate that takes whether a key is auto-generated and the key's schema-tree node ID, and
+     * returns whether the key's value should be deserialized.
+     */
+    using ValueFilter = std::function<bool(bool, SchemaTree::Node::id_t)>;
+
+    // Methods
+    /**
+     * Reads a key-value pair log event IR unit, recording the serialized values without
+     * deserializing them. Any previously read log event is discarded.
+     * @param reader
+     * @param tag
+     * @return A void result on success, or an error code indicating the failure:
+     * - std::errc::result_out_of_range if the IR stream is truncated.
+     * - std::errc::protocol_error if the IR stream is corrupted, or contains auto-generated key IDs
+     *   *after* a user-generated key ID.
+     * - Forwards `deserialize_and_decode_schema_tree_node_id`'s return values.
+     */
+    [[nodiscard]] auto read_ir_unit(ReaderInterface& reader, encoded_tag_t tag)
+            -> ystdlib::error_handling::Result<void>;
+
+    /**
+     * Deserializes the values selected by the given filter and constructs a log event from them.
+     * @param auto_gen_keys_schema_tree
+     * @param user_gen_keys_schema_tree
+     * @param utc_offset
+     * @param filter
+     * @return A result containing the log event or an error code indicating the failure:
+     * - std::errc::result_out_of_range if a value is truncated.
+     * - std::errc::protocol_error if a value is corrupted or a user-generated key is duplicated.
+     * - Forwards `KeyValuePairLogEvent::create`'s return values if the deserialized values cannot
+     *   construct a valid key-value pair log event.
+     */
+    [[nodiscard]] auto deserialize(
+            std::shared_ptr<SchemaTree const> auto_gen_keys_schema_tree,
+            std::shared_ptr<SchemaTree const> user_gen_keys_schema_tree,
+            UtcOffset utc_offset,
+            ValueFilter const& filter
+    ) const -> ystdlib::error_handling::Result<KeyValuePairLogEvent>;
+
+    /**
+     * Deserializes all values and constructs a log event from them.
+     * @param auto_gen_keys_schema_tree
+     * @param user_gen_keys_schema_tree
+     * @param utc_offset
+     * @return Forwards `deserialize`'s return values.
+     */
+    [[nodiscard]] auto deserialize(
+            std::shared_ptr<SchemaTree const> auto_gen_keys_schema_tree,
+            std::shared_ptr<SchemaTree const> user_gen_keys_schema_tree,
+            UtcOffset utc_offset
+    ) const -> ystdlib::error_handling::Result<KeyValuePairLogEvent> {
+        return deserialize(
+                std::move(auto_gen_keys_schema_tree),
+                std::move(user_gen_keys_schema_tree),
+                utc_offset,
+                [](bool, SchemaTree::Node::id_t) { return true; }
+        );
+    }
+
+private:
+    // Types
+    /**
+     * The location of a serialized value in `m_serialized_values`.
+     */
+    struct ValueLocation {
+        bool is_auto_generated{false};
+        SchemaTree::Node::id_t node_id{};
+        encoded_tag_t tag{};
+        size_t begin_pos{0};
+        size_t end_pos{0};
+    };
+
+    // Variables
+    std::vector<char> m_serialized_values;
+    std::vector<ValueLocation> m_value_locations;
+};
+
 /**
  * @param tag
  * @return The IR unit type of indicated by the given tag on success.
@@ -107,6 +107,17 @@ public:
         return m_query_handler_impl.evaluate_kv_pair_log_event(log_event);
     }
 
+    /**
+     * @param is_auto_generated
+     * @param node_id
+     * @return Whether evaluating the underlying query may require the value of the given key. Log
+     * events can be evaluated against only the values of such keys.
+     */
+    [[nodiscard]] auto is_value_referenced(bool is_auto_generated, SchemaTree::Node::id_t node_id)
+            const -> bool {
+        return m_query_handler_impl.is_value_referenced(is_auto_generated, node_id);
+    }
+
 private:
     // Constructor
     explicit QueryHandler(
@@ -108,6 +108,16 @@ using clp_s::search::ast::literal_type_bitmask_t;
         QueryHandlerImpl::PartialResolutionMap& user_gen_namespace_partial_resolutions
 ) -> ystdlib::error_handling::Result<void>;
 
+/**
+ * @param root The root of the search AST.
+ * @return A result containing whether any filter in the search AST is on a pure wildcard column,
+ * or an error code indicating the failure:
+ * - ErrorCodeEnum::AstDynamicCastFailure if failed to dynamically cast an AST node to a target
+ *   type.
+ */
+[[nodiscard]] auto has_pure_wildcard_column(std::shared_ptr<Expression> const& root)
+        -> ystdlib::error_handling::Result<bool>;
+
 /**
  * @param key_namespace
  * @return Whether `key_namespace` is auto-generated or user-generated, or std::nullopt if the
@@ -339,6 +349,36 @@ auto initialize_partial_resolution_from_search_ast(
     return ystdlib::error_handling::success();
 }
 
+auto has_pure_wildcard_column(std::shared_ptr<Expression> const& root)
+        -> ystdlib::error_handling::Result<bool> {
+    if (nullptr == root) {
+        return false;
+    }
+
+    std::vector<Expression*> ast_dfs_stack;
+    ast_dfs_stack.emplace_back(root.get());
+    while (false == ast_dfs_stack.empty()) {
+        auto* expr{ast_dfs_stack.back()};
+        ast_dfs_stack.pop_back();
+        if (expr->has_only_expression_operands()) {
+            for (auto it{expr->op_begin()}; it != expr->op_end(); ++it) {
+                auto* child_expr{dynamic_cast<Expression*>(it->get())};
+                if (nullptr == child_expr) {
+                    return ErrorCode{ErrorCodeEnum::AstDynamicCastFailure};
+                }
+                ast_dfs_stack.emplace_back(child_expr);
+            }
+            continue;
+        }
+
+        auto* filter{dynamic_cast<FilterExpr*>(expr)};
+        if (nullptr != filter && filter->get_column()->is_pure_wildcard()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 auto is_auto_generated(std::string_view key_namespace) -> std::optional<bool> {
     if (clp_s::constants::cAutogenNamespace == key_namespace) {
         return true;
@@ -429,8 +469,13 @@ auto QueryHandlerImpl::create(
                     projected_column_to_original_key_and_index
             ));
 
+    auto const query_has_pure_wildcard_column{
+            YSTDLIB_ERROR_HANDLING_TRYX(has_pure_wildcard_column(query))
+    };
+
     return QueryHandlerImpl{
             std::move(query),
+            query_has_pure_wildcard_column,
             std::move(auto_gen_namespace_partial_resolutions),
             std::move(user_gen_namespace_partial_resolutions),
             std::move(projected_columns),
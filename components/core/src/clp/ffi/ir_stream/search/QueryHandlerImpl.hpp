@@ -189,6 +189,24 @@ public:
             NewProjectedSchemaTreeNodeCallbackType new_projected_schema_tree_node_callback
     ) -> ystdlib::error_handling::Result<void>;
 
+    /**
+     * Implementation of `QueryHandler::is_value_referenced`.
+     * @param is_auto_generated
+     * @param node_id
+     * @return Whether evaluating the query may require the value of the given key.
+     */
+    [[nodiscard]] auto is_value_referenced(bool is_auto_generated, SchemaTree::Node::id_t node_id)
+            const -> bool {
+        if (nullptr == m_query || m_is_empty_query) {
+            return false;
+        }
+        if (m_has_pure_wildcard_column) {
+            return true;
+        }
+        return is_auto_generated ? m_auto_gen_referenced_node_ids.contains(node_id)
+                                 : m_user_gen_referenced_node_ids.contains(node_id);
+    }
+
     [[nodiscard]] auto get_resolved_column_to_schema_tree_node_ids() const -> std::unordered_map<
             clp_s::search::ast::ColumnDescriptor*,
             std::unordered_set<SchemaTree::Node::id_t>
@@ -294,6 +312,7 @@ private:
     // Constructor
     QueryHandlerImpl(
             std::shared_ptr<clp_s::search::ast::Expression> query,
+            bool has_pure_wildcard_column,
             PartialResolutionMap auto_gen_namespace_partial_resolutions,
             PartialResolutionMap user_gen_namespace_partial_resolutions,
             std::vector<std::shared_ptr<clp_s::search::ast::ColumnDescriptor>> projected_columns,
@@ -304,6 +323,7 @@ private:
               m_is_empty_query{
                       nullptr != dynamic_cast<clp_s::search::ast::EmptyExpr*>(m_query.get())
               },
+              m_has_pure_wildcard_column{has_pure_wildcard_column},
               m_auto_gen_namespace_partial_resolutions{
                       std::move(auto_gen_namespace_partial_resolutions)
               },
@@ -388,6 +408,7 @@ private:
     // Variables
     std::shared_ptr<clp_s::search::ast::Expression> m_query;
     bool m_is_empty_query;
+    bool m_has_pure_wildcard_column;
     PartialResolutionMap m_auto_gen_namespace_partial_resolutions;
     PartialResolutionMap m_user_gen_namespace_partial_resolutions;
     std::unordered_map<
@@ -395,6 +416,8 @@ private:
             std::unordered_set<SchemaTree::Node::id_t>
     >
             m_resolved_column_to_schema_tree_node_ids;
+    std::unordered_set<SchemaTree::Node::id_t> m_auto_gen_referenced_node_ids;
+    std::unordered_set<SchemaTree::Node::id_t> m_user_gen_referenced_node_ids;
     std::vector<std::shared_ptr<clp_s::search::ast::ColumnDescriptor>> m_projected_columns;
     ProjectionMap m_projected_column_to_original_key_and_index;
     bool m_case_sensitive_match;
@@ -516,6 +539,10 @@ auto QueryHandlerImpl::handle_column_resolution_on_new_schema_tree_node(
             std::unordered_set<SchemaTree::Node::id_t>{}
     );
     it->second.emplace(node_id);
+    auto& referenced_node_ids{
+            is_auto_generated ? m_auto_gen_referenced_node_ids : m_user_gen_referenced_node_ids
+    };
+    referenced_node_ids.emplace(node_id);
     return ystdlib::error_handling::success();
 }
 }  // namespace clp::ffi::ir_stream::search
@@ -1,9 +1,16 @@
 #include "parsing.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
 #include <string_utils/string_utils.hpp>
 
 #include "../type_utils.hpp"
@@ -13,6 +20,18 @@ using std::string;
 using std::string_view;
 
 namespace clp::ir {
+namespace {
+/**
+ * @param c
+ * @return Whether c is a hexadecimal digit
+ */
+auto is_hex_digit(char c) -> bool;
+
+auto is_hex_digit(char c) -> bool {
+    return ('a' <= c && c <= 'f') || ('A' <= c && c <= 'F') || ('0' <= c && c <= '9');
+}
+}  // namespace
+
 /*
  * For performance, we rely on the ASCII ordering of characters to compare ranges of characters at a
  * time instead of comparing individual characters
@@ -35,7 +54,12 @@ bool is_var(std::string_view value) {
 }
 
 bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& end_pos) {
-    auto const msg_length = str.length();
+    VariableTokenizer tokenizer{str};
+    return tokenizer.get_bounds_of_next_var(begin_pos, end_pos);
+}
+
+bool VariableTokenizer::get_bounds_of_next_var(size_t& begin_pos, size_t& end_pos) {
+    auto const msg_length = m_str.length();
     if (msg_length <= end_pos) {
         return false;
     }
@@ -44,41 +68,54 @@ bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& en
         begin_pos = end_pos;
 
         // Find next non-delimiter
-        for (; begin_pos < msg_length; ++begin_pos) {
-            auto c = str[begin_pos];
-            if (false == is_delim(c)) {
+        while (true) {
+            if (msg_length <= begin_pos) {
+                // Early exit for performance
+                begin_pos = msg_length;
+                return false;
+            }
+            load_block_containing(begin_pos);
+            auto const non_delims = ~m_masks.delim >> (begin_pos - m_block_pos);
+            if (0 != non_delims) {
+                begin_pos += std::countr_zero(non_delims);
                 break;
             }
-        }
-        if (msg_length == begin_pos) {
-            // Early exit for performance
-            return false;
+            begin_pos = m_block_pos + cBlockSize;
         }
 
         bool contains_decimal_digit = false;
         bool contains_alphabet = false;
+        bool could_be_hex_value = true;
 
         // Find next delimiter
         end_pos = begin_pos;
-        for (; end_pos < msg_length; ++end_pos) {
-            auto c = str[end_pos];
-            if (string_utils::is_decimal_digit(c)) {
-                contains_decimal_digit = true;
-            } else if (string_utils::is_alphabet(c)) {
-                contains_alphabet = true;
-            } else if (is_delim(c)) {
+        while (true) {
+            load_block_containing(end_pos);
+            auto const offset = end_pos - m_block_pos;
+            auto const num_remaining_chars = cBlockSize - offset;
+            auto const num_token_chars = std::min<size_t>(
+                    std::countr_zero(static_cast<Mask>(m_masks.delim >> offset)),
+                    num_remaining_chars
+            );
+            auto const token_mask = cBlockSize == num_token_chars
+                                            ? ~Mask{0}
+                                            : static_cast<Mask>((Mask{1} << num_token_chars) - 1);
+            contains_decimal_digit |= 0 != ((m_masks.decimal_digit >> offset) & token_mask);
+            contains_alphabet |= 0 != ((m_masks.alphabet >> offset) & token_mask);
+            could_be_hex_value &= token_mask == ((m_masks.hex_digit >> offset) & token_mask);
+            end_pos += num_token_chars;
+            if (num_token_chars < num_remaining_chars) {
                 break;
             }
         }
 
-        auto variable = str.substr(begin_pos, end_pos - begin_pos);
         // Treat token as variable if:
         // - it contains a decimal digit, or
         // - it's directly preceded by '=' and contains an alphabet char, or
         // - it could be a multi-digit hex value
         if (contains_decimal_digit
-            || (0 < begin_pos && '=' == str[begin_pos - 1] && contains_alphabet)
-            || could_be_multi_digit_hex_value(variable))
+            || (0 < begin_pos && '=' == m_str[begin_pos - 1] && contains_alphabet)
+            || (end_pos - begin_pos >= 2 && could_be_hex_value))
         {
             break;
         }
@@ -87,6 +124,75 @@ bool get_bounds_of_next_var(string_view const str, size_t& begin_pos, size_t& en
     return (msg_length != begin_pos);
 }
 
+void VariableTokenizer::load_block_containing(size_t pos) {
+    if (m_block_pos <= pos && pos - m_block_pos < cBlockSize) {
+        return;
+    }
+    m_block_pos = pos;
+
+    auto const num_chars = std::min(cBlockSize, m_str.length() - pos);
+    auto const* chars = m_str.data() + pos;
+    m_masks = {};
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Classify 16 characters at a time by comparing them against the ranges of each class. The
+    // comparisons are signed, so characters above 0x7F never fall within any of the (ASCII) ranges,
+    // matching `is_delim`.
+    constexpr size_t cVectorSize = 16;
+    auto const in_range = [](__m128i vec, char lower, char upper) {
+        return _mm_and_si128(
+                _mm_cmpgt_epi8(vec, _mm_set1_epi8(static_cast<char>(lower - 1))),
+                _mm_cmplt_epi8(vec, _mm_set1_epi8(static_cast<char>(upper + 1)))
+        );
+    };
+    auto const to_mask = [](__m128i vec) {
+        return static_cast<Mask>(static_cast<uint16_t>(_mm_movemask_epi8(vec)));
+    };
+    for (; i + cVectorSize <= num_chars; i += cVectorSize) {
+        auto const vec = _mm_loadu_si128(reinterpret_cast<__m128i const*>(chars + i));
+        auto const decimal_digit = in_range(vec, '0', '9');
+        auto const alphabet = _mm_or_si128(in_range(vec, 'A', 'Z'), in_range(vec, 'a', 'z'));
+        auto const hex_digit = _mm_or_si128(
+                decimal_digit,
+                _mm_or_si128(in_range(vec, 'A', 'F'), in_range(vec, 'a', 'f'))
+        );
+        auto const other_non_delim = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(vec, _mm_set1_epi8('+')), in_range(vec, '-', '.')),
+                _mm_or_si128(
+                        _mm_cmpeq_epi8(vec, _mm_set1_epi8('\\')),
+                        _mm_cmpeq_epi8(vec, _mm_set1_epi8('_'))
+                )
+        );
+        auto const non_delim
+                = _mm_or_si128(_mm_or_si128(decimal_digit, alphabet), other_non_delim);
+        m_masks.delim |= static_cast<Mask>((~to_mask(non_delim) & 0xFFFF) << i);
+        m_masks.decimal_digit |= static_cast<Mask>(to_mask(decimal_digit) << i);
+        m_masks.alphabet |= static_cast<Mask>(to_mask(alphabet) << i);
+        m_masks.hex_digit |= static_cast<Mask>(to_mask(hex_digit) << i);
+    }
+#endif
+    for (; i < num_chars; ++i) {
+        auto const c = chars[i];
+        auto const bit = static_cast<Mask>(Mask{1} << i);
+        if (is_delim(c)) {
+            m_masks.delim |= bit;
+        }
+        if (string_utils::is_decimal_digit(c)) {
+            m_masks.decimal_digit |= bit;
+        }
+        if (string_utils::is_alphabet(c)) {
+            m_masks.alphabet |= bit;
+        }
+        if (is_hex_digit(c)) {
+            m_masks.hex_digit |= bit;
+        }
+    }
+    if (num_chars < cBlockSize) {
+        // Treat positions past the end of the string as delimiters
+        m_masks.delim |= static_cast<Mask>(~Mask{0} << num_chars);
+    }
+}
+
 void escape_and_append_const_to_logtype(string_view constant, string& logtype) {
     // clang-format off
     auto escape_handler = [&](
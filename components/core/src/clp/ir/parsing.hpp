@@ -10,6 +10,7 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -77,6 +78,60 @@ bool is_var(std::string_view value);
  */
 bool get_bounds_of_next_var(std::string_view str, size_t& begin_pos, size_t& end_pos);
 
+/**
+ * Tokenizer which finds the bounds of the variables in a string, as `get_bounds_of_next_var` does.
+ *
+ * Rather than checking one character at a time, the tokenizer classifies a block of characters at
+ * a time (using SIMD instructions when available) into bitmasks of delimiters, digits, alphabet
+ * characters, and hex digits. It then finds the bounds of tokens, and the classes of characters
+ * they contain, using bitwise operations on the masks. The masks of the current block are kept
+ * between calls, so finding consecutive variables in a string classifies each block about once.
+ *
+ * NOTE: The string must outlive the tokenizer.
+ */
+class VariableTokenizer {
+public:
+    // Constructors
+    explicit VariableTokenizer(std::string_view str) : m_str{str} {}
+
+    // Methods
+    /**
+     * Gets the bounds of the next variable in the tokenizer's string
+     * @param begin_pos Begin position of last variable, changes to begin position of next variable
+     * @param end_pos End position of last variable, changes to end position of next variable
+     * @return Same as `get_bounds_of_next_var`
+     */
+    bool get_bounds_of_next_var(size_t& begin_pos, size_t& end_pos);
+
+private:
+    // Types
+    // Bitmask where bit i corresponds to the i-th character of the current block
+    using Mask = uint32_t;
+
+    struct CharClassMasks {
+        Mask delim{0};
+        Mask decimal_digit{0};
+        Mask alphabet{0};
+        Mask hex_digit{0};
+    };
+
+    // Constants
+    static constexpr size_t cBlockSize = sizeof(Mask) * 8;
+
+    // Methods
+    /**
+     * Classifies the block of characters starting at the given position, unless the current block
+     * already contains it. Positions past the end of the string are classified as delimiters.
+     * @param pos
+     */
+    void load_block_containing(size_t pos);
+
+    // Variables
+    std::string_view m_str;
+    size_t m_block_pos{std::string_view::npos};
+    CharClassMasks m_masks;
+};
+
 /**
  * Appends a constant to the logtype, escaping any variable placeholders.
  * @param constant
@@ -1,4 +1,3 @@
-#include <set>
 #include <string>
 
 #include <boost/filesystem.hpp>
@@ -17,7 +16,6 @@
 using clp::CommandLineArgumentsBase;
 using clp::FileWriter;
 using clp::ir::VariablePlaceholder;
-using clp::segment_id_t;
 using std::string;
 
 int main(int argc, char const* argv[]) {
@@ -120,8 +118,8 @@ int main(int argc, char const* argv[]) {
         );
         file_writer.write_char('\n');
 
-        std::set<segment_id_t> const& segment_ids = entry.get_ids_of_segments_containing_entry();
-        // segment_ids is a std::set, which iterates the IDs in ascending order
+        auto const segment_ids = logtype_dict.get_ids_of_segments_containing_entry(entry.get_id());
+        // segment_ids is a SegmentIdBitmap, which iterates the IDs in ascending order
         for (auto segment_id : segment_ids) {
             index_writer.write_string(std::to_string(segment_id) + " ");
         }
@@ -158,8 +156,8 @@ int main(int argc, char const* argv[]) {
         file_writer.write_string(entry.get_value());
         file_writer.write_char('\n');
 
-        std::set<segment_id_t> const& segment_ids = entry.get_ids_of_segments_containing_entry();
-        // segment_ids is a std::set, which iterates the IDs in ascending order
+        auto const segment_ids = var_dict.get_ids_of_segments_containing_entry(entry.get_id());
+        // segment_ids is a SegmentIdBitmap, which iterates the IDs in ascending order
         for (auto segment_id : segment_ids) {
             index_writer.write_string(std::to_string(segment_id) + " ");
         }
@@ -14,6 +14,26 @@ constexpr char cMetadataFileName[] = "metadata";
 constexpr char cMetadataDBFileName[] = "metadata.db";
 constexpr char cSchemaFileName[] = "schema.txt";
 
+/**
+ * Segments are compressed as a sequence of independently decompressible zstd frames, each
+ * containing roughly `FrameTargetUncompressedSize` bytes, followed by a seek table listing the
+ * size of every frame. The seek table uses zstd's seekable format: it's stored in a zstd skippable
+ * frame (so that it's ignored by decompressors that don't know about it) and consists of:
+ * - the skippable frame's magic number and size (32-bit each);
+ * - the compressed and uncompressed size of each frame (32-bit each);
+ * - a footer containing the number of frames (32-bit), a descriptor (8-bit; must be 0 since
+ *   frames aren't checksummed), and the seekable magic number (32-bit).
+ * All values are little-endian.
+ */
+namespace cSegmentSeekTable {
+constexpr uint64_t FrameTargetUncompressedSize{1024 * 1024};
+constexpr uint32_t SkippableFrameMagicNumber{0x184D'2A5E};
+constexpr uint32_t SeekableMagicNumber{0x8F92'EAB1};
+constexpr size_t SkippableFrameHeaderSize{2 * sizeof(uint32_t)};
+constexpr size_t EntrySize{2 * sizeof(uint32_t)};
+constexpr size_t FooterSize{sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint32_t)};
+}  // namespace cSegmentSeekTable
+
 namespace cArchiveFormatVersion {
 constexpr uint8_t VersionMajor{0};
 constexpr uint8_t VersionMinor{1};
@@ -3,6 +3,11 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
 #include "../../EncodedVariableInterpreter.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../Constants.hpp"
@@ -146,6 +151,9 @@ ErrorCode File::open_me(
     m_current_ts_pattern_ix = 0;
     m_current_ts_in_milli = m_begin_ts;
 
+    m_variables_offsets.clear();
+    m_candidate_msgs_query = nullptr;
+
     return ErrorCode_Success;
 }
 
@@ -172,6 +180,9 @@ void File::close_me() {
     m_end_ts = cEpochTimeMin;
     m_orig_path.clear();
 
+    m_variables_offsets.clear();
+    m_candidate_msgs_query = nullptr;
+
     m_archive_logtype_dict = nullptr;
 }
 
@@ -250,51 +261,130 @@ bool File::find_message_in_time_range(
 }
 
 SubQuery const* File::find_message_matching_query(Query const& query, Message& msg) {
-    SubQuery const* matching_sub_query = nullptr;
-    while (m_msgs_ix < m_num_messages && nullptr == matching_sub_query) {
-        auto const curr_msg_ix{m_msgs_ix};
-        auto logtype_id = m_logtypes[curr_msg_ix];
-
-        // Get number of variables in logtype
-        auto const& logtype_dictionary_entry = m_archive_logtype_dict->get_entry(logtype_id);
-        auto const num_vars = logtype_dictionary_entry.get_num_variables();
-
-        auto const vars_begin_ix{m_variables_ix};
-        auto const vars_end_ix{m_variables_ix + num_vars};
+    compute_variables_offsets();
+    auto const num_searchable_msgs{m_variables_offsets.size() - 1};
+    if (query.get_relevant_sub_queries().empty()) {
+        m_msgs_ix = std::max(m_msgs_ix, num_searchable_msgs);
+    }
 
-        // Advance indices
-        ++m_msgs_ix;
-        m_variables_ix = vars_end_ix;
+    SubQuery const* matching_sub_query = nullptr;
+    while (m_msgs_ix < num_searchable_msgs && nullptr == matching_sub_query) {
+        if (&query != m_candidate_msgs_query || m_msgs_ix < m_candidate_msgs_begin_ix
+            || m_msgs_ix >= m_candidate_msgs_end_ix)
+        {
+            compute_candidate_msgs_bitmap(query);
+        }
 
-        auto const timestamp{m_timestamps[curr_msg_ix]};
-        if (false == query.timestamp_is_in_search_time_range(timestamp)) {
+        // Find the next candidate message in the block
+        auto const bitmap_ix{m_msgs_ix - m_candidate_msgs_begin_ix};
+        auto word_ix{bitmap_ix / 64};
+        auto word{m_candidate_msgs_bitmap[word_ix] & (~uint64_t{0} << (bitmap_ix % 64))};
+        while (0 == word && ++word_ix < m_candidate_msgs_bitmap.size()) {
+            word = m_candidate_msgs_bitmap[word_ix];
+        }
+        if (0 == word) {
+            m_msgs_ix = m_candidate_msgs_end_ix;
             continue;
         }
-
+        auto const curr_msg_ix{
+                m_candidate_msgs_begin_ix + word_ix * 64
+                + static_cast<size_t>(std::countr_zero(word))
+        };
+        m_msgs_ix = curr_msg_ix + 1;
+
+        auto const logtype_id{m_logtypes[curr_msg_ix]};
+        auto const vars_begin_ix{m_variables_offsets[curr_msg_ix]};
+        auto const vars_end_ix{m_variables_offsets[curr_msg_ix + 1]};
+        bool vars_loaded{false};
         for (auto const* sub_query : query.get_relevant_sub_queries()) {
             if (false == sub_query->matches_logtype(logtype_id)) {
                 continue;
             }
 
-            msg.clear_vars();
-            for (auto vars_ix{vars_begin_ix}; vars_ix < vars_end_ix; ++vars_ix) {
-                msg.add_var(m_variables[vars_ix]);
+            if (false == vars_loaded) {
+                msg.clear_vars();
+                for (auto vars_ix{vars_begin_ix}; vars_ix < vars_end_ix; ++vars_ix) {
+                    msg.add_var(m_variables[vars_ix]);
+                }
+                vars_loaded = true;
             }
             if (false == sub_query->matches_vars(msg.get_vars())) {
                 continue;
             }
 
             msg.set_logtype_id(logtype_id);
-            msg.set_timestamp(timestamp);
+            msg.set_timestamp(m_timestamps[curr_msg_ix]);
             msg.set_msg_ix(m_begin_message_ix, curr_msg_ix);
             matching_sub_query = sub_query;
             break;
         }
     }
 
+    if (m_msgs_ix < m_variables_offsets.size()) {
+        m_variables_ix = m_variables_offsets[m_msgs_ix];
+    }
+
     return matching_sub_query;
 }
 
+void File::compute_variables_offsets() {
+    if (false == m_variables_offsets.empty()) {
+        return;
+    }
+
+    m_variables_offsets.reserve(m_num_messages + 1);
+    size_t offset{0};
+    m_variables_offsets.push_back(offset);
+    for (size_t msg_ix = 0; msg_ix < m_num_messages; ++msg_ix) {
+        auto const& logtype_dictionary_entry
+                = m_archive_logtype_dict->get_entry(m_logtypes[msg_ix]);
+        offset += logtype_dictionary_entry.get_num_variables();
+        if (offset > m_num_variables) {
+            // Logtypes not in sync with variables, so don't search the remaining messages
+            break;
+        }
+        m_variables_offsets.push_back(offset);
+    }
+}
+
+void File::compute_candidate_msgs_bitmap(Query const& query) {
+    auto const num_searchable_msgs{m_variables_offsets.size() - 1};
+    m_candidate_msgs_query = &query;
+    m_candidate_msgs_begin_ix = m_msgs_ix;
+    m_candidate_msgs_end_ix = std::min(m_msgs_ix + cSearchBlockSize, num_searchable_msgs);
+
+    auto const search_begin_timestamp{query.get_search_begin_timestamp()};
+    auto const search_end_timestamp{query.get_search_end_timestamp()};
+    auto const* timestamps{m_timestamps + m_candidate_msgs_begin_ix};
+    auto const* logtypes{m_logtypes + m_candidate_msgs_begin_ix};
+    auto const num_msgs{m_candidate_msgs_end_ix - m_candidate_msgs_begin_ix};
+    for (size_t word_ix = 0; word_ix < m_candidate_msgs_bitmap.size(); ++word_ix) {
+        auto const word_begin_ix{word_ix * 64};
+        auto const word_end_ix{std::min(word_begin_ix + 64, num_msgs)};
+
+        // Check the timestamps without branching so that the loop can be vectorized
+        uint64_t word{0};
+        for (auto msg_ix{word_begin_ix}; msg_ix < word_end_ix; ++msg_ix) {
+            auto const timestamp{timestamps[msg_ix]};
+            auto const is_in_time_range{
+                    static_cast<uint64_t>(search_begin_timestamp <= timestamp)
+                    & static_cast<uint64_t>(timestamp <= search_end_timestamp)
+            };
+            word |= is_in_time_range << (msg_ix - word_begin_ix);
+        }
+
+        // Only check the logtypes of messages in the time range
+        for (auto bits{word}; 0 != bits; bits &= bits - 1) {
+            auto const bit_ix{std::countr_zero(bits)};
+            if (false == query.matches_relevant_logtype(logtypes[word_begin_ix + bit_ix])) {
+                word &= ~(uint64_t{1} << bit_ix);
+            }
+        }
+
+        m_candidate_msgs_bitmap[word_ix] = word;
+    }
+}
+
 bool File::get_next_message(Message& msg) {
     if (m_msgs_ix >= m_num_messages) {
         return false;
@@ -1,6 +1,9 @@
 #ifndef CLP_STREAMING_ARCHIVE_READER_FILE_HPP
 #define CLP_STREAMING_ARCHIVE_READER_FILE_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <list>
 #include <set>
 #include <vector>
@@ -30,6 +33,10 @@ public:
         }
     };
 
+    // Constants
+    // Number of messages whose timestamps and logtypes are checked at once when searching
+    static constexpr size_t cSearchBlockSize{1024};
+
     // Constructors
     File()
             : m_archive_logtype_dict(nullptr),
@@ -120,6 +127,18 @@ private:
      * @return pointer to matching subquery otherwise
      */
     SubQuery const* find_message_matching_query(Query const& query, Message& msg);
+    /**
+     * Computes the offset of each message's variables in `m_variables`, if they haven't already
+     * been computed for this file
+     */
+    void compute_variables_offsets();
+    /**
+     * Computes the bitmap of messages, in the block of messages starting at `m_msgs_ix`, that have
+     * a timestamp in the query's time range and a logtype that's possible in one of the query's
+     * relevant sub-queries
+     * @param query
+     */
+    void compute_candidate_msgs_bitmap(Query const& query);
     /**
      * Get next message in file
      * @param msg
@@ -162,6 +181,16 @@ private:
 
     size_t m_split_ix;
     bool m_is_split;
+
+    // Offset of each message's variables in `m_variables`, followed by the total number of
+    // variables in messages that can be searched
+    std::vector<size_t> m_variables_offsets;
+    // Bitmap of the messages in [m_candidate_msgs_begin_ix, m_candidate_msgs_end_ix) that may
+    // match m_candidate_msgs_query
+    std::array<uint64_t, cSearchBlockSize / 64> m_candidate_msgs_bitmap{};
+    size_t m_candidate_msgs_begin_ix{0};
+    size_t m_candidate_msgs_end_ix{0};
+    Query const* m_candidate_msgs_query{nullptr};
 };
 }  // namespace clp::streaming_archive::reader
 
@@ -3,8 +3,14 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <fmt/format.h>
@@ -66,10 +72,12 @@ ErrorCode Segment::try_open(string const& segment_dir_path, segment_id_t segment
         return ErrorCode_Failure;
     }
 
-    auto const view{m_memory_mapped_segment_file.value().get_view()};
-    m_decompressor.open(view.data(), view.size());
-
     m_segment_path = segment_path;
+
+    auto const view{m_memory_mapped_segment_file.value().get_view()};
+    read_frames(view);
+    m_current_frame_ix = 0;
+    m_decompressor.open(view.data(), m_compressed_data_size);
     return ErrorCode_Success;
 }
 
@@ -78,6 +86,8 @@ void Segment::close() {
         m_decompressor.close();
         m_memory_mapped_segment_file.reset();
         m_segment_path.clear();
+        m_frames.clear();
+        m_compressed_data_size = 0;
     }
 }
 
@@ -92,10 +102,93 @@ Segment::try_read(uint64_t decompressed_stream_pos, char* extraction_buf, uint64
         );
         return ErrorCode_BadParam;
     }
-    return m_decompressor.get_decompressed_stream_region(
+
+    // Find the frame containing the content and, if necessary, restart decompression from it. The
+    // decompressor can read past the end of the frame since the frames are contiguous.
+    auto const next_frame_it = std::upper_bound(
+            m_frames.cbegin(),
+            m_frames.cend(),
             decompressed_stream_pos,
+            [](uint64_t pos, Frame const& frame) { return pos < frame.uncompressed_offset; }
+    );
+    auto const frame_ix = static_cast<size_t>(next_frame_it - m_frames.cbegin()) - 1;
+    auto const& frame = m_frames[frame_ix];
+    if (frame_ix != m_current_frame_ix) {
+        auto const view{m_memory_mapped_segment_file.value().get_view()};
+        m_decompressor.close();
+        m_decompressor.open(
+                view.data() + frame.compressed_offset,
+                m_compressed_data_size - frame.compressed_offset
+        );
+        m_current_frame_ix = frame_ix;
+    }
+    return m_decompressor.get_decompressed_stream_region(
+            decompressed_stream_pos - frame.uncompressed_offset,
             extraction_buf,
             extraction_len
     );
 }
+
+void Segment::read_frames(std::span<char const> segment) {
+    // Treat the segment as a single frame unless a valid seek table is found
+    m_frames.assign({Frame{0, 0}});
+    m_compressed_data_size = segment.size();
+
+#if USE_ZSTD_COMPRESSION
+    auto read_uint32 = [&](size_t pos) -> uint32_t {
+        uint32_t value{};
+        std::memcpy(&value, segment.data() + pos, sizeof(value));
+        return value;
+    };
+
+    if (segment.size() < cSegmentSeekTable::SkippableFrameHeaderSize
+                                 + cSegmentSeekTable::FooterSize)
+    {
+        return;
+    }
+    auto const footer_pos = segment.size() - cSegmentSeekTable::FooterSize;
+    auto const num_frames = read_uint32(footer_pos);
+    auto const descriptor = static_cast<uint8_t>(segment[footer_pos + sizeof(uint32_t)]);
+    auto const magic_number = read_uint32(footer_pos + sizeof(uint32_t) + sizeof(uint8_t));
+    if (cSegmentSeekTable::SeekableMagicNumber != magic_number || 0 != descriptor) {
+        return;
+    }
+
+    auto const skippable_frame_size
+            = uint64_t{num_frames} * cSegmentSeekTable::EntrySize + cSegmentSeekTable::FooterSize;
+    auto const seek_table_size = cSegmentSeekTable::SkippableFrameHeaderSize + skippable_frame_size;
+    if (seek_table_size > segment.size()) {
+        return;
+    }
+    auto const seek_table_pos = segment.size() - seek_table_size;
+    if (cSegmentSeekTable::SkippableFrameMagicNumber != read_uint32(seek_table_pos)
+        || skippable_frame_size != read_uint32(seek_table_pos + sizeof(uint32_t)))
+    {
+        return;
+    }
+
+    std::vector<Frame> frames;
+    frames.reserve(num_frames);
+    uint64_t compressed_offset{0};
+    uint64_t uncompressed_offset{0};
+    auto entry_pos = seek_table_pos + cSegmentSeekTable::SkippableFrameHeaderSize;
+    for (uint32_t i = 0; i < num_frames; ++i, entry_pos += cSegmentSeekTable::EntrySize) {
+        frames.push_back({compressed_offset, uncompressed_offset});
+        compressed_offset += read_uint32(entry_pos);
+        uncompressed_offset += read_uint32(entry_pos + sizeof(uint32_t));
+    }
+    if (compressed_offset != seek_table_pos) {
+        SPDLOG_WARN(
+                "streaming_archive::reader::Segment: Ignoring corrupt seek table in {}",
+                m_segment_path.c_str()
+        );
+        return;
+    }
+
+    m_compressed_data_size = seek_table_pos;
+    if (false == frames.empty()) {
+        m_frames = std::move(frames);
+    }
+#endif
+}
 }  // namespace clp::streaming_archive::reader
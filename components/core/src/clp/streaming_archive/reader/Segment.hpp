@@ -1,9 +1,13 @@
 #ifndef CLP_STREAMING_ARCHIVE_READER_SEGMENT_HPP
 #define CLP_STREAMING_ARCHIVE_READER_SEGMENT_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 #include "../../Defs.h"
 #include "../../ErrorCode.hpp"
@@ -15,7 +19,9 @@
 namespace clp::streaming_archive::reader {
 /**
  * Class for reading segments. A segment is a container for multiple compressed buffers that
- * itself may be further compressed and stored on disk.
+ * itself may be further compressed and stored on disk. If the segment has a seek table (see
+ * `cSegmentSeekTable`), reads start decompressing from the frame containing the requested content
+ * rather than from the beginning of the segment.
  */
 class Segment {
 public:
@@ -52,9 +58,31 @@ public:
     try_read(uint64_t decompressed_stream_pos, char* extraction_buf, uint64_t extraction_len);
 
 private:
+    // Types
+    struct Frame {
+        uint64_t compressed_offset;
+        uint64_t uncompressed_offset;
+    };
+
+    // Methods
+    /**
+     * Reads the frames of the segment from the seek table at the end of the segment. Segments
+     * without a (valid) seek table are treated as a single frame.
+     * @param segment
+     */
+    void read_frames(std::span<char const> segment);
+
+    // Variables
     std::string m_segment_path;
     std::optional<ReadOnlyMemoryMappedFile> m_memory_mapped_segment_file;
 
+    // Sorted by offset
+    std::vector<Frame> m_frames;
+    // The size of the segment excluding the seek table
+    size_t m_compressed_data_size{0};
+    // The frame the decompressor was opened at
+    size_t m_current_frame_ix{0};
+
 #if USE_PASSTHROUGH_COMPRESSION
     streaming_compression::passthrough::Decompressor m_decompressor;
 #elif USE_ZSTD_COMPRESSION
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include <boost/asio.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -156,6 +157,7 @@ void Archive::open(UserConfig const& user_config) {
     }
 
     m_global_metadata_db = user_config.global_metadata_db;
+    m_global_metadata_db_mutex = user_config.global_metadata_db_mutex;
 
     m_file = nullptr;
 
@@ -234,18 +236,24 @@ void Archive::close() {
 
     m_metadata_file_writer.close();
 
-    update_global_metadata();
+    {
+        std::unique_lock<std::mutex> global_metadata_db_lock;
+        if (nullptr != m_global_metadata_db_mutex) {
+            global_metadata_db_lock = std::unique_lock<std::mutex>{*m_global_metadata_db_mutex};
+        }
+        update_global_metadata();
+        if (m_print_archive_stats_progress) {
+            print_archive_stats_progress();
+        }
+    }
     m_global_metadata_db = nullptr;
+    m_global_metadata_db_mutex = nullptr;
 
     for (auto* file : m_file_metadata_for_global_update) {
         delete file;
     }
     m_file_metadata_for_global_update.clear();
 
-    if (m_print_archive_stats_progress) {
-        print_archive_stats_progress();
-    }
-
     m_metadata_db.close();
 
     m_creator_id_as_string.clear();
@@ -3,6 +3,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -38,6 +39,8 @@ public:
      * @param global_metadata_db
      * @param print_archive_stats_progress Enable printing statistics about the archive as it's
      * compressed
+     * @param global_metadata_db_mutex Mutex to hold while updating the global metadata database
+     * and printing statistics, if archives sharing the database are closed concurrently
      */
     struct UserConfig {
         boost::uuids::uuid id;
@@ -48,6 +51,7 @@ public:
         std::string output_dir;
         GlobalMetadataDB* global_metadata_db;
         bool print_archive_stats_progress;
+        std::mutex* global_metadata_db_mutex{nullptr};
     };
 
     class OperationFailed : public TraceableException {
@@ -354,6 +358,7 @@ private:
     FileWriter m_metadata_file_writer;
 
     GlobalMetadataDB* m_global_metadata_db;
+    std::mutex* m_global_metadata_db_mutex{nullptr};
 
     bool m_print_archive_stats_progress;
 };
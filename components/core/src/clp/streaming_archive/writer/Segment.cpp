@@ -2,8 +2,10 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 
 #include "../../ErrorCode.hpp"
@@ -39,6 +41,9 @@ void Segment::open(string const& segments_dir_path, segment_id_t id, int compres
 
     m_offset = 0;
     m_compressed_size = 0;
+    m_frame_sizes.clear();
+    m_frame_uncompressed_size = 0;
+    m_frame_begin_pos = 0;
 
     m_file_writer.open(m_segment_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
 #if USE_PASSTHROUGH_COMPRESSION
@@ -51,7 +56,15 @@ void Segment::open(string const& segments_dir_path, segment_id_t id, int compres
 }
 
 void Segment::close() {
+#if USE_ZSTD_COMPRESSION
+    if (m_frame_uncompressed_size > 0) {
+        end_frame();
+    }
+    m_compressor.close();
+    write_seek_table();
+#else
     m_compressor.close();
+#endif
     m_compressed_size = m_file_writer.get_pos();
 
     m_file_writer.flush();
@@ -63,7 +76,23 @@ void Segment::close() {
 
 void Segment::append(char const* buf, uint64_t const buf_len, uint64_t& offset) {
     // Compress
+#if USE_ZSTD_COMPRESSION
+    // Split the buffer at frame boundaries
+    for (uint64_t buf_pos = 0; buf_pos < buf_len;) {
+        auto const chunk_len = std::min(
+                buf_len - buf_pos,
+                cSegmentSeekTable::FrameTargetUncompressedSize - m_frame_uncompressed_size
+        );
+        m_compressor.write(buf + buf_pos, chunk_len);
+        buf_pos += chunk_len;
+        m_frame_uncompressed_size += chunk_len;
+        if (m_frame_uncompressed_size >= cSegmentSeekTable::FrameTargetUncompressedSize) {
+            end_frame();
+        }
+    }
+#else
     m_compressor.write(buf, buf_len);
+#endif
 
     // Return offset and update it
     offset = m_offset;
@@ -86,4 +115,34 @@ size_t Segment::get_compressed_size() {
 bool Segment::is_open() const {
     return !m_segment_path.empty();
 }
+
+void Segment::end_frame() {
+#if USE_ZSTD_COMPRESSION
+    // Flushing ends the frame; the next write starts a new one
+    m_compressor.flush();
+#endif
+    auto const frame_end_pos = m_file_writer.get_pos();
+    m_frame_sizes.push_back(
+            {static_cast<uint32_t>(frame_end_pos - m_frame_begin_pos),
+             static_cast<uint32_t>(m_frame_uncompressed_size)}
+    );
+    m_frame_begin_pos = frame_end_pos;
+    m_frame_uncompressed_size = 0;
+}
+
+void Segment::write_seek_table() {
+    auto const num_frames = static_cast<uint32_t>(m_frame_sizes.size());
+    auto const skippable_frame_size = static_cast<uint32_t>(
+            num_frames * cSegmentSeekTable::EntrySize + cSegmentSeekTable::FooterSize
+    );
+    m_file_writer.write_numeric_value(cSegmentSeekTable::SkippableFrameMagicNumber);
+    m_file_writer.write_numeric_value(skippable_frame_size);
+    for (auto const& frame_sizes : m_frame_sizes) {
+        m_file_writer.write_numeric_value(frame_sizes.compressed_size);
+        m_file_writer.write_numeric_value(frame_sizes.uncompressed_size);
+    }
+    m_file_writer.write_numeric_value(num_frames);
+    m_file_writer.write_numeric_value(uint8_t{0});
+    m_file_writer.write_numeric_value(cSegmentSeekTable::SeekableMagicNumber);
+}
 }  // namespace clp::streaming_archive::writer
@@ -1,8 +1,10 @@
 #ifndef CLP_STREAMING_ARCHIVE_WRITER_SEGMENT_HPP
 #define CLP_STREAMING_ARCHIVE_WRITER_SEGMENT_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../../Defs.h"
 #include "../../ErrorCode.hpp"
@@ -15,7 +17,10 @@
 namespace clp::streaming_archive::writer {
 /**
  * Class for writing segments. A segment is a container for multiple compressed buffers that
- * itself may be further compressed and then stored on disk.
+ * itself may be further compressed and then stored on disk. When compressed with zstd, the segment
+ * is split into independently decompressible frames indexed by a seek table (see
+ * `cSegmentSeekTable`), so that readers can decompress a region without decompressing everything
+ * before it.
  */
 class Segment {
 public:
@@ -79,6 +84,25 @@ public:
     size_t get_compressed_size();
 
 private:
+    // Types
+    struct FrameSizes {
+        uint32_t compressed_size;
+        uint32_t uncompressed_size;
+    };
+
+    // Methods
+    /**
+     * Ends the current frame and records its size in the seek table
+     * @throw streaming_archive::writer::Segment::OperationFailed if compression fails
+     */
+    void end_frame();
+
+    /**
+     * Writes the seek table at the end of the segment
+     * @throw FileWriter::OperationFailed on write failure
+     */
+    void write_seek_table();
+
     // Variables
     std::string m_segment_path;
     segment_id_t m_id;
@@ -86,6 +110,11 @@ private:
     uint64_t m_offset;  // total input bytes processed
     uint64_t m_compressed_size;
 
+    // Frames of the segment, along with the sizes and start position of the current frame
+    std::vector<FrameSizes> m_frame_sizes;
+    uint64_t m_frame_uncompressed_size{0};
+    size_t m_frame_begin_pos{0};
+
     FileWriter m_file_writer;
 #if USE_PASSTHROUGH_COMPRESSION
     streaming_compression::passthrough::Compressor m_compressor;
@@ -0,0 +1,122 @@
+#include "ArchiveCache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace clp_s {
+namespace {
+/**
+ * @tparam DictionaryReaderType
+ * @param dictionary
+ * @return The estimated number of bytes of memory used by the entries of the given dictionary.
+ */
+template <typename DictionaryReaderType>
+auto estimate_dictionary_size(std::shared_ptr<DictionaryReaderType> const& dictionary) -> size_t {
+    if (nullptr == dictionary) {
+        return 0;
+    }
+    size_t size{0};
+    for (auto const& entry : dictionary->get_entries()) {
+        size += sizeof(entry) + entry.get_value().size();
+    }
+    return size;
+}
+}  // namespace
+
+auto ArchiveCache::take_archive(std::string const& archive_id) -> std::shared_ptr<CachedArchive> {
+    std::lock_guard const lock{m_mutex};
+    auto const it = m_key_to_entry.find(Key{archive_id, cArchiveStateKey});
+    if (m_key_to_entry.end() == it) {
+        return nullptr;
+    }
+    auto archive = std::move(it->second->archive);
+    m_size -= it->second->size;
+    m_entries.erase(it->second);
+    m_key_to_entry.erase(it);
+    return archive;
+}
+
+void
+ArchiveCache::put_archive(std::string const& archive_id, std::shared_ptr<CachedArchive> archive) {
+    if (nullptr == archive) {
+        return;
+    }
+    auto const size{estimate_size(*archive)};
+    std::lock_guard const lock{m_mutex};
+    insert({.key = Key{archive_id, cArchiveStateKey},
+            .size = size,
+            .archive = std::move(archive)});
+}
+
+auto ArchiveCache::get_stream(std::string const& archive_id, size_t stream_id)
+        -> std::shared_ptr<char[]> {
+    std::lock_guard const lock{m_mutex};
+    auto const it = m_key_to_entry.find(Key{archive_id, stream_id});
+    if (m_key_to_entry.end() == it) {
+        return nullptr;
+    }
+    // Mark the entry as the most recently used
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->stream;
+}
+
+void ArchiveCache::put_stream(
+        std::string const& archive_id,
+        size_t stream_id,
+        std::shared_ptr<char[]> stream,
+        size_t stream_size
+) {
+    if (nullptr == stream) {
+        return;
+    }
+    std::lock_guard const lock{m_mutex};
+    insert({.key = Key{archive_id, stream_id},
+            .size = stream_size,
+            .stream = std::move(stream)});
+}
+
+void ArchiveCache::insert(Entry entry) {
+    if (auto const it = m_key_to_entry.find(entry.key); m_key_to_entry.end() != it) {
+        m_size -= it->second->size;
+        m_entries.erase(it->second);
+        m_key_to_entry.erase(it);
+    }
+    if (entry.size > m_capacity) {
+        return;
+    }
+
+    while (m_size + entry.size > m_capacity) {
+        auto const& lru_entry = m_entries.back();
+        m_size -= lru_entry.size;
+        m_key_to_entry.erase(lru_entry.key);
+        m_entries.pop_back();
+    }
+
+    m_size += entry.size;
+    auto key = entry.key;
+    m_entries.push_front(std::move(entry));
+    m_key_to_entry.emplace(std::move(key), m_entries.begin());
+}
+
+auto ArchiveCache::estimate_size(CachedArchive const& archive) -> size_t {
+    size_t size{sizeof(CachedArchive)};
+    if (nullptr != archive.schema_tree) {
+        for (auto const& node : archive.schema_tree->get_nodes()) {
+            size += sizeof(node) + node.get_key_name().size();
+        }
+    }
+    if (nullptr != archive.schema_map) {
+        for (auto const& [schema_id, schema] : *archive.schema_map) {
+            size += sizeof(schema_id) + sizeof(schema) + schema.size() * sizeof(int32_t);
+        }
+    }
+    size += estimate_dictionary_size(archive.var_dict);
+    size += estimate_dictionary_size(archive.log_dict);
+    size += estimate_dictionary_size(archive.array_dict);
+    return size;
+}
+}  // namespace clp_s
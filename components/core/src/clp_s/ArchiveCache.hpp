@@ -0,0 +1,152 @@
+#ifndef CLP_S_ARCHIVECACHE_HPP
+#define CLP_S_ARCHIVECACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "ArchiveReaderAdaptor.hpp"
+#include "DictionaryReader.hpp"
+#include "ReaderUtils.hpp"
+#include "SchemaTree.hpp"
+
+namespace clp_s {
+/**
+ * How the entries of a dictionary have been read.
+ */
+enum class DictionaryReadState : uint8_t {
+    Unread,
+    ReadLazily,
+    Read
+};
+
+/**
+ * The state of an archive that can be reused by later searches of the archive, so that they don't
+ * have to read it again.
+ */
+struct CachedArchive {
+    std::shared_ptr<ArchiveReaderAdaptor> adaptor;
+    std::shared_ptr<SchemaTree> schema_tree;
+    std::shared_ptr<ReaderUtils::SchemaMap> schema_map;
+    std::shared_ptr<VariableDictionaryReader> var_dict;
+    std::shared_ptr<LogTypeDictionaryReader> log_dict;
+    std::shared_ptr<LogTypeDictionaryReader> array_dict;
+    DictionaryReadState var_dict_state{DictionaryReadState::Unread};
+    DictionaryReadState log_dict_state{DictionaryReadState::Unread};
+    DictionaryReadState array_dict_state{DictionaryReadState::Unread};
+};
+
+/**
+ * A cache of the state (dictionaries, schema trees, etc.) and decompressed packed streams of
+ * recently read archives, shared by the archive readers of a long-lived process. The cache is
+ * bounded by a byte budget, and the least recently used entries are evicted once the budget is
+ * exceeded.
+ *
+ * The state of an archive can only be used by one reader at a time, so readers take it out of the
+ * cache while they have the archive open and put it back when they close the archive. Decompressed
+ * streams are immutable and can be shared by any number of readers.
+ *
+ * This class is thread-safe.
+ */
+class ArchiveCache {
+public:
+    // Constructors
+    /**
+     * @param capacity The maximum (estimated) number of bytes of data to cache.
+     */
+    explicit ArchiveCache(size_t capacity) : m_capacity{capacity} {}
+
+    // Methods
+    /**
+     * Takes the cached state of an archive out of the cache.
+     * @param archive_id
+     * @return The cached state of the archive, or nullptr if it isn't cached.
+     */
+    [[nodiscard]] auto take_archive(std::string const& archive_id)
+            -> std::shared_ptr<CachedArchive>;
+
+    /**
+     * Puts the state of an archive (back) into the cache.
+     * @param archive_id
+     * @param archive
+     */
+    void put_archive(std::string const& archive_id, std::shared_ptr<CachedArchive> archive);
+
+    /**
+     * @param archive_id
+     * @param stream_id
+     * @return The given decompressed stream of the given archive, or nullptr if it isn't cached.
+     */
+    [[nodiscard]] auto get_stream(std::string const& archive_id, size_t stream_id)
+            -> std::shared_ptr<char[]>;
+
+    /**
+     * Puts a decompressed stream into the cache. The stream must not be modified afterwards.
+     * @param archive_id
+     * @param stream_id
+     * @param stream
+     * @param stream_size
+     */
+    void put_stream(
+            std::string const& archive_id,
+            size_t stream_id,
+            std::shared_ptr<char[]> stream,
+            size_t stream_size
+    );
+
+    [[nodiscard]] auto get_capacity() const -> size_t { return m_capacity; }
+
+    /**
+     * @return The (estimated) number of bytes of data in the cache.
+     */
+    [[nodiscard]] auto get_size() const -> size_t {
+        std::lock_guard const lock{m_mutex};
+        return m_size;
+    }
+
+private:
+    // Types
+    // Archive state is keyed by the archive ID and `cArchiveStateKey`, while streams are keyed by
+    // the archive ID and the stream ID.
+    using Key = std::pair<std::string, size_t>;
+
+    struct Entry {
+        Key key;
+        size_t size{};
+        std::shared_ptr<CachedArchive> archive;
+        std::shared_ptr<char[]> stream;
+    };
+
+    // Constants
+    static constexpr size_t cArchiveStateKey{SIZE_MAX};
+
+    // Methods
+    /**
+     * Inserts an entry as the most recently used entry, replacing any existing entry with the same
+     * key and evicting entries until the cache is within its capacity. Entries larger than the
+     * capacity aren't inserted.
+     * @param entry
+     */
+    void insert(Entry entry);
+
+    /**
+     * @param archive
+     * @return The estimated number of bytes of memory used by the given archive state.
+     */
+    [[nodiscard]] static auto estimate_size(CachedArchive const& archive) -> size_t;
+
+    size_t m_capacity;
+    size_t m_size{0};
+    // Ordered from the most to the least recently used entry
+    std::list<Entry> m_entries;
+    std::map<Key, std::list<Entry>::iterator> m_key_to_entry;
+    mutable std::mutex m_mutex;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ARCHIVECACHE_HPP
@@ -1,17 +1,27 @@
 #include "ArchiveReader.hpp"
 
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "archive_constants.hpp"
+#include "ArchiveCache.hpp"
 #include "ArchiveReaderAdaptor.hpp"
 #include "InputConfig.hpp"
 #include "ReaderUtils.hpp"
+#include "SingleFileArchiveDefs.hpp"
 
 using std::string_view;
 
 namespace clp_s {
-void ArchiveReader::open(Path const& archive_path, NetworkAuthOption const& network_auth) {
+void ArchiveReader::open(
+        Path const& archive_path,
+        NetworkAuthOption const& network_auth,
+        bool use_memory_mapping
+) {
     if (m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
@@ -21,20 +31,48 @@ void ArchiveReader::open(Path const& archive_path, NetworkAuthOption const& netw
         throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
     }
 
-    m_archive_reader_adaptor = std::make_shared<ArchiveReaderAdaptor>(archive_path, network_auth);
-
-    if (auto const rc = m_archive_reader_adaptor->load_archive_metadata(); ErrorCodeSuccess != rc) {
-        throw OperationFailed(rc, __FILENAME__, __LINE__);
+    std::shared_ptr<CachedArchive> cached_archive;
+    if (nullptr != m_cache) {
+        cached_archive = m_cache->take_archive(m_archive_id);
     }
+    if (nullptr != cached_archive) {
+        m_archive_reader_adaptor = std::move(cached_archive->adaptor);
+        m_schema_tree = std::move(cached_archive->schema_tree);
+        m_schema_map = std::move(cached_archive->schema_map);
+        m_var_dict = std::move(cached_archive->var_dict);
+        m_log_dict = std::move(cached_archive->log_dict);
+        m_array_dict = std::move(cached_archive->array_dict);
+        m_var_dict_state = cached_archive->var_dict_state;
+        m_log_dict_state = cached_archive->log_dict_state;
+        m_array_dict_state = cached_archive->array_dict_state;
+    } else {
+        m_archive_reader_adaptor = std::make_shared<ArchiveReaderAdaptor>(
+                archive_path,
+                network_auth,
+                use_memory_mapping
+        );
 
-    m_schema_tree = ReaderUtils::read_schema_tree(*m_archive_reader_adaptor);
-    m_schema_map = ReaderUtils::read_schemas(*m_archive_reader_adaptor);
+        if (auto const rc = m_archive_reader_adaptor->load_archive_metadata();
+            ErrorCodeSuccess != rc)
+        {
+            throw OperationFailed(rc, __FILENAME__, __LINE__);
+        }
 
-    m_log_event_idx_column_id = m_schema_tree->get_metadata_field_id(constants::cLogEventIdxName);
+        m_schema_tree = ReaderUtils::read_schema_tree(*m_archive_reader_adaptor);
+        m_schema_map = ReaderUtils::read_schemas(*m_archive_reader_adaptor);
 
-    m_var_dict = ReaderUtils::get_variable_dictionary_reader(*m_archive_reader_adaptor);
-    m_log_dict = ReaderUtils::get_log_type_dictionary_reader(*m_archive_reader_adaptor);
-    m_array_dict = ReaderUtils::get_array_dictionary_reader(*m_archive_reader_adaptor);
+        m_var_dict = ReaderUtils::get_variable_dictionary_reader(*m_archive_reader_adaptor);
+        m_log_dict = ReaderUtils::get_log_type_dictionary_reader(*m_archive_reader_adaptor);
+        m_array_dict = ReaderUtils::get_array_dictionary_reader(*m_archive_reader_adaptor);
+        m_var_dict_state = DictionaryReadState::Unread;
+        m_log_dict_state = DictionaryReadState::Unread;
+        m_array_dict_state = DictionaryReadState::Unread;
+    }
+    m_has_encoded_integer_columns = m_archive_reader_adaptor->get_header().version
+                                    >= cEncodedIntegerColumnsArchiveVersion;
+
+    m_log_event_idx_column_id = m_schema_tree->get_metadata_field_id(constants::cLogEventIdxName);
+    m_is_cacheable = nullptr != m_cache;
 }
 
 void ArchiveReader::read_metadata() {
@@ -124,22 +162,111 @@ void ArchiveReader::read_metadata() {
             = m_stream_reader.get_uncompressed_stream_size(prev_metadata.stream_id)
               - prev_metadata.stream_offset;
     m_id_to_schema_metadata[prev_schema_id] = prev_metadata;
+
+    read_table_statistics();
     m_table_metadata_decompressor.close();
 
     m_archive_reader_adaptor->checkin_reader_for_section(constants::cArchiveTableMetadataFile);
 }
 
+void ArchiveReader::read_table_statistics() {
+    size_t num_tables;
+    if (auto error = m_table_metadata_decompressor.try_read_numeric_value(num_tables);
+        ErrorCodeSuccess != error)
+    {
+        // Archives written before column statistics were introduced don't have them
+        if (ErrorCodeEndOfFile == error) {
+            return;
+        }
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+
+    for (size_t i = 0; i < num_tables; ++i) {
+        int32_t schema_id;
+        size_t num_columns;
+        if (auto error = m_table_metadata_decompressor.try_read_numeric_value(schema_id);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+        if (auto error = m_table_metadata_decompressor.try_read_numeric_value(num_columns);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+
+        auto& statistics = m_id_to_table_statistics[schema_id];
+        for (size_t j = 0; j < num_columns; ++j) {
+            int32_t column_id;
+            if (auto error = m_table_metadata_decompressor.try_read_numeric_value(column_id);
+                ErrorCodeSuccess != error)
+            {
+                throw OperationFailed(error, __FILENAME__, __LINE__);
+            }
+            statistics[column_id].read(m_table_metadata_decompressor);
+        }
+    }
+}
+
+auto ArchiveReader::get_table_stream_id(int32_t schema_id) const -> size_t {
+    auto const it = m_id_to_schema_metadata.find(schema_id);
+    if (m_id_to_schema_metadata.end() == it) {
+        throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+    }
+    return it->second.stream_id;
+}
+
+auto ArchiveReader::get_table_statistics(int32_t schema_id) const -> TableStatistics const* {
+    auto const it = m_id_to_table_statistics.find(schema_id);
+    if (m_id_to_table_statistics.end() == it) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
 void ArchiveReader::read_dictionaries_and_metadata() {
     read_metadata();
-    m_var_dict->read_entries();
-    m_log_dict->read_entries();
-    m_array_dict->read_entries();
+    read_dictionary_entries(*m_var_dict, m_var_dict_state, false);
+    read_dictionary_entries(*m_log_dict, m_log_dict_state, false);
+    read_dictionary_entries(*m_array_dict, m_array_dict_state, false);
 }
 
 void ArchiveReader::open_packed_streams() {
     m_stream_reader.open_packed_streams(m_archive_reader_adaptor);
 }
 
+void ArchiveReader::prefetch_tables(
+        std::vector<int32_t> const& schema_ids,
+        size_t max_num_prefetched_streams
+) {
+    // Tables are packed into streams in the order of `m_schema_ids`, so consecutive tables may
+    // share a stream
+    std::vector<size_t> stream_ids;
+    std::optional<size_t> prev_stream_id;
+    for (auto schema_id : schema_ids) {
+        auto const it = m_id_to_schema_metadata.find(schema_id);
+        if (m_id_to_schema_metadata.end() == it) {
+            throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+        }
+        auto const stream_id = it->second.stream_id;
+        if (prev_stream_id == stream_id) {
+            continue;
+        }
+        prev_stream_id = stream_id;
+
+        // Cached streams don't need to be prefetched, but they're pinned so that they can't be
+        // evicted before they're read
+        if (nullptr != m_cache) {
+            if (auto stream = m_cache->get_stream(m_archive_id, stream_id); nullptr != stream) {
+                m_pinned_streams.emplace(stream_id, std::move(stream));
+                continue;
+            }
+        }
+        stream_ids.push_back(stream_id);
+    }
+    m_stream_reader.prefetch_streams(std::move(stream_ids), max_num_prefetched_streams);
+}
+
 SchemaReader& ArchiveReader::read_schema_table(
         int32_t schema_id,
         bool should_extract_timestamp,
@@ -163,6 +290,30 @@ SchemaReader& ArchiveReader::read_schema_table(
     return m_schema_reader;
 }
 
+std::shared_ptr<SchemaReader> ArchiveReader::read_detached_schema_table(
+        int32_t schema_id,
+        bool should_extract_timestamp,
+        bool should_marshal_records
+) {
+    if (m_id_to_schema_metadata.count(schema_id) == 0) {
+        throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+    }
+
+    auto schema_reader = std::make_shared<SchemaReader>();
+    initialize_schema_reader(
+            *schema_reader,
+            schema_id,
+            should_extract_timestamp,
+            should_marshal_records
+    );
+
+    auto& schema_metadata = m_id_to_schema_metadata[schema_id];
+    auto stream_buffer = read_stream(schema_metadata.stream_id, false);
+    schema_reader
+            ->load(stream_buffer, schema_metadata.stream_offset, schema_metadata.uncompressed_size);
+    return schema_reader;
+}
+
 std::vector<std::shared_ptr<SchemaReader>> ArchiveReader::read_all_tables() {
     std::vector<std::shared_ptr<SchemaReader>> readers;
     readers.reserve(m_id_to_schema_metadata.size());
@@ -186,10 +337,13 @@ BaseColumnReader* ArchiveReader::append_reader_column(SchemaReader& reader, int3
     auto const& node = m_schema_tree->get_node(column_id);
     switch (node.get_type()) {
         case NodeType::Integer:
-            column_reader = new Int64ColumnReader(column_id);
+            column_reader = new Int64ColumnReader(column_id, m_has_encoded_integer_columns);
             break;
         case NodeType::DeltaInteger:
-            column_reader = new DeltaEncodedInt64ColumnReader(column_id);
+            column_reader = new DeltaEncodedInt64ColumnReader(
+                    column_id,
+                    m_has_encoded_integer_columns
+            );
             break;
         case NodeType::Float:
             column_reader = new FloatColumnReader(column_id);
@@ -201,16 +355,31 @@ BaseColumnReader* ArchiveReader::append_reader_column(SchemaReader& reader, int3
             column_reader = new DictionaryFloatColumnReader(column_id, m_var_dict);
             break;
         case NodeType::ClpString:
-            column_reader = new ClpStringColumnReader(column_id, m_var_dict, m_log_dict);
+            column_reader = new ClpStringColumnReader(
+                    column_id,
+                    m_var_dict,
+                    m_log_dict,
+                    m_has_encoded_integer_columns
+            );
             break;
         case NodeType::VarString:
-            column_reader = new VariableStringColumnReader(column_id, m_var_dict);
+            column_reader = new VariableStringColumnReader(
+                    column_id,
+                    m_var_dict,
+                    m_has_encoded_integer_columns
+            );
             break;
         case NodeType::Boolean:
             column_reader = new BooleanColumnReader(column_id);
             break;
         case NodeType::UnstructuredArray:
-            column_reader = new ClpStringColumnReader(column_id, m_var_dict, m_array_dict, true);
+            column_reader = new ClpStringColumnReader(
+                    column_id,
+                    m_var_dict,
+                    m_array_dict,
+                    m_has_encoded_integer_columns,
+                    true
+            );
             break;
         case NodeType::DateString:
             column_reader = new DateStringColumnReader(column_id, get_timestamp_dictionary());
@@ -245,10 +414,13 @@ void ArchiveReader::append_unordered_reader_columns(
         auto const& node = m_schema_tree->get_node(column_id);
         switch (node.get_type()) {
             case NodeType::Integer:
-                column_reader = new Int64ColumnReader(column_id);
+                column_reader = new Int64ColumnReader(column_id, m_has_encoded_integer_columns);
                 break;
             case NodeType::DeltaInteger:
-                column_reader = new DeltaEncodedInt64ColumnReader(column_id);
+                column_reader = new DeltaEncodedInt64ColumnReader(
+                        column_id,
+                        m_has_encoded_integer_columns
+                );
                 break;
             case NodeType::Float:
                 column_reader = new FloatColumnReader(column_id);
@@ -260,10 +432,19 @@ void ArchiveReader::append_unordered_reader_columns(
                 column_reader = new DictionaryFloatColumnReader(column_id, m_var_dict);
                 break;
             case NodeType::ClpString:
-                column_reader = new ClpStringColumnReader(column_id, m_var_dict, m_log_dict);
+                column_reader = new ClpStringColumnReader(
+                        column_id,
+                        m_var_dict,
+                        m_log_dict,
+                        m_has_encoded_integer_columns
+                );
                 break;
             case NodeType::VarString:
-                column_reader = new VariableStringColumnReader(column_id, m_var_dict);
+                column_reader = new VariableStringColumnReader(
+                        column_id,
+                        m_var_dict,
+                        m_has_encoded_integer_columns
+                );
                 break;
             case NodeType::Boolean:
                 column_reader = new BooleanColumnReader(column_id);
@@ -297,7 +478,7 @@ void ArchiveReader::initialize_schema_reader(
         bool should_extract_timestamp,
         bool should_marshal_records
 ) {
-    auto& schema = (*m_schema_map)[schema_id];
+    auto& schema = m_schema_map->at(schema_id);
     reader.reset(
             m_schema_tree,
             m_projection,
@@ -369,19 +550,41 @@ void ArchiveReader::close() {
     }
     m_is_open = false;
 
-    m_var_dict->close();
-    m_log_dict->close();
-    m_array_dict->close();
-
     m_stream_reader.close();
+    // Only archives that were opened successfully and that can be read again without reopening
+    // them are cached
+    if (m_is_cacheable && m_archive_reader_adaptor->is_reusable()) {
+        m_cache->put_archive(
+                m_archive_id,
+                std::make_shared<CachedArchive>(CachedArchive{
+                        .adaptor = std::move(m_archive_reader_adaptor),
+                        .schema_tree = m_schema_tree,
+                        .schema_map = m_schema_map,
+                        .var_dict = m_var_dict,
+                        .log_dict = m_log_dict,
+                        .array_dict = m_array_dict,
+                        .var_dict_state = m_var_dict_state,
+                        .log_dict_state = m_log_dict_state,
+                        .array_dict_state = m_array_dict_state
+                })
+        );
+    } else {
+        m_var_dict->close();
+        m_log_dict->close();
+        m_array_dict->close();
+    }
     m_archive_reader_adaptor.reset();
+    m_pinned_streams.clear();
+    m_is_cacheable = false;
 
     m_id_to_schema_metadata.clear();
+    m_id_to_table_statistics.clear();
     m_schema_ids.clear();
     m_cur_stream_id = 0;
     m_stream_buffer.reset();
     m_stream_buffer_size = 0ULL;
     m_log_event_idx_column_id = -1;
+    m_has_encoded_integer_columns = false;
 }
 
 std::shared_ptr<char[]> ArchiveReader::read_stream(size_t stream_id, bool reuse_buffer) {
@@ -389,6 +592,10 @@ std::shared_ptr<char[]> ArchiveReader::read_stream(size_t stream_id, bool reuse_
         return m_stream_buffer;
     }
 
+    if (nullptr != m_cache) {
+        return read_cached_stream(stream_id);
+    }
+
     if (false == reuse_buffer) {
         m_stream_buffer.reset();
         m_stream_buffer_size = 0;
@@ -398,4 +605,28 @@ std::shared_ptr<char[]> ArchiveReader::read_stream(size_t stream_id, bool reuse_
     m_cur_stream_id = stream_id;
     return m_stream_buffer;
 }
+
+std::shared_ptr<char[]> ArchiveReader::read_cached_stream(size_t stream_id) {
+    // Cached streams are shared with other readers, so their buffers can never be reused
+    m_stream_buffer_size = 0;
+    if (auto const it = m_pinned_streams.find(stream_id); m_pinned_streams.end() != it) {
+        m_stream_buffer = std::move(it->second);
+        m_pinned_streams.erase(it);
+    } else {
+        m_stream_buffer = m_cache->get_stream(m_archive_id, stream_id);
+    }
+
+    if (nullptr == m_stream_buffer) {
+        m_stream_reader.read_stream(stream_id, m_stream_buffer, m_stream_buffer_size);
+        m_cache->put_stream(
+                m_archive_id,
+                stream_id,
+                m_stream_buffer,
+                m_stream_reader.get_uncompressed_stream_size(stream_id)
+        );
+        m_stream_buffer_size = 0;
+    }
+    m_cur_stream_id = stream_id;
+    return m_stream_buffer;
+}
 }  // namespace clp_s
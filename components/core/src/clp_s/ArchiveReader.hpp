@@ -2,12 +2,15 @@
 #define CLP_S_ARCHIVEREADER_HPP
 
 #include <map>
+#include <memory>
 #include <set>
 #include <span>
 #include <string_view>
 #include <utility>
 
+#include "ArchiveCache.hpp"
 #include "ArchiveReaderAdaptor.hpp"
+#include "ColumnStatistics.hpp"
 #include "DictionaryReader.hpp"
 #include "InputConfig.hpp"
 #include "PackedStreamReader.hpp"
@@ -30,11 +33,25 @@ public:
     ArchiveReader() : m_is_open(false) {}
 
     /**
-     * Opens an archive for reading.
+     * Sets the cache used to reuse the dictionaries, schema trees and decompressed streams of
+     * archives across multiple times they're opened. Must be called while no archive is open.
+     * @param cache the cache, or nullptr to stop caching
+     */
+    void set_cache(std::shared_ptr<ArchiveCache> cache) { m_cache = std::move(cache); }
+
+    /**
+     * Opens an archive for reading. If the archive's state is cached, it's reused instead of
+     * being read again.
      * @param archive_path
      * @param network_auth
+     * @param use_memory_mapping Whether to memory map the archive if it's on the local file system.
+     * Has no effect if the archive's state is cached.
      */
-    void open(Path const& archive_path, NetworkAuthOption const& network_auth);
+    void open(
+            Path const& archive_path,
+            NetworkAuthOption const& network_auth,
+            bool use_memory_mapping = true
+    );
 
     /**
      * Reads the dictionaries and metadata.
@@ -52,7 +69,7 @@ public:
      * @return the variable dictionary reader
      */
     std::shared_ptr<VariableDictionaryReader> read_variable_dictionary(bool lazy = false) {
-        m_var_dict->read_entries(lazy);
+        read_dictionary_entries(*m_var_dict, m_var_dict_state, lazy);
         return m_var_dict;
     }
 
@@ -62,7 +79,7 @@ public:
      * @return the log type dictionary reader
      */
     std::shared_ptr<LogTypeDictionaryReader> read_log_type_dictionary(bool lazy = false) {
-        m_log_dict->read_entries(lazy);
+        read_dictionary_entries(*m_log_dict, m_log_dict_state, lazy);
         return m_log_dict;
     }
 
@@ -72,7 +89,7 @@ public:
      * @return the array dictionary reader
      */
     std::shared_ptr<LogTypeDictionaryReader> read_array_dictionary(bool lazy = false) {
-        m_array_dict->read_entries(lazy);
+        read_dictionary_entries(*m_array_dict, m_array_dict_state, lazy);
         return m_array_dict;
     }
 
@@ -81,6 +98,17 @@ public:
      */
     void read_metadata();
 
+    /**
+     * Starts reading and decompressing the streams containing the given tables in the background,
+     * so that reading each table overlaps with processing the previous ones. Must be called after
+     * `open_packed_streams` and before any tables are read. Afterwards, only the given tables can
+     * be read, though any of them may be skipped.
+     * @param schema_ids the IDs of the tables that will be read, in the order returned by
+     * `get_schema_ids` except that tables in the same stream may be in any order
+     * @param max_num_prefetched_streams the maximum number of decompressed streams to buffer
+     */
+    void prefetch_tables(std::vector<int32_t> const& schema_ids, size_t max_num_prefetched_streams);
+
     /**
      * Reads a table from the archive.
      * @param schema_id
@@ -94,6 +122,22 @@ public:
             bool should_marshal_records
     );
 
+    /**
+     * Reads a table from the archive into a newly created schema reader. Unlike
+     * `read_schema_table`, the returned reader owns its column data, so it remains valid after
+     * subsequent tables are read and can be used on a different thread than the one reading the
+     * archive.
+     * @param schema_id
+     * @param should_extract_timestamp
+     * @param should_marshal_records
+     * @return the schema reader
+     */
+    std::shared_ptr<SchemaReader> read_detached_schema_table(
+            int32_t schema_id,
+            bool should_extract_timestamp,
+            bool should_marshal_records
+    );
+
     /**
      * Loads all of the tables in the archive and returns SchemaReaders for them.
      * @return the schema readers for every table in the archive
@@ -127,7 +171,7 @@ public:
     void store(FileWriter& writer);
 
     /**
-     * Closes the archive.
+     * Closes the archive. If a cache is set, the archive's state is put into the cache.
      */
     void close();
 
@@ -137,6 +181,20 @@ public:
      */
     [[nodiscard]] std::vector<int32_t> const& get_schema_ids() const { return m_schema_ids; }
 
+    /**
+     * @param schema_id
+     * @return The ID of the stream containing the given table.
+     * @throw OperationFailed if the table doesn't exist.
+     */
+    [[nodiscard]] auto get_table_stream_id(int32_t schema_id) const -> size_t;
+
+    /**
+     * @param schema_id
+     * @return The column statistics of the given table, or nullptr if the archive doesn't have
+     * statistics for it.
+     */
+    [[nodiscard]] auto get_table_statistics(int32_t schema_id) const -> TableStatistics const*;
+
     void set_projection(std::shared_ptr<search::Projection> projection) {
         m_projection = projection;
     }
@@ -146,7 +204,42 @@ public:
      */
     bool has_log_order() { return m_log_event_idx_column_id >= 0; }
 
+    [[nodiscard]] auto is_open() const -> bool { return m_is_open; }
+
 private:
+    /**
+     * Reads the entries of a dictionary, unless they were already read at least as eagerly (e.g.,
+     * by a previous search of a cached archive).
+     * @tparam DictionaryReaderType
+     * @param dictionary
+     * @param state the state of the dictionary, which is updated
+     * @param lazy
+     */
+    template <typename DictionaryReaderType>
+    static void read_dictionary_entries(
+            DictionaryReaderType& dictionary,
+            DictionaryReadState& state,
+            bool lazy
+    ) {
+        if (DictionaryReadState::Read == state || (lazy && DictionaryReadState::Unread != state)) {
+            return;
+        }
+        dictionary.read_entries(lazy);
+        state = lazy ? DictionaryReadState::ReadLazily : DictionaryReadState::Read;
+    }
+
+    /**
+     * Reads a stream through the cache, decompressing and caching it if it isn't cached yet.
+     * @param stream_id
+     * @return a buffer containing the decompressed stream, which must not be modified
+     */
+    std::shared_ptr<char[]> read_cached_stream(size_t stream_id);
+
+    /**
+     * Reads the column statistics at the end of the table metadata, if the archive has them.
+     */
+    void read_table_statistics();
+
     /**
      * Initializes a schema reader passed by reference to become a reader for a given schema.
      * @param reader
@@ -201,12 +294,23 @@ private:
     std::shared_ptr<VariableDictionaryReader> m_var_dict;
     std::shared_ptr<LogTypeDictionaryReader> m_log_dict;
     std::shared_ptr<LogTypeDictionaryReader> m_array_dict;
+    DictionaryReadState m_var_dict_state{DictionaryReadState::Unread};
+    DictionaryReadState m_log_dict_state{DictionaryReadState::Unread};
+    DictionaryReadState m_array_dict_state{DictionaryReadState::Unread};
     std::shared_ptr<ArchiveReaderAdaptor> m_archive_reader_adaptor;
+    std::shared_ptr<ArchiveCache> m_cache;
+    bool m_is_cacheable{false};
+    // Cached streams that will be read after prefetching, held so that they can't be evicted
+    std::map<size_t, std::shared_ptr<char[]>> m_pinned_streams;
 
     std::shared_ptr<SchemaTree> m_schema_tree;
     std::shared_ptr<ReaderUtils::SchemaMap> m_schema_map;
     std::vector<int32_t> m_schema_ids;
     std::map<int32_t, SchemaReader::SchemaMetadata> m_id_to_schema_metadata;
+    std::map<int32_t, TableStatistics> m_id_to_table_statistics;
+    // Whether integer columns were stored by `IntegerColumnEncoder`, which depends on the version
+    // of the archive
+    bool m_has_encoded_integer_columns{false};
     std::shared_ptr<search::Projection> m_projection{
             std::make_shared<search::Projection>(search::ProjectionMode::ReturnAllColumns)
     };
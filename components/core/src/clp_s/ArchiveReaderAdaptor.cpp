@@ -1,9 +1,12 @@
 #include "ArchiveReaderAdaptor.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <exception>
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -14,7 +17,9 @@
 #include <spdlog/spdlog.h>
 
 #include "../clp/BoundedReader.hpp"
+#include "../clp/BufferReader.hpp"
 #include "../clp/FileReader.hpp"
+#include "../clp/ReadOnlyMemoryMappedFile.hpp"
 #include "archive_constants.hpp"
 #include "InputConfig.hpp"
 #include "RangeIndexWriter.hpp"
@@ -23,11 +28,15 @@
 namespace clp_s {
 ArchiveReaderAdaptor::ArchiveReaderAdaptor(
         Path const& archive_path,
-        NetworkAuthOption const& network_auth
+        NetworkAuthOption const& network_auth,
+        bool use_memory_mapping
 )
         : m_archive_path{archive_path},
           m_network_auth{network_auth},
           m_single_file_archive{false},
+          m_use_memory_mapping{
+                  use_memory_mapping && InputSource::Filesystem == archive_path.source
+          },
           m_timestamp_dictionary{std::make_shared<TimestampDictionaryReader>()} {
     if (InputSource::Filesystem != archive_path.source
         || std::filesystem::is_regular_file(archive_path.path))
@@ -250,6 +259,22 @@ ErrorCode ArchiveReaderAdaptor::try_read_archive_metadata(ZstdDecompressor& deco
 }
 
 std::shared_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::try_create_reader_at_header() {
+    if (InputSource::Filesystem == m_archive_path.source) {
+        auto const header_path{
+                m_single_file_archive ? m_archive_path.path
+                                      : m_archive_path.path + constants::cArchiveHeaderFile
+        };
+        if (auto const mapped_header = try_get_mapped_file(header_path); mapped_header.has_value())
+        {
+            return std::make_shared<clp::BufferReader>(
+                    mapped_header->data(),
+                    mapped_header->size()
+            );
+        }
+        // Read the rest of the archive the same way as its header
+        m_use_memory_mapping = false;
+    }
+
     if (InputSource::Filesystem == m_archive_path.source && false == m_single_file_archive) {
         try {
             return std::make_shared<clp::FileReader>(
@@ -272,6 +297,9 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
     }
 
     m_current_reader_holder.emplace(section);
+    if (auto const mapped_section = get_mapped_section(section); mapped_section.has_value()) {
+        return std::make_unique<clp::BufferReader>(mapped_section->data(), mapped_section->size());
+    }
     if (m_single_file_archive) {
         return checkout_reader_for_sfa_section(section);
     } else {
@@ -279,29 +307,73 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
     }
 }
 
-std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_sfa_section(
-        std::string_view section
-) {
+auto ArchiveReaderAdaptor::get_mapped_section(std::string_view section)
+        -> std::optional<std::span<char const>> {
+    if (false == m_single_file_archive) {
+        return try_get_mapped_file(m_archive_path.path + std::string{section});
+    }
+
+    auto const mapped_archive = try_get_mapped_file(m_archive_path.path);
+    if (false == mapped_archive.has_value()) {
+        return std::nullopt;
+    }
+    auto const [file_offset, next_file_offset] = get_sfa_section_bounds(section);
+    if (file_offset > next_file_offset || next_file_offset > mapped_archive->size()) {
+        throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+    }
+    return mapped_archive->subspan(file_offset, next_file_offset - file_offset);
+}
+
+auto ArchiveReaderAdaptor::try_get_mapped_file(std::string const& path)
+        -> std::optional<std::span<char const>> {
+    if (false == m_use_memory_mapping) {
+        return std::nullopt;
+    }
+
+    auto it = m_mapped_files.find(path);
+    if (m_mapped_files.end() == it) {
+        try {
+            it = m_mapped_files
+                         .emplace(path, std::make_unique<clp::ReadOnlyMemoryMappedFile>(path))
+                         .first;
+        } catch (std::exception const& e) {
+            SPDLOG_WARN("Failed to memory map {}, falling back to reading it - {}", path, e.what());
+            return std::nullopt;
+        }
+    }
+    auto const view{it->second->get_view()};
+    return std::span<char const>{view.data(), view.size()};
+}
+
+auto ArchiveReaderAdaptor::get_sfa_section_bounds(std::string_view section) const
+        -> std::pair<size_t, size_t> {
     auto it = std::find_if(
             m_archive_file_info.files.begin(),
             m_archive_file_info.files.end(),
-            [&](ArchiveFileInfo& info) { return info.n == section; }
+            [&](ArchiveFileInfo const& info) { return info.n == section; }
     );
     if (m_archive_file_info.files.end() == it) {
         throw OperationFailed(ErrorCodeBadParam, __FILENAME__, __LINE__);
     }
 
-    size_t curr_pos{};
-    if (auto rc = m_reader->try_get_pos(curr_pos); clp::ErrorCode::ErrorCode_Success != rc) {
-        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
-    }
-
-    size_t file_offset = m_files_section_offset + it->o;
+    size_t const file_offset = m_files_section_offset + it->o;
     ++it;
     size_t next_file_offset{m_archive_header.compressed_size};
     if (m_archive_file_info.files.end() != it) {
         next_file_offset = m_files_section_offset + it->o;
     }
+    return {file_offset, next_file_offset};
+}
+
+std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_sfa_section(
+        std::string_view section
+) {
+    auto const [file_offset, next_file_offset] = get_sfa_section_bounds(section);
+
+    size_t curr_pos{};
+    if (auto rc = m_reader->try_get_pos(curr_pos); clp::ErrorCode::ErrorCode_Success != rc) {
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
 
     if (curr_pos > file_offset) {
         throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
@@ -318,6 +390,14 @@ std::unique_ptr<clp::ReaderInterface> ArchiveReaderAdaptor::checkout_reader_for_
     return std::make_unique<clp::BoundedReader>(m_reader.get(), next_file_offset);
 }
 
+auto ArchiveReaderAdaptor::has_section(std::string_view section) const -> bool {
+    return std::any_of(
+            m_archive_file_info.files.begin(),
+            m_archive_file_info.files.end(),
+            [&](ArchiveFileInfo const& info) { return info.n == section; }
+    );
+}
+
 void ArchiveReaderAdaptor::checkin_reader_for_section(std::string_view section) {
     if (false == m_current_reader_holder.has_value()) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
@@ -2,8 +2,11 @@
 #define CLP_S_ARCHIVEREADERADAPTOR_HPP
 
 #include <cstddef>
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -18,6 +21,7 @@
 
 #include "../clp/BoundedReader.hpp"
 #include "../clp/ReaderInterface.hpp"
+#include "../clp/ReadOnlyMemoryMappedFile.hpp"
 #include "InputConfig.hpp"
 #include "SingleFileArchiveDefs.hpp"
 #include "TimestampDictionaryReader.hpp"
@@ -43,6 +47,10 @@ struct RangeIndexEntry {
 /**
  * ArchiveReaderAdaptor is an adaptor class which helps with reading single and multi-file archives
  * which exist on either S3 or a locally mounted file system.
+ *
+ * Archives on a locally mounted file system are memory mapped, so that sections can be read (and
+ * decompressed) directly from the mapping rather than being copied through intermediate buffers.
+ * If an archive can't be mapped, it's read through regular file readers instead.
  */
 class ArchiveReaderAdaptor {
 public:
@@ -53,7 +61,16 @@ public:
                 : TraceableException(error_code, filename, line_number) {}
     };
 
-    explicit ArchiveReaderAdaptor(Path const& archive_path, NetworkAuthOption const& network_auth);
+    /**
+     * @param archive_path
+     * @param network_auth
+     * @param use_memory_mapping Whether to memory map the archive if it's on the local file system.
+     */
+    explicit ArchiveReaderAdaptor(
+            Path const& archive_path,
+            NetworkAuthOption const& network_auth,
+            bool use_memory_mapping = true
+    );
 
     /**
      * Loads metadata for an archive including the header and metadata section. This method must be
@@ -81,12 +98,39 @@ public:
      */
     void checkin_reader_for_section(std::string_view section);
 
+    /**
+     * Gets a view of a given section of the archive, if the archive is memory mapped. Unlike
+     * `checkout_reader_for_section`, this doesn't check out the section, so it can be used to
+     * access a section that's already checked out. The view remains valid for the lifetime of the
+     * adaptor.
+     * @param section
+     * @return A view of the section, or std::nullopt if the section isn't memory mapped.
+     * @throw OperationFailed if the requested section does not exist in a single file archive, or
+     *        lies outside of the archive.
+     */
+    [[nodiscard]] auto get_mapped_section(std::string_view section)
+            -> std::optional<std::span<char const>>;
+
+    /**
+     * @param section
+     * @return Whether the archive contains the given section.
+     */
+    [[nodiscard]] auto has_section(std::string_view section) const -> bool;
+
     std::shared_ptr<TimestampDictionaryReader> get_timestamp_dictionary() {
         return m_timestamp_dictionary;
     }
 
     ArchiveHeader const& get_header() const { return m_archive_header; }
 
+    /**
+     * @return Whether the adaptor can be used to read the archive again after it has been read,
+     * i.e., whether the archive is memory mapped and no section is checked out.
+     */
+    [[nodiscard]] auto is_reusable() const -> bool {
+        return m_use_memory_mapping && false == m_current_reader_holder.has_value();
+    }
+
     std::vector<RangeIndexEntry> const& get_range_index() const { return m_range_index; }
 
 private:
@@ -140,6 +184,23 @@ private:
      */
     std::shared_ptr<clp::ReaderInterface> try_create_reader_at_header();
 
+    /**
+     * Tries to memory map a file of the archive, reusing any existing mapping of the file.
+     * @param path
+     * @return A view of the mapped file, or std::nullopt if the archive isn't being memory mapped
+     * or the file couldn't be mapped.
+     */
+    auto try_get_mapped_file(std::string const& path) -> std::optional<std::span<char const>>;
+
+    /**
+     * @param section
+     * @return The offsets of the beginning and end of the given section of the single file
+     * archive.
+     * @throw OperationFailed if the requested section does not exist in ArchiveFileInfo.
+     */
+    [[nodiscard]] auto get_sfa_section_bounds(std::string_view section) const
+            -> std::pair<size_t, size_t>;
+
     /**
      * Checks out a reader for a given section of the single file archive.
      * @param section
@@ -168,6 +229,9 @@ private:
     Path m_archive_path{};
     NetworkAuthOption m_network_auth{};
     bool m_single_file_archive{false};
+    bool m_use_memory_mapping{false};
+    std::map<std::string, std::unique_ptr<clp::ReadOnlyMemoryMappedFile>, std::less<>>
+            m_mapped_files;
     ArchiveFileInfoPacket m_archive_file_info{};
     ArchiveHeader m_archive_header{};
     ArchiveInfoPacket m_archive_info{};
@@ -1,13 +1,19 @@
 #include "ArchiveWriter.hpp"
 
 #include <algorithm>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <memory>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
 #include "archive_constants.hpp"
+#include "ColumnStatistics.hpp"
 #include "Defs.hpp"
 #include "SchemaTree.hpp"
 
@@ -17,7 +23,9 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
     m_compression_level = option.compression_level;
     m_print_archive_stats = option.print_archive_stats;
     m_single_file_archive = option.single_file_archive;
+    m_index_variable_dictionary = option.index_variable_dictionary;
     m_min_table_size = option.min_table_size;
+    m_num_threads = option.num_threads;
     m_archives_dir = option.archives_dir;
     m_authoritative_timestamp = option.authoritative_timestamp;
     m_authoritative_timestamp_namespace = option.authoritative_timestamp_namespace;
@@ -63,6 +71,11 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
             throw OperationFailed(rc, __FILENAME__, __LINE__);
         }
     }
+    size_t var_dict_index_compressed_size{0};
+    if (m_index_variable_dictionary) {
+        var_dict_index_compressed_size
+                = m_var_dict->write_index(m_archive_path + constants::cArchiveVarDictIndexFile);
+    }
     auto var_dict_compressed_size = m_var_dict->close();
     auto log_dict_compressed_size = m_log_dict->close();
     auto array_dict_compressed_size = m_array_dict->close();
@@ -76,9 +89,14 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
             {constants::cArchiveTableMetadataFile, table_metadata_compressed_size},
             {constants::cArchiveVarDictFile, var_dict_compressed_size},
             {constants::cArchiveLogDictFile, log_dict_compressed_size},
-            {constants::cArchiveArrayDictFile, array_dict_compressed_size},
-            {constants::cArchiveTablesFile, table_compressed_size}
+            {constants::cArchiveArrayDictFile, array_dict_compressed_size}
     };
+    // The index is placed after every dictionary since it's read lazily, on the first wildcard
+    // search of the variable dictionary, and sections of an archive can only be read in order.
+    if (m_index_variable_dictionary) {
+        files.push_back({constants::cArchiveVarDictIndexFile, var_dict_index_compressed_size});
+    }
+    files.push_back({constants::cArchiveTablesFile, table_compressed_size});
     uint64_t offset = 0;
     for (auto& file : files) {
         uint64_t original_size = file.o;
@@ -99,8 +117,9 @@ auto ArchiveWriter::close(bool is_split) -> ArchiveStats {
         size_t metadata_size = header_and_metadata_writer.get_pos() - sizeof(ArchiveHeader);
 
         m_compressed_size
-                = var_dict_compressed_size + log_dict_compressed_size + array_dict_compressed_size
-                  + metadata_size + schema_tree_compressed_size + schema_map_compressed_size
+                = var_dict_compressed_size + var_dict_index_compressed_size
+                  + log_dict_compressed_size + array_dict_compressed_size + metadata_size
+                  + schema_tree_compressed_size + schema_map_compressed_size
                   + table_metadata_compressed_size + table_compressed_size + sizeof(ArchiveHeader);
 
         write_archive_header(header_and_metadata_writer, metadata_size);
@@ -255,16 +274,22 @@ void ArchiveWriter::write_archive_header(FileWriter& archive_writer, size_t meta
 
 void
 ArchiveWriter::append_message(int32_t schema_id, Schema const& schema, ParsedMessage& message) {
-    SchemaWriter* schema_writer;
+    append_message(get_or_create_schema_writer(schema_id, schema), message);
+}
+
+SchemaWriter* ArchiveWriter::get_or_create_schema_writer(int32_t schema_id, Schema const& schema) {
     auto it = m_id_to_schema_writer.find(schema_id);
     if (it != m_id_to_schema_writer.end()) {
-        schema_writer = it->second;
-    } else {
-        schema_writer = new SchemaWriter();
-        initialize_schema_writer(schema_writer, schema);
-        m_id_to_schema_writer[schema_id] = schema_writer;
+        return it->second;
     }
 
+    auto* schema_writer = new SchemaWriter();
+    initialize_schema_writer(schema_writer, schema);
+    m_id_to_schema_writer[schema_id] = schema_writer;
+    return schema_writer;
+}
+
+void ArchiveWriter::append_message(SchemaWriter* schema_writer, ParsedMessage& message) {
     m_encoded_message_size += schema_writer->append_message(message);
     ++m_next_log_event_id;
 }
@@ -392,6 +417,19 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
      *     - Schema ID: <32-bit integer>
      *     - Number of messages: <64-bit integer>
      *
+     * Section 3: Column Statistics
+     * - Contains statistics (e.g., value ranges) about the columns of each schema table, which
+     *   allow searches to skip tables that can't match a query. Archives written before this
+     *   section was introduced end after Section 2.
+     * - Structure:
+     *   - Number of schema tables with column statistics: <64-bit integer>
+     *   - For each schema table:
+     *     - Schema ID: <32-bit integer>
+     *     - Number of columns with statistics: <64-bit integer>
+     *     - For each column:
+     *       - Column ID: <32-bit integer>
+     *       - Statistics: see `ColumnStatistics::write`
+     *
      * We buffer the first half of the metadata in the "stream_metadata" vector, and the second half
      * of the metadata in the "schema_metadata" vector as we compress the tables. The metadata is
      * flushed once all of the schema tables have been compressed.
@@ -404,6 +442,9 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
     schema_metadata.reserve(m_id_to_schema_writer.size());
     schemas.reserve(m_id_to_schema_writer.size());
     for (auto it = m_id_to_schema_writer.begin(); it != m_id_to_schema_writer.end(); ++it) {
+        // Encoding the columns determines the final size of each table, which is needed to lay
+        // out the packed streams
+        it->second->finalize();
         schemas.push_back(it);
     }
     auto comp = [](schema_map_it const& lhs, schema_map_it const& rhs) -> bool {
@@ -412,34 +453,47 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
     };
     std::sort(schemas.begin(), schemas.end(), comp);
 
+    // Assign the tables to packed streams up front. The layout of each stream only depends on the
+    // uncompressed size of its tables, so the streams can then be compressed independently.
+    std::vector<std::vector<SchemaWriter*>> packed_streams;
     uint64_t current_stream_offset = 0;
-    uint64_t current_stream_id = 0;
-    uint64_t current_table_file_offset = 0;
-    m_tables_compressor.open(m_tables_file_writer, m_compression_level);
     for (auto it : schemas) {
-        it->second->store(m_tables_compressor);
+        if (stream_metadata.size() == packed_streams.size()) {
+            packed_streams.emplace_back();
+        }
+        packed_streams.back().push_back(it->second);
         schema_metadata.emplace_back(
-                current_stream_id,
+                stream_metadata.size(),
                 current_stream_offset,
                 it->first,
                 it->second->get_num_messages()
         );
         current_stream_offset += it->second->get_total_uncompressed_size();
-        delete it->second;
 
         if (current_stream_offset > m_min_table_size || schemas.size() == schema_metadata.size()) {
-            stream_metadata.emplace_back(current_table_file_offset, current_stream_offset);
-            m_tables_compressor.close();
+            // The file offset is set once the stream has been compressed.
+            stream_metadata.emplace_back(0, current_stream_offset);
             current_stream_offset = 0;
-            ++current_stream_id;
-            current_table_file_offset = m_tables_file_writer.get_pos();
+        }
+    }
 
-            if (schemas.size() != schema_metadata.size()) {
-                m_tables_compressor.open(m_tables_file_writer, m_compression_level);
-            }
+    // Storing the tables frees their writers, so their statistics must be collected first
+    std::vector<std::pair<int32_t, TableStatistics>> table_statistics;
+    table_statistics.reserve(schemas.size());
+    for (auto it : schemas) {
+        TableStatistics statistics;
+        it->second->collect_statistics(statistics);
+        if (false == statistics.empty()) {
+            table_statistics.emplace_back(it->first, std::move(statistics));
         }
     }
 
+    if (m_num_threads > 1 && packed_streams.size() > 1) {
+        store_packed_streams_in_parallel(packed_streams, stream_metadata);
+    } else {
+        store_packed_streams(packed_streams, stream_metadata);
+    }
+
     m_table_metadata_compressor.write_numeric_value(stream_metadata.size());
     for (auto& stream : stream_metadata) {
         m_table_metadata_compressor.write_numeric_value(stream.file_offset);
@@ -458,6 +512,16 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
         m_table_metadata_compressor.write_numeric_value(schema.schema_id);
         m_table_metadata_compressor.write_numeric_value(schema.num_messages);
     }
+
+    m_table_metadata_compressor.write_numeric_value(table_statistics.size());
+    for (auto& [schema_id, statistics] : table_statistics) {
+        m_table_metadata_compressor.write_numeric_value(schema_id);
+        m_table_metadata_compressor.write_numeric_value(statistics.size());
+        for (auto& [column_id, column_statistics] : statistics) {
+            m_table_metadata_compressor.write_numeric_value(column_id);
+            column_statistics.write(m_table_metadata_compressor);
+        }
+    }
     m_table_metadata_compressor.close();
 
     auto table_metadata_compressed_size = m_table_metadata_file_writer.get_pos();
@@ -468,4 +532,106 @@ std::pair<size_t, size_t> ArchiveWriter::store_tables() {
 
     return {table_metadata_compressed_size, table_compressed_size};
 }
+
+void ArchiveWriter::store_packed_streams(
+        std::vector<std::vector<SchemaWriter*>> const& packed_streams,
+        std::vector<StreamMetadata>& stream_metadata
+) {
+    for (size_t i = 0; i < packed_streams.size(); ++i) {
+        stream_metadata[i].file_offset = m_tables_file_writer.get_pos();
+        m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+        for (auto* schema_writer : packed_streams[i]) {
+            schema_writer->store(m_tables_compressor);
+            delete schema_writer;
+        }
+        m_tables_compressor.close();
+    }
+}
+
+void ArchiveWriter::store_packed_streams_in_parallel(
+        std::vector<std::vector<SchemaWriter*>> const& packed_streams,
+        std::vector<StreamMetadata>& stream_metadata
+) {
+    auto const num_workers{std::min(m_num_threads, packed_streams.size())};
+    clp::BoundedBlockingQueue<std::shared_ptr<PackedStreamCompressionTask>> task_queue{
+            num_workers
+    };
+    std::vector<std::unique_ptr<PackedStreamCompressor>> workers;
+    workers.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back(
+                std::make_unique<PackedStreamCompressor>(task_queue, m_compression_level)
+        );
+        workers.back()->start();
+    }
+
+    // Streams must be written in order, so keep the tasks that are in flight in a FIFO and write
+    // each one as soon as it (and every stream before it) has been compressed. Limiting the number
+    // of tasks in flight bounds the amount of compressed data buffered in memory.
+    size_t const max_num_tasks_in_flight{2 * num_workers};
+    std::deque<std::shared_ptr<PackedStreamCompressionTask>> tasks_in_flight;
+    size_t num_streams_written{0};
+    auto write_oldest_stream = [&]() {
+        auto task = std::move(tasks_in_flight.front());
+        tasks_in_flight.pop_front();
+        task->compressed.get_future().get();
+        stream_metadata[num_streams_written].file_offset = m_tables_file_writer.get_pos();
+        m_tables_file_writer.write(task->compressed_stream.data(), task->compressed_stream.size());
+        ++num_streams_written;
+    };
+
+    try {
+        for (auto const& packed_stream : packed_streams) {
+            if (tasks_in_flight.size() >= max_num_tasks_in_flight) {
+                write_oldest_stream();
+            }
+            auto task = std::make_shared<PackedStreamCompressionTask>();
+            task->tables = &packed_stream;
+            tasks_in_flight.push_back(task);
+            if (false == task_queue.push(std::move(task))) {
+                throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+            }
+        }
+        while (false == tasks_in_flight.empty()) {
+            write_oldest_stream();
+        }
+    } catch (...) {
+        task_queue.close();
+        for (auto& worker : workers) {
+            worker->join();
+        }
+        throw;
+    }
+
+    task_queue.close();
+    for (auto& worker : workers) {
+        worker->join();
+    }
+}
+
+ArchiveWriter::PackedStreamCompressor::PackedStreamCompressor(
+        clp::BoundedBlockingQueue<std::shared_ptr<PackedStreamCompressionTask>>& task_queue,
+        int compression_level
+)
+        : m_task_queue{task_queue},
+          m_compression_level{compression_level} {}
+
+void ArchiveWriter::PackedStreamCompressor::thread_method() {
+    while (auto task = m_task_queue.pop()) {
+        auto& compression_task = *task.value();
+        try {
+            m_compressor.open(compression_task.compressed_stream, m_compression_level);
+            for (auto* schema_writer : *compression_task.tables) {
+                schema_writer->store(m_compressor);
+                delete schema_writer;
+            }
+            m_compressor.close();
+            compression_task.compressed.set_value();
+        } catch (...) {
+            // Keep going so that every queued task is completed and the writing thread can't block
+            // forever waiting on one.
+            compression_task.compressed.set_exception(std::current_exception());
+        }
+    }
+}
 }  // namespace clp_s
@@ -1,16 +1,22 @@
 #ifndef CLP_S_ARCHIVEWRITER_HPP
 #define CLP_S_ARCHIVEWRITER_HPP
 
+#include <cstddef>
+#include <future>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <nlohmann/json.hpp>
 
+#include "../clp/BoundedBlockingQueue.hpp"
 #include "../clp/streaming_archive/Constants.hpp"
+#include "../clp/Thread.hpp"
 #include "archive_constants.hpp"
 #include "DictionaryWriter.hpp"
 #include "RangeIndexWriter.hpp"
@@ -28,7 +34,9 @@ struct ArchiveWriterOption {
     int compression_level;
     bool print_archive_stats;
     bool single_file_archive;
+    bool index_variable_dictionary{false};
     size_t min_table_size;
+    size_t num_threads{1};
     std::vector<std::string> authoritative_timestamp;
     std::string authoritative_timestamp_namespace;
 };
@@ -160,6 +168,26 @@ public:
      */
     void append_message(int32_t schema_id, Schema const& schema, ParsedMessage& message);
 
+    /**
+     * Gets the writer for a schema's table, creating the table if it doesn't exist yet.
+     *
+     * Together with `append_message(SchemaWriter*, ParsedMessage&)`, this allows a message to be
+     * appended in two steps. The first step only accesses the schema tree and the set of tables,
+     * while the second only accesses the table and the dictionaries, so the two steps can run on
+     * different threads as long as each step is only ever run on one thread at a time.
+     * @param schema_id
+     * @param schema
+     * @return the schema writer
+     */
+    SchemaWriter* get_or_create_schema_writer(int32_t schema_id, Schema const& schema);
+
+    /**
+     * Appends a message to a table returned by `get_or_create_schema_writer`
+     * @param schema_writer
+     * @param message
+     */
+    void append_message(SchemaWriter* schema_writer, ParsedMessage& message);
+
     /**
      * Adds a node to the schema tree and attempts to resolve the node against the authoritative
      * timestamp key.
@@ -270,6 +298,37 @@ public:
     }
 
 private:
+    /**
+     * A packed stream to be compressed into memory by a `PackedStreamCompressor`.
+     */
+    struct PackedStreamCompressionTask {
+        std::vector<SchemaWriter*> const* tables{};
+        std::string compressed_stream;
+        std::promise<void> compressed;
+    };
+
+    /**
+     * A worker thread which compresses packed streams taken from a shared queue until the queue is
+     * drained.
+     */
+    class PackedStreamCompressor : public clp::Thread {
+    public:
+        // Constructor
+        PackedStreamCompressor(
+                clp::BoundedBlockingQueue<std::shared_ptr<PackedStreamCompressionTask>>&
+                        task_queue,
+                int compression_level
+        );
+
+    private:
+        // Methods implementing `clp::Thread`
+        void thread_method() override;
+
+        clp::BoundedBlockingQueue<std::shared_ptr<PackedStreamCompressionTask>>& m_task_queue;
+        int m_compression_level;
+        ZstdCompressor m_compressor;
+    };
+
     /**
      * Initializes the schema writer
      * @param writer
@@ -285,6 +344,31 @@ private:
      */
     [[nodiscard]] std::pair<size_t, size_t> store_tables();
 
+    /**
+     * Compresses each packed stream on the calling thread and writes it to the tables file.
+     * @param packed_streams The tables in each packed stream. Every table is deleted once stored.
+     * @param stream_metadata The metadata for each packed stream, which is updated with the offset
+     * of the stream in the tables file.
+     */
+    void store_packed_streams(
+            std::vector<std::vector<SchemaWriter*>> const& packed_streams,
+            std::vector<StreamMetadata>& stream_metadata
+    );
+
+    /**
+     * Compresses the packed streams concurrently using up to `m_num_threads` threads and writes
+     * them to the tables file in order, producing the same layout as `store_packed_streams`.
+     * @param packed_streams The tables in each packed stream. Every table is deleted once stored.
+     * @param stream_metadata The metadata for each packed stream, which is updated with the offset
+     * of the stream in the tables file.
+     * @throw ArchiveWriter::OperationFailed or the exception raised while compressing a stream on
+     * failure
+     */
+    void store_packed_streams_in_parallel(
+            std::vector<std::vector<SchemaWriter*>> const& packed_streams,
+            std::vector<StreamMetadata>& stream_metadata
+    );
+
     /**
      * Writes the archive to a single file
      * @param files
@@ -337,7 +421,9 @@ private:
     int m_compression_level{};
     bool m_print_archive_stats{};
     bool m_single_file_archive{};
+    bool m_index_variable_dictionary{};
     size_t m_min_table_size{};
+    size_t m_num_threads{1};
 
     std::vector<std::string> m_authoritative_timestamp;
     std::string m_authoritative_timestamp_namespace;
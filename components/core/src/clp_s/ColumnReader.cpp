@@ -4,16 +4,22 @@
 #include <cstdint>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "../clp/EncodedVariableInterpreter.hpp"
 #include "BufferViewReader.hpp"
 #include "ColumnWriter.hpp"
 #include "FloatFormatEncoding.hpp"
+#include "IntegerColumnEncoding.hpp"
 #include "Utils.hpp"
 
 namespace clp_s {
 void Int64ColumnReader::load(BufferViewReader& reader, uint64_t num_messages) {
-    m_values = reader.read_unaligned_span<int64_t>(num_messages);
+    if (m_is_encoded) {
+        m_values.read(reader, num_messages);
+    } else {
+        m_values.read_unencoded(reader, num_messages);
+    }
 }
 
 std::variant<int64_t, double, std::string, uint8_t> Int64ColumnReader::extract_value(
@@ -23,7 +29,11 @@ std::variant<int64_t, double, std::string, uint8_t> Int64ColumnReader::extract_v
 }
 
 void DeltaEncodedInt64ColumnReader::load(BufferViewReader& reader, uint64_t num_messages) {
-    m_values = reader.read_unaligned_span<int64_t>(num_messages);
+    if (m_is_encoded) {
+        m_values.read(reader, num_messages);
+    } else {
+        m_values.read_unencoded(reader, num_messages);
+    }
     if (num_messages > 0) {
         m_cur_idx = 0;
         m_cur_value = m_values[0];
@@ -46,6 +56,17 @@ int64_t DeltaEncodedInt64ColumnReader::get_value_at_idx(size_t idx) {
     return m_cur_value;
 }
 
+void DeltaEncodedInt64ColumnReader::decode_values(std::vector<int64_t>& values) {
+    auto const deltas{m_values.get_values()};
+    auto const num_values{deltas.size()};
+    values.resize(num_values);
+    int64_t cur_value{0};
+    for (size_t i{0}; i < num_values; ++i) {
+        cur_value += deltas[i];
+        values[i] = cur_value;
+    }
+}
+
 std::variant<int64_t, double, std::string, uint8_t> DeltaEncodedInt64ColumnReader::extract_value(
         uint64_t cur_message
 ) {
@@ -125,9 +146,15 @@ void DictionaryFloatColumnReader::extract_string_value_into_buffer(
 }
 
 void ClpStringColumnReader::load(BufferViewReader& reader, uint64_t num_messages) {
-    m_logtypes = reader.read_unaligned_span<uint64_t>(num_messages);
+    if (m_is_encoded) {
+        m_logtypes.read(reader, num_messages);
+        size_t encoded_vars_length = reader.read_value<size_t>();
+        m_encoded_vars.read(reader, encoded_vars_length);
+        return;
+    }
+    m_logtypes.read_unencoded(reader, num_messages);
     size_t encoded_vars_length = reader.read_value<size_t>();
-    m_encoded_vars = reader.read_unaligned_span<int64_t>(encoded_vars_length);
+    m_encoded_vars.read_unencoded(reader, encoded_vars_length);
 }
 
 void
@@ -154,7 +181,8 @@ ClpStringColumnReader::extract_string_value_into_buffer(uint64_t cur_message, st
     }
 
     int64_t encoded_vars_offset = ClpStringColumnWriter::get_encoded_offset(value);
-    auto encoded_vars = m_encoded_vars.sub_span(encoded_vars_offset, entry.get_num_variables());
+    auto encoded_vars
+            = m_encoded_vars.get_values().sub_span(encoded_vars_offset, entry.get_num_variables());
 
     clp::EncodedVariableInterpreter::decode_variables_into_message(
             entry,
@@ -195,11 +223,15 @@ UnalignedMemSpan<int64_t> ClpStringColumnReader::get_encoded_vars(uint64_t cur_m
 
     int64_t encoded_vars_offset = ClpStringColumnWriter::get_encoded_offset(value);
 
-    return m_encoded_vars.sub_span(encoded_vars_offset, entry.get_num_variables());
+    return m_encoded_vars.get_values().sub_span(encoded_vars_offset, entry.get_num_variables());
 }
 
 void VariableStringColumnReader::load(BufferViewReader& reader, uint64_t num_messages) {
-    m_variables = reader.read_unaligned_span<uint64_t>(num_messages);
+    if (m_is_encoded) {
+        m_variables.read(reader, num_messages);
+    } else {
+        m_variables.read_unencoded(reader, num_messages);
+    }
 }
 
 std::variant<int64_t, double, std::string, uint8_t> VariableStringColumnReader::extract_value(
@@ -5,10 +5,12 @@
 #include <cstdint>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "BufferViewReader.hpp"
 #include "DictionaryReader.hpp"
 #include "FloatFormatEncoding.hpp"
+#include "IntegerColumnEncoding.hpp"
 #include "SchemaTree.hpp"
 #include "TimestampDictionaryReader.hpp"
 #include "Utils.hpp"
@@ -74,7 +76,14 @@ private:
 class Int64ColumnReader : public BaseColumnReader {
 public:
     // Constructor
-    explicit Int64ColumnReader(int32_t id) : BaseColumnReader(id) {}
+    /**
+     * @param id
+     * @param is_encoded Whether the column was stored by `IntegerColumnEncoder`, which is the case
+     * for every archive since `cEncodedIntegerColumnsArchiveVersion`.
+     */
+    Int64ColumnReader(int32_t id, bool is_encoded)
+            : BaseColumnReader(id),
+              m_is_encoded{is_encoded} {}
 
     // Destructor
     ~Int64ColumnReader() override = default;
@@ -90,14 +99,26 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return A view of every value in the column, decoding the column if necessary
+     */
+    [[nodiscard]] auto get_values() -> UnalignedMemSpan<int64_t> { return m_values.get_values(); }
+
 private:
-    UnalignedMemSpan<int64_t> m_values;
+    LazyIntegerColumn<int64_t> m_values;
+    bool m_is_encoded;
 };
 
 class DeltaEncodedInt64ColumnReader : public BaseColumnReader {
 public:
     // Constructor
-    explicit DeltaEncodedInt64ColumnReader(int32_t id) : BaseColumnReader(id) {}
+    /**
+     * @param id
+     * @param is_encoded Whether the column was stored by `IntegerColumnEncoder`.
+     */
+    DeltaEncodedInt64ColumnReader(int32_t id, bool is_encoded)
+            : BaseColumnReader(id),
+              m_is_encoded{is_encoded} {}
 
     // Destructor
     ~DeltaEncodedInt64ColumnReader() override = default;
@@ -113,6 +134,12 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * Decodes every value in the column by prefix-summing the stored deltas.
+     * @param values Returns the decoded values
+     */
+    void decode_values(std::vector<int64_t>& values);
+
 private:
     /**
      * Gets the value stored at a given index by summing up the stored deltas between the requested
@@ -122,7 +149,8 @@ private:
      */
     int64_t get_value_at_idx(size_t idx);
 
-    UnalignedMemSpan<int64_t> m_values;
+    LazyIntegerColumn<int64_t> m_values;
+    bool m_is_encoded;
     int64_t m_cur_value{};
     size_t m_cur_idx{};
 };
@@ -146,6 +174,11 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return A view of every value in the column
+     */
+    [[nodiscard]] auto get_values() const -> UnalignedMemSpan<double> { return m_values; }
+
 private:
     UnalignedMemSpan<double> m_values;
 };
@@ -176,6 +209,11 @@ public:
      */
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return A view of every value in the column
+     */
+    [[nodiscard]] auto get_values() const -> UnalignedMemSpan<double> { return m_values; }
+
 private:
     UnalignedMemSpan<double> m_values;
     UnalignedMemSpan<float_format_t> m_formats;
@@ -229,6 +267,11 @@ public:
 
     void extract_string_value_into_buffer(uint64_t cur_message, std::string& buffer) override;
 
+    /**
+     * @return A view of every value in the column
+     */
+    [[nodiscard]] auto get_values() const -> UnalignedMemSpan<uint8_t> { return m_values; }
+
 private:
     UnalignedMemSpan<uint8_t> m_values;
 };
@@ -240,11 +283,13 @@ public:
             int32_t id,
             std::shared_ptr<VariableDictionaryReader> var_dict,
             std::shared_ptr<LogTypeDictionaryReader> log_dict,
+            bool is_encoded,
             bool is_array = false
     )
             : BaseColumnReader(id),
               m_var_dict(std::move(var_dict)),
               m_log_dict(std::move(log_dict)),
+              m_is_encoded(is_encoded),
               m_is_array(is_array) /*, encoded_vars_index_(0)*/ {}
 
     // Destructor
@@ -284,18 +329,24 @@ private:
     std::shared_ptr<VariableDictionaryReader> m_var_dict;
     std::shared_ptr<LogTypeDictionaryReader> m_log_dict;
 
-    UnalignedMemSpan<uint64_t> m_logtypes;
-    UnalignedMemSpan<int64_t> m_encoded_vars;
+    LazyIntegerColumn<uint64_t> m_logtypes;
+    LazyIntegerColumn<int64_t> m_encoded_vars;
 
+    bool m_is_encoded;
     bool m_is_array;
 };
 
 class VariableStringColumnReader : public BaseColumnReader {
 public:
     // Constructor
-    VariableStringColumnReader(int32_t id, std::shared_ptr<VariableDictionaryReader> var_dict)
+    VariableStringColumnReader(
+            int32_t id,
+            std::shared_ptr<VariableDictionaryReader> var_dict,
+            bool is_encoded
+    )
             : BaseColumnReader(id),
-              m_var_dict(std::move(var_dict)) {}
+              m_var_dict(std::move(var_dict)),
+              m_is_encoded(is_encoded) {}
 
     // Destructor
     ~VariableStringColumnReader() override = default;
@@ -321,10 +372,19 @@ public:
      */
     int64_t get_variable_id(uint64_t cur_message);
 
+    /**
+     * @return A view of the variable dictionary IDs for every message in the column, decoding the
+     * column if necessary
+     */
+    [[nodiscard]] auto get_variable_ids() -> UnalignedMemSpan<uint64_t> {
+        return m_variables.get_values();
+    }
+
 private:
     std::shared_ptr<VariableDictionaryReader> m_var_dict;
 
-    UnalignedMemSpan<uint64_t> m_variables;
+    LazyIntegerColumn<uint64_t> m_variables;
+    bool m_is_encoded;
 };
 
 class DateStringColumnReader : public BaseColumnReader {
@@ -354,6 +414,13 @@ public:
      */
     epochtime_t get_encoded_time(uint64_t cur_message);
 
+    /**
+     * @return A view of the encoded epoch time for every message in the column
+     */
+    [[nodiscard]] auto get_encoded_times() const -> UnalignedMemSpan<int64_t> {
+        return m_timestamps;
+    }
+
 private:
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dict;
 
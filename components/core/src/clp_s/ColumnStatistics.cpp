@@ -0,0 +1,185 @@
+#include "ColumnStatistics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+namespace {
+/**
+ * @param value
+ * @return A well-mixed 64-bit hash of the value (the finalizer of SplitMix64).
+ */
+auto mix(uint64_t value) -> uint64_t {
+    value ^= value >> 30U;
+    value *= 0xbf58'476d'1ce4'e5b9ULL;
+    value ^= value >> 27U;
+    value *= 0x94d0'49bb'1331'11ebULL;
+    value ^= value >> 31U;
+    return value;
+}
+}  // namespace
+
+void ColumnStatistics::add_int_range(int64_t min, int64_t max) {
+    if (m_int_range.has_value()) {
+        m_int_range->first = std::min(m_int_range->first, min);
+        m_int_range->second = std::max(m_int_range->second, max);
+    } else {
+        m_int_range.emplace(min, max);
+    }
+}
+
+void ColumnStatistics::add_float_range(double min, double max) {
+    if (m_float_range.has_value()) {
+        m_float_range->first = std::min(m_float_range->first, min);
+        m_float_range->second = std::max(m_float_range->second, max);
+    } else {
+        m_float_range.emplace(min, max);
+    }
+}
+
+void ColumnStatistics::add_var_ids(std::vector<uint64_t> const& var_ids) {
+    m_var_ids.insert(m_var_ids.end(), var_ids.begin(), var_ids.end());
+}
+
+auto ColumnStatistics::may_contain_var_id(uint64_t var_id) const -> bool {
+    if (m_bloom_filter.empty()) {
+        return true;
+    }
+    uint64_t const bit_mask{m_bloom_filter.size() * 64 - 1};
+    auto const [hash1, hash2] = hash_var_id(var_id);
+    for (size_t i = 0; i < cNumBloomFilterHashes; ++i) {
+        auto const bit{(hash1 + i * hash2) & bit_mask};
+        if (0 == (m_bloom_filter[bit / 64] & (1ULL << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ColumnStatistics::write(ZstdCompressor& compressor) {
+    build_bloom_filter();
+
+    uint8_t flags{0};
+    if (m_int_range.has_value()) {
+        flags |= HasIntRange;
+    }
+    if (m_float_range.has_value()) {
+        flags |= HasFloatRange;
+    }
+    if (false == m_bloom_filter.empty()) {
+        flags |= HasBloomFilter;
+    }
+    compressor.write_numeric_value(flags);
+
+    if (m_int_range.has_value()) {
+        compressor.write_numeric_value(m_int_range->first);
+        compressor.write_numeric_value(m_int_range->second);
+    }
+    if (m_float_range.has_value()) {
+        compressor.write_numeric_value(m_float_range->first);
+        compressor.write_numeric_value(m_float_range->second);
+    }
+    if (false == m_bloom_filter.empty()) {
+        compressor.write_numeric_value<uint64_t>(m_bloom_filter.size());
+        compressor.write(
+                reinterpret_cast<char const*>(m_bloom_filter.data()),
+                m_bloom_filter.size() * sizeof(uint64_t)
+        );
+    }
+}
+
+void ColumnStatistics::read(ZstdDecompressor& decompressor) {
+    m_int_range.reset();
+    m_float_range.reset();
+    m_var_ids.clear();
+    m_bloom_filter.clear();
+
+    uint8_t flags{};
+    if (auto error = decompressor.try_read_numeric_value(flags); ErrorCodeSuccess != error) {
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+
+    auto read_range = [&](auto& range) {
+        typename std::remove_reference_t<decltype(range)>::value_type min_max{};
+        if (auto error = decompressor.try_read_numeric_value(min_max.first);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+        if (auto error = decompressor.try_read_numeric_value(min_max.second);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+        range.emplace(min_max);
+    };
+    if (0 != (flags & HasIntRange)) {
+        read_range(m_int_range);
+    }
+    if (0 != (flags & HasFloatRange)) {
+        read_range(m_float_range);
+    }
+    if (0 != (flags & HasBloomFilter)) {
+        uint64_t num_words{};
+        if (auto error = decompressor.try_read_numeric_value(num_words); ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+        if (false == std::has_single_bit(num_words)) {
+            throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+        }
+        m_bloom_filter.resize(num_words);
+        if (auto error = decompressor.try_read_exact_length(
+                    reinterpret_cast<char*>(m_bloom_filter.data()),
+                    num_words * sizeof(uint64_t)
+            );
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+    }
+}
+
+void ColumnStatistics::build_bloom_filter() {
+    if (m_var_ids.empty()) {
+        return;
+    }
+    std::ranges::sort(m_var_ids);
+    auto const duplicates = std::ranges::unique(m_var_ids);
+    m_var_ids.erase(duplicates.begin(), duplicates.end());
+    if (m_var_ids.size() > cMaxNumBloomFilterEntries) {
+        m_var_ids.clear();
+        return;
+    }
+
+    auto const num_bits{std::bit_ceil(std::max<size_t>(
+            m_var_ids.size() * cBloomFilterBitsPerEntry,
+            64
+    ))};
+    m_bloom_filter.assign(num_bits / 64, 0);
+    for (auto var_id : m_var_ids) {
+        auto const [hash1, hash2] = hash_var_id(var_id);
+        for (size_t i = 0; i < cNumBloomFilterHashes; ++i) {
+            auto const bit{(hash1 + i * hash2) & (num_bits - 1)};
+            m_bloom_filter[bit / 64] |= 1ULL << (bit % 64);
+        }
+    }
+    m_var_ids.clear();
+}
+
+auto ColumnStatistics::hash_var_id(uint64_t var_id) -> std::pair<uint64_t, uint64_t> {
+    auto const hash1{mix(var_id)};
+    // An odd second hash visits distinct bits when the number of bits is a power of two
+    auto const hash2{mix(hash1) | 1U};
+    return {hash1, hash2};
+}
+}  // namespace clp_s
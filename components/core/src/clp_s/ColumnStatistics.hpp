@@ -0,0 +1,123 @@
+#ifndef CLP_S_COLUMNSTATISTICS_HPP
+#define CLP_S_COLUMNSTATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "TraceableException.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+/**
+ * Statistics about the values in a column of a schema table, used to prove that a filter can't
+ * match any message in the table without decompressing it.
+ *
+ * Depending on the type of the column, the statistics contain:
+ * - the range of its integer values (integers and date strings);
+ * - the range of its float values;
+ * - a bloom filter over the variable dictionary IDs of its values (variable strings).
+ *
+ * While compressing, values are accumulated in the statistics and the bloom filter is only built
+ * once the statistics are written.
+ */
+class ColumnStatistics {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    // Columns with more distinct variable dictionary IDs than this don't get a bloom filter, to
+    // bound the size of the statistics.
+    static constexpr size_t cMaxNumBloomFilterEntries{64ULL * 1024};
+    static constexpr size_t cBloomFilterBitsPerEntry{10};
+    static constexpr size_t cNumBloomFilterHashes{7};
+
+    // Methods
+    void add_int_range(int64_t min, int64_t max);
+
+    void add_float_range(double min, double max);
+
+    void add_var_ids(std::vector<uint64_t> const& var_ids);
+
+    [[nodiscard]] auto get_int_range() const -> std::optional<std::pair<int64_t, int64_t>> const& {
+        return m_int_range;
+    }
+
+    [[nodiscard]] auto get_float_range() const -> std::optional<std::pair<double, double>> const& {
+        return m_float_range;
+    }
+
+    /**
+     * @return Whether the statistics don't contain anything.
+     */
+    [[nodiscard]] auto empty() const -> bool {
+        return false == m_int_range.has_value() && false == m_float_range.has_value()
+               && m_var_ids.empty() && m_bloom_filter.empty();
+    }
+
+    [[nodiscard]] auto has_bloom_filter() const -> bool { return false == m_bloom_filter.empty(); }
+
+    /**
+     * @param var_id
+     * @return Whether the column may contain a value with the given variable dictionary ID. Always
+     * true if the statistics don't have a bloom filter.
+     */
+    [[nodiscard]] auto may_contain_var_id(uint64_t var_id) const -> bool;
+
+    /**
+     * Writes the statistics to the given compressor, building the bloom filter from the
+     * accumulated variable dictionary IDs.
+     * @param compressor
+     */
+    void write(ZstdCompressor& compressor);
+
+    /**
+     * Reads statistics written by `write` from the given decompressor.
+     * @param decompressor
+     * @throw OperationFailed if the statistics couldn't be read
+     */
+    void read(ZstdDecompressor& decompressor);
+
+private:
+    // Types
+    enum Flags : uint8_t {
+        HasIntRange = 1U << 0U,
+        HasFloatRange = 1U << 1U,
+        HasBloomFilter = 1U << 2U
+    };
+
+    /**
+     * Builds the bloom filter from `m_var_ids`.
+     */
+    void build_bloom_filter();
+
+    /**
+     * @param var_id
+     * @return The two hashes of the given ID used to derive the bits it sets in the bloom filter.
+     */
+    [[nodiscard]] static auto hash_var_id(uint64_t var_id) -> std::pair<uint64_t, uint64_t>;
+
+    std::optional<std::pair<int64_t, int64_t>> m_int_range;
+    std::optional<std::pair<double, double>> m_float_range;
+    std::vector<uint64_t> m_var_ids;
+    // The number of bits is always a power of two
+    std::vector<uint64_t> m_bloom_filter;
+};
+
+/**
+ * The statistics of each column in a schema table, indexed by column ID.
+ */
+using TableStatistics = std::map<int32_t, ColumnStatistics>;
+}  // namespace clp_s
+
+#endif  // CLP_S_COLUMNSTATISTICS_HPP
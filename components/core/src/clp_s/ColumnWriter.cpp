@@ -14,6 +14,7 @@
 #include "../clp/ffi/EncodedTextAst.hpp"
 #include "../clp/ffi/ir_stream/decoding_methods.hpp"
 #include "../clp/TraceableException.hpp"
+#include "ColumnStatistics.hpp"
 #include "ParsedMessage.hpp"
 #include "ZstdCompressor.hpp"
 
@@ -23,26 +24,51 @@ size_t Int64ColumnWriter::add_value(ParsedMessage::variable_t& value) {
     return sizeof(int64_t);
 }
 
+size_t Int64ColumnWriter::finalize([[maybe_unused]] size_t unencoded_size) {
+    return m_encoder.choose_encoding(m_values);
+}
+
 void Int64ColumnWriter::store(ZstdCompressor& compressor) {
-    size_t size = m_values.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
+    m_encoder.store(m_values, compressor);
+}
+
+void Int64ColumnWriter::collect_statistics(ColumnStatistics& statistics) const {
+    if (m_values.empty()) {
+        return;
+    }
+    auto const [min_it, max_it] = std::minmax_element(m_values.begin(), m_values.end());
+    statistics.add_int_range(*min_it, *max_it);
 }
 
 size_t DeltaEncodedInt64ColumnWriter::add_value(ParsedMessage::variable_t& value) {
     if (0 == m_values.size()) {
         m_cur = std::get<int64_t>(value);
         m_values.push_back(m_cur);
+        m_min = m_cur;
+        m_max = m_cur;
     } else {
         auto next = std::get<int64_t>(value);
         m_values.push_back(next - m_cur);
         m_cur = next;
+        m_min = std::min(m_min, m_cur);
+        m_max = std::max(m_max, m_cur);
     }
     return sizeof(int64_t);
 }
 
+size_t DeltaEncodedInt64ColumnWriter::finalize([[maybe_unused]] size_t unencoded_size) {
+    return m_encoder.choose_encoding(m_values);
+}
+
 void DeltaEncodedInt64ColumnWriter::store(ZstdCompressor& compressor) {
-    size_t size = m_values.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
+    m_encoder.store(m_values, compressor);
+}
+
+void DeltaEncodedInt64ColumnWriter::collect_statistics(ColumnStatistics& statistics) const {
+    if (m_values.empty()) {
+        return;
+    }
+    statistics.add_int_range(m_min, m_max);
 }
 
 size_t FloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
@@ -55,6 +81,14 @@ void FloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
 }
 
+void FloatColumnWriter::collect_statistics(ColumnStatistics& statistics) const {
+    if (m_values.empty()) {
+        return;
+    }
+    auto const [min_it, max_it] = std::minmax_element(m_values.begin(), m_values.end());
+    statistics.add_float_range(*min_it, *max_it);
+}
+
 size_t FormattedFloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     auto const& [float_value, format]{std::get<std::pair<double, float_format_t>>(value)};
     m_values.push_back(float_value);
@@ -70,6 +104,14 @@ void FormattedFloatColumnWriter::store(ZstdCompressor& compressor) {
     compressor.write(reinterpret_cast<char const*>(m_formats.data()), format_size);
 }
 
+void FormattedFloatColumnWriter::collect_statistics(ColumnStatistics& statistics) const {
+    if (m_values.empty()) {
+        return;
+    }
+    auto const [min_it, max_it] = std::minmax_element(m_values.begin(), m_values.end());
+    statistics.add_float_range(*min_it, *max_it);
+}
+
 size_t DictionaryFloatColumnWriter::add_value(ParsedMessage::variable_t& value) {
     clp::variable_dictionary_id_t id{};
     m_var_dict->add_entry(std::get<std::string>(value), id);
@@ -146,13 +188,16 @@ size_t ClpStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     return sizeof(int64_t) + sizeof(int64_t) * (m_encoded_vars.size() - offset);
 }
 
+size_t ClpStringColumnWriter::finalize([[maybe_unused]] size_t unencoded_size) {
+    return m_logtype_encoder.choose_encoding(m_logtypes) + get_total_header_size()
+           + m_encoded_var_encoder.choose_encoding(m_encoded_vars);
+}
+
 void ClpStringColumnWriter::store(ZstdCompressor& compressor) {
-    size_t logtypes_size = m_logtypes.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_logtypes.data()), logtypes_size);
-    size_t encoded_vars_size = m_encoded_vars.size() * sizeof(int64_t);
+    m_logtype_encoder.store(m_logtypes, compressor);
     size_t num_encoded_vars = m_encoded_vars.size();
     compressor.write_numeric_value(num_encoded_vars);
-    compressor.write(reinterpret_cast<char const*>(m_encoded_vars.data()), encoded_vars_size);
+    m_encoded_var_encoder.store(m_encoded_vars, compressor);
 }
 
 size_t VariableStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
@@ -162,9 +207,16 @@ size_t VariableStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
     return sizeof(clp::variable_dictionary_id_t);
 }
 
+size_t VariableStringColumnWriter::finalize([[maybe_unused]] size_t unencoded_size) {
+    return m_encoder.choose_encoding(m_var_dict_ids);
+}
+
 void VariableStringColumnWriter::store(ZstdCompressor& compressor) {
-    auto size{m_var_dict_ids.size() * sizeof(clp::variable_dictionary_id_t)};
-    compressor.write(reinterpret_cast<char const*>(m_var_dict_ids.data()), size);
+    m_encoder.store(m_var_dict_ids, compressor);
+}
+
+void VariableStringColumnWriter::collect_statistics(ColumnStatistics& statistics) const {
+    statistics.add_var_ids(m_var_dict_ids);
 }
 
 size_t DateStringColumnWriter::add_value(ParsedMessage::variable_t& value) {
@@ -181,4 +233,12 @@ void DateStringColumnWriter::store(ZstdCompressor& compressor) {
     size_t encodings_size = m_timestamp_encodings.size() * sizeof(int64_t);
     compressor.write(reinterpret_cast<char const*>(m_timestamp_encodings.data()), encodings_size);
 }
+
+void DateStringColumnWriter::collect_statistics(ColumnStatistics& statistics) const {
+    if (m_timestamps.empty()) {
+        return;
+    }
+    auto const [min_it, max_it] = std::minmax_element(m_timestamps.begin(), m_timestamps.end());
+    statistics.add_int_range(*min_it, *max_it);
+}
 }  // namespace clp_s
@@ -5,9 +5,11 @@
 #include <variant>
 
 #include "../clp/Defs.h"
+#include "ColumnStatistics.hpp"
 #include "DictionaryWriter.hpp"
 #include "FileWriter.hpp"
 #include "FloatFormatEncoding.hpp"
+#include "IntegerColumnEncoding.hpp"
 #include "ParsedMessage.hpp"
 #include "TimestampDictionaryWriter.hpp"
 #include "ZstdCompressor.hpp"
@@ -37,12 +39,29 @@ public:
     /**
      * Returns the total size of the header data that will be written to the compressor. This header
      * size plus the sum of sizes returned by add_value is equal to the total size of data that will
-     * be written to the compressor in bytes.
+     * be written to the compressor in bytes, unless the column is encoded by `finalize`.
      *
      * @return the total size of header data that will be written to the compressor in bytes
      */
     virtual size_t get_total_header_size() const { return 0; }
 
+    /**
+     * Prepares the column to be stored once every value has been added, e.g., by choosing how to
+     * encode the column. Must be called before `store`.
+     * @param unencoded_size The header size plus the sum of sizes returned by add_value.
+     * @return the total size of data that will be written to the compressor in bytes
+     */
+    virtual size_t finalize(size_t unencoded_size) { return unencoded_size; }
+
+    /**
+     * Adds statistics about the values in the column to the given statistics. Columns that don't
+     * support statistics leave them unchanged.
+     * @param statistics
+     */
+    virtual void collect_statistics([[maybe_unused]] ColumnStatistics& statistics) const {}
+
+    [[nodiscard]] int32_t get_id() const { return m_id; }
+
 protected:
     int32_t m_id;
 };
@@ -58,10 +77,15 @@ public:
     // Methods inherited from BaseColumnWriter
     size_t add_value(ParsedMessage::variable_t& value) override;
 
+    size_t finalize(size_t unencoded_size) override;
+
     void store(ZstdCompressor& compressor) override;
 
+    void collect_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_values;
+    IntegerColumnEncoder<int64_t> m_encoder;
 };
 
 class DeltaEncodedInt64ColumnWriter : public BaseColumnWriter {
@@ -75,11 +99,18 @@ public:
     // Methods inherited from BaseColumnWriter
     size_t add_value(ParsedMessage::variable_t& value) override;
 
+    size_t finalize(size_t unencoded_size) override;
+
     void store(ZstdCompressor& compressor) override;
 
+    void collect_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_values;
     int64_t m_cur{};
+    int64_t m_min{};
+    int64_t m_max{};
+    IntegerColumnEncoder<int64_t> m_encoder;
 };
 
 class FloatColumnWriter : public BaseColumnWriter {
@@ -95,6 +126,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void collect_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<double> m_values;
 };
@@ -112,6 +145,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void collect_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<double> m_values;
     std::vector<float_format_t> m_formats;
@@ -175,6 +210,8 @@ public:
     // Methods inherited from BaseColumnWriter
     size_t add_value(ParsedMessage::variable_t& value) override;
 
+    size_t finalize(size_t unencoded_size) override;
+
     void store(ZstdCompressor& compressor) override;
 
     size_t get_total_header_size() const override { return sizeof(size_t); }
@@ -217,6 +254,8 @@ private:
 
     std::vector<encoded_log_dict_id_t> m_logtypes;
     std::vector<clp::encoded_variable_t> m_encoded_vars;
+    IntegerColumnEncoder<encoded_log_dict_id_t> m_logtype_encoder;
+    IntegerColumnEncoder<clp::encoded_variable_t> m_encoded_var_encoder;
 };
 
 class VariableStringColumnWriter : public BaseColumnWriter {
@@ -232,11 +271,16 @@ public:
     // Methods inherited from BaseColumnWriter
     size_t add_value(ParsedMessage::variable_t& value) override;
 
+    size_t finalize(size_t unencoded_size) override;
+
     void store(ZstdCompressor& compressor) override;
 
+    void collect_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
     std::vector<clp::variable_dictionary_id_t> m_var_dict_ids;
+    IntegerColumnEncoder<clp::variable_dictionary_id_t> m_encoder;
 };
 
 class DateStringColumnWriter : public BaseColumnWriter {
@@ -252,6 +296,8 @@ public:
 
     void store(ZstdCompressor& compressor) override;
 
+    void collect_statistics(ColumnStatistics& statistics) const override;
+
 private:
     std::vector<int64_t> m_timestamps;
     std::vector<int64_t> m_timestamp_encodings;
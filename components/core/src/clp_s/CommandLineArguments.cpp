@@ -10,6 +10,7 @@
 
 #include "../clp/cli_utils.hpp"
 #include "../clp/type_utils.hpp"
+#include "../reducer/AggregateOperator.hpp"
 #include "../reducer/types.hpp"
 #include "FileReader.hpp"
 
@@ -224,6 +225,13 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     po::value<size_t>(&m_minimum_table_size)->value_name("MIN_TABLE_SIZE")->
                         default_value(m_minimum_table_size),
                     "Minimum size (B) for a packed table before it gets compressed."
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_compression_threads)->value_name("NUM")->
+                        default_value(m_num_compression_threads),
+                    "Number of threads to use for compressing the packed tables of each archive."
+                    " Values greater than one also pipeline the reading, parsing, and encoding of"
+                    " JSON input."
             )(
                     "max-document-size",
                     po::value<size_t>(&m_max_document_size)->value_name("DOC_SIZE")->
@@ -252,6 +260,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "single-file-archive",
                     po::bool_switch(&m_single_file_archive),
                     "Create a single archive file instead of multiple files."
+            )(
+                    "index-variable-dictionary",
+                    po::bool_switch(&m_index_variable_dictionary),
+                    "Build an n-gram index of the variable dictionary to speed up wildcard searches."
             )(
                     "structurize-arrays",
                     po::bool_switch(&m_structurize_arrays),
@@ -311,6 +323,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No archives directory specified.");
             }
 
+            if (0 == m_num_compression_threads) {
+                throw std::invalid_argument("Value for num-threads must be greater than zero.");
+            }
+
             if (false == input_path_list_file_path.empty()) {
                 if (false == read_paths_from_file(input_path_list_file_path, input_paths)) {
                     SPDLOG_ERROR("Failed to read paths from {}", input_path_list_file_path);
@@ -473,6 +489,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
             po::options_description search_options;
             std::string output_handler_name;
             std::string archive_path;
+            std::string aggregation_type_name;
             // clang-format off
             search_options.add_options()(
                     "archive-path",
@@ -546,10 +563,42 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "count-by-time",
                     po::value<int64_t>(&m_count_by_time_bucket_size)->value_name("SIZE"),
                     "Count the number of results in each time span of the given size (ms)"
+            )(
+                    "aggregate",
+                    po::value<std::string>(&aggregation_type_name)->value_name("TYPE"),
+                    "Aggregate the values of the field given by --aggregate-field (sum | min | max"
+                    " | avg | count-distinct | percentile). count-distinct and percentile are"
+                    " approximate."
+            )(
+                    "aggregate-field",
+                    po::value<std::string>(&m_aggregation_field)->value_name("KEY"),
+                    "Key of the field to aggregate, with nested keys separated by '.'"
+            )(
+                    "quantile",
+                    po::value<double>(&m_aggregation_quantile)->value_name("Q")->
+                        default_value(m_aggregation_quantile),
+                    "Quantile to estimate for the percentile aggregation, in [0, 1]"
             );
             // clang-format on
             search_options.add(aggregation_options);
 
+            po::options_description execution_options("Execution Options");
+            // clang-format off
+            execution_options.add_options()(
+                    "num-threads",
+                    po::value<size_t>(&m_num_search_threads)->value_name("NUM")->
+                        default_value(m_num_search_threads),
+                    "Number of threads to use for searching the tables in each archive"
+            )(
+                    "num-prefetched-streams",
+                    po::value<size_t>(&m_num_prefetched_streams)->value_name("NUM")->
+                        default_value(m_num_prefetched_streams),
+                    "Number of packed streams to read and decompress ahead of the search, in the"
+                    " background (0 disables prefetching)"
+            );
+            // clang-format on
+            search_options.add(execution_options);
+
             po::options_description network_output_handler_options(
                     "Network Output Handler Options"
             );
@@ -695,6 +744,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 visible_options.add(general_options);
                 visible_options.add(match_options);
                 visible_options.add(aggregation_options);
+                visible_options.add(execution_options);
                 visible_options.add(file_output_handler_options);
                 visible_options.add(network_output_handler_options);
                 visible_options.add(results_cache_output_handler_options);
@@ -727,6 +777,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 );
             }
 
+            if (0 == m_num_search_threads) {
+                throw std::invalid_argument("Value for num-threads must be greater than zero.");
+            }
+
             if (parsed_command_line_options.count("count-by-time") > 0) {
                 m_do_count_by_time_aggregation = true;
                 if (m_count_by_time_bucket_size <= 0) {
@@ -793,8 +847,26 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 );
             }
 
-            bool aggregation_was_specified
-                    = m_do_count_by_time_aggregation || m_do_count_results_aggregation;
+            if (parsed_command_line_options.count("aggregate") > 0) {
+                m_aggregation_type = reducer::parse_aggregation_type(aggregation_type_name);
+                if (false == m_aggregation_type.has_value()) {
+                    throw std::invalid_argument("Unknown aggregation: " + aggregation_type_name);
+                }
+                if (m_aggregation_field.empty()) {
+                    throw std::invalid_argument(
+                            "The --aggregate option requires a non-empty --aggregate-field."
+                    );
+                }
+                if (false == (m_aggregation_quantile >= 0.0 && m_aggregation_quantile <= 1.0)) {
+                    throw std::invalid_argument("Value for quantile must be in [0, 1].");
+                }
+            } else if (parsed_command_line_options.count("aggregate-field") > 0) {
+                throw std::invalid_argument("The --aggregate-field option requires --aggregate.");
+            }
+
+            bool aggregation_was_specified = m_do_count_by_time_aggregation
+                                             || m_do_count_results_aggregation
+                                             || m_aggregation_type.has_value();
             if (aggregation_was_specified && OutputHandlerType::Reducer != m_output_handler_type) {
                 throw std::invalid_argument(
                         "Aggregations are only supported with the reducer output handler."
@@ -803,14 +875,18 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                         && OutputHandlerType::Reducer == m_output_handler_type))
             {
                 throw std::invalid_argument(
-                        "The reducer output handler currently only supports count and"
-                        " count-by-time aggregations."
+                        "The reducer output handler requires an aggregation."
                 );
             }
 
-            if (m_do_count_by_time_aggregation && m_do_count_results_aggregation) {
+            auto const num_aggregations_specified
+                    = static_cast<int>(m_do_count_by_time_aggregation)
+                      + static_cast<int>(m_do_count_results_aggregation)
+                      + static_cast<int>(m_aggregation_type.has_value());
+            if (num_aggregations_specified > 1) {
                 throw std::invalid_argument(
-                        "The --count-by-time and --count options are mutually exclusive."
+                        "The --count-by-time, --count, and --aggregate options are mutually"
+                        " exclusive."
                 );
             }
         }
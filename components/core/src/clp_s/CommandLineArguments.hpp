@@ -1,6 +1,7 @@
 #ifndef CLP_S_COMMANDLINEARGUMENTS_HPP
 #define CLP_S_COMMANDLINEARGUMENTS_HPP
 
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <vector>
@@ -9,6 +10,7 @@
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 
+#include "../reducer/AggregateOperator.hpp"
 #include "../reducer/types.hpp"
 #include "Defs.hpp"
 #include "InputConfig.hpp"
@@ -91,6 +93,10 @@ public:
 
     bool get_ignore_case() const { return m_ignore_case; }
 
+    size_t get_num_search_threads() const { return m_num_search_threads; }
+
+    size_t get_num_prefetched_streams() const { return m_num_prefetched_streams; }
+
     std::string const& get_reducer_host() const { return m_reducer_host; }
 
     int get_reducer_port() const { return m_reducer_port; }
@@ -103,6 +109,14 @@ public:
 
     int64_t get_count_by_time_bucket_size() const { return m_count_by_time_bucket_size; }
 
+    std::optional<reducer::AggregationType> get_aggregation_type() const {
+        return m_aggregation_type;
+    }
+
+    std::string const& get_aggregation_field() const { return m_aggregation_field; }
+
+    double get_aggregation_quantile() const { return m_aggregation_quantile; }
+
     OutputHandlerType get_output_handler_type() const { return m_output_handler_type; }
 
     [[nodiscard]] auto get_retain_float_format() const -> bool {
@@ -111,6 +125,8 @@ public:
 
     bool get_single_file_archive() const { return m_single_file_archive; }
 
+    bool get_index_variable_dictionary() const { return m_index_variable_dictionary; }
+
     bool get_structurize_arrays() const { return m_structurize_arrays; }
 
     bool get_ordered_decompression() const { return m_ordered_decompression; }
@@ -119,6 +135,8 @@ public:
 
     size_t get_minimum_table_size() const { return m_minimum_table_size; }
 
+    size_t get_num_compression_threads() const { return m_num_compression_threads; }
+
     std::vector<std::string> const& get_projection_columns() const { return m_projection_columns; }
 
     bool get_record_log_order() const { return false == m_disable_log_order; }
@@ -201,11 +219,13 @@ private:
     size_t m_max_document_size{512ULL * 1024 * 1024};  // 512 MB
     bool m_no_retain_float_format{false};
     bool m_single_file_archive{false};
+    bool m_index_variable_dictionary{false};
     bool m_structurize_arrays{false};
     bool m_ordered_decompression{false};
     size_t m_target_ordered_chunk_size{};
     bool m_print_ordered_chunk_stats{false};
     size_t m_minimum_table_size{1ULL * 1024 * 1024};  // 1 MB
+    size_t m_num_compression_threads{1};
     bool m_disable_log_order{false};
 
     // MongoDB configuration variables
@@ -227,6 +247,8 @@ private:
     std::optional<epochtime_t> m_search_end_ts;
     bool m_ignore_case{false};
     std::vector<std::string> m_projection_columns;
+    size_t m_num_search_threads{1};
+    size_t m_num_prefetched_streams{0};
 
     // Search aggregation variables
     std::string m_reducer_host;
@@ -235,6 +257,9 @@ private:
     bool m_do_count_results_aggregation{false};
     bool m_do_count_by_time_aggregation{false};
     int64_t m_count_by_time_bucket_size{0};  // Milliseconds
+    std::optional<reducer::AggregationType> m_aggregation_type;
+    std::string m_aggregation_field;
+    double m_aggregation_quantile{0.5};
 
     OutputHandlerType m_output_handler_type{OutputHandlerType::Stdout};
 };
@@ -0,0 +1,170 @@
+#include "DictionaryIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "FileWriter.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+void DictionaryIndex::add_entry(std::string_view value, uint64_t id) {
+    if (value.size() < cNgramLength) {
+        return;
+    }
+    for (size_t i = 0; i + cNgramLength <= value.size(); ++i) {
+        auto& ids = m_ngram_to_ids[get_ngram(value, i)];
+        // An n-gram may occur more than once in the same value
+        if (ids.empty() || ids.back() != id) {
+            ids.push_back(id);
+        }
+    }
+}
+
+auto DictionaryIndex::store(std::string const& index_path, int compression_level) -> size_t {
+    FileWriter index_writer;
+    ZstdCompressor index_compressor;
+    index_writer.open(index_path, FileWriter::OpenMode::CreateForWriting);
+    index_compressor.open(index_writer, compression_level);
+
+    // Write the n-grams in sorted order, with delta-encoded IDs, so that the index compresses well
+    std::vector<ngram_t> ngrams;
+    ngrams.reserve(m_ngram_to_ids.size());
+    for (auto const& [ngram, ids] : m_ngram_to_ids) {
+        ngrams.push_back(ngram);
+    }
+    std::ranges::sort(ngrams);
+
+    index_compressor.write_numeric_value<uint64_t>(ngrams.size());
+    for (auto ngram : ngrams) {
+        auto& ids = m_ngram_to_ids[ngram];
+        // IDs are only in order if entries were added in order
+        std::ranges::sort(ids);
+        index_compressor.write_numeric_value(ngram);
+        index_compressor.write_numeric_value<uint64_t>(ids.size());
+        uint64_t prev_id{0};
+        for (auto id : ids) {
+            index_compressor.write_numeric_value(id - prev_id);
+            prev_id = id;
+        }
+    }
+
+    index_compressor.close();
+    size_t compressed_size = index_writer.get_pos();
+    index_writer.close();
+    return compressed_size;
+}
+
+void DictionaryIndex::read(ZstdDecompressor& decompressor) {
+    m_ngram_to_ids.clear();
+
+    uint64_t num_ngrams{};
+    if (auto error = decompressor.try_read_numeric_value(num_ngrams); ErrorCodeSuccess != error) {
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+    m_ngram_to_ids.reserve(num_ngrams);
+    for (uint64_t i = 0; i < num_ngrams; ++i) {
+        ngram_t ngram{};
+        uint64_t num_ids{};
+        if (auto error = decompressor.try_read_numeric_value(ngram); ErrorCodeSuccess != error) {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+        if (auto error = decompressor.try_read_numeric_value(num_ids); ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+
+        std::vector<uint64_t> ids(num_ids);
+        uint64_t prev_id{0};
+        for (auto& id : ids) {
+            uint64_t delta{};
+            if (auto error = decompressor.try_read_numeric_value(delta); ErrorCodeSuccess != error)
+            {
+                throw OperationFailed(error, __FILENAME__, __LINE__);
+            }
+            id = prev_id + delta;
+            prev_id = id;
+        }
+        m_ngram_to_ids.emplace(ngram, std::move(ids));
+    }
+}
+
+auto DictionaryIndex::get_candidate_ids(std::string_view wildcard_string) const
+        -> std::optional<std::vector<uint64_t>> {
+    // Collect the n-grams in each literal (i.e., wildcard-free, unescaped) part of the string
+    std::vector<ngram_t> ngrams;
+    std::string literal;
+    auto add_literal_ngrams = [&]() {
+        for (size_t i = 0; i + cNgramLength <= literal.size(); ++i) {
+            ngrams.push_back(get_ngram(literal, i));
+        }
+        literal.clear();
+    };
+    for (size_t i = 0; i < wildcard_string.size(); ++i) {
+        auto const c = wildcard_string[i];
+        if ('\\' == c) {
+            ++i;
+            if (i < wildcard_string.size()) {
+                literal += wildcard_string[i];
+            }
+        } else if ('*' == c || '?' == c) {
+            add_literal_ngrams();
+        } else {
+            literal += c;
+        }
+    }
+    add_literal_ngrams();
+
+    if (ngrams.empty()) {
+        return std::nullopt;
+    }
+    std::ranges::sort(ngrams);
+    auto const duplicates = std::ranges::unique(ngrams);
+    ngrams.erase(duplicates.begin(), duplicates.end());
+
+    // Intersect the posting lists, starting with the shortest to keep the intersection small
+    std::vector<std::vector<uint64_t> const*> posting_lists;
+    posting_lists.reserve(ngrams.size());
+    for (auto ngram : ngrams) {
+        auto const it = m_ngram_to_ids.find(ngram);
+        if (m_ngram_to_ids.end() == it) {
+            return std::vector<uint64_t>{};
+        }
+        posting_lists.push_back(&it->second);
+    }
+    std::ranges::sort(posting_lists, [](auto const* lhs, auto const* rhs) {
+        return lhs->size() < rhs->size();
+    });
+
+    std::vector<uint64_t> candidate_ids{*posting_lists.front()};
+    std::vector<uint64_t> intersection;
+    for (size_t i = 1; i < posting_lists.size() && false == candidate_ids.empty(); ++i) {
+        intersection.clear();
+        std::ranges::set_intersection(
+                candidate_ids,
+                *posting_lists[i],
+                std::back_inserter(intersection)
+        );
+        std::swap(candidate_ids, intersection);
+    }
+    return candidate_ids;
+}
+
+auto DictionaryIndex::get_ngram(std::string_view value, size_t pos) -> ngram_t {
+    ngram_t ngram{0};
+    for (size_t i = 0; i < cNgramLength; ++i) {
+        auto const c = static_cast<unsigned char>(value[pos + i]);
+        ngram = (ngram << 8) | static_cast<ngram_t>(std::tolower(c));
+    }
+    return ngram;
+}
+}  // namespace clp_s
@@ -0,0 +1,90 @@
+#ifndef CLP_S_DICTIONARYINDEX_HPP
+#define CLP_S_DICTIONARYINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "TraceableException.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+/**
+ * A trigram index over the values of a dictionary, used to avoid scanning every entry of the
+ * dictionary when searching it for a wildcard string.
+ *
+ * The index maps every (case-folded) trigram in the dictionary to the sorted IDs of the entries
+ * containing it. Any entry that matches a wildcard string must contain every trigram in the
+ * literal parts of the wildcard string, so intersecting their posting lists yields a small set of
+ * candidate entries that can then be matched individually.
+ */
+class DictionaryIndex {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constants
+    static constexpr size_t cNgramLength{3};
+
+    // Methods
+    /**
+     * Adds a dictionary entry to the index. Entries shorter than `cNgramLength` aren't indexed
+     * since they can't contain any literal long enough to be looked up in the index.
+     * @param value
+     * @param id
+     */
+    void add_entry(std::string_view value, uint64_t id);
+
+    /**
+     * Writes the index to a file.
+     * @param index_path
+     * @param compression_level
+     * @return the compressed size of the index in bytes
+     */
+    [[nodiscard]] auto store(std::string const& index_path, int compression_level) -> size_t;
+
+    /**
+     * Reads the index from the given decompressor, replacing any existing contents.
+     * @param decompressor
+     * @throw OperationFailed if the index couldn't be read
+     */
+    void read(ZstdDecompressor& decompressor);
+
+    /**
+     * Gets the IDs of the entries that may match the given wildcard string. Entries that aren't
+     * returned are guaranteed not to match the wildcard string, regardless of case sensitivity.
+     * @param wildcard_string
+     * @return The sorted IDs of the candidate entries, or std::nullopt if the wildcard string
+     * doesn't contain a literal long enough to narrow down the candidates.
+     */
+    [[nodiscard]] auto get_candidate_ids(std::string_view wildcard_string) const
+            -> std::optional<std::vector<uint64_t>>;
+
+    void clear() { m_ngram_to_ids.clear(); }
+
+private:
+    // Types
+    using ngram_t = uint32_t;
+
+    /**
+     * @param value
+     * @param pos
+     * @return The case-folded n-gram starting at the given position of the value.
+     */
+    [[nodiscard]] static auto get_ngram(std::string_view value, size_t pos) -> ngram_t;
+
+    absl::flat_hash_map<ngram_t, std::vector<uint64_t>> m_ngram_to_ids;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_DICTIONARYINDEX_HPP
@@ -4,6 +4,7 @@
 #define CLP_S_DICTIONARYREADER_HPP
 
 #include <iterator>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -15,6 +16,7 @@
 #include "../clp/Defs.h"
 #include "ArchiveReaderAdaptor.hpp"
 #include "DictionaryEntry.hpp"
+#include "DictionaryIndex.hpp"
 
 namespace clp_s {
 template <typename DictionaryIdType, typename EntryType>
@@ -38,8 +40,10 @@ public:
     /**
      * Opens dictionary for reading
      * @param dictionary_path
+     * @param index_path the archive section containing the dictionary's `DictionaryIndex`, or an
+     * empty string if the dictionary isn't indexed
      */
-    void open(std::string const& dictionary_path);
+    void open(std::string const& dictionary_path, std::string const& index_path = {});
 
     /**
      * Closes the dictionary
@@ -78,7 +82,9 @@ public:
     get_entry_matching_value(std::string_view search_string, bool ignore_case) const;
 
     /**
-     * Gets the entries that match a given wildcard string
+     * Gets the entries that match a given wildcard string. If the dictionary is indexed, the index
+     * is read the first time this method is called and only the candidate entries it returns are
+     * matched against the wildcard string.
      * @param wildcard_string
      * @param ignore_case
      * @param entries Set in which to store found entries
@@ -90,11 +96,18 @@ public:
     ) const;
 
 protected:
+    /**
+     * @return The dictionary's index, reading it if necessary, or nullptr if it isn't indexed
+     */
+    DictionaryIndex const* get_index() const;
+
     bool m_is_open;
     ArchiveReaderAdaptor& m_adaptor;
     std::string m_dictionary_path;
+    std::string m_index_path;
     ZstdDecompressor m_dictionary_decompressor;
     std::vector<EntryType> m_entries;
+    mutable std::optional<DictionaryIndex> m_index;
 };
 
 using VariableDictionaryReader
@@ -103,12 +116,16 @@ using LogTypeDictionaryReader
         = DictionaryReader<clp::logtype_dictionary_id_t, LogTypeDictionaryEntry>;
 
 template <typename DictionaryIdType, typename EntryType>
-void DictionaryReader<DictionaryIdType, EntryType>::open(std::string const& dictionary_path) {
+void DictionaryReader<DictionaryIdType, EntryType>::open(
+        std::string const& dictionary_path,
+        std::string const& index_path
+) {
     if (m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
 
     m_dictionary_path = dictionary_path;
+    m_index_path = index_path;
     m_is_open = true;
 }
 
@@ -117,6 +134,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::close() {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
+    m_index.reset();
     m_is_open = false;
 }
 
@@ -204,6 +222,28 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
+    if (auto const* index = get_index(); nullptr != index) {
+        if (auto const candidate_ids = index->get_candidate_ids(wildcard_string);
+            candidate_ids.has_value())
+        {
+            for (auto const id : candidate_ids.value()) {
+                if (id >= m_entries.size()) {
+                    throw OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+                }
+                auto const& entry = m_entries[id];
+                if (clp::string_utils::wildcard_match_unsafe(
+                            entry.get_value(),
+                            wildcard_string,
+                            !ignore_case
+                    ))
+                {
+                    entries.insert(&entry);
+                }
+            }
+            return;
+        }
+    }
+
     for (auto const& entry : m_entries) {
         if (clp::string_utils::wildcard_match_unsafe(
                     entry.get_value(),
@@ -215,6 +255,26 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         }
     }
 }
+
+template <typename DictionaryIdType, typename EntryType>
+DictionaryIndex const* DictionaryReader<DictionaryIdType, EntryType>::get_index() const {
+    if (m_index_path.empty()) {
+        return nullptr;
+    }
+    if (m_index.has_value()) {
+        return &m_index.value();
+    }
+
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+    auto index_reader = m_adaptor.checkout_reader_for_section(m_index_path);
+    ZstdDecompressor index_decompressor;
+    index_decompressor.open(*index_reader, cDecompressorFileReadBufferCapacity);
+    auto& index = m_index.emplace();
+    index.read(index_decompressor);
+    index_decompressor.close();
+    m_adaptor.checkin_reader_for_section(m_index_path);
+    return &index;
+}
 }  // namespace clp_s
 
 #endif  // CLP_S_DICTIONARYREADER_HPP
@@ -3,10 +3,13 @@
 #ifndef CLP_S_DICTIONARYWRITER_HPP
 #define CLP_S_DICTIONARYWRITER_HPP
 
+#include <string>
+
 #include <absl/container/flat_hash_map.h>
 
 #include "../clp/Defs.h"
 #include "DictionaryEntry.hpp"
+#include "DictionaryIndex.hpp"
 
 namespace clp_s {
 template <typename DictionaryIdType, typename EntryType>
@@ -43,6 +46,14 @@ public:
      */
     [[nodiscard]] size_t close();
 
+    /**
+     * Writes a `DictionaryIndex` of the dictionary's entries to a file. Must be called before the
+     * dictionary is closed.
+     * @param index_path
+     * @return the compressed size of the index in bytes
+     */
+    [[nodiscard]] size_t write_index(std::string const& index_path);
+
     /**
      * Writes the dictionary's header and flushes unwritten content to disk
      */
@@ -64,6 +75,7 @@ protected:
     // Variables related to on-disk storage
     FileWriter m_dictionary_file_writer;
     ZstdCompressor m_dictionary_compressor;
+    int m_compression_level{};
 
     value_to_id_t m_value_to_id;
     uint64_t m_next_id{};
@@ -124,6 +136,7 @@ void DictionaryWriter<DictionaryIdType, EntryType>::open(
     m_dictionary_file_writer.write_numeric_value<uint64_t>(0);
     // Open compressor
     m_dictionary_compressor.open(m_dictionary_file_writer, compression_level);
+    m_compression_level = compression_level;
 
     m_next_id = 0;
     m_max_id = max_id;
@@ -149,6 +162,19 @@ size_t DictionaryWriter<DictionaryIdType, EntryType>::close() {
     return compressed_size;
 }
 
+template <typename DictionaryIdType, typename EntryType>
+size_t DictionaryWriter<DictionaryIdType, EntryType>::write_index(std::string const& index_path) {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
+    }
+
+    DictionaryIndex index;
+    for (auto const& [value, id] : m_value_to_id) {
+        index.add_entry(value, id);
+    }
+    return index.store(index_path, m_compression_level);
+}
+
 template <typename DictionaryIdType, typename EntryType>
 void DictionaryWriter<DictionaryIdType, EntryType>::write_header_and_flush_to_disk() {
     if (false == m_is_open) {
@@ -0,0 +1,454 @@
+#ifndef CLP_S_INTEGERCOLUMNENCODING_HPP
+#define CLP_S_INTEGERCOLUMNENCODING_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BufferViewReader.hpp"
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+#include "Utils.hpp"
+#include "ZstdCompressor.hpp"
+
+namespace clp_s {
+/**
+ * The encodings that can be used to store a column of 64-bit integers (e.g., integer values or
+ * dictionary IDs). Every encoded column starts with the encoding, followed by:
+ * - Raw: the values.
+ * - BitPacked (frame of reference): the bit width `w` (8-bit) and the minimum value (64-bit),
+ *   followed by the difference between each value and the minimum, packed into `w` bits each and
+ *   stored in 64-bit words (least significant bits first).
+ * - RunLength: the number of runs (64-bit), followed by the value of each run and then the
+ *   (exclusive) index at which each run ends.
+ */
+enum class IntegerEncoding : uint8_t {
+    Raw = 0,
+    BitPacked = 1,
+    RunLength = 2
+};
+
+/**
+ * Chooses the smallest encoding for a column of 64-bit integers and stores the column with it.
+ * @tparam T The type of the integers.
+ */
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+class IntegerColumnEncoder {
+public:
+    // Methods
+    /**
+     * Chooses the smallest encoding for the given values.
+     * @param values
+     * @return The size of the encoded values in bytes.
+     */
+    auto choose_encoding(std::vector<T> const& values) -> size_t;
+
+    /**
+     * Stores the given values using the encoding chosen by the last call to `choose_encoding`.
+     * @param values The same values that were passed to `choose_encoding`.
+     * @param compressor
+     */
+    void store(std::vector<T> const& values, ZstdCompressor& compressor) const;
+
+    [[nodiscard]] auto get_encoding() const -> IntegerEncoding { return m_encoding; }
+
+private:
+    IntegerEncoding m_encoding{IntegerEncoding::Raw};
+    uint8_t m_bit_width{};
+    T m_reference{};
+};
+
+/**
+ * A column of 64-bit integers stored by `IntegerColumnEncoder` which is only decoded once it's
+ * needed. Reading the column only parses its header, so columns that are never accessed (e.g.,
+ * columns that are neither filtered on nor projected, or every column in a table without matches)
+ * are never decoded. Individual values are decoded in place, while `get_values` decodes the whole
+ * column the first time it's called.
+ * @tparam T The type of the integers.
+ */
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+class LazyIntegerColumn {
+public:
+    // Methods
+    /**
+     * Reads the header of a column stored by `IntegerColumnEncoder` and views its data.
+     * @param reader
+     * @param num_values
+     * @throw BufferViewReader::OperationFailed if the column is corrupt.
+     */
+    void read(BufferViewReader& reader, size_t num_values);
+
+    /**
+     * Views a column of values stored without an encoding.
+     * @param reader
+     * @param num_values
+     * @throw BufferViewReader::OperationFailed if the column is truncated.
+     */
+    void read_unencoded(BufferViewReader& reader, size_t num_values);
+
+    [[nodiscard]] auto get_encoding() const -> IntegerEncoding { return m_encoding; }
+
+    [[nodiscard]] auto size() const -> size_t { return m_num_values; }
+
+    /**
+     * @param i
+     * @return The value at index `i`. Accessing the values of a run-length encoded column in order
+     * takes constant time per value.
+     */
+    [[nodiscard]] auto operator[](size_t i) -> T;
+
+    /**
+     * Decodes every value in the column.
+     * @param values Returns the decoded values.
+     */
+    void decode(std::vector<T>& values) const;
+
+    /**
+     * @return A view of every value in the column, decoding the column if it hasn't been already.
+     * The view is only valid as long as this object and the buffer viewed by the reader are.
+     */
+    [[nodiscard]] auto get_values() -> UnalignedMemSpan<T>;
+
+private:
+    // Methods
+    /**
+     * @param i
+     * @return The run containing index `i` of a run-length encoded column.
+     */
+    [[nodiscard]] auto find_run(size_t i) -> size_t;
+
+    // Variables
+    IntegerEncoding m_encoding{IntegerEncoding::Raw};
+    size_t m_num_values{0};
+
+    // The raw values, or the decoded values once the column has been decoded
+    UnalignedMemSpan<T> m_values;
+    std::vector<T> m_decoded_values;
+    bool m_is_decoded{false};
+
+    // BitPacked
+    uint8_t m_bit_width{};
+    T m_reference{};
+    UnalignedMemSpan<uint64_t> m_words;
+
+    // RunLength
+    UnalignedMemSpan<T> m_run_values;
+    UnalignedMemSpan<uint64_t> m_run_ends;
+    size_t m_cur_run{0};
+};
+
+namespace integer_column_encoding::internal {
+constexpr size_t cBitsPerWord{64};
+
+/**
+ * @param num_values
+ * @param bit_width
+ * @return The number of 64-bit words needed to store `num_values` values of `bit_width` bits.
+ */
+constexpr auto get_num_packed_words(size_t num_values, size_t bit_width) -> size_t {
+    return (num_values * bit_width + cBitsPerWord - 1) / cBitsPerWord;
+}
+
+/**
+ * @param words
+ * @param bit_width
+ * @param i
+ * @return The `i`th value packed into `bit_width` bits, where `bit_width` is non-zero.
+ */
+inline auto get_packed_value(UnalignedMemSpan<uint64_t> words, size_t bit_width, size_t i)
+        -> uint64_t {
+    uint64_t const mask{cBitsPerWord == bit_width ? ~0ULL : (1ULL << bit_width) - 1};
+    auto const bit_pos{i * bit_width};
+    auto const word_idx{bit_pos / cBitsPerWord};
+    auto const shift{bit_pos % cBitsPerWord};
+    uint64_t value{words[word_idx] >> shift};
+    if (shift + bit_width > cBitsPerWord) {
+        value |= words[word_idx + 1] << (cBitsPerWord - shift);
+    }
+    return value & mask;
+}
+
+/**
+ * Unpacks values packed into `bit_width` bits each and adds them to `reference`. The loop is kept
+ * simple (a fixed stride per value) so that the compiler can vectorize it.
+ * @tparam T
+ * @param words
+ * @param bit_width
+ * @param reference
+ * @param values Returns the unpacked values. Must already be sized to the number of values.
+ */
+template <typename T>
+void unpack(
+        UnalignedMemSpan<uint64_t> words,
+        size_t bit_width,
+        T reference,
+        std::vector<T>& values
+) {
+    auto const unsigned_reference{static_cast<uint64_t>(reference)};
+    if (0 == bit_width) {
+        std::fill(values.begin(), values.end(), reference);
+        return;
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<T>(unsigned_reference + get_packed_value(words, bit_width, i));
+    }
+}
+}  // namespace integer_column_encoding::internal
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+auto IntegerColumnEncoder<T>::choose_encoding(std::vector<T> const& values) -> size_t {
+    using integer_column_encoding::internal::get_num_packed_words;
+
+    m_encoding = IntegerEncoding::Raw;
+    size_t const raw_size{sizeof(IntegerEncoding) + values.size() * sizeof(T)};
+    if (values.empty()) {
+        return raw_size;
+    }
+
+    auto const [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+    size_t num_runs{1};
+    for (size_t i = 1; i < values.size(); ++i) {
+        if (values[i] != values[i - 1]) {
+            ++num_runs;
+        }
+    }
+
+    // Subtracting the unsigned representations gives the range of signed values as well
+    auto const range{static_cast<uint64_t>(*max_it) - static_cast<uint64_t>(*min_it)};
+    auto const bit_width{static_cast<uint8_t>(std::bit_width(range))};
+    size_t const bit_packed_size{
+            sizeof(IntegerEncoding) + sizeof(uint8_t) + sizeof(T)
+            + get_num_packed_words(values.size(), bit_width) * sizeof(uint64_t)
+    };
+    size_t const run_length_size{
+            sizeof(IntegerEncoding) + sizeof(uint64_t) + num_runs * (sizeof(T) + sizeof(uint64_t))
+    };
+
+    // Prefer the encodings that are cheaper to decode when sizes are equal
+    size_t size{raw_size};
+    if (bit_packed_size < size) {
+        m_encoding = IntegerEncoding::BitPacked;
+        m_bit_width = bit_width;
+        m_reference = *min_it;
+        size = bit_packed_size;
+    }
+    if (run_length_size < size) {
+        m_encoding = IntegerEncoding::RunLength;
+        size = run_length_size;
+    }
+    return size;
+}
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+void IntegerColumnEncoder<T>::store(std::vector<T> const& values, ZstdCompressor& compressor)
+        const {
+    using integer_column_encoding::internal::cBitsPerWord;
+    using integer_column_encoding::internal::get_num_packed_words;
+
+    compressor.write_numeric_value(m_encoding);
+    switch (m_encoding) {
+        case IntegerEncoding::Raw:
+            compressor.write(
+                    reinterpret_cast<char const*>(values.data()),
+                    values.size() * sizeof(T)
+            );
+            break;
+        case IntegerEncoding::BitPacked: {
+            compressor.write_numeric_value(m_bit_width);
+            compressor.write_numeric_value(m_reference);
+            std::vector<uint64_t> words(get_num_packed_words(values.size(), m_bit_width), 0);
+            auto const unsigned_reference{static_cast<uint64_t>(m_reference)};
+            for (size_t i = 0; i < values.size() && 0 != m_bit_width; ++i) {
+                auto const delta{static_cast<uint64_t>(values[i]) - unsigned_reference};
+                auto const bit_pos{i * m_bit_width};
+                auto const word_idx{bit_pos / cBitsPerWord};
+                auto const shift{bit_pos % cBitsPerWord};
+                words[word_idx] |= delta << shift;
+                if (shift + m_bit_width > cBitsPerWord) {
+                    words[word_idx + 1] |= delta >> (cBitsPerWord - shift);
+                }
+            }
+            compressor.write(
+                    reinterpret_cast<char const*>(words.data()),
+                    words.size() * sizeof(uint64_t)
+            );
+            break;
+        }
+        case IntegerEncoding::RunLength: {
+            std::vector<T> run_values;
+            std::vector<uint64_t> run_ends;
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (run_values.empty() || values[i] != run_values.back()) {
+                    if (false == run_values.empty()) {
+                        run_ends.push_back(i);
+                    }
+                    run_values.push_back(values[i]);
+                }
+            }
+            run_ends.push_back(values.size());
+            compressor.write_numeric_value<uint64_t>(run_values.size());
+            compressor.write(
+                    reinterpret_cast<char const*>(run_values.data()),
+                    run_values.size() * sizeof(T)
+            );
+            compressor.write(
+                    reinterpret_cast<char const*>(run_ends.data()),
+                    run_ends.size() * sizeof(uint64_t)
+            );
+            break;
+        }
+    }
+}
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+void LazyIntegerColumn<T>::read(BufferViewReader& reader, size_t num_values) {
+    using integer_column_encoding::internal::cBitsPerWord;
+    using integer_column_encoding::internal::get_num_packed_words;
+
+    m_num_values = num_values;
+    m_decoded_values.clear();
+    m_is_decoded = false;
+    m_cur_run = 0;
+
+    m_encoding = reader.read_value<IntegerEncoding>();
+    switch (m_encoding) {
+        case IntegerEncoding::Raw:
+            m_values = reader.read_unaligned_span<T>(num_values);
+            m_is_decoded = true;
+            break;
+        case IntegerEncoding::BitPacked:
+            m_bit_width = reader.read_value<uint8_t>();
+            m_reference = reader.read_value<T>();
+            if (m_bit_width > cBitsPerWord) {
+                throw BufferViewReader::OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+            }
+            m_words = reader.read_unaligned_span<uint64_t>(
+                    get_num_packed_words(num_values, m_bit_width)
+            );
+            break;
+        case IntegerEncoding::RunLength: {
+            auto const num_runs{reader.read_value<uint64_t>()};
+            m_run_values = reader.read_unaligned_span<T>(num_runs);
+            m_run_ends = reader.read_unaligned_span<uint64_t>(num_runs);
+            if (num_values > 0 && (0 == num_runs || num_values != m_run_ends[num_runs - 1])) {
+                throw BufferViewReader::OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+            }
+            // Validating the runs up front (there are usually far fewer runs than values) lets
+            // values be looked up without any further checks
+            uint64_t run_begin{0};
+            for (size_t i = 0; i < num_runs; ++i) {
+                auto const run_end{m_run_ends[i]};
+                if (run_end < run_begin || run_end > num_values) {
+                    throw BufferViewReader::OperationFailed(
+                            ErrorCodeCorrupt,
+                            __FILENAME__,
+                            __LINE__
+                    );
+                }
+                run_begin = run_end;
+            }
+            break;
+        }
+        default:
+            throw BufferViewReader::OperationFailed(ErrorCodeCorrupt, __FILENAME__, __LINE__);
+    }
+}
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+void LazyIntegerColumn<T>::read_unencoded(BufferViewReader& reader, size_t num_values) {
+    m_encoding = IntegerEncoding::Raw;
+    m_num_values = num_values;
+    m_decoded_values.clear();
+    m_values = reader.read_unaligned_span<T>(num_values);
+    m_is_decoded = true;
+}
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+auto LazyIntegerColumn<T>::operator[](size_t i) -> T {
+    if (m_is_decoded) {
+        return m_values[i];
+    }
+    if (IntegerEncoding::BitPacked == m_encoding) {
+        if (0 == m_bit_width) {
+            return m_reference;
+        }
+        return static_cast<T>(
+                static_cast<uint64_t>(m_reference)
+                + integer_column_encoding::internal::get_packed_value(m_words, m_bit_width, i)
+        );
+    }
+    return m_run_values[find_run(i)];
+}
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+auto LazyIntegerColumn<T>::find_run(size_t i) -> size_t {
+    auto const run_begin{0 == m_cur_run ? 0 : m_run_ends[m_cur_run - 1]};
+    if (run_begin <= i && i < m_run_ends[m_cur_run]) {
+        return m_cur_run;
+    }
+
+    // Find the first run which ends after `i`
+    size_t low{i < run_begin ? 0 : m_cur_run + 1};
+    size_t high{i < run_begin ? m_cur_run : m_run_ends.size() - 1};
+    while (low < high) {
+        auto const mid{low + (high - low) / 2};
+        if (m_run_ends[mid] <= i) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    m_cur_run = low;
+    return m_cur_run;
+}
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+void LazyIntegerColumn<T>::decode(std::vector<T>& values) const {
+    values.resize(m_num_values);
+    if (m_is_decoded) {
+        for (size_t i = 0; i < m_num_values; ++i) {
+            values[i] = m_values[i];
+        }
+        return;
+    }
+    if (IntegerEncoding::BitPacked == m_encoding) {
+        integer_column_encoding::internal::unpack(m_words, m_bit_width, m_reference, values);
+        return;
+    }
+    size_t run_begin{0};
+    for (size_t i = 0; i < m_run_values.size(); ++i) {
+        auto const run_end{m_run_ends[i]};
+        std::fill(
+                values.begin() + static_cast<std::ptrdiff_t>(run_begin),
+                values.begin() + static_cast<std::ptrdiff_t>(run_end),
+                m_run_values[i]
+        );
+        run_begin = run_end;
+    }
+}
+
+template <typename T>
+requires(std::same_as<T, int64_t> || std::same_as<T, uint64_t>)
+auto LazyIntegerColumn<T>::get_values() -> UnalignedMemSpan<T> {
+    if (false == m_is_decoded) {
+        decode(m_decoded_values);
+        m_values = {reinterpret_cast<char*>(m_decoded_values.data()), m_decoded_values.size()};
+        m_is_decoded = true;
+    }
+    return m_values;
+}
+}  // namespace clp_s
+
+#endif  // CLP_S_INTEGERCOLUMNENCODING_HPP
@@ -35,7 +35,11 @@ JsonConstructor::JsonConstructor(JsonConstructorOption const& option) : m_option
 
 void JsonConstructor::store() {
     m_archive_reader = std::make_unique<ArchiveReader>();
-    m_archive_reader->open(m_option.archive_path, m_option.network_auth);
+    m_archive_reader->open(
+            m_option.archive_path,
+            m_option.network_auth,
+            m_option.use_memory_mapping
+    );
     m_archive_reader->read_dictionaries_and_metadata();
 
     if (m_option.ordered && false == m_archive_reader->has_log_order()) {
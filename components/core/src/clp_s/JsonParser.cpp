@@ -3,6 +3,7 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <stack>
@@ -28,6 +29,7 @@
 #include <clp/ffi/SchemaTree.hpp>
 #include <clp/ffi/Value.hpp>
 #include <clp/NetworkReader.hpp>
+#include <clp/ReadAheadReader.hpp>
 #include <clp/ReaderInterface.hpp>
 #include <clp/time_types.hpp>
 #include <clp_s/archive_constants.hpp>
@@ -140,6 +142,7 @@ auto round_trip_is_identical(std::string_view float_str, double value, float_for
 JsonParser::JsonParser(JsonParserOption const& option)
         : m_target_encoded_size(option.target_encoded_size),
           m_max_document_size(option.max_document_size),
+          m_num_threads(option.num_threads),
           m_timestamp_key(option.timestamp_key),
           m_structurize_arrays(option.structurize_arrays),
           m_record_log_order(option.record_log_order),
@@ -178,7 +181,9 @@ JsonParser::JsonParser(JsonParserOption const& option)
     m_archive_options.compression_level = option.compression_level;
     m_archive_options.print_archive_stats = option.print_archive_stats;
     m_archive_options.single_file_archive = option.single_file_archive;
+    m_archive_options.index_variable_dictionary = option.index_variable_dictionary;
     m_archive_options.min_table_size = option.min_table_size;
+    m_archive_options.num_threads = option.num_threads;
     m_archive_options.id = m_generator();
     m_archive_options.authoritative_timestamp = m_timestamp_column;
     m_archive_options.authoritative_timestamp_namespace = m_timestamp_namespace;
@@ -668,6 +673,12 @@ auto JsonParser::ingest_json(
         Path const& path,
         std::string const& archive_creator_id
 ) -> bool {
+    bool const is_pipelined{m_num_threads > 1};
+    if (is_pipelined) {
+        // Read (and decompress) the input ahead on a background thread
+        reader = std::make_shared<clp::ReadAheadReader>(std::move(reader));
+    }
+
     JsonFileIterator json_file_iterator(*reader, m_max_document_size);
     if (simdjson::error_code::SUCCESS != json_file_iterator.get_error()) {
         SPDLOG_ERROR(
@@ -683,6 +694,40 @@ auto JsonParser::ingest_json(
     size_t bytes_consumed_up_to_prev_archive{0ULL};
     size_t bytes_consumed_up_to_prev_record{0ULL};
 
+    // When pipelined, messages are appended to the archive in batches on a background thread, so
+    // the ID of each log event has to be tracked here rather than read from the archive writer.
+    std::unique_ptr<MessageAppender> message_appender;
+    MessageAppender::MessageBatch message_batch;
+    int64_t next_log_event_id{};
+    auto start_appending_messages = [&]() {
+        next_log_event_id = m_archive_writer->get_next_log_event_id();
+        if (is_pipelined) {
+            message_appender = std::make_unique<MessageAppender>(
+                    *m_archive_writer,
+                    cMaxNumQueuedMessageBatches
+            );
+        }
+    };
+    auto finish_appending_messages = [&]() -> bool {
+        if (nullptr == message_appender) {
+            return true;
+        }
+        bool succeeded{message_batch.empty() || message_appender->append(std::move(message_batch))};
+        message_batch.clear();
+        succeeded = message_appender->finish() && succeeded;
+        message_appender.reset();
+        if (false == succeeded) {
+            SPDLOG_ERROR("Failed to append messages from {} to the archive", path.path);
+        }
+        return succeeded;
+    };
+    auto get_data_size = [&]() -> size_t {
+        if (nullptr == message_appender) {
+            return m_archive_writer->get_data_size();
+        }
+        return message_appender->get_data_size();
+    };
+
     size_t file_split_number{0ULL};
     int32_t log_event_idx_node_id{};
     auto initialize_fields_for_archive = [&]() -> bool {
@@ -737,6 +782,7 @@ auto JsonParser::ingest_json(
         return false;
     }
     auto update_fields_after_archive_split = [&]() { ++file_split_number; };
+    start_appending_messages();
 
     while (json_file_iterator.get_json(json_it)) {
         m_current_schema.clear();
@@ -759,10 +805,7 @@ auto JsonParser::ingest_json(
 
         // Add log_event_idx field to metadata for record
         if (m_record_log_order) {
-            m_current_parsed_message.add_value(
-                    log_event_idx_node_id,
-                    m_archive_writer->get_next_log_event_id()
-            );
+            m_current_parsed_message.add_value(log_event_idx_node_id, next_log_event_id);
             m_current_schema.insert_ordered(log_event_idx_node_id);
         }
 
@@ -783,11 +826,31 @@ auto JsonParser::ingest_json(
 
         int32_t current_schema_id = m_archive_writer->add_schema(m_current_schema);
         m_current_parsed_message.set_id(current_schema_id);
-        m_archive_writer
-                ->append_message(current_schema_id, m_current_schema, m_current_parsed_message);
+        if (nullptr == message_appender) {
+            m_archive_writer
+                    ->append_message(current_schema_id, m_current_schema, m_current_parsed_message);
+        } else {
+            message_batch.emplace_back(
+                    m_archive_writer
+                            ->get_or_create_schema_writer(current_schema_id, m_current_schema),
+                    std::move(m_current_parsed_message)
+            );
+            if (message_batch.size() >= cMessageBatchSize) {
+                if (false == message_appender->append(std::move(message_batch))) {
+                    std::ignore = finish_appending_messages();
+                    return false;
+                }
+                message_batch.clear();
+                message_batch.reserve(cMessageBatchSize);
+            }
+        }
+        ++next_log_event_id;
 
         bytes_consumed_up_to_prev_record = json_file_iterator.get_num_bytes_consumed();
-        if (m_archive_writer->get_data_size() >= m_target_encoded_size) {
+        if (get_data_size() >= m_target_encoded_size) {
+            if (false == finish_appending_messages()) {
+                return false;
+            }
             m_archive_writer->increment_uncompressed_size(
                     bytes_consumed_up_to_prev_record - bytes_consumed_up_to_prev_archive
             );
@@ -797,11 +860,16 @@ auto JsonParser::ingest_json(
             if (false == initialize_fields_for_archive()) {
                 return false;
             }
+            start_appending_messages();
         }
 
         m_current_parsed_message.clear();
     }
 
+    if (false == finish_appending_messages()) {
+        return false;
+    }
+
     m_archive_writer->increment_uncompressed_size(
             json_file_iterator.get_num_bytes_read() - bytes_consumed_up_to_prev_archive
     );
@@ -1315,6 +1383,38 @@ void JsonParser::split_archive() {
     m_archive_writer->open(m_archive_options);
 }
 
+auto JsonParser::MessageAppender::append(MessageBatch batch) -> bool {
+    if (m_failed) {
+        return false;
+    }
+    return m_batch_queue.push(std::move(batch));
+}
+
+auto JsonParser::MessageAppender::finish() -> bool {
+    m_batch_queue.close();
+    if (false == m_is_finished) {
+        join();
+        m_is_finished = true;
+    }
+    return false == m_failed;
+}
+
+void JsonParser::MessageAppender::thread_method() {
+    while (auto batch = m_batch_queue.pop()) {
+        try {
+            for (auto& [schema_writer, message] : batch.value()) {
+                m_archive_writer.append_message(schema_writer, message);
+            }
+            m_data_size = m_archive_writer.get_data_size();
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to append messages to the archive - {}", e.what());
+            m_failed = true;
+            m_batch_queue.close();
+            return;
+        }
+    }
+}
+
 bool JsonParser::check_and_log_curl_error(
         Path const& path,
         std::shared_ptr<clp::ReaderInterface> reader
@@ -1,12 +1,14 @@
 #ifndef CLP_S_JSONPARSER_HPP
 #define CLP_S_JSONPARSER_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -14,16 +16,19 @@
 #include <boost/uuid/random_generator.hpp>
 #include <simdjson.h>
 
+#include <clp/BoundedBlockingQueue.hpp>
 #include <clp/ffi/KeyValuePairLogEvent.hpp>
 #include <clp/ffi/SchemaTree.hpp>
 #include <clp/ffi/Value.hpp>
 #include <clp/ReaderInterface.hpp>
+#include <clp/Thread.hpp>
 #include <clp_s/ArchiveWriter.hpp>
 #include <clp_s/ErrorCode.hpp>
 #include <clp_s/InputConfig.hpp>
 #include <clp_s/ParsedMessage.hpp>
 #include <clp_s/Schema.hpp>
 #include <clp_s/SchemaTree.hpp>
+#include <clp_s/SchemaWriter.hpp>
 #include <clp_s/TraceableException.hpp>
 
 namespace clp_s {
@@ -34,12 +39,14 @@ struct JsonParserOption {
     size_t target_encoded_size{};
     size_t max_document_size{};
     size_t min_table_size{};
+    size_t num_threads{1};
     int compression_level{};
     bool print_archive_stats{};
     bool structurize_arrays{};
     bool record_log_order{true};
     bool retain_float_format{false};
     bool single_file_archive{false};
+    bool index_variable_dictionary{false};
     NetworkAuthOption network_auth{};
 };
 
@@ -71,9 +78,82 @@ public:
     [[nodiscard]] auto store() -> std::vector<ArchiveStats>;
 
 private:
+    /**
+     * Appends batches of parsed messages to the archive on a background thread, so that encoding
+     * the columns of previous messages overlaps with parsing the next ones.
+     *
+     * While the appender is running, the thread that creates it may only use the archive writer to
+     * parse messages (i.e., to add nodes, schemas, and timestamps, and to get the writers for
+     * tables), since the appender is concurrently appending to the tables and dictionaries.
+     */
+    class MessageAppender : public clp::Thread {
+    public:
+        // Types
+        using MessageBatch = std::vector<std::pair<SchemaWriter*, ParsedMessage>>;
+
+        // Constructor
+        /**
+         * Starts the appender.
+         * @param archive_writer
+         * @param max_num_queued_batches
+         */
+        MessageAppender(ArchiveWriter& archive_writer, size_t max_num_queued_batches)
+                : m_archive_writer{archive_writer},
+                  m_batch_queue{max_num_queued_batches},
+                  m_data_size{archive_writer.get_data_size()} {
+            start();
+        }
+
+        // Destructor
+        ~MessageAppender() override { std::ignore = finish(); }
+
+        // Delete copy & move constructors and assignment operators
+        MessageAppender(MessageAppender const&) = delete;
+        MessageAppender(MessageAppender&&) = delete;
+        auto operator=(MessageAppender const&) -> MessageAppender& = delete;
+        auto operator=(MessageAppender&&) -> MessageAppender& = delete;
+
+        // Methods
+        /**
+         * Queues a batch of messages to be appended, blocking while the queue is full.
+         * @param batch
+         * @return Whether the batch was queued, i.e., false if the appender has failed.
+         */
+        [[nodiscard]] auto append(MessageBatch batch) -> bool;
+
+        /**
+         * Waits for every queued batch to be appended and stops the appender.
+         * @return Whether every batch was appended successfully.
+         */
+        [[nodiscard]] auto finish() -> bool;
+
+        /**
+         * @return The size of the archive's encoded data, as of the last batch to be appended.
+         */
+        [[nodiscard]] auto get_data_size() const -> size_t { return m_data_size; }
+
+    private:
+        // Methods implementing `clp::Thread`
+        void thread_method() override;
+
+        ArchiveWriter& m_archive_writer;
+        clp::BoundedBlockingQueue<MessageBatch> m_batch_queue;
+        std::atomic_size_t m_data_size;
+        std::atomic_bool m_failed{false};
+        bool m_is_finished{false};
+    };
+
+    static constexpr size_t cMessageBatchSize{1024};
+    static constexpr size_t cMaxNumQueuedMessageBatches{4};
+
     /**
      * Parses JSON input and ingests it into the current archive, splitting the archive if it grows
      * beyond the target encoded size.
+     *
+     * If more than one thread is configured, ingestion is pipelined: the input is read (and
+     * decompressed) ahead on one thread, parsed on the calling thread, and appended to the archive
+     * on another. In this mode, the archive is split once the appended data reaches the target
+     * encoded size, which may be a few batches after the message that crossed it.
      * @param reader
      * @param path
      * @param archive_creator_id
@@ -236,6 +316,7 @@ private:
     ArchiveWriterOption m_archive_options{};
     size_t m_target_encoded_size;
     size_t m_max_document_size;
+    size_t m_num_threads{1};
     bool m_structurize_arrays{false};
     bool m_record_log_order{true};
     bool m_retain_float_format{false};
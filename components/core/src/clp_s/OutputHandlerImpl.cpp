@@ -1,5 +1,8 @@
 #include "OutputHandlerImpl.hpp"
 
+#include <cctype>
+#include <cstddef>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -147,6 +150,17 @@ void ResultsCacheOutputHandler::write(
         string_view archive_id,
         int64_t log_event_idx
 ) {
+    // Results that aren't among the latest results written so far can't be among the latest
+    // results overall
+    if (m_latest_timestamps.size() < m_max_num_results) {
+        m_latest_timestamps.push(timestamp);
+    } else if (m_latest_timestamps.empty() || m_latest_timestamps.top() >= timestamp) {
+        return;
+    } else {
+        m_latest_timestamps.pop();
+        m_latest_timestamps.push(timestamp);
+    }
+
     if (m_latest_results.size() < m_max_num_results) {
         m_latest_results.emplace(
                 std::make_unique<QueryResult>(
@@ -171,6 +185,13 @@ void ResultsCacheOutputHandler::write(
     }
 }
 
+auto ResultsCacheOutputHandler::get_timestamp_cutoff() const -> std::optional<epochtime_t> {
+    if (m_latest_timestamps.empty() || m_latest_timestamps.size() < m_max_num_results) {
+        return std::nullopt;
+    }
+    return m_latest_timestamps.top();
+}
+
 CountOutputHandler::CountOutputHandler(int reducer_socket_fd)
         : ::clp_s::search::OutputHandler(false, false),
           m_reducer_socket_fd(reducer_socket_fd),
@@ -191,6 +212,90 @@ ErrorCode CountOutputHandler::finish() {
     return ErrorCode::ErrorCodeSuccess;
 }
 
+AggregateOutputHandler::AggregateOutputHandler(
+        int reducer_socket_fd,
+        reducer::AggregationType type,
+        string const& field,
+        double quantile
+)
+        : ::clp_s::search::OutputHandler(false, false),
+          m_reducer_socket_fd(reducer_socket_fd),
+          m_aggregates_string_values(reducer::aggregates_string_values(type)),
+          m_field(field),
+          m_pipeline(reducer::PipelineInputMode::InterStage) {
+    // Convert the dotted key into a JSON pointer, escaping '~' and '/' within each key
+    for (size_t begin_pos{0}; begin_pos <= field.size();) {
+        auto end_pos = field.find('.', begin_pos);
+        if (string::npos == end_pos) {
+            end_pos = field.size();
+        }
+        m_field_json_pointer.push_back('/');
+        for (auto const c : string_view{field}.substr(begin_pos, end_pos - begin_pos)) {
+            if ('~' == c) {
+                m_field_json_pointer += "~0";
+            } else if ('/' == c) {
+                m_field_json_pointer += "~1";
+            } else {
+                m_field_json_pointer.push_back(c);
+            }
+        }
+        begin_pos = end_pos + 1;
+    }
+
+    m_pipeline.add_pipeline_stage(reducer::create_aggregate_operator(type, field, quantile));
+}
+
+void AggregateOutputHandler::write(string_view message) {
+    simdjson::padded_string const padded_message{message};
+    simdjson::ondemand::document document;
+    simdjson::ondemand::value value;
+    simdjson::ondemand::json_type type{};
+    if (simdjson::SUCCESS != m_json_parser.iterate(padded_message).get(document)
+        || simdjson::SUCCESS != document.at_pointer(m_field_json_pointer).get(value)
+        || simdjson::SUCCESS != value.type().get(type))
+    {
+        return;
+    }
+
+    if (m_aggregates_string_values) {
+        string_view str;
+        if (simdjson::ondemand::json_type::string == type) {
+            if (simdjson::SUCCESS != value.get_string().get(str)) {
+                return;
+            }
+        } else if (simdjson::ondemand::json_type::number == type
+                   || simdjson::ondemand::json_type::boolean == type)
+        {
+            str = value.raw_json_token();
+            while (false == str.empty() && std::isspace(static_cast<unsigned char>(str.back())))
+            {
+                str.remove_suffix(1);
+            }
+        } else {
+            return;
+        }
+        m_record.set_record_value(m_field, string{str});
+    } else {
+        double number{};
+        if (simdjson::ondemand::json_type::number != type
+            || simdjson::SUCCESS != value.get_double().get(number))
+        {
+            return;
+        }
+        m_record.set_record_value(m_field, number);
+    }
+    m_pipeline.push_record(m_record);
+}
+
+ErrorCode AggregateOutputHandler::finish() {
+    if (false
+        == reducer::send_pipeline_results(m_reducer_socket_fd, std::move(m_pipeline.finish())))
+    {
+        return ErrorCode::ErrorCodeFailureNetwork;
+    }
+    return ErrorCode::ErrorCodeSuccess;
+}
+
 ErrorCode CountByTimeOutputHandler::finish() {
     if (false
         == reducer::send_pipeline_results(
@@ -5,7 +5,9 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <queue>
 #include <string>
 #include <string_view>
@@ -13,8 +15,11 @@
 
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
+#include <simdjson.h>
 
+#include "../reducer/AggregateOperator.hpp"
 #include "../reducer/Pipeline.hpp"
+#include "../reducer/Record.hpp"
 #include "../reducer/RecordGroupIterator.hpp"
 #include "Defs.hpp"
 #include "FileWriter.hpp"
@@ -185,6 +190,14 @@ public:
 
     void write(std::string_view message) override { write(message, 0, {}, 0); }
 
+    [[nodiscard]] auto keeps_latest_results() const -> bool override { return true; }
+
+    /**
+     * @return The timestamp of the earliest of the latest `max_num_results` results written so far,
+     * once that many results have been written.
+     */
+    [[nodiscard]] auto get_timestamp_cutoff() const -> std::optional<epochtime_t> override;
+
 private:
     mongocxx::client m_client;
     mongocxx::collection m_collection;
@@ -197,6 +210,10 @@ private:
             QueryResultGreaterTimestampComparator
     >
             m_latest_results;
+    // The timestamps of the latest results written across every flush, since `m_latest_results`
+    // is emptied by each flush
+    std::priority_queue<epochtime_t, std::vector<epochtime_t>, std::greater<>>
+            m_latest_timestamps;
 };
 
 /**
@@ -267,6 +284,54 @@ private:
     int64_t m_count_by_time_bucket_size;
 };
 
+/**
+ * Output handler that aggregates the values of a field of each result (e.g., their sum or an
+ * approximate percentile) and sends the partial aggregate to a reducer. Results that don't contain
+ * the field, or whose field value has the wrong type for the aggregation, are skipped.
+ */
+class AggregateOutputHandler : public ::clp_s::search::OutputHandler {
+public:
+    // Constructors
+    /**
+     * @param reducer_socket_fd
+     * @param type
+     * @param field The key of the field to aggregate, with nested keys separated by '.'.
+     * @param quantile The quantile to estimate, for reducer::AggregationType::ApproxPercentile.
+     */
+    AggregateOutputHandler(
+            int reducer_socket_fd,
+            reducer::AggregationType type,
+            std::string const& field,
+            double quantile
+    );
+
+    // Methods inherited from OutputHandler
+    void write(
+            std::string_view message,
+            epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) override {}
+
+    void write(std::string_view message) override;
+
+    /**
+     * Flushes the partial aggregate.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailureNetwork on network error
+     */
+    ErrorCode finish() override;
+
+private:
+    int m_reducer_socket_fd;
+    bool m_aggregates_string_values;
+    std::string m_field;
+    std::string m_field_json_pointer;
+    simdjson::ondemand::parser m_json_parser;
+    reducer::MultiValueRecordAdapter m_record;
+    reducer::Pipeline m_pipeline;
+};
+
 /**
  * Output handler that records all results in a provided vector.
  */
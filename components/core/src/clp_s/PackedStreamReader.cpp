@@ -1,5 +1,15 @@
 #include "PackedStreamReader.hpp"
 
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
 #include "../clp/BoundedReader.hpp"
 #include "archive_constants.hpp"
 #include "ArchiveReaderAdaptor.hpp"
@@ -56,9 +66,36 @@ void PackedStreamReader::open_packed_streams(std::shared_ptr<ArchiveReaderAdapto
     {
         throw OperationFailed(static_cast<ErrorCode>(rc), __FILE__, __LINE__);
     }
+    m_mapped_packed_streams = m_adaptor->get_mapped_section(constants::cArchiveTablesFile);
+}
+
+void PackedStreamReader::prefetch_streams(
+        std::vector<size_t> stream_ids,
+        size_t max_num_prefetched_streams
+) {
+    if (PackedStreamReaderState::PackedStreamsOpened != m_state || nullptr != m_prefetcher) {
+        throw OperationFailed(ErrorCodeNotReady, __FILE__, __LINE__);
+    }
+    for (size_t i = 0; i < stream_ids.size(); ++i) {
+        if (stream_ids[i] >= m_stream_metadata.size()) {
+            throw OperationFailed(ErrorCodeCorrupt, __FILE__, __LINE__);
+        }
+        if (i > 0 && stream_ids[i - 1] >= stream_ids[i]) {
+            throw OperationFailed(ErrorCodeBadParam, __FILE__, __LINE__);
+        }
+    }
+
+    m_prefetcher = std::make_unique<StreamPrefetcher>(
+            *this,
+            std::move(stream_ids),
+            max_num_prefetched_streams
+    );
+    m_prefetcher->start();
 }
 
 void PackedStreamReader::close() {
+    m_prefetcher.reset();
+
     bool needs_checkin{false};
     switch (m_state) {
         case PackedStreamReaderState::PackedStreamsOpened:
@@ -73,6 +110,7 @@ void PackedStreamReader::close() {
         m_adaptor->checkin_reader_for_section(constants::cArchiveTablesFile);
     }
     m_adaptor.reset();
+    m_mapped_packed_streams.reset();
     m_prev_stream_id = 0ULL;
     m_begin_offset = 0ULL;
     m_stream_metadata.clear();
@@ -81,7 +119,6 @@ void PackedStreamReader::close() {
 
 void
 PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size) {
-    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
     if (stream_id >= m_stream_metadata.size()) {
         throw OperationFailed(ErrorCodeCorrupt, __FILE__, __LINE__);
     }
@@ -100,21 +137,48 @@ PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf,
     }
     m_prev_stream_id = stream_id;
 
-    auto& [file_offset, uncompressed_size] = m_stream_metadata[stream_id];
-    size_t adjusted_file_offset = m_begin_offset + file_offset;
-    if (auto error = m_packed_stream_reader->try_seek_from_begin(adjusted_file_offset);
-        clp::ErrorCode::ErrorCode_Success != error)
-    {
-        throw OperationFailed(static_cast<ErrorCode>(error), __FILE__, __LINE__);
+    if (nullptr != m_prefetcher) {
+        read_prefetched_stream(stream_id, buf, buf_size);
+    } else {
+        decompress_stream(stream_id, buf, buf_size);
     }
+}
 
-    size_t end_pos = m_adaptor->get_header().compressed_size;
-    if ((stream_id + 1) < m_stream_metadata.size()) {
-        end_pos = m_begin_offset + m_stream_metadata[stream_id + 1].file_offset;
-    }
-    clp::BoundedReader bounded_reader{m_packed_stream_reader.get(), end_pos};
+void PackedStreamReader::decompress_stream(
+        size_t stream_id,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) {
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+    auto& [file_offset, uncompressed_size] = m_stream_metadata[stream_id];
+    std::optional<clp::BoundedReader> bounded_reader;
+    if (m_mapped_packed_streams.has_value()) {
+        size_t end_offset = m_mapped_packed_streams->size();
+        if ((stream_id + 1) < m_stream_metadata.size()) {
+            end_offset = m_stream_metadata[stream_id + 1].file_offset;
+        }
+        if (file_offset > end_offset || end_offset > m_mapped_packed_streams->size()) {
+            throw OperationFailed(ErrorCodeCorrupt, __FILE__, __LINE__);
+        }
+        m_packed_stream_decompressor.open(
+                m_mapped_packed_streams->data() + file_offset,
+                end_offset - file_offset
+        );
+    } else {
+        size_t adjusted_file_offset = m_begin_offset + file_offset;
+        if (auto error = m_packed_stream_reader->try_seek_from_begin(adjusted_file_offset);
+            clp::ErrorCode::ErrorCode_Success != error)
+        {
+            throw OperationFailed(static_cast<ErrorCode>(error), __FILE__, __LINE__);
+        }
 
-    m_packed_stream_decompressor.open(bounded_reader, cDecompressorFileReadBufferCapacity);
+        size_t end_pos = m_adaptor->get_header().compressed_size;
+        if ((stream_id + 1) < m_stream_metadata.size()) {
+            end_pos = m_begin_offset + m_stream_metadata[stream_id + 1].file_offset;
+        }
+        bounded_reader.emplace(m_packed_stream_reader.get(), end_pos);
+        m_packed_stream_decompressor.open(*bounded_reader, cDecompressorFileReadBufferCapacity);
+    }
     if (buf_size < uncompressed_size) {
         // make_shared is supposed to work here for c++20, but it seems like the compiler version
         // we use doesn't support it, so we convert a unique_ptr to a shared_ptr instead.
@@ -129,4 +193,58 @@ PackedStreamReader::read_stream(size_t stream_id, std::shared_ptr<char[]>& buf,
     }
     m_packed_stream_decompressor.close_for_reuse();
 }
+
+void PackedStreamReader::read_prefetched_stream(
+        size_t stream_id,
+        std::shared_ptr<char[]>& buf,
+        size_t& buf_size
+) {
+    while (auto prefetched_stream = m_prefetcher->get_next_stream()) {
+        if (ErrorCodeSuccess != prefetched_stream->error) {
+            throw OperationFailed(prefetched_stream->error, __FILE__, __LINE__);
+        }
+        if (prefetched_stream->stream_id < stream_id) {
+            // The caller skipped this stream
+            continue;
+        }
+        if (prefetched_stream->stream_id > stream_id) {
+            break;
+        }
+        buf = std::move(prefetched_stream->buf);
+        buf_size = prefetched_stream->buf_size;
+        return;
+    }
+    // The requested stream wasn't prefetched
+    throw OperationFailed(ErrorCodeBadParam, __FILE__, __LINE__);
+}
+
+PackedStreamReader::StreamPrefetcher::~StreamPrefetcher() {
+    // Unblock the background thread if it's waiting for space in the queue
+    m_prefetched_streams.close();
+    join();
+}
+
+void PackedStreamReader::StreamPrefetcher::thread_method() {
+    for (auto stream_id : m_stream_ids) {
+        PrefetchedStream prefetched_stream{.stream_id = stream_id};
+        try {
+            m_reader.decompress_stream(
+                    stream_id,
+                    prefetched_stream.buf,
+                    prefetched_stream.buf_size
+            );
+        } catch (TraceableException const& e) {
+            prefetched_stream.error = e.get_error_code();
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to prefetch stream {} - {}", stream_id, e.what());
+            prefetched_stream.error = ErrorCodeFailure;
+        }
+
+        auto const failed{ErrorCodeSuccess != prefetched_stream.error};
+        if (false == m_prefetched_streams.push(std::move(prefetched_stream)) || failed) {
+            break;
+        }
+    }
+    m_prefetched_streams.close();
+}
 }  // namespace clp_s
@@ -3,10 +3,14 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "../clp/BoundedBlockingQueue.hpp"
 #include "../clp/ReaderInterface.hpp"
+#include "../clp/Thread.hpp"
 #include "ArchiveReaderAdaptor.hpp"
 #include "ZstdDecompressor.hpp"
 
@@ -16,6 +20,12 @@ namespace clp_s {
  * read the tables section without loading the tables metadata, and any attempt to read tables
  * section out of order will throw. As well, any incorrect usage of this class (e.g. closing without
  * opening) will throw.
+ *
+ * When the archive is memory mapped, streams are decompressed straight from the mapping.
+ *
+ * If the streams that will be read are known in advance, they can be prefetched: a background
+ * thread then reads and decompresses the upcoming streams while the caller processes the current
+ * one.
  */
 class PackedStreamReader {
 public:
@@ -49,7 +59,18 @@ public:
     void open_packed_streams(std::shared_ptr<ArchiveReaderAdaptor> adaptor);
 
     /**
-     * Closes the file reader for the tables section.
+     * Starts reading and decompressing the given streams on a background thread, ahead of calls to
+     * `read_stream`. Must be invoked after opening the packed streams and before reading any
+     * streams. Once prefetching has started, only the given streams can be read, and any of them
+     * that are skipped by the caller are discarded.
+     * @param stream_ids the IDs of the streams to prefetch, in strictly ascending order
+     * @param max_num_prefetched_streams the maximum number of decompressed streams that can be
+     * buffered ahead of the caller
+     */
+    void prefetch_streams(std::vector<size_t> stream_ids, size_t max_num_prefetched_streams);
+
+    /**
+     * Closes the file reader for the tables section, stopping any prefetching.
      */
     void close();
 
@@ -70,6 +91,9 @@ public:
      * if it is too small to contain the requested stream.
      * @param buf_size the size of the underlying buffer owned by buf -- passed and updated by
      * reference
+     *
+     * When streams are being prefetched, `buf` is replaced with the buffer the stream was
+     * prefetched into rather than being reused.
      */
     void read_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
 
@@ -85,13 +109,87 @@ private:
         ReadingPackedStreams
     };
 
+    /**
+     * A stream decompressed by the prefetcher, or the error that stopped the prefetcher.
+     */
+    struct PrefetchedStream {
+        size_t stream_id{};
+        std::shared_ptr<char[]> buf;
+        size_t buf_size{};
+        ErrorCode error{ErrorCodeSuccess};
+    };
+
+    /**
+     * This class implements clp::Thread to read and decompress streams ahead of the caller.
+     */
+    class StreamPrefetcher : public clp::Thread {
+    public:
+        // Constructor
+        StreamPrefetcher(
+                PackedStreamReader& reader,
+                std::vector<size_t> stream_ids,
+                size_t max_num_prefetched_streams
+        )
+                : m_reader{reader},
+                  m_stream_ids{std::move(stream_ids)},
+                  m_prefetched_streams{max_num_prefetched_streams} {}
+
+        // Destructor
+        /**
+         * Stops prefetching and waits for the background thread to exit.
+         */
+        ~StreamPrefetcher() override;
+
+        // Delete copy & move constructors and assignment operators
+        StreamPrefetcher(StreamPrefetcher const&) = delete;
+        StreamPrefetcher(StreamPrefetcher&&) = delete;
+        auto operator=(StreamPrefetcher const&) -> StreamPrefetcher& = delete;
+        auto operator=(StreamPrefetcher&&) -> StreamPrefetcher& = delete;
+
+        // Methods
+        /**
+         * @return The next prefetched stream, or std::nullopt if every stream has been returned.
+         */
+        [[nodiscard]] auto get_next_stream() -> std::optional<PrefetchedStream> {
+            return m_prefetched_streams.pop();
+        }
+
+    private:
+        // Methods implementing `clp::Thread`
+        void thread_method() override;
+
+        PackedStreamReader& m_reader;
+        std::vector<size_t> m_stream_ids;
+        clp::BoundedBlockingQueue<PrefetchedStream> m_prefetched_streams;
+    };
+
+    /**
+     * Seeks to and decompresses a stream without checking the reader's state.
+     * @param stream_id
+     * @param buf
+     * @param buf_size
+     * @throw OperationFailed on failure
+     */
+    void decompress_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
+
+    /**
+     * Returns a prefetched stream, discarding any prefetched streams before it.
+     * @param stream_id
+     * @param buf
+     * @param buf_size
+     * @throw OperationFailed if the stream wasn't prefetched or if prefetching it failed
+     */
+    void read_prefetched_stream(size_t stream_id, std::shared_ptr<char[]>& buf, size_t& buf_size);
+
     std::vector<PackedStreamMetadata> m_stream_metadata;
     std::shared_ptr<ArchiveReaderAdaptor> m_adaptor;
     std::unique_ptr<clp::ReaderInterface> m_packed_stream_reader;
+    std::optional<std::span<char const>> m_mapped_packed_streams;
     ZstdDecompressor m_packed_stream_decompressor;
     PackedStreamReaderState m_state{PackedStreamReaderState::Uninitialized};
     size_t m_begin_offset{};
     size_t m_prev_stream_id{0ULL};
+    std::unique_ptr<StreamPrefetcher> m_prefetcher;
 };
 }  // namespace clp_s
 
@@ -29,6 +29,12 @@ public:
     // Constructor
     ParsedMessage() : m_schema_id(-1) {}
 
+    // Default copy & move constructors and assignment operators
+    ParsedMessage(ParsedMessage const&) = default;
+    ParsedMessage(ParsedMessage&&) noexcept = default;
+    auto operator=(ParsedMessage const&) -> ParsedMessage& = default;
+    auto operator=(ParsedMessage&&) noexcept -> ParsedMessage& = default;
+
     // Destructor
     ~ParsedMessage() = default;
 
@@ -59,7 +59,11 @@ std::shared_ptr<VariableDictionaryReader> ReaderUtils::get_variable_dictionary_r
         ArchiveReaderAdaptor& adaptor
 ) {
     auto reader = std::make_shared<VariableDictionaryReader>(adaptor);
-    reader->open(constants::cArchiveVarDictFile);
+    if (adaptor.has_section(constants::cArchiveVarDictIndexFile)) {
+        reader->open(constants::cArchiveVarDictFile, constants::cArchiveVarDictIndexFile);
+    } else {
+        reader->open(constants::cArchiveVarDictFile);
+    }
     return reader;
 }
 
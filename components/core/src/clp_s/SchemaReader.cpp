@@ -242,14 +242,17 @@ bool SchemaReader::get_next_message_with_metadata(
         int64_t& log_event_idx,
         FilterClass* filter
 ) {
-    // TODO: If we already get max_num_results messages, we can skip messages
-    // with the timestamp less than the smallest timestamp in the priority queue
     while (m_cur_message < m_num_messages) {
         if (false == filter->filter(m_cur_message)) {
             m_cur_message++;
             continue;
         }
 
+        if (m_timestamp_cutoff.has_value() && m_get_timestamp() <= m_timestamp_cutoff.value()) {
+            m_cur_message++;
+            continue;
+        }
+
         if (m_should_marshal_records) {
             if (false == m_serializer_initialized) {
                 initialize_serializer();
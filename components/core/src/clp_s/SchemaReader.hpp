@@ -2,6 +2,7 @@
 #define CLP_S_SCHEMAREADER_HPP
 
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <type_traits>
@@ -104,6 +105,7 @@ public:
         m_reordered_columns.clear();
         m_timestamp_column = nullptr;
         m_get_timestamp = []() -> epochtime_t { return 0; };
+        m_timestamp_cutoff.reset();
         m_log_event_idx_column = nullptr;
         m_local_id_to_global_id.clear();
         m_global_id_to_local_id.clear();
@@ -142,7 +144,9 @@ public:
     );
 
     /**
-     * Loads the encoded messages from a shared buffer starting at a given offset
+     * Loads the encoded messages from a shared buffer starting at a given offset. Encoded integer
+     * columns are only decoded once they're accessed, so columns which are never filtered on or
+     * marshalled cost nothing beyond reading their headers.
      * @param stream_buffer
      * @param offset
      * @param uncompressed_size
@@ -178,6 +182,8 @@ public:
 
     /**
      * Gets the next message matching a filter as well as its timestamp and log event index.
+     * Messages with timestamps at or before the timestamp cutoff (if any) are skipped without
+     * being marshalled.
      * @param message
      * @param timestamp
      * @param log_event_idx
@@ -191,6 +197,15 @@ public:
             FilterClass* filter
     );
 
+    /**
+     * Sets the timestamp that messages returned by `get_next_message_with_metadata` must be later
+     * than.
+     * @param timestamp_cutoff The cutoff, or std::nullopt to return messages with any timestamp.
+     */
+    void set_timestamp_cutoff(std::optional<epochtime_t> timestamp_cutoff) {
+        m_timestamp_cutoff = timestamp_cutoff;
+    }
+
     /**
      * Initializes the filter
      * @param filter
@@ -323,6 +338,7 @@ private:
 
     BaseColumnReader* m_timestamp_column;
     std::function<epochtime_t()> m_get_timestamp;
+    std::optional<epochtime_t> m_timestamp_cutoff;
     BaseColumnReader* m_log_event_idx_column{nullptr};
 
     std::shared_ptr<SchemaTree> m_global_schema_tree;
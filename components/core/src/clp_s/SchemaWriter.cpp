@@ -1,23 +1,29 @@
 #include "SchemaWriter.hpp"
 
+#include <cstddef>
 #include <utility>
 
 namespace clp_s {
 void SchemaWriter::append_column(BaseColumnWriter* column_writer) {
     m_total_uncompressed_size += column_writer->get_total_header_size();
     m_columns.push_back(column_writer);
+    m_column_sizes.push_back(column_writer->get_total_header_size());
 }
 
 size_t SchemaWriter::append_message(ParsedMessage& message) {
     int count{};
     size_t total_size{};
     for (auto& i : message.get_content()) {
-        total_size += m_columns[count]->add_value(i.second);
+        auto const size = m_columns[count]->add_value(i.second);
+        m_column_sizes[count] += size;
+        total_size += size;
         ++count;
     }
 
     for (auto& i : message.get_unordered_content()) {
-        total_size += m_columns[count]->add_value(i);
+        auto const size = m_columns[count]->add_value(i);
+        m_column_sizes[count] += size;
+        total_size += size;
         ++count;
     }
 
@@ -26,12 +32,31 @@ size_t SchemaWriter::append_message(ParsedMessage& message) {
     return total_size;
 }
 
+void SchemaWriter::finalize() {
+    m_total_uncompressed_size = 0;
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        m_total_uncompressed_size += m_columns[i]->finalize(m_column_sizes[i]);
+    }
+}
+
 void SchemaWriter::store(ZstdCompressor& compressor) {
     for (auto& writer : m_columns) {
         writer->store(compressor);
     }
 }
 
+void SchemaWriter::collect_statistics(TableStatistics& statistics) const {
+    for (auto const* writer : m_columns) {
+        // The same column may appear more than once in a schema (e.g., in structured arrays), in
+        // which case its statistics cover every occurrence
+        auto& column_statistics = statistics[writer->get_id()];
+        writer->collect_statistics(column_statistics);
+        if (column_statistics.empty()) {
+            statistics.erase(writer->get_id());
+        }
+    }
+}
+
 SchemaWriter::~SchemaWriter() {
     for (auto i : m_columns) {
         delete i;
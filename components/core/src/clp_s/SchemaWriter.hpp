@@ -3,6 +3,7 @@
 
 #include <vector>
 
+#include "ColumnStatistics.hpp"
 #include "ColumnWriter.hpp"
 #include "FileWriter.hpp"
 #include "ParsedMessage.hpp"
@@ -37,16 +38,29 @@ public:
      */
     size_t append_message(ParsedMessage& message);
 
+    /**
+     * Prepares the columns to be stored once every message has been appended. Must be called
+     * before `store`.
+     */
+    void finalize();
+
     /**
      * Stores the columns to disk.
      * @param compressor
      */
     void store(ZstdCompressor& compressor);
 
+    /**
+     * Collects statistics about the values in each column that supports them.
+     * @param statistics Returns the statistics of each column, indexed by column ID.
+     */
+    void collect_statistics(TableStatistics& statistics) const;
+
     uint64_t get_num_messages() const { return m_num_messages; }
 
     /**
-     * @return the uncompressed in-memory size of the data that will be written to the compressor
+     * @return the uncompressed in-memory size of the data that will be written to the compressor.
+     * This is only an estimate until `finalize` is called.
      */
     size_t get_total_uncompressed_size() const { return m_total_uncompressed_size; }
 
@@ -55,6 +69,7 @@ private:
     size_t m_total_uncompressed_size{};
 
     std::vector<BaseColumnWriter*> m_columns;
+    std::vector<size_t> m_column_sizes;
     std::vector<BaseColumnWriter*> m_unordered_columns;
 };
 }  // namespace clp_s
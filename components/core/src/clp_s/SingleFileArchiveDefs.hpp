@@ -10,8 +10,12 @@
 namespace clp_s {
 // define the version
 constexpr uint8_t cArchiveMajorVersion = 0;
-constexpr uint8_t cArchiveMinorVersion = 4;
-constexpr uint16_t cArchivePatchVersion = 1;
+constexpr uint8_t cArchiveMinorVersion = 5;
+constexpr uint16_t cArchivePatchVersion = 0;
+
+// The first version in which integer and dictionary ID columns are stored with an encoding (see
+// `IntegerColumnEncoding.hpp`)
+constexpr uint32_t cEncodedIntegerColumnsArchiveVersion = (0U << 24) | (5U << 16) | 0U;
 
 // define the magic number
 constexpr uint8_t cStructuredSFAMagicNumber[] = {0xFD, 0x2F, 0xC5, 0x30};
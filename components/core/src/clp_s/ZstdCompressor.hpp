@@ -79,9 +79,37 @@ public:
      */
     void open(FileWriter& file_writer, int compression_level = cDefaultCompressionLevel);
 
+    /**
+     * Initialize streaming compressor to append its compressed output to an in-memory buffer
+     * instead of a file. This allows independent streams to be compressed concurrently and written
+     * to the same file afterwards.
+     * @param compressed_buffer
+     * @param compression_level
+     */
+    void open(std::string& compressed_buffer, int compression_level = cDefaultCompressionLevel);
+
 private:
+    // Methods
+    /**
+     * Initializes the compression stream
+     * @param compression_level
+     */
+    void init_compression_stream(int compression_level);
+
+    /**
+     * Writes compressed data to the file or buffer the compressor was opened with
+     * @param data
+     * @param data_length
+     */
+    void write_compressed_data(char const* data, size_t data_length);
+
+    [[nodiscard]] auto is_open() const -> bool {
+        return nullptr != m_compressed_stream_file_writer || nullptr != m_compressed_stream_buffer;
+    }
+
     // Variables
     FileWriter* m_compressed_stream_file_writer{};
+    std::string* m_compressed_stream_buffer{};
 
     // Compressed stream variables
     ZSTD_CStream* m_compression_stream;
@@ -8,6 +8,8 @@
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <spdlog/spdlog.h>
 
+#include "../clp/BufferReader.hpp"
+
 namespace clp_s {
 ZstdDecompressor::ZstdDecompressor()
         : Decompressor(CompressorType::ZSTD),
@@ -190,6 +192,15 @@ void ZstdDecompressor::open(clp::ReaderInterface& reader, size_t file_read_buffe
     if (InputType::NotInitialized != m_input_type) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
+    if (auto const* buffer_reader = dynamic_cast<clp::BufferReader const*>(&reader);
+        nullptr != buffer_reader)
+    {
+        char const* compressed_data_buf{nullptr};
+        size_t compressed_data_buf_size{0};
+        buffer_reader->peek_buffer(compressed_data_buf, compressed_data_buf_size);
+        open(compressed_data_buf, compressed_data_buf_size);
+        return;
+    }
     m_input_type = InputType::ClpReader;
 
     m_reader = &reader;
@@ -43,6 +43,13 @@ public:
 
     void open(FileReader& file_reader, size_t file_read_buffer_capacity) override;
 
+    /**
+     * Opens the decompressor on the remaining content of the given reader. The content of readers
+     * over an in-memory buffer (e.g., a memory-mapped archive section) is decompressed in place
+     * rather than being copied through the read buffer, and such readers aren't advanced.
+     * @param reader
+     * @param file_read_buffer_capacity
+     */
     void open(clp::ReaderInterface& reader, size_t file_read_buffer_capacity) override;
 
     void close() override;
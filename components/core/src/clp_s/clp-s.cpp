@@ -23,26 +23,15 @@
 #include "JsonParser.hpp"
 #include "kv_ir_search.hpp"
 #include "OutputHandlerImpl.hpp"
-#include "search/AddTimestampConditions.hpp"
-#include "search/ast/ConvertToExists.hpp"
 #include "search/ast/EmptyExpr.hpp"
 #include "search/ast/Expression.hpp"
-#include "search/ast/NarrowTypes.hpp"
-#include "search/ast/OrOfAndForm.hpp"
-#include "search/ast/SearchUtils.hpp"
-#include "search/EvaluateRangeIndexFilters.hpp"
-#include "search/EvaluateTimestampIndex.hpp"
 #include "search/kql/kql.hpp"
-#include "search/Output.hpp"
 #include "search/OutputHandler.hpp"
-#include "search/Projection.hpp"
-#include "search/SchemaMatch.hpp"
+#include "search/SearchEngine.hpp"
 #include "TimestampPattern.hpp"
 
 using namespace clp_s::search;
 using clp_s::cArchiveFormatDevelopmentVersionFlag;
-using clp_s::cEpochTimeMax;
-using clp_s::cEpochTimeMin;
 using clp_s::CommandLineArguments;
 using clp_s::KvIrSearchError;
 using clp_s::KvIrSearchErrorEnum;
@@ -64,14 +53,16 @@ void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_opt
 /**
  * Searches the given archive.
  * @param command_line_arguments
- * @param archive_reader
+ * @param search_engine
+ * @param archive_path
  * @param expr A copy of the search AST which may be modified
  * @param reducer_socket_fd
  * @return Whether the search succeeded
  */
 bool search_archive(
         CommandLineArguments const& command_line_arguments,
-        std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
+        SearchEngine& search_engine,
+        clp_s::Path const& archive_path,
         std::shared_ptr<ast::Expression> expr,
         int reducer_socket_fd
 );
@@ -98,11 +89,13 @@ bool compress(CommandLineArguments const& command_line_arguments) {
     option.target_encoded_size = command_line_arguments.get_target_encoded_size();
     option.max_document_size = command_line_arguments.get_max_document_size();
     option.min_table_size = command_line_arguments.get_minimum_table_size();
+    option.num_threads = command_line_arguments.get_num_compression_threads();
     option.compression_level = command_line_arguments.get_compression_level();
     option.timestamp_key = command_line_arguments.get_timestamp_key();
     option.print_archive_stats = command_line_arguments.print_archive_stats();
     option.retain_float_format = command_line_arguments.get_retain_float_format();
     option.single_file_archive = command_line_arguments.get_single_file_archive();
+    option.index_variable_dictionary = command_line_arguments.get_index_variable_dictionary();
     option.structurize_arrays = command_line_arguments.get_structurize_arrays();
     option.record_log_order = command_line_arguments.get_record_log_order();
 
@@ -122,172 +115,87 @@ void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_opt
 
 bool search_archive(
         CommandLineArguments const& command_line_arguments,
-        std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
+        SearchEngine& search_engine,
+        clp_s::Path const& archive_path,
         std::shared_ptr<ast::Expression> expr,
         int reducer_socket_fd
 ) {
-    auto const& query = command_line_arguments.get_query();
-
-    auto timestamp_dict = archive_reader->get_timestamp_dictionary();
-    AddTimestampConditions add_timestamp_conditions(
-            timestamp_dict->get_authoritative_timestamp_tokenized_column(),
-            command_line_arguments.get_search_begin_ts(),
-            command_line_arguments.get_search_end_ts()
-    );
-    if (expr = add_timestamp_conditions.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr))
-    {
-        SPDLOG_ERROR(
-                "Query '{}' specified timestamp filters tge {} tle {}, but no authoritative "
-                "timestamp column was found for this archive",
-                query,
-                command_line_arguments.get_search_begin_ts().value_or(cEpochTimeMin),
-                command_line_arguments.get_search_end_ts().value_or(cEpochTimeMax)
-        );
-        return false;
-    }
-
-    ast::OrOfAndForm standardize_pass;
-    if (expr = standardize_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_ERROR("Query '{}' is logically false", query);
-        return false;
-    }
-
-    ast::NarrowTypes narrow_pass;
-    if (expr = narrow_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_ERROR("Query '{}' is logically false", query);
-        return false;
-    }
-
-    ast::ConvertToExists convert_pass;
-    if (expr = convert_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_ERROR("Query '{}' is logically false", query);
-        return false;
-    }
-
-    EvaluateRangeIndexFilters metadata_filter_pass{
-            archive_reader->get_range_index(),
-            false == command_line_arguments.get_ignore_case()
-    };
-    if (expr = metadata_filter_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_INFO("No matching metadata ranges for query '{}'", query);
-        return true;
-    }
-
-    // skip decompressing the archive if we won't match based on
-    // the timestamp index
-    EvaluateTimestampIndex timestamp_index(timestamp_dict);
-    if (clp_s::EvaluatedValue::False == timestamp_index.run(expr)) {
-        SPDLOG_INFO("No matching timestamp ranges for query '{}'", query);
-        return true;
-    }
-
-    // Narrow against schemas
-    auto match_pass = std::make_shared<SchemaMatch>(
-            archive_reader->get_schema_tree(),
-            archive_reader->get_schema_map()
-    );
-    if (expr = match_pass->run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
-        SPDLOG_INFO("No matching schemas for query '{}'", query);
-        return true;
-    }
-
-    // Populate projection
-    auto projection = std::make_shared<Projection>(
-            command_line_arguments.get_projection_columns().empty()
-                    ? ProjectionMode::ReturnAllColumns
-                    : ProjectionMode::ReturnSelectedColumns
-    );
-    try {
-        for (auto const& column : command_line_arguments.get_projection_columns()) {
-            std::vector<std::string> descriptor_tokens;
-            std::string descriptor_namespace;
-            if (false
-                == clp_s::search::ast::tokenize_column_descriptor(
-                        column,
-                        descriptor_tokens,
-                        descriptor_namespace
-                ))
-            {
-                SPDLOG_ERROR("Can not tokenize invalid column: \"{}\"", column);
-                return false;
-            }
-            projection->add_column(
-                    ast::ColumnDescriptor::create_from_escaped_tokens(
-                            descriptor_tokens,
-                            descriptor_namespace
-                    )
-            );
-        }
-    } catch (std::exception const& e) {
-        SPDLOG_ERROR("{}", e.what());
-        return false;
-    }
-    projection->resolve_columns(archive_reader->get_schema_tree());
-    archive_reader->set_projection(projection);
-
-    std::unique_ptr<OutputHandler> output_handler;
-    try {
-        switch (command_line_arguments.get_output_handler_type()) {
-            case CommandLineArguments::OutputHandlerType::File:
-                output_handler = std::make_unique<clp_s::FileOutputHandler>(
-                        command_line_arguments.get_file_output_path(),
-                        true
-                );
-                break;
-            case CommandLineArguments::OutputHandlerType::Network:
-                output_handler = std::make_unique<clp_s::NetworkOutputHandler>(
-                        command_line_arguments.get_network_dest_host(),
-                        command_line_arguments.get_network_dest_port()
-                );
-                break;
-            case CommandLineArguments::OutputHandlerType::Reducer:
-                if (command_line_arguments.do_count_results_aggregation()) {
-                    output_handler = std::make_unique<clp_s::CountOutputHandler>(reducer_socket_fd);
-                } else if (command_line_arguments.do_count_by_time_aggregation()) {
-                    output_handler = std::make_unique<clp_s::CountByTimeOutputHandler>(
-                            reducer_socket_fd,
-                            command_line_arguments.get_count_by_time_bucket_size()
+    SearchOption option;
+    option.query = command_line_arguments.get_query();
+    option.search_begin_ts = command_line_arguments.get_search_begin_ts();
+    option.search_end_ts = command_line_arguments.get_search_end_ts();
+    option.ignore_case = command_line_arguments.get_ignore_case();
+    option.projection_columns = command_line_arguments.get_projection_columns();
+    option.num_threads = command_line_arguments.get_num_search_threads();
+    option.num_prefetched_streams = command_line_arguments.get_num_prefetched_streams();
+
+    auto create_output_handler = [&]() -> std::unique_ptr<OutputHandler> {
+        try {
+            switch (command_line_arguments.get_output_handler_type()) {
+                case CommandLineArguments::OutputHandlerType::File:
+                    return std::make_unique<clp_s::FileOutputHandler>(
+                            command_line_arguments.get_file_output_path(),
+                            true
+                    );
+                case CommandLineArguments::OutputHandlerType::Network:
+                    return std::make_unique<clp_s::NetworkOutputHandler>(
+                            command_line_arguments.get_network_dest_host(),
+                            command_line_arguments.get_network_dest_port()
                     );
-                } else {
+                case CommandLineArguments::OutputHandlerType::Reducer:
+                    if (command_line_arguments.do_count_results_aggregation()) {
+                        return std::make_unique<clp_s::CountOutputHandler>(reducer_socket_fd);
+                    }
+                    if (command_line_arguments.do_count_by_time_aggregation()) {
+                        return std::make_unique<clp_s::CountByTimeOutputHandler>(
+                                reducer_socket_fd,
+                                command_line_arguments.get_count_by_time_bucket_size()
+                        );
+                    }
+                    if (auto const aggregation_type = command_line_arguments.get_aggregation_type();
+                        aggregation_type.has_value())
+                    {
+                        return std::make_unique<clp_s::AggregateOutputHandler>(
+                                reducer_socket_fd,
+                                aggregation_type.value(),
+                                command_line_arguments.get_aggregation_field(),
+                                command_line_arguments.get_aggregation_quantile()
+                        );
+                    }
                     SPDLOG_ERROR("Unhandled aggregation type.");
-                    return false;
-                }
-                break;
-            case CommandLineArguments::OutputHandlerType::ResultsCache:
-                output_handler = std::make_unique<clp_s::ResultsCacheOutputHandler>(
-                        command_line_arguments.get_mongodb_uri(),
-                        command_line_arguments.get_mongodb_collection(),
-                        command_line_arguments.get_batch_size(),
-                        command_line_arguments.get_max_num_results()
-                );
-                break;
-            case CommandLineArguments::OutputHandlerType::Stdout:
-                output_handler = std::make_unique<clp_s::StandardOutputHandler>();
-                break;
-            default:
-                SPDLOG_ERROR("Unhandled OutputHandlerType.");
-                return false;
+                    return nullptr;
+                case CommandLineArguments::OutputHandlerType::ResultsCache:
+                    return std::make_unique<clp_s::ResultsCacheOutputHandler>(
+                            command_line_arguments.get_mongodb_uri(),
+                            command_line_arguments.get_mongodb_collection(),
+                            command_line_arguments.get_batch_size(),
+                            command_line_arguments.get_max_num_results()
+                    );
+                case CommandLineArguments::OutputHandlerType::Stdout:
+                    return std::make_unique<clp_s::StandardOutputHandler>();
+                default:
+                    SPDLOG_ERROR("Unhandled OutputHandlerType.");
+                    return nullptr;
+            }
+        } catch (std::exception const& e) {
+            SPDLOG_ERROR("Failed to create output handler - {}", e.what());
+            return nullptr;
         }
-    } catch (std::exception const& e) {
-        SPDLOG_ERROR("Failed to create output handler - {}", e.what());
-        return false;
-    }
+    };
 
-    // output result
-    Output output(
-            match_pass,
-            expr,
-            archive_reader,
-            std::move(output_handler),
-            command_line_arguments.get_ignore_case()
+    return search_engine.search_archive(
+            archive_path,
+            command_line_arguments.get_network_auth(),
+            std::move(expr),
+            option,
+            create_output_handler
     );
-    return output.filter();
 }
 }  // namespace
 
 int main(int argc, char const* argv[]) {
     try {
-        auto stderr_logger = spdlog::stderr_logger_st("stderr");
+        auto stderr_logger = spdlog::stderr_logger_mt("stderr");
         spdlog::set_default_logger(stderr_logger);
         spdlog::set_pattern("%Y-%m-%dT%H:%M:%S.%e%z [%l] %v");
     } catch (std::exception& e) {
@@ -370,7 +278,7 @@ int main(int argc, char const* argv[]) {
             }
         }
 
-        auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
+        SearchEngine search_engine;
         for (auto const& input_path : command_line_arguments.get_input_paths()) {
             if (std::string::npos != input_path.path.find(clp::ir::cIrFileExtension)) {
                 auto const result{clp_s::search_kv_ir_stream(
@@ -420,23 +328,17 @@ int main(int argc, char const* argv[]) {
                 }
             }
 
-            try {
-                archive_reader->open(input_path, command_line_arguments.get_network_auth());
-            } catch (std::exception const& e) {
-                SPDLOG_ERROR("Failed to open archive - {}", e.what());
-                return 1;
-            }
             if (false
                 == search_archive(
                         command_line_arguments,
-                        archive_reader,
+                        search_engine,
+                        input_path,
                         expr->copy(),
                         reducer_socket_fd
                 ))
             {
                 return 1;
             }
-            archive_reader->close();
         }
     }
 
@@ -8,8 +8,6 @@
 #include <string_view>
 #include <utility>
 
-#include <fmt/format.h>
-#include <nlohmann/json_fwd.hpp>
 #include <spdlog/spdlog.h>
 #include <ystdlib/error_handling/ErrorCode.hpp>
 #include <ystdlib/error_handling/Result.hpp>
@@ -100,6 +98,10 @@ public:
 private:
     // Constructor
     IrUnitHandler() = default;
+
+    // Variables
+    // Reused across log events to avoid reallocating the serialized output
+    std::string m_json_str_buf;
 };
 
 /**
@@ -145,48 +147,31 @@ auto IrUnitHandler::create(
     return IrUnitHandler{};
 }
 
-/**
- * The following clang-tidy check is disabled because this function is intentionally designed as a
- * non-static member function for the following reasons:
- * - It is expected to be extended in the future to support additional search features.
- * - It must be invoked through an object created by the factory function, which ensures all
- *   necessary validations are performed.
- */
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 auto IrUnitHandler::handle_log_event(
         clp::ffi::KeyValuePairLogEvent log_event,
         [[maybe_unused]] size_t log_event_idx
 ) -> IRErrorCode {
-    auto const serialize_result{log_event.serialize_to_json()};
-    if (serialize_result.has_error()) {
+    constexpr std::string_view cAutoGenKey{"{\"auto_generated_kv_pairs\":"};
+    constexpr std::string_view cUserGenKey{",\"user_generated_kv_pairs\":"};
+
+    m_json_str_buf.clear();
+    m_json_str_buf += cAutoGenKey;
+    auto result{log_event.append_auto_gen_kv_pairs_as_json_str(m_json_str_buf)};
+    if (false == result.has_error()) {
+        m_json_str_buf += cUserGenKey;
+        result = log_event.append_user_gen_kv_pairs_as_json_str(m_json_str_buf);
+    }
+    if (result.has_error()) {
         SPDLOG_ERROR(
-                "kv-ir search: Failed to serialize kv-pair log event to JSON objects."
+                "kv-ir search: Failed to serialize kv-pair log event into a JSON string."
                 " error_category={}, error={}",
-                serialize_result.error().category().name(),
-                serialize_result.error().message()
+                result.error().category().name(),
+                result.error().message()
         );
         return IRErrorCode::IRErrorCode_Decode_Error;
     }
-    auto const& [auto_gen_kv_pairs, user_gen_kv_pairs] = serialize_result.value();
-
-    try {
-        constexpr std::string_view cAutoGenKey{"\"auto_generated_kv_pairs\""};
-        constexpr std::string_view cUserGenKey{"\"user_generated_kv_pairs\""};
-        std::cout << fmt::format(
-                "{{{}:{},{}:{}}}\n",
-                cAutoGenKey,
-                auto_gen_kv_pairs.dump(),
-                cUserGenKey,
-                user_gen_kv_pairs.dump()
-        );
-    } catch (nlohmann::json::exception const& ex) {
-        SPDLOG_ERROR(
-                "kv-ir search: Failed to serialize kv-pair log event into JSON strings."
-                " ErrorMessage={}",
-                ex.what()
-        );
-        return IRErrorCode::IRErrorCode_Corrupted_IR;
-    }
+    m_json_str_buf += "}\n";
+    std::cout << m_json_str_buf;
 
     return IRErrorCode::IRErrorCode_Success;
 }
@@ -0,0 +1,155 @@
+#include "EvaluateColumnStatistics.hpp"
+
+#include <cstdint>
+#include <memory>
+
+#include "../ColumnStatistics.hpp"
+#include "../Utils.hpp"
+#include "ast/AndExpr.hpp"
+#include "ast/ColumnDescriptor.hpp"
+#include "ast/Expression.hpp"
+#include "ast/FilterExpr.hpp"
+#include "ast/FilterOperation.hpp"
+#include "ast/Literal.hpp"
+#include "ast/OrExpr.hpp"
+
+using clp_s::search::ast::AndExpr;
+using clp_s::search::ast::Expression;
+using clp_s::search::ast::FilterExpr;
+using clp_s::search::ast::FilterOperation;
+using clp_s::search::ast::LiteralType;
+using clp_s::search::ast::OrExpr;
+
+namespace clp_s::search {
+namespace {
+/**
+ * @tparam T
+ * @param op
+ * @param min
+ * @param max
+ * @param operand
+ * @return Whether no value in [min, max] can satisfy `value op operand`.
+ */
+template <typename T>
+auto range_cannot_match(FilterOperation op, T min, T max, T operand) -> bool {
+    switch (op) {
+        case FilterOperation::EQ:
+            return operand < min || operand > max;
+        case FilterOperation::NEQ:
+            return min == operand && max == operand;
+        case FilterOperation::LT:
+            return min >= operand;
+        case FilterOperation::LTE:
+            return min > operand;
+        case FilterOperation::GT:
+            return max <= operand;
+        case FilterOperation::GTE:
+            return max < operand;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+auto EvaluateColumnStatistics::run(std::shared_ptr<Expression> const& expr) const
+        -> EvaluatedValue {
+    if (std::dynamic_pointer_cast<OrExpr>(expr)) {
+        bool any_unknown = false;
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            EvaluatedValue ret = run(sub_expr);
+            if (ret == EvaluatedValue::True) {
+                return expr->is_inverted() ? EvaluatedValue::False : EvaluatedValue::True;
+            } else if (ret == EvaluatedValue::Unknown) {
+                any_unknown = true;
+            }
+        }
+
+        if (any_unknown) {
+            return EvaluatedValue::Unknown;
+        }
+        // must have been all false
+        return expr->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+    } else if (std::dynamic_pointer_cast<AndExpr>(expr)) {
+        bool any_unknown = false;
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            EvaluatedValue ret = run(sub_expr);
+            if (ret == EvaluatedValue::False) {
+                return expr->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+            } else if (ret == EvaluatedValue::Unknown) {
+                any_unknown = true;
+            }
+        }
+
+        if (any_unknown) {
+            return EvaluatedValue::Unknown;
+        }
+        // must have been all true
+        return expr->is_inverted() ? EvaluatedValue::False : EvaluatedValue::True;
+    } else if (auto filter = std::dynamic_pointer_cast<FilterExpr>(expr)) {
+        if (filter_cannot_match(filter.get())) {
+            return filter->is_inverted() ? EvaluatedValue::True : EvaluatedValue::False;
+        }
+        return EvaluatedValue::Unknown;
+    }
+    return EvaluatedValue::Unknown;
+}
+
+auto EvaluateColumnStatistics::filter_cannot_match(FilterExpr* filter) const -> bool {
+    auto* column = filter->get_column().get();
+    // Filters on wildcard columns may search several columns of the table
+    if (column->is_pure_wildcard() || column->has_unresolved_tokens()) {
+        return false;
+    }
+
+    auto const statistics_it = m_table_statistics.find(column->get_column_id());
+    if (m_table_statistics.end() == statistics_it) {
+        return false;
+    }
+    auto const& statistics = statistics_it->second;
+
+    auto const op = filter->get_operation();
+    auto const& operand = filter->get_operand();
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT:
+        case LiteralType::EpochDateT: {
+            int64_t value{};
+            auto const& range = statistics.get_int_range();
+            if (false == range.has_value() || nullptr == operand
+                || false == operand->as_int(value, op))
+            {
+                return false;
+            }
+            return range_cannot_match(op, range->first, range->second, value);
+        }
+        case LiteralType::FloatT: {
+            double value{};
+            auto const& range = statistics.get_float_range();
+            if (false == range.has_value() || nullptr == operand
+                || false == operand->as_float(value, op))
+            {
+                return false;
+            }
+            return range_cannot_match(op, range->first, range->second, value);
+        }
+        case LiteralType::VarStringT: {
+            if (FilterOperation::EQ != op || false == statistics.has_bloom_filter()) {
+                return false;
+            }
+            auto const matching_vars_it = m_expr_var_match_map.find(filter);
+            if (m_expr_var_match_map.end() == matching_vars_it) {
+                return false;
+            }
+            for (auto const var_id : *matching_vars_it->second) {
+                if (statistics.may_contain_var_id(static_cast<uint64_t>(var_id))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+}  // namespace clp_s::search
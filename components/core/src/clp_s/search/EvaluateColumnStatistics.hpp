@@ -0,0 +1,60 @@
+#ifndef CLP_S_SEARCH_EVALUATECOLUMNSTATISTICS_HPP
+#define CLP_S_SEARCH_EVALUATECOLUMNSTATISTICS_HPP
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../ColumnStatistics.hpp"
+#include "../Utils.hpp"
+#include "ast/Expression.hpp"
+#include "ast/FilterExpr.hpp"
+
+namespace clp_s::search {
+/**
+ * Evaluates the query for a schema table against the statistics of the table's columns (see
+ * `ColumnStatistics`) to prove whether any message in the table can match it, so that tables which
+ * can't match are skipped without being decompressed.
+ *
+ * Should only be run on the query returned by `SchemaMatch::get_query_for_schema` for the table,
+ * after the query has been constant propagated by `QueryRunner`.
+ */
+class EvaluateColumnStatistics {
+public:
+    // Constructors
+    /**
+     * @param table_statistics
+     * @param expr_var_match_map The variable dictionary IDs matched by each variable string
+     * filter in the query.
+     */
+    EvaluateColumnStatistics(
+            TableStatistics const& table_statistics,
+            std::unordered_map<ast::Expression*, std::unordered_set<int64_t>*> const&
+                    expr_var_match_map
+    )
+            : m_table_statistics{table_statistics},
+              m_expr_var_match_map{expr_var_match_map} {}
+
+    /**
+     * @param expr
+     * @return EvaluatedValue::False if no message in the table can match the expression, or
+     * EvaluatedValue::Unknown otherwise. EvaluatedValue::True may be returned for sub-expressions
+     * that are inverted.
+     */
+    [[nodiscard]] auto run(std::shared_ptr<ast::Expression> const& expr) const -> EvaluatedValue;
+
+private:
+    /**
+     * @param filter
+     * @return Whether the column statistics prove that the (non-inverted) filter can't match any
+     * message in the table.
+     */
+    [[nodiscard]] auto filter_cannot_match(ast::FilterExpr* filter) const -> bool;
+
+    TableStatistics const& m_table_statistics;
+    std::unordered_map<ast::Expression*, std::unordered_set<int64_t>*> const& m_expr_var_match_map;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_EVALUATECOLUMNSTATISTICS_HPP
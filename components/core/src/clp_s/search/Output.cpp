@@ -1,11 +1,18 @@
 #include "Output.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include <spdlog/spdlog.h>
 
 #include "../../clp/type_utils.hpp"
+#include "../Defs.hpp"
 #include "../SchemaTree.hpp"
 #include "../Utils.hpp"
 #include "ast/AndExpr.hpp"
@@ -68,8 +75,10 @@ bool Output::filter() {
     m_archive_reader->read_variable_dictionary();
     m_archive_reader->read_log_type_dictionary();
 
+    // Workers search tables concurrently, so the array dictionary can't be decoded lazily while
+    // it's being searched.
     if (has_array) {
-        if (has_array_search) {
+        if (has_array_search || m_num_threads > 1) {
             m_archive_reader->read_array_dictionary();
         } else {
             m_archive_reader->read_array_dictionary(true);
@@ -79,10 +88,53 @@ bool Output::filter() {
     m_query_runner.global_init();
     m_archive_reader->open_packed_streams();
 
+    if (m_num_prefetched_streams > 0) {
+        // Only prefetch the tables that will actually be searched
+        std::vector<int32_t> tables_to_search;
+        for (int32_t schema_id : matched_schemas) {
+            if (EvaluatedValue::False != m_query_runner.schema_init(schema_id)) {
+                tables_to_search.push_back(schema_id);
+            }
+        }
+        matched_schemas = std::move(tables_to_search);
+    }
+
+    if (m_output_handler->should_output_metadata() && m_output_handler->keeps_latest_results()) {
+        prepare_latest_results_search(matched_schemas);
+    }
+
+    if (m_num_prefetched_streams > 0) {
+        m_archive_reader->prefetch_tables(matched_schemas, m_num_prefetched_streams);
+    }
+
+    bool const succeeded = m_num_threads > 1 ? filter_tables_in_parallel(matched_schemas)
+                                             : filter_tables(matched_schemas);
+    if (false == succeeded) {
+        return false;
+    }
+
+    auto ecode = m_output_handler->finish();
+    if (ErrorCode::ErrorCodeSuccess != ecode) {
+        SPDLOG_ERROR(
+                "Failed to flush output handler, error={}.",
+                clp::enum_to_underlying_type(ecode)
+        );
+        return false;
+    }
+    return true;
+}
+
+auto Output::filter_tables(std::vector<int32_t> const& matched_schemas) -> bool {
     std::string message;
     auto const archive_id = m_archive_reader->get_archive_id();
-    for (int32_t schema_id : matched_schemas) {
-        if (EvaluatedValue::False == m_query_runner.schema_init(schema_id)) {
+    for (size_t table_ix = 0; table_ix < matched_schemas.size(); ++table_ix) {
+        if (can_skip_remaining_tables(table_ix)) {
+            break;
+        }
+        auto const schema_id = matched_schemas[table_ix];
+        if (can_skip_table(table_ix)
+            || EvaluatedValue::False == m_query_runner.schema_init(schema_id))
+        {
             continue;
         }
 
@@ -96,6 +148,7 @@ bool Output::filter() {
         if (m_output_handler->should_output_metadata()) {
             epochtime_t timestamp{};
             int64_t log_event_idx{};
+            reader.set_timestamp_cutoff(get_timestamp_cutoff());
             while (reader.get_next_message_with_metadata(
                     message,
                     timestamp,
@@ -104,6 +157,9 @@ bool Output::filter() {
             ))
             {
                 m_output_handler->write(message, timestamp, archive_id, log_event_idx);
+                if (m_is_latest_results_search) {
+                    reader.set_timestamp_cutoff(m_output_handler->get_timestamp_cutoff());
+                }
             }
         } else {
             while (reader.get_next_message(message, &m_query_runner)) {
@@ -119,7 +175,248 @@ bool Output::filter() {
             return false;
         }
     }
-    auto ecode = m_output_handler->finish();
+    return true;
+}
+
+auto Output::filter_tables_in_parallel(std::vector<int32_t> const& matched_schemas) -> bool {
+    // Bound the number of decompressed tables waiting to be searched so that memory usage stays
+    // proportional to the number of workers rather than the size of the archive.
+    clp::BoundedBlockingQueue<std::shared_ptr<SchemaReader>> table_queue{2 * m_num_threads};
+    m_parallel_search_failed = false;
+
+    std::vector<std::unique_ptr<TableSearchWorker>> workers;
+    workers.reserve(m_num_threads);
+    for (size_t i = 0; i < m_num_threads; ++i) {
+        workers.emplace_back(std::make_unique<TableSearchWorker>(*this, table_queue));
+        workers.back()->start();
+    }
+
+    // Tables must be read in order, so the calling thread reads and decompresses them while the
+    // workers search them.
+    bool succeeded = true;
+    try {
+        for (size_t table_ix = 0; table_ix < matched_schemas.size(); ++table_ix) {
+            if (m_parallel_search_failed || can_skip_remaining_tables(table_ix)) {
+                break;
+            }
+            auto const schema_id = matched_schemas[table_ix];
+            if (can_skip_table(table_ix)
+                || EvaluatedValue::False == m_query_runner.schema_init(schema_id))
+            {
+                continue;
+            }
+
+            auto reader = m_archive_reader->read_detached_schema_table(
+                    schema_id,
+                    m_output_handler->should_output_metadata(),
+                    m_should_marshal_records
+            );
+            if (false == table_queue.push(std::move(reader))) {
+                break;
+            }
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to read schema table - {}", e.what());
+        succeeded = false;
+    }
+
+    table_queue.close();
+    for (auto& worker : workers) {
+        worker->join();
+        succeeded = succeeded && worker->succeeded();
+    }
+    return succeeded;
+}
+
+void Output::prepare_latest_results_search(std::vector<int32_t>& matched_schemas) {
+    std::vector<std::pair<int32_t, epochtime_t>> tables;
+    tables.reserve(matched_schemas.size());
+    for (auto schema_id : matched_schemas) {
+        tables.emplace_back(schema_id, get_table_timestamp_upper_bound(schema_id));
+    }
+
+    // Streams can only be read in order, so tables can only be reordered within a stream
+    auto stream_begin = tables.begin();
+    while (tables.end() != stream_begin) {
+        auto const stream_id = m_archive_reader->get_table_stream_id(stream_begin->first);
+        auto const stream_end = std::find_if(stream_begin, tables.end(), [&](auto const& table) {
+            return m_archive_reader->get_table_stream_id(table.first) != stream_id;
+        });
+        std::stable_sort(stream_begin, stream_end, [](auto const& lhs, auto const& rhs) {
+            return lhs.second > rhs.second;
+        });
+        stream_begin = stream_end;
+    }
+
+    m_is_latest_results_search = true;
+    m_table_timestamp_upper_bounds.resize(tables.size());
+    m_remaining_tables_timestamp_upper_bounds.resize(tables.size());
+    auto remaining_tables_upper_bound{cEpochTimeMin};
+    for (size_t i = tables.size(); i > 0; --i) {
+        auto const& [schema_id, upper_bound] = tables[i - 1];
+        matched_schemas[i - 1] = schema_id;
+        m_table_timestamp_upper_bounds[i - 1] = upper_bound;
+        remaining_tables_upper_bound = std::max(remaining_tables_upper_bound, upper_bound);
+        m_remaining_tables_timestamp_upper_bounds[i - 1] = remaining_tables_upper_bound;
+    }
+}
+
+auto Output::get_table_timestamp_upper_bound(int32_t schema_id) const -> epochtime_t {
+    auto const timestamp_dict = m_archive_reader->get_timestamp_dictionary();
+    auto const& timestamp_column_ids = timestamp_dict->get_authoritative_timestamp_column_ids();
+    auto const* table_statistics = m_archive_reader->get_table_statistics(schema_id);
+
+    // Messages without a timestamp are output with a timestamp of zero
+    epochtime_t upper_bound{0};
+    for (auto const column_id : m_archive_reader->get_schema_map()->at(schema_id)) {
+        if (0 == timestamp_column_ids.count(column_id)) {
+            continue;
+        }
+        if (nullptr == table_statistics) {
+            return cEpochTimeMax;
+        }
+        auto const statistics_it = table_statistics->find(column_id);
+        if (table_statistics->end() == statistics_it) {
+            return cEpochTimeMax;
+        }
+
+        auto const& int_range = statistics_it->second.get_int_range();
+        auto const& float_range = statistics_it->second.get_float_range();
+        if (int_range.has_value()) {
+            upper_bound = std::max(upper_bound, int_range->second);
+        } else if (float_range.has_value()
+                   && float_range->second < static_cast<double>(cEpochTimeMax))
+        {
+            // Float timestamps are truncated when they're output
+            upper_bound = std::max(upper_bound, static_cast<epochtime_t>(float_range->second));
+        } else {
+            return cEpochTimeMax;
+        }
+    }
+    return upper_bound;
+}
+
+auto Output::can_skip_table(size_t table_ix) -> bool {
+    if (false == m_is_latest_results_search) {
+        return false;
+    }
+    auto const timestamp_cutoff = get_timestamp_cutoff();
+    return timestamp_cutoff.has_value()
+           && m_table_timestamp_upper_bounds[table_ix] <= timestamp_cutoff.value();
+}
+
+auto Output::can_skip_remaining_tables(size_t table_ix) -> bool {
+    if (false == m_is_latest_results_search) {
+        return false;
+    }
+    auto const timestamp_cutoff = get_timestamp_cutoff();
+    return timestamp_cutoff.has_value()
+           && m_remaining_tables_timestamp_upper_bounds[table_ix] <= timestamp_cutoff.value();
+}
+
+auto Output::get_timestamp_cutoff() -> std::optional<epochtime_t> {
+    if (false == m_is_latest_results_search) {
+        return std::nullopt;
+    }
+    std::lock_guard<std::mutex> const lock{m_output_handler_mutex};
+    return m_output_handler->get_timestamp_cutoff();
+}
+
+Output::TableSearchWorker::TableSearchWorker(
+        Output& output,
+        clp::BoundedBlockingQueue<std::shared_ptr<SchemaReader>>& table_queue
+)
+        : m_output{output},
+          m_table_queue{table_queue},
+          m_query_runner(
+                  output.m_match,
+                  output.m_expr,
+                  output.m_archive_reader,
+                  output.m_ignore_case
+          ) {
+    m_query_runner.global_init(output.m_query_runner);
+}
+
+void Output::TableSearchWorker::thread_method() {
+    try {
+        while (auto reader = m_table_queue.pop()) {
+            if (false == search_table(*reader.value())) {
+                m_succeeded = false;
+                break;
+            }
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to search schema table - {}", e.what());
+        m_succeeded = false;
+    }
+
+    if (false == m_succeeded) {
+        // Stop the reading thread and the other workers as soon as possible.
+        m_output.m_parallel_search_failed = true;
+        m_table_queue.close();
+    }
+}
+
+auto Output::TableSearchWorker::search_table(SchemaReader& reader) -> bool {
+    // Write results in batches to limit contention on the output handler.
+    constexpr size_t cMaxNumBufferedResults{1024};
+
+    if (EvaluatedValue::False == m_query_runner.schema_init(reader.get_schema_id())) {
+        return true;
+    }
+    reader.initialize_filter(&m_query_runner);
+
+    BufferedResult result;
+    if (m_output.m_output_handler->should_output_metadata()) {
+        reader.set_timestamp_cutoff(m_output.get_timestamp_cutoff());
+        while (reader.get_next_message_with_metadata(
+                result.message,
+                result.timestamp,
+                result.log_event_idx,
+                &m_query_runner
+        ))
+        {
+            m_buffered_results.emplace_back(std::move(result));
+            if (m_buffered_results.size() >= cMaxNumBufferedResults) {
+                if (false == write_buffered_results(false)) {
+                    return false;
+                }
+                reader.set_timestamp_cutoff(m_output.get_timestamp_cutoff());
+            }
+        }
+    } else {
+        while (reader.get_next_message(result.message, &m_query_runner)) {
+            m_buffered_results.emplace_back(std::move(result));
+            if (m_buffered_results.size() >= cMaxNumBufferedResults
+                && false == write_buffered_results(false))
+            {
+                return false;
+            }
+        }
+    }
+    return write_buffered_results(true);
+}
+
+auto Output::TableSearchWorker::write_buffered_results(bool flush) -> bool {
+    std::lock_guard<std::mutex> const lock{m_output.m_output_handler_mutex};
+    auto& output_handler = *m_output.m_output_handler;
+    if (output_handler.should_output_metadata()) {
+        auto const archive_id = m_output.m_archive_reader->get_archive_id();
+        for (auto const& result : m_buffered_results) {
+            output_handler
+                    .write(result.message, result.timestamp, archive_id, result.log_event_idx);
+        }
+    } else {
+        for (auto const& result : m_buffered_results) {
+            output_handler.write(result.message);
+        }
+    }
+    m_buffered_results.clear();
+
+    if (false == flush) {
+        return true;
+    }
+    auto ecode = output_handler.flush();
     if (ErrorCode::ErrorCodeSuccess != ecode) {
         SPDLOG_ERROR(
                 "Failed to flush output handler, error={}.",
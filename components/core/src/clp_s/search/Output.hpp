@@ -1,14 +1,22 @@
 #ifndef CLP_S_SEARCH_OUTPUT_HPP
 #define CLP_S_SEARCH_OUTPUT_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <stack>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "../../clp/BoundedBlockingQueue.hpp"
+#include "../../clp/Thread.hpp"
 #include "../ArchiveReader.hpp"
 #include "../SchemaReader.hpp"
 #include "../Utils.hpp"
@@ -23,6 +31,19 @@ namespace clp_s::search {
  * This class orchestrates the process of searching through a CLP archive,
  * filtering log messages according to a specified query, and then outputting the
  * matching messages using a provided `OutputHandler`.
+ *
+ * When configured with more than one thread, the calling thread reads and decompresses the matched
+ * tables in order while a pool of workers, each with its own `QueryRunner`, searches them
+ * concurrently. Results from every worker are funnelled into the same `OutputHandler`, one batch at
+ * a time, so results from different tables may be interleaved.
+ *
+ * Independently, the tables that can contain matches can be prefetched, in which case the upcoming
+ * tables are read and decompressed on a background thread while the current one is searched.
+ *
+ * If the output handler only keeps the latest results, the tables in each stream are searched from
+ * latest to earliest (streams themselves must be read in order), and the search skips tables whose
+ * timestamp statistics show they can't contain a kept result, stopping once none of the remaining
+ * tables can.
  */
 class Output {
 public:
@@ -30,13 +51,18 @@ public:
            std::shared_ptr<ast::Expression> const& expr,
            std::shared_ptr<ArchiveReader> const& archive_reader,
            std::unique_ptr<OutputHandler> output_handler,
-           bool ignore_case)
+           bool ignore_case,
+           size_t num_threads = 1,
+           size_t num_prefetched_streams = 0)
             : m_query_runner(match, expr, archive_reader, ignore_case),
               m_archive_reader(archive_reader),
               m_expr(expr),
               m_match(match),
               m_output_handler(std::move(output_handler)),
-              m_should_marshal_records(m_output_handler->should_marshal_records()) {}
+              m_should_marshal_records(m_output_handler->should_marshal_records()),
+              m_ignore_case(ignore_case),
+              m_num_threads(num_threads),
+              m_num_prefetched_streams(num_prefetched_streams) {}
 
     /**
      * Filters messages within the archive and outputs the filtered messages to the configured
@@ -47,12 +73,119 @@ public:
     auto filter() -> bool;
 
 private:
+    /**
+     * A search result buffered by a worker before being written to the output handler.
+     */
+    struct BufferedResult {
+        std::string message;
+        epochtime_t timestamp{};
+        int64_t log_event_idx{};
+    };
+
+    /**
+     * A worker thread which searches tables taken from a shared queue until the queue is drained.
+     */
+    class TableSearchWorker : public clp::Thread {
+    public:
+        // Constructor
+        TableSearchWorker(
+                Output& output,
+                clp::BoundedBlockingQueue<std::shared_ptr<SchemaReader>>& table_queue
+        );
+
+        [[nodiscard]] auto succeeded() const -> bool { return m_succeeded; }
+
+    private:
+        // Methods implementing `clp::Thread`
+        void thread_method() override;
+
+        /**
+         * Searches a single table, writing its results to the output handler.
+         * @param reader
+         * @return Whether the table was searched successfully
+         */
+        auto search_table(SchemaReader& reader) -> bool;
+
+        /**
+         * Writes the buffered results to the output handler and clears the buffer.
+         * @param flush Whether to also flush the output handler
+         * @return Whether the results were written successfully
+         */
+        auto write_buffered_results(bool flush) -> bool;
+
+        Output& m_output;
+        clp::BoundedBlockingQueue<std::shared_ptr<SchemaReader>>& m_table_queue;
+        QueryRunner m_query_runner;
+        std::vector<BufferedResult> m_buffered_results;
+        bool m_succeeded{true};
+    };
+
+    /**
+     * Searches the given tables one at a time on the calling thread.
+     * @param matched_schemas
+     * @return Whether every table was searched successfully
+     */
+    auto filter_tables(std::vector<int32_t> const& matched_schemas) -> bool;
+
+    /**
+     * Searches the given tables concurrently using `m_num_threads` `TableSearchWorker`s.
+     * @param matched_schemas
+     * @return Whether every table was searched successfully
+     */
+    auto filter_tables_in_parallel(std::vector<int32_t> const& matched_schemas) -> bool;
+
+    /**
+     * Prepares to search only for the latest results by reordering the tables in each stream from
+     * latest to earliest and recording the latest timestamp each table can contain.
+     * @param matched_schemas Returns the reordered tables
+     */
+    void prepare_latest_results_search(std::vector<int32_t>& matched_schemas);
+
+    /**
+     * @param schema_id
+     * @return An upper bound on the timestamps of the messages in the given table, derived from the
+     * statistics of its timestamp columns.
+     */
+    [[nodiscard]] auto get_table_timestamp_upper_bound(int32_t schema_id) const -> epochtime_t;
+
+    /**
+     * @param table_ix The index of a table in the tables being searched
+     * @return Whether none of the messages in the table can be kept by the output handler
+     */
+    [[nodiscard]] auto can_skip_table(size_t table_ix) -> bool;
+
+    /**
+     * @param table_ix The index of a table in the tables being searched
+     * @return Whether none of the messages in the table or the tables after it can be kept by the
+     * output handler
+     */
+    [[nodiscard]] auto can_skip_remaining_tables(size_t table_ix) -> bool;
+
+    /**
+     * @return The output handler's timestamp cutoff if only the latest results are being searched
+     * for, or std::nullopt otherwise. Safe to call while tables are searched in parallel.
+     */
+    [[nodiscard]] auto get_timestamp_cutoff() -> std::optional<epochtime_t>;
+
     QueryRunner m_query_runner;
     std::shared_ptr<ArchiveReader> m_archive_reader;
     std::shared_ptr<ast::Expression> m_expr;
     std::shared_ptr<SchemaMatch> m_match;
     std::unique_ptr<OutputHandler> m_output_handler;
     bool m_should_marshal_records{true};
+    bool m_ignore_case{false};
+    size_t m_num_threads{1};
+    size_t m_num_prefetched_streams{0};
+
+    // Upper bounds on the timestamps in each table being searched, and in each table along with the
+    // tables after it, when only the latest results are being searched for
+    bool m_is_latest_results_search{false};
+    std::vector<epochtime_t> m_table_timestamp_upper_bounds;
+    std::vector<epochtime_t> m_remaining_tables_timestamp_upper_bounds;
+
+    // Guards `m_output_handler` while tables are searched in parallel.
+    std::mutex m_output_handler_mutex;
+    std::atomic_bool m_parallel_search_failed{false};
 };
 }  // namespace clp_s::search
 
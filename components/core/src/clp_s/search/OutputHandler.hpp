@@ -1,6 +1,7 @@
 #ifndef CLP_S_SEARCH_OUTPUTHANDLER_HPP
 #define CLP_S_SEARCH_OUTPUTHANDLER_HPP
 
+#include <optional>
 #include <string_view>
 #include <vector>
 
@@ -54,6 +55,21 @@ public:
      */
     [[nodiscard]] virtual auto finish() -> ErrorCode { return ErrorCode::ErrorCodeSuccess; }
 
+    /**
+     * @return Whether the output handler only keeps a bounded number of the results with the latest
+     * timestamps, in which case tables are searched from latest to earliest where possible, and
+     * tables and messages that can't contain a kept result are skipped.
+     */
+    [[nodiscard]] virtual auto keeps_latest_results() const -> bool { return false; }
+
+    /**
+     * @return The timestamp that results must be later than to be kept by the output handler, or
+     * std::nullopt if any result may be kept.
+     */
+    [[nodiscard]] virtual auto get_timestamp_cutoff() const -> std::optional<epochtime_t> {
+        return std::nullopt;
+    }
+
     [[nodiscard]] auto should_output_metadata() const -> bool { return m_should_output_metadata; }
 
     [[nodiscard]] auto should_marshal_records() const -> bool { return m_should_marshal_records; }
@@ -1,6 +1,10 @@
 #include "QueryRunner.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include <log_surgeon/Lexer.hpp>
@@ -20,6 +24,7 @@
 #include "ast/Literal.hpp"
 #include "ast/OrExpr.hpp"
 #include "ast/SearchUtils.hpp"
+#include "EvaluateColumnStatistics.hpp"
 #include "EvaluateTimestampIndex.hpp"
 
 using clp_s::search::ast::AndExpr;
@@ -37,11 +42,124 @@ using clp_s::search::ast::OrExpr;
 #define eval(op, a, b) (((op) == FilterOperation::EQ) ? ((a) == (b)) : ((a) != (b)))
 
 namespace clp_s::search {
+namespace {
+/**
+ * Marks every message for which `predicate` holds for the corresponding value. Messages which are
+ * already marked stay marked, which allows the results for several readers of the same column to be
+ * combined.
+ *
+ * NOTE: This loop is intentionally branch-free so that the compiler can vectorize it.
+ * @tparam Values A random-access container of values
+ * @tparam Predicate
+ * @param values
+ * @param predicate
+ * @param selection
+ */
+template <typename Values, typename Predicate>
+void mark_matching_values(
+        Values const& values,
+        Predicate predicate,
+        std::vector<uint8_t>& selection
+) {
+    auto const num_values{selection.size()};
+    for (size_t i{0}; i < num_values; ++i) {
+        selection[i] |= static_cast<uint8_t>(predicate(values[i]));
+    }
+}
+
+/**
+ * Marks every message whose value compares true against `operand` using a numeric filter
+ * operation.
+ * @tparam T
+ * @tparam Values A random-access container of values of type T
+ * @param values
+ * @param op
+ * @param operand
+ * @param selection
+ */
+template <typename T, typename Values>
+void mark_matching_numeric_values(
+        Values const& values,
+        FilterOperation op,
+        T operand,
+        std::vector<uint8_t>& selection
+) {
+    auto mark_compared_values = [&](auto compare) {
+        mark_matching_values(
+                values,
+                [&](T value) { return compare(value, operand); },
+                selection
+        );
+    };
+    switch (op) {
+        case FilterOperation::EQ:
+            mark_compared_values(std::equal_to<T>{});
+            break;
+        case FilterOperation::NEQ:
+            mark_compared_values(std::not_equal_to<T>{});
+            break;
+        case FilterOperation::LT:
+            mark_compared_values(std::less<T>{});
+            break;
+        case FilterOperation::GT:
+            mark_compared_values(std::greater<T>{});
+            break;
+        case FilterOperation::LTE:
+            mark_compared_values(std::less_equal<T>{});
+            break;
+        case FilterOperation::GTE:
+            mark_compared_values(std::greater_equal<T>{});
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Combines two selections in place.
+ * @param selection
+ * @param other
+ * @param is_and Whether to compute the conjunction (true) or disjunction (false)
+ */
+void combine_selections(
+        std::vector<uint8_t>& selection,
+        std::vector<uint8_t> const& other,
+        bool is_and
+) {
+    auto const num_values{selection.size()};
+    if (is_and) {
+        for (size_t i{0}; i < num_values; ++i) {
+            selection[i] &= other[i];
+        }
+    } else {
+        for (size_t i{0}; i < num_values; ++i) {
+            selection[i] |= other[i];
+        }
+    }
+}
+
+/**
+ * Inverts a selection in place.
+ * @param selection
+ */
+void invert_selection(std::vector<uint8_t>& selection) {
+    for (auto& selected : selection) {
+        selected ^= 1U;
+    }
+}
+}  // namespace
+
 void QueryRunner::global_init() {
     populate_internal_columns();
     populate_string_queries(m_expr);
 }
 
+void QueryRunner::global_init(QueryRunner const& other) {
+    m_metadata_columns = other.m_metadata_columns;
+    m_string_query_map = other.m_string_query_map;
+    m_string_var_match_map = other.m_string_var_match_map;
+}
+
 auto QueryRunner::schema_init(int32_t schema_id) -> EvaluatedValue {
     m_expr_clp_query.clear();
     m_expr_var_match_map.clear();
@@ -56,6 +174,16 @@ auto QueryRunner::schema_init(int32_t schema_id) -> EvaluatedValue {
         return m_expression_value;
     }
 
+    if (auto const* table_statistics = m_archive_reader->get_table_statistics(schema_id);
+        nullptr != table_statistics && m_expression_value == EvaluatedValue::Unknown)
+    {
+        EvaluateColumnStatistics column_statistics{*table_statistics, m_expr_var_match_map};
+        if (EvaluatedValue::False == column_statistics.run(m_expr)) {
+            m_expression_value = EvaluatedValue::False;
+            return m_expression_value;
+        }
+    }
+
     add_wildcard_columns_to_searched_columns();
     return m_expression_value;
 }
@@ -98,6 +226,215 @@ void QueryRunner::init(SchemaReader* reader, std::vector<BaseColumnReader*> cons
         auto column_id = column_reader->get_id();
         initialize_reader(column_id, column_reader);
     }
+
+    initialize_selection();
+}
+
+void QueryRunner::initialize_selection() {
+    m_selection_mode = SelectionMode::Disabled;
+    if (EvaluatedValue::True == m_expression_value) {
+        return;
+    }
+
+    auto* expr = m_expr.get();
+    if (can_evaluate_batch(expr)) {
+        evaluate_batch(expr, m_selection);
+        m_selection_mode = SelectionMode::Exact;
+        return;
+    }
+
+    // For a conjunction we can still evaluate the operands that support batch evaluation up front,
+    // since any message which fails one of them can't match the full expression.
+    if (nullptr == dynamic_cast<AndExpr*>(expr) || expr->is_inverted()) {
+        return;
+    }
+    std::vector<uint8_t> operand_selection;
+    for (auto const& op : expr->get_op_list()) {
+        auto* operand = static_cast<Expression*>(op.get());
+        if (false == can_evaluate_batch(operand)) {
+            continue;
+        }
+        evaluate_batch(operand, operand_selection);
+        if (SelectionMode::Disabled == m_selection_mode) {
+            std::swap(m_selection, operand_selection);
+            m_selection_mode = SelectionMode::Candidates;
+        } else {
+            combine_selections(m_selection, operand_selection, true);
+        }
+    }
+}
+
+auto QueryRunner::can_evaluate_batch(Expression* expr) const -> bool {
+    if (expr->has_only_expression_operands()) {
+        for (auto const& op : expr->get_op_list()) {
+            if (false == can_evaluate_batch(static_cast<Expression*>(op.get()))) {
+                return false;
+            }
+        }
+        return nullptr != dynamic_cast<AndExpr*>(expr) || nullptr != dynamic_cast<OrExpr*>(expr);
+    }
+
+    auto* filter = dynamic_cast<FilterExpr*>(expr);
+    if (nullptr == filter || filter->get_column()->is_pure_wildcard()) {
+        return false;
+    }
+    switch (filter->get_column()->get_literal_type()) {
+        case LiteralType::IntegerT:
+        case LiteralType::FloatT:
+        case LiteralType::BooleanT:
+        case LiteralType::EpochDateT:
+            return true;
+        case LiteralType::VarStringT:
+            return m_expr_var_match_map.contains(expr);
+        default:
+            return false;
+    }
+}
+
+void QueryRunner::evaluate_batch(Expression* expr, std::vector<uint8_t>& selection) {
+    if (auto* filter = dynamic_cast<FilterExpr*>(expr); nullptr != filter) {
+        evaluate_filter_batch(filter, selection);
+    } else {
+        bool const is_and{nullptr != dynamic_cast<AndExpr*>(expr)};
+        selection.assign(m_reader->get_num_messages(), is_and ? 1 : 0);
+        std::vector<uint8_t> operand_selection;
+        for (auto const& op : expr->get_op_list()) {
+            evaluate_batch(static_cast<Expression*>(op.get()), operand_selection);
+            combine_selections(selection, operand_selection, is_and);
+        }
+    }
+
+    if (expr->is_inverted()) {
+        invert_selection(selection);
+    }
+}
+
+void QueryRunner::evaluate_filter_batch(FilterExpr* expr, std::vector<uint8_t>& selection) {
+    auto const num_messages{m_reader->get_num_messages()};
+    auto const op{expr->get_operation()};
+    if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
+        selection.assign(num_messages, 1);
+        return;
+    }
+
+    selection.assign(num_messages, 0);
+    auto* column = expr->get_column().get();
+    int32_t const column_id{column->get_column_id()};
+    auto literal = expr->get_operand();
+    switch (column->get_literal_type()) {
+        case LiteralType::IntegerT: {
+            int64_t op_value{};
+            if (false == literal->as_int(op_value, op)) {
+                return;
+            }
+            for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+                auto* int_reader = dynamic_cast<Int64ColumnReader*>(reader);
+                auto* delta_reader = dynamic_cast<DeltaEncodedInt64ColumnReader*>(reader);
+                if (nullptr != int_reader) {
+                    mark_matching_numeric_values(int_reader->get_values(), op, op_value, selection);
+                } else if (nullptr != delta_reader) {
+                    delta_reader->decode_values(m_decoded_int_values);
+                    mark_matching_numeric_values(m_decoded_int_values, op, op_value, selection);
+                } else {
+                    for (uint64_t i{0}; i < num_messages; ++i) {
+                        selection[i] |= static_cast<uint8_t>(evaluate_int_filter_core(
+                                op,
+                                std::get<int64_t>(reader->extract_value(i)),
+                                op_value
+                        ));
+                    }
+                }
+            }
+            return;
+        }
+        case LiteralType::FloatT: {
+            double op_value{};
+            if (false == literal->as_float(op_value, op)) {
+                return;
+            }
+            for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+                auto* float_reader = dynamic_cast<FloatColumnReader*>(reader);
+                auto* formatted_reader = dynamic_cast<FormattedFloatColumnReader*>(reader);
+                if (nullptr != float_reader) {
+                    mark_matching_numeric_values(
+                            float_reader->get_values(),
+                            op,
+                            op_value,
+                            selection
+                    );
+                } else if (nullptr != formatted_reader) {
+                    mark_matching_numeric_values(
+                            formatted_reader->get_values(),
+                            op,
+                            op_value,
+                            selection
+                    );
+                } else {
+                    for (uint64_t i{0}; i < num_messages; ++i) {
+                        selection[i] |= static_cast<uint8_t>(evaluate_float_filter_core(
+                                op,
+                                std::get<double>(reader->extract_value(i)),
+                                op_value
+                        ));
+                    }
+                }
+            }
+            return;
+        }
+        case LiteralType::BooleanT: {
+            bool op_value{};
+            if (false == literal->as_bool(op_value, op)
+                || (FilterOperation::EQ != op && FilterOperation::NEQ != op))
+            {
+                return;
+            }
+            bool const match_value{(FilterOperation::EQ == op) == op_value};
+            for (BaseColumnReader* reader : m_basic_readers[column_id]) {
+                auto* bool_reader = dynamic_cast<BooleanColumnReader*>(reader);
+                if (nullptr != bool_reader) {
+                    mark_matching_values(
+                            bool_reader->get_values(),
+                            [match_value](uint8_t value) { return (0 != value) == match_value; },
+                            selection
+                    );
+                } else {
+                    for (uint64_t i{0}; i < num_messages; ++i) {
+                        bool const value = std::get<uint8_t>(reader->extract_value(i));
+                        selection[i] |= static_cast<uint8_t>(value == match_value);
+                    }
+                }
+            }
+            return;
+        }
+        case LiteralType::EpochDateT: {
+            int64_t op_value{};
+            auto* reader = m_datestring_readers[column_id];
+            if (nullptr == reader || false == literal->as_int(op_value, op)) {
+                return;
+            }
+            mark_matching_numeric_values(reader->get_encoded_times(), op, op_value, selection);
+            return;
+        }
+        case LiteralType::VarStringT: {
+            if (FilterOperation::EQ != op && FilterOperation::NEQ != op) {
+                return;
+            }
+            auto const* matching_vars = m_expr_var_match_map.at(expr);
+            bool const is_eq{FilterOperation::EQ == op};
+            for (VariableStringColumnReader* reader : m_var_string_readers[column_id]) {
+                mark_matching_values(
+                        reader->get_variable_ids(),
+                        [&](uint64_t id) {
+                            return matching_vars->contains(static_cast<int64_t>(id)) == is_eq;
+                        },
+                        selection
+                );
+            }
+            return;
+        }
+        default:
+            return;
+    }
 }
 
 std::string& QueryRunner::get_cached_decompressed_unstructured_array(int32_t column_id) {
@@ -116,6 +453,15 @@ std::string& QueryRunner::get_cached_decompressed_unstructured_array(int32_t col
 }
 
 bool QueryRunner::filter(uint64_t cur_message) {
+    if (SelectionMode::Disabled != m_selection_mode) {
+        if (0 == m_selection[cur_message]) {
+            return false;
+        }
+        if (SelectionMode::Exact == m_selection_mode) {
+            return true;
+        }
+    }
+
     m_cur_message = cur_message;
     m_extracted_unstructured_arrays.clear();
     return evaluate(m_expr.get(), m_schema);
@@ -855,14 +1201,14 @@ void QueryRunner::populate_string_queries(std::shared_ptr<Expression> const& exp
             std::string query_string;
             filter->get_operand()->as_clp_string(query_string, filter->get_operation());
 
-            if (m_string_query_map.count(query_string)) {
+            if (m_string_query_map->count(query_string)) {
                 return;
             }
 
             // search on log type dictionary
             clp::epochtime_t placeholder_timestamp{};
             log_surgeon::lexers::ByteLexer placeholder_lexer;
-            m_string_query_map.emplace(
+            m_string_query_map->emplace(
                     query_string,
                     clp::GrepCore::process_raw_query(
                             *m_log_dict,
@@ -880,11 +1226,11 @@ void QueryRunner::populate_string_queries(std::shared_ptr<Expression> const& exp
         if (filter->get_column()->matches_type(LiteralType::VarStringT)) {
             std::string query_string;
             filter->get_operand()->as_var_string(query_string, filter->get_operation());
-            if (m_string_var_match_map.count(query_string)) {
+            if (m_string_var_match_map->count(query_string)) {
                 return;
             }
 
-            std::unordered_set<int64_t>& matching_vars = m_string_var_match_map[query_string];
+            std::unordered_set<int64_t>& matching_vars = (*m_string_var_match_map)[query_string];
             if (false == ast::has_unescaped_wildcards(query_string)) {
                 auto const unescaped_query_string{clp::string_utils::unescape_string(query_string)};
                 auto const entries = m_var_dict->get_entry_matching_value(
@@ -935,7 +1281,7 @@ void QueryRunner::populate_searched_wildcard_columns(std::shared_ptr<Expression>
         }
         m_wildcard_columns.push_back(col);
         literal_type_bitmask_t matching_types{0};
-        for (int32_t node : (*m_schemas)[m_schema]) {
+        for (int32_t node : m_schemas->at(m_schema)) {
             if (Schema::schema_entry_is_unordered_object(node)) {
                 continue;
             }
@@ -1063,7 +1409,7 @@ EvaluatedValue QueryRunner::constant_propagate(std::shared_ptr<Expression> const
                 return EvaluatedValue::False;
             }
             if (filter->get_column()->matches_type(LiteralType::ClpStringT)) {
-                auto& query_processing_result = m_string_query_map.at(filter_string);
+                auto& query_processing_result = m_string_query_map->at(filter_string);
                 if (query_processing_result.has_value()) {
                     m_expr_clp_query[expr.get()] = &(query_processing_result.value());
                     matches_clp_string = true;
@@ -1073,7 +1419,7 @@ EvaluatedValue QueryRunner::constant_propagate(std::shared_ptr<Expression> const
                 has_clp_string = wildcard->matches_type(LiteralType::ClpStringT);
             }
             if (filter->get_column()->matches_type(LiteralType::VarStringT)) {
-                m_expr_var_match_map[expr.get()] = &m_string_var_match_map.at(filter_string);
+                m_expr_var_match_map[expr.get()] = &m_string_var_match_map->at(filter_string);
                 has_var_string = wildcard->matches_type(LiteralType::VarStringT);
                 matches_var_string = !m_expr_var_match_map.at(expr.get())->empty();
             }
@@ -1115,7 +1461,7 @@ EvaluatedValue QueryRunner::constant_propagate(std::shared_ptr<Expression> const
             filter->get_operand()->as_clp_string(filter_string, filter->get_operation());
 
             // set up string query for this filter
-            auto& query_processing_result = m_string_query_map.at(filter_string);
+            auto& query_processing_result = m_string_query_map->at(filter_string);
             if (query_processing_result.has_value()) {
                 m_expr_clp_query[expr.get()] = &(query_processing_result.value());
                 return EvaluatedValue::Unknown;
@@ -1136,7 +1482,7 @@ EvaluatedValue QueryRunner::constant_propagate(std::shared_ptr<Expression> const
             filter->get_operand()->as_var_string(filter_string, filter->get_operation());
 
             // set up string query for this filter
-            m_expr_var_match_map[expr.get()] = &m_string_var_match_map.at(filter_string);
+            m_expr_var_match_map[expr.get()] = &m_string_var_match_map->at(filter_string);
 
             // use string queries to potentially propagate known result
             if (m_expr_var_match_map.at(expr.get())->empty()) {
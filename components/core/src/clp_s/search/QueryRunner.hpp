@@ -74,13 +74,26 @@ public:
      */
     void global_init();
 
+    /**
+     * Initializes the query processing context that is common to all schemas by sharing the
+     * context of another `QueryRunner` for the same query and archive. This avoids repeating the
+     * dictionary searches performed by `global_init` when several `QueryRunner`s search the same
+     * archive concurrently.
+     *
+     * NOTE: `other` must have been initialized with `global_init` and must not be re-initialized
+     * while this `QueryRunner` is in use.
+     * @param other
+     */
+    void global_init(QueryRunner const& other);
+
     /**
      * Initializes the query processing context for a given schema.
      *
      * It clears any previous schema-specific data and initializes internal data structures required
      * for query execution based on the provided schema ID. Then it performs constant propagation on
-     * the expression. If the expression evaluates to false, it returns EvaluatedValue::False.
-     * Otherwise, it sets the wildcard matching type mask.
+     * the expression and, if the archive has column statistics for the schema's table, evaluates
+     * the expression against them. If the expression evaluates to false, it returns
+     * EvaluatedValue::False. Otherwise, it sets the wildcard matching type mask.
      *
      * @param schema_id
      */
@@ -110,6 +123,19 @@ private:
         Filter
     };
 
+    /**
+     * Describes how `m_selection` relates to the result of evaluating the expression on each
+     * message in the current table.
+     */
+    enum class SelectionMode : uint8_t {
+        // `m_selection` is unused and every message is evaluated individually.
+        Disabled,
+        // `m_selection` holds the exact result of the expression for every message.
+        Exact,
+        // Messages not set in `m_selection` can't match; the rest are evaluated individually.
+        Candidates
+    };
+
     std::shared_ptr<ArchiveReader> m_archive_reader;
     std::shared_ptr<ast::Expression> m_expr;
     std::shared_ptr<SchemaMatch> m_match;
@@ -127,8 +153,14 @@ private:
 
     std::shared_ptr<ReaderUtils::SchemaMap> m_schemas;
 
-    std::map<std::string, std::optional<clp::Query>> m_string_query_map;
-    std::map<std::string, std::unordered_set<int64_t>> m_string_var_match_map;
+    // The results of searching the dictionaries are read-only after `global_init`, so they can be
+    // shared between `QueryRunner`s searching the same archive.
+    std::shared_ptr<std::map<std::string, std::optional<clp::Query>>> m_string_query_map{
+            std::make_shared<std::map<std::string, std::optional<clp::Query>>>()
+    };
+    std::shared_ptr<std::map<std::string, std::unordered_set<int64_t>>> m_string_var_match_map{
+            std::make_shared<std::map<std::string, std::unordered_set<int64_t>>>()
+    };
     std::unordered_map<ast::Expression*, clp::Query*> m_expr_clp_query;
     std::unordered_map<ast::Expression*, std::unordered_set<int64_t>*> m_expr_var_match_map;
     std::unordered_map<int32_t, std::vector<ClpStringColumnReader*>> m_clp_string_readers;
@@ -154,6 +186,10 @@ private:
     bool m_maybe_string{false};
     bool m_maybe_number{false};
 
+    SelectionMode m_selection_mode{SelectionMode::Disabled};
+    std::vector<uint8_t> m_selection;
+    std::vector<int64_t> m_decoded_int_values;
+
     /**
      * Initializes the variables. Init is called once for each schema after which filter is called
      * once for every message in the schema
@@ -162,6 +198,36 @@ private:
      */
     void init(SchemaReader* reader, std::vector<BaseColumnReader*> const& column_readers) override;
 
+    /**
+     * Evaluates as much of the expression as possible over every message in the current table at
+     * once, and records the result in `m_selection`.
+     */
+    void initialize_selection();
+
+    /**
+     * @param expr
+     * @return Whether the expression can be evaluated over a whole table at once by
+     * `evaluate_batch`
+     */
+    auto can_evaluate_batch(ast::Expression* expr) const -> bool;
+
+    /**
+     * Evaluates an expression over every message in the current table at once.
+     * @param expr
+     * @param selection Returns one entry per message which is 1 if the expression evaluates to
+     * true for that message, and 0 otherwise
+     */
+    void evaluate_batch(ast::Expression* expr, std::vector<uint8_t>& selection);
+
+    /**
+     * Evaluates a filter expression over every message in the current table at once, ignoring
+     * whether the filter is inverted.
+     * @param expr
+     * @param selection Returns one entry per message which is 1 if the filter evaluates to true
+     * for that message, and 0 otherwise
+     */
+    void evaluate_filter_batch(ast::FilterExpr* expr, std::vector<uint8_t>& selection);
+
     /**
      * Evaluates an expression
      * @param expr
@@ -564,7 +564,8 @@ bool SchemaMatch::schema_matched(int32_t schema_id) {
 }
 
 bool SchemaMatch::schema_searches_against_column(int32_t schema, int32_t column_id) {
-    return m_schema_to_searched_columns[schema].count(column_id);
+    auto const it{m_schema_to_searched_columns.find(schema)};
+    return m_schema_to_searched_columns.end() != it && it->second.contains(column_id);
 }
 
 void SchemaMatch::add_searched_column_to_schema(int32_t schema, int32_t column) {
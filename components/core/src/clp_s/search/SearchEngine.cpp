@@ -0,0 +1,182 @@
+#include "SearchEngine.hpp"
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "../ArchiveCache.hpp"
+#include "../ArchiveReader.hpp"
+#include "../Defs.hpp"
+#include "../InputConfig.hpp"
+#include "AddTimestampConditions.hpp"
+#include "ast/ColumnDescriptor.hpp"
+#include "ast/ConvertToExists.hpp"
+#include "ast/EmptyExpr.hpp"
+#include "ast/Expression.hpp"
+#include "ast/NarrowTypes.hpp"
+#include "ast/OrOfAndForm.hpp"
+#include "ast/SearchUtils.hpp"
+#include "EvaluateRangeIndexFilters.hpp"
+#include "EvaluateTimestampIndex.hpp"
+#include "Output.hpp"
+#include "OutputHandler.hpp"
+#include "Projection.hpp"
+#include "SchemaMatch.hpp"
+
+namespace clp_s::search {
+SearchEngine::SearchEngine(std::shared_ptr<ArchiveCache> cache) : m_cache{std::move(cache)} {
+    m_archive_reader->set_cache(m_cache);
+}
+
+auto SearchEngine::search_archive(
+        Path const& archive_path,
+        NetworkAuthOption const& network_auth,
+        std::shared_ptr<ast::Expression> expr,
+        SearchOption const& option,
+        OutputHandlerFactory const& create_output_handler
+) -> bool {
+    try {
+        m_archive_reader->open(archive_path, network_auth);
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to open archive - {}", e.what());
+        return false;
+    }
+
+    bool succeeded{false};
+    try {
+        succeeded = search_open_archive(std::move(expr), option, create_output_handler);
+    } catch (...) {
+        if (m_archive_reader->is_open()) {
+            m_archive_reader->close();
+        }
+        throw;
+    }
+
+    // The search may have already closed the archive if it found no results
+    if (m_archive_reader->is_open()) {
+        m_archive_reader->close();
+    }
+    return succeeded;
+}
+
+auto SearchEngine::search_open_archive(
+        std::shared_ptr<ast::Expression> expr,
+        SearchOption const& option,
+        OutputHandlerFactory const& create_output_handler
+) -> bool {
+    auto const& query = option.query;
+
+    auto timestamp_dict = m_archive_reader->get_timestamp_dictionary();
+    AddTimestampConditions add_timestamp_conditions(
+            timestamp_dict->get_authoritative_timestamp_tokenized_column(),
+            option.search_begin_ts,
+            option.search_end_ts
+    );
+    if (expr = add_timestamp_conditions.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr))
+    {
+        SPDLOG_ERROR(
+                "Query '{}' specified timestamp filters tge {} tle {}, but no authoritative "
+                "timestamp column was found for this archive",
+                query,
+                option.search_begin_ts.value_or(cEpochTimeMin),
+                option.search_end_ts.value_or(cEpochTimeMax)
+        );
+        return false;
+    }
+
+    ast::OrOfAndForm standardize_pass;
+    if (expr = standardize_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return false;
+    }
+
+    ast::NarrowTypes narrow_pass;
+    if (expr = narrow_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return false;
+    }
+
+    ast::ConvertToExists convert_pass;
+    if (expr = convert_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_ERROR("Query '{}' is logically false", query);
+        return false;
+    }
+
+    EvaluateRangeIndexFilters metadata_filter_pass{
+            m_archive_reader->get_range_index(),
+            false == option.ignore_case
+    };
+    if (expr = metadata_filter_pass.run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_INFO("No matching metadata ranges for query '{}'", query);
+        return true;
+    }
+
+    // skip decompressing the archive if we won't match based on
+    // the timestamp index
+    EvaluateTimestampIndex timestamp_index(timestamp_dict);
+    if (EvaluatedValue::False == timestamp_index.run(expr)) {
+        SPDLOG_INFO("No matching timestamp ranges for query '{}'", query);
+        return true;
+    }
+
+    // Narrow against schemas
+    auto match_pass = std::make_shared<SchemaMatch>(
+            m_archive_reader->get_schema_tree(),
+            m_archive_reader->get_schema_map()
+    );
+    if (expr = match_pass->run(expr); std::dynamic_pointer_cast<ast::EmptyExpr>(expr)) {
+        SPDLOG_INFO("No matching schemas for query '{}'", query);
+        return true;
+    }
+
+    // Populate projection
+    auto projection = std::make_shared<Projection>(
+            option.projection_columns.empty() ? ProjectionMode::ReturnAllColumns
+                                              : ProjectionMode::ReturnSelectedColumns
+    );
+    try {
+        for (auto const& column : option.projection_columns) {
+            std::vector<std::string> descriptor_tokens;
+            std::string descriptor_namespace;
+            if (false
+                == ast::tokenize_column_descriptor(column, descriptor_tokens, descriptor_namespace))
+            {
+                SPDLOG_ERROR("Can not tokenize invalid column: \"{}\"", column);
+                return false;
+            }
+            projection->add_column(
+                    ast::ColumnDescriptor::create_from_escaped_tokens(
+                            descriptor_tokens,
+                            descriptor_namespace
+                    )
+            );
+        }
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("{}", e.what());
+        return false;
+    }
+    projection->resolve_columns(m_archive_reader->get_schema_tree());
+    m_archive_reader->set_projection(projection);
+
+    auto output_handler = create_output_handler();
+    if (nullptr == output_handler) {
+        return false;
+    }
+
+    // output result
+    Output output(
+            match_pass,
+            expr,
+            m_archive_reader,
+            std::move(output_handler),
+            option.ignore_case,
+            option.num_threads,
+            option.num_prefetched_streams
+    );
+    return output.filter();
+}
+}  // namespace clp_s::search
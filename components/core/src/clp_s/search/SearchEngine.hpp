@@ -0,0 +1,94 @@
+#ifndef CLP_S_SEARCH_SEARCHENGINE_HPP
+#define CLP_S_SEARCH_SEARCHENGINE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../ArchiveCache.hpp"
+#include "../ArchiveReader.hpp"
+#include "../Defs.hpp"
+#include "../InputConfig.hpp"
+#include "ast/Expression.hpp"
+#include "OutputHandler.hpp"
+
+namespace clp_s::search {
+/**
+ * Options for searching an archive.
+ */
+struct SearchOption {
+    // The query string, used in log messages
+    std::string query;
+    std::optional<epochtime_t> search_begin_ts;
+    std::optional<epochtime_t> search_end_ts;
+    bool ignore_case{false};
+    std::vector<std::string> projection_columns;
+    size_t num_threads{1};
+    size_t num_prefetched_streams{0};
+};
+
+/**
+ * A search engine for clp-s archives, which runs the passes that specialize a query for an archive
+ * and then searches the archive. The engine can be kept alive to run many searches in a
+ * long-running process: if it's given an `ArchiveCache`, the dictionaries, schema trees and
+ * decompressed streams of recently searched archives are cached, so repeated searches of the same
+ * archives don't have to read or decompress them again.
+ *
+ * An engine can only run one search at a time; engines running searches concurrently can share a
+ * cache.
+ */
+class SearchEngine {
+public:
+    // Types
+    using OutputHandlerFactory = std::function<std::unique_ptr<OutputHandler>()>;
+
+    // Constructors
+    /**
+     * @param cache the cache to use, or nullptr to read every archive from scratch
+     */
+    explicit SearchEngine(std::shared_ptr<ArchiveCache> cache = nullptr);
+
+    // Methods
+    /**
+     * Searches the given archive.
+     * @param archive_path
+     * @param network_auth
+     * @param expr A copy of the search AST which may be modified
+     * @param option
+     * @param create_output_handler Creates the output handler for the results of the search, or
+     * returns nullptr on failure. Only called if the archive may contain results.
+     * @return Whether the search succeeded
+     */
+    [[nodiscard]] auto search_archive(
+            Path const& archive_path,
+            NetworkAuthOption const& network_auth,
+            std::shared_ptr<ast::Expression> expr,
+            SearchOption const& option,
+            OutputHandlerFactory const& create_output_handler
+    ) -> bool;
+
+    [[nodiscard]] auto get_cache() const -> std::shared_ptr<ArchiveCache> const& { return m_cache; }
+
+private:
+    /**
+     * Searches the archive that's open in the archive reader.
+     * @param expr
+     * @param option
+     * @param create_output_handler
+     * @return Whether the search succeeded
+     */
+    [[nodiscard]] auto search_open_archive(
+            std::shared_ptr<ast::Expression> expr,
+            SearchOption const& option,
+            OutputHandlerFactory const& create_output_handler
+    ) -> bool;
+
+    std::shared_ptr<ArchiveCache> m_cache;
+    std::shared_ptr<ArchiveReader> m_archive_reader{std::make_shared<ArchiveReader>()};
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_SEARCHENGINE_HPP
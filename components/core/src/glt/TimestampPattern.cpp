@@ -1,11 +1,13 @@
 #include "TimestampPattern.hpp"
 
+#include <bit>
 #include <chrono>
 #include <cstring>
 #include <vector>
 
 #include <date/date.h>
 
+#include "../clp/KnownTimestampPatternMatcher.hpp"
 #include "spdlog_with_specializations.hpp"
 
 using std::string;
@@ -112,6 +114,12 @@ static bool convert_string_to_number(
 }
 
 namespace glt {
+namespace {
+using KnownPatternMatcher = clp::KnownTimestampPatternMatcher<TimestampPattern>;
+
+KnownPatternMatcher known_ts_pattern_matcher;
+}  // namespace
+
 /*
  * To initialize m_known_ts_patterns, we first create a vector of patterns then copy it to a dynamic
  * array. This eases maintenance of the list and the cost doesn't matter since it is only done once
@@ -197,6 +205,7 @@ void TimestampPattern::init() {
     for (size_t i = 0; i < patterns.size(); ++i) {
         m_known_ts_patterns[i] = patterns[i];
     }
+    known_ts_pattern_matcher.compile(m_known_ts_patterns.get(), m_known_ts_patterns_len);
 }
 
 TimestampPattern const* TimestampPattern::search_known_ts_patterns(
@@ -205,7 +214,18 @@ TimestampPattern const* TimestampPattern::search_known_ts_patterns(
         size_t& timestamp_begin_pos,
         size_t& timestamp_end_pos
 ) {
-    for (size_t i = 0; i < m_known_ts_patterns_len; ++i) {
+    // Only try the candidate patterns, in order, since the rest can't match the line
+    auto candidates = known_ts_pattern_matcher.get_candidates(line);
+    while (0 != candidates) {
+        auto const i = static_cast<size_t>(std::countr_zero(candidates));
+        candidates &= candidates - 1;
+        if (m_known_ts_patterns[i]
+                    .parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos))
+        {
+            return &m_known_ts_patterns[i];
+        }
+    }
+    for (size_t i = KnownPatternMatcher::cMaxNumPatterns; i < m_known_ts_patterns_len; ++i) {
         if (m_known_ts_patterns[i]
                     .parse_timestamp(line, timestamp, timestamp_begin_pos, timestamp_end_pos))
         {
@@ -0,0 +1,71 @@
+#include "AggregateOperator.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "aggregates.hpp"
+#include "Operator.hpp"
+
+namespace reducer {
+std::optional<AggregationType> parse_aggregation_type(std::string_view name) {
+    if ("sum" == name) {
+        return AggregationType::Sum;
+    }
+    if ("min" == name) {
+        return AggregationType::Min;
+    }
+    if ("max" == name) {
+        return AggregationType::Max;
+    }
+    if ("avg" == name) {
+        return AggregationType::Avg;
+    }
+    if ("count-distinct" == name) {
+        return AggregationType::ApproxCountDistinct;
+    }
+    if ("percentile" == name) {
+        return AggregationType::ApproxPercentile;
+    }
+    return std::nullopt;
+}
+
+std::shared_ptr<Operator>
+create_aggregate_operator(AggregationType type, std::string field, double quantile) {
+    switch (type) {
+        case AggregationType::Sum:
+            return std::make_shared<AggregateOperator<SumAggregate>>(
+                    std::move(field),
+                    SumAggregate{}
+            );
+        case AggregationType::Min:
+            return std::make_shared<AggregateOperator<MinAggregate>>(
+                    std::move(field),
+                    MinAggregate{}
+            );
+        case AggregationType::Max:
+            return std::make_shared<AggregateOperator<MaxAggregate>>(
+                    std::move(field),
+                    MaxAggregate{}
+            );
+        case AggregationType::Avg:
+            return std::make_shared<AggregateOperator<AvgAggregate>>(
+                    std::move(field),
+                    AvgAggregate{}
+            );
+        case AggregationType::ApproxCountDistinct:
+            return std::make_shared<AggregateOperator<ApproxCountDistinctAggregate>>(
+                    std::move(field),
+                    ApproxCountDistinctAggregate{}
+            );
+        case AggregationType::ApproxPercentile:
+            return std::make_shared<AggregateOperator<ApproxPercentileAggregate>>(
+                    std::move(field),
+                    ApproxPercentileAggregate{quantile}
+            );
+    }
+    return nullptr;
+}
+}  // namespace reducer
@@ -0,0 +1,189 @@
+#ifndef REDUCER_AGGREGATEOPERATOR_HPP
+#define REDUCER_AGGREGATEOPERATOR_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Operator.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordGroupIterator.hpp"
+
+namespace reducer {
+/**
+ * The aggregations that can be performed by an AggregateOperator (besides counting, which is
+ * performed by CountOperator).
+ */
+enum class AggregationType : uint8_t {
+    Sum,
+    Min,
+    Max,
+    Avg,
+    ApproxCountDistinct,
+    ApproxPercentile
+};
+
+/**
+ * @param name
+ * @return The aggregation type with the given name, or std::nullopt if there's no such type.
+ */
+std::optional<AggregationType> parse_aggregation_type(std::string_view name);
+
+/**
+ * @param type
+ * @return Whether the aggregation type aggregates the string form of values rather than numeric
+ * values.
+ */
+constexpr bool aggregates_string_values(AggregationType type) {
+    return AggregationType::ApproxCountDistinct == type;
+}
+
+/**
+ * Creates an operator that performs the given aggregation on a field of each record.
+ * @param type
+ * @param field The key of the record element to aggregate.
+ * @param quantile The quantile to estimate, for AggregationType::ApproxPercentile.
+ * @return The operator.
+ */
+std::shared_ptr<Operator>
+create_aggregate_operator(AggregationType type, std::string field, double quantile);
+
+/**
+ * A RecordGroupIterator that exposes a map which maps GroupTags to aggregates, optionally filtered
+ * by a set of GroupTags.
+ * @tparam Aggregate The type of aggregate stored in the map.
+ */
+template <typename Aggregate>
+class AggregateMapRecordGroupIterator : public RecordGroupIterator {
+public:
+    AggregateMapRecordGroupIterator(
+            std::map<GroupTags, Aggregate>& map,
+            std::set<GroupTags> const* filter
+    )
+            : m_map{map},
+              m_map_it{map.begin()},
+              m_filter{filter},
+              m_group{nullptr, m_record} {
+        if (nullptr != m_filter) {
+            m_filter_it = m_filter->cbegin();
+            advance_to_next_filter();
+        }
+    }
+
+    // Disable copy and move construction/assignment since m_map is a reference
+    AggregateMapRecordGroupIterator(AggregateMapRecordGroupIterator const&) = delete;
+    AggregateMapRecordGroupIterator(AggregateMapRecordGroupIterator&&) = delete;
+    auto operator=(AggregateMapRecordGroupIterator const&)
+            -> AggregateMapRecordGroupIterator& = delete;
+    auto operator=(AggregateMapRecordGroupIterator&&) -> AggregateMapRecordGroupIterator& = delete;
+
+    ~AggregateMapRecordGroupIterator() override = default;
+
+    RecordGroup& get() override {
+        // Aggregates may omit elements (e.g., the minimum of no values), so start from scratch
+        // rather than leaving the previous group's elements in the record
+        m_record.clear();
+        m_map_it->second.write_to_record(m_record);
+        m_group.set_tags(&m_map_it->first);
+        m_group.reset_record_iterator();
+        return m_group;
+    }
+
+    void next() override {
+        if (nullptr == m_filter) {
+            ++m_map_it;
+        } else {
+            advance_to_next_filter();
+        }
+    }
+
+    bool done() override { return m_map_it == m_map.end(); }
+
+private:
+    void advance_to_next_filter() {
+        m_map_it = m_map.end();
+        while (m_map_it == m_map.end() && m_filter_it != m_filter->cend()) {
+            m_map_it = m_map.find(*m_filter_it);
+            ++m_filter_it;
+        }
+    }
+
+    std::map<GroupTags, Aggregate>& m_map;
+    typename std::map<GroupTags, Aggregate>::iterator m_map_it;
+    std::set<GroupTags> const* m_filter;
+    std::set<GroupTags>::const_iterator m_filter_it;
+    MultiValueRecordAdapter m_record;
+    SingleRecordGroup m_group;
+};
+
+/**
+ * Operator that accumulates an aggregate of a field per record group.
+ *
+ * Inter-stage records contain the field's value, while intra-stage records contain partial
+ * aggregates produced by other AggregateOperators of the same type, allowing results to be
+ * aggregated in parts (e.g., by each search worker) and then combined.
+ * @tparam Aggregate The type of aggregate to accumulate. It must be copyable and have the methods:
+ * - `void add(Record const& record, std::string_view field)`, which adds a record's field value.
+ * - `void merge(Record const& record)`, which merges a partial aggregate.
+ * - `void write_to_record(MultiValueRecordAdapter& record)`, which writes the partial aggregate
+ *   along with its final value, if it has one, to an empty record.
+ */
+template <typename Aggregate>
+class AggregateOperator : public Operator {
+public:
+    AggregateOperator(std::string field, Aggregate initial_aggregate)
+            : m_field{std::move(field)},
+              m_initial_aggregate{std::move(initial_aggregate)} {}
+
+    void
+    push_intra_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override {
+        auto& aggregate = get_aggregate(tags);
+        for (; false == record_it.done(); record_it.next()) {
+            aggregate.merge(record_it.get());
+        }
+    }
+
+    void
+    push_inter_stage_record_group(GroupTags const& tags, ConstRecordIterator& record_it) override {
+        auto& aggregate = get_aggregate(tags);
+        for (; false == record_it.done(); record_it.next()) {
+            aggregate.add(record_it.get(), m_field);
+        }
+    }
+
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator() override {
+        return std::make_unique<AggregateMapRecordGroupIterator<Aggregate>>(
+                m_group_aggregates,
+                nullptr
+        );
+    }
+
+    std::unique_ptr<RecordGroupIterator> get_stored_result_iterator(
+            std::set<GroupTags> const& filtered_tags
+    ) override {
+        return std::make_unique<AggregateMapRecordGroupIterator<Aggregate>>(
+                m_group_aggregates,
+                &filtered_tags
+        );
+    }
+
+private:
+    Aggregate& get_aggregate(GroupTags const& tags) {
+        return m_group_aggregates.try_emplace(tags, m_initial_aggregate).first->second;
+    }
+
+    std::string m_field;
+    Aggregate m_initial_aggregate;
+    std::map<GroupTags, Aggregate> m_group_aggregates;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_AGGREGATEOPERATOR_HPP
@@ -0,0 +1,349 @@
+#include "ColumnarRecordGroup.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+namespace {
+/**
+ * Reads the fields of serialized record groups while checking that they're within the data.
+ */
+class Decoder {
+public:
+    Decoder(char const* buf, size_t len) : m_cur{buf}, m_end{buf + len} {}
+
+    [[nodiscard]] bool done() const { return m_cur == m_end; }
+
+    /**
+     * @tparam T
+     * @return The value at the current position.
+     * @throw ColumnarRecordGroup::OperationFailed if the data is truncated.
+     */
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        std::memcpy(&value, read_bytes(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    /**
+     * @return A string view of a length-prefixed string at the current position.
+     * @throw ColumnarRecordGroup::OperationFailed if the data is truncated.
+     */
+    std::string_view read_string() {
+        auto const length = read<uint32_t>();
+        return {read_bytes(length), length};
+    }
+
+    /**
+     * @param num_bytes
+     * @return A pointer to the bytes at the current position.
+     * @throw ColumnarRecordGroup::OperationFailed if the data is truncated.
+     */
+    char const* read_bytes(size_t num_bytes) {
+        if (static_cast<size_t>(m_end - m_cur) < num_bytes) {
+            throw ColumnarRecordGroup::OperationFailed(
+                    clp::ErrorCode_Truncated,
+                    __FILENAME__,
+                    __LINE__
+            );
+        }
+        auto const* bytes = m_cur;
+        m_cur += num_bytes;
+        return bytes;
+    }
+
+private:
+    char const* m_cur;
+    char const* m_end;
+};
+
+/**
+ * Encodes the batches of a serialized record group.
+ */
+class Encoder {
+public:
+    explicit Encoder(std::vector<uint8_t>& buf) : m_buf{buf} {}
+
+    /**
+     * Starts a new batch if the given record's typed keys differ from those of the current batch,
+     * and then appends the record's values to the batch's columns.
+     * @param record
+     */
+    void add_record(Record const& record);
+
+    /**
+     * Writes the current batch, if any, to the buffer.
+     */
+    void flush_batch();
+
+    [[nodiscard]] uint32_t get_num_batches() const { return m_num_batches; }
+
+private:
+    struct Column {
+        std::string key;
+        ValueType type;
+        std::vector<uint8_t> values;
+    };
+
+    std::vector<uint8_t>& m_buf;
+    std::vector<Column> m_columns;
+    uint32_t m_num_records{0};
+    uint32_t m_num_batches{0};
+};
+
+/**
+ * Appends the bytes of a value to a buffer.
+ * @tparam T
+ * @param value
+ * @param buf
+ */
+template <typename T>
+void append_value(T value, std::vector<uint8_t>& buf);
+
+/**
+ * Appends a length-prefixed string to a buffer.
+ * @param str
+ * @param buf
+ */
+void append_string(std::string_view str, std::vector<uint8_t>& buf);
+
+template <typename T>
+void append_value(T value, std::vector<uint8_t>& buf) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+void append_string(std::string_view str, std::vector<uint8_t>& buf) {
+    append_value(static_cast<uint32_t>(str.size()), buf);
+    buf.insert(buf.end(), str.cbegin(), str.cend());
+}
+
+void Encoder::add_record(Record const& record) {
+    std::vector<TypedRecordKey> typed_keys;
+    for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+         typed_key_it->next())
+    {
+        typed_keys.push_back(typed_key_it->get());
+    }
+
+    auto const same_schema = [&]() {
+        if (typed_keys.size() != m_columns.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < typed_keys.size(); ++i) {
+            if (typed_keys[i].get_key() != m_columns[i].key
+                || typed_keys[i].get_type() != m_columns[i].type)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (0 == m_num_records || false == same_schema()) {
+        flush_batch();
+        for (auto const& typed_key : typed_keys) {
+            m_columns.push_back({std::string{typed_key.get_key()}, typed_key.get_type(), {}});
+        }
+    }
+
+    for (auto& column : m_columns) {
+        switch (column.type) {
+            case ValueType::Int64:
+                append_value(record.get_int64_value(column.key), column.values);
+                break;
+            case ValueType::Double:
+                append_value(record.get_double_value(column.key), column.values);
+                break;
+            case ValueType::String:
+                append_string(record.get_string_view(column.key), column.values);
+                break;
+        }
+    }
+    ++m_num_records;
+}
+
+void Encoder::flush_batch() {
+    if (0 == m_num_records) {
+        return;
+    }
+
+    append_value(m_num_records, m_buf);
+    append_value(static_cast<uint32_t>(m_columns.size()), m_buf);
+    for (auto const& column : m_columns) {
+        append_value(static_cast<uint8_t>(column.type), m_buf);
+        append_string(column.key, m_buf);
+        append_value(static_cast<uint64_t>(column.values.size()), m_buf);
+        m_buf.insert(m_buf.end(), column.values.cbegin(), column.values.cend());
+    }
+
+    m_columns.clear();
+    m_num_records = 0;
+    ++m_num_batches;
+}
+}  // namespace
+
+ColumnarRecordGroup::ColumnarRecordGroup(char const* buf, size_t len) {
+    Decoder decoder{buf, len};
+
+    auto const num_tags = decoder.read<uint32_t>();
+    for (uint32_t i = 0; i < num_tags; ++i) {
+        m_tags.emplace_back(decoder.read_string());
+    }
+
+    auto const num_batches = decoder.read<uint32_t>();
+    for (uint32_t batch_ix = 0; batch_ix < num_batches; ++batch_ix) {
+        auto& batch = m_batches.emplace_back();
+        batch.num_records = decoder.read<uint32_t>();
+        auto const num_columns = decoder.read<uint32_t>();
+        for (uint32_t i = 0; i < num_columns; ++i) {
+            auto& column = batch.columns.emplace_back();
+            auto const type = decoder.read<uint8_t>();
+            if (type > static_cast<uint8_t>(ValueType::Double)) {
+                throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+            }
+            column.type = static_cast<ValueType>(type);
+            column.key = decoder.read_string();
+            auto const values_size = decoder.read<uint64_t>();
+            column.values = decoder.read_bytes(values_size);
+
+            if (ValueType::String == column.type) {
+                Decoder values_decoder{column.values, values_size};
+                // Each string takes at least the bytes of its length
+                column.string_values.reserve(
+                        std::min<size_t>(batch.num_records, values_size / sizeof(uint32_t))
+                );
+                for (size_t row = 0; row < batch.num_records; ++row) {
+                    column.string_values.push_back(values_decoder.read_string());
+                }
+                if (false == values_decoder.done()) {
+                    throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+                }
+            } else if (batch.num_records * sizeof(int64_t) != values_size) {
+                throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+            }
+            batch.typed_keys.emplace_back(column.key, column.type);
+        }
+    }
+    if (false == decoder.done()) {
+        throw OperationFailed(clp::ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    m_record_it.reset();
+}
+
+std::string_view ColumnarRecordGroup::ColumnarRecord::get_string_view(std::string_view key
+) const {
+    auto const* column = find_column(key);
+    if (nullptr == column || ValueType::String != column->type) {
+        return {};
+    }
+    return column->string_values[m_row];
+}
+
+int64_t ColumnarRecordGroup::ColumnarRecord::get_int64_value(std::string_view key) const {
+    auto const* column = find_column(key);
+    if (nullptr == column || ValueType::String == column->type) {
+        return 0;
+    }
+    auto const* value = column->values + m_row * sizeof(int64_t);
+    if (ValueType::Double == column->type) {
+        double double_value{};
+        std::memcpy(&double_value, value, sizeof(double_value));
+        return static_cast<int64_t>(double_value);
+    }
+    int64_t int64_value{};
+    std::memcpy(&int64_value, value, sizeof(int64_value));
+    return int64_value;
+}
+
+double ColumnarRecordGroup::ColumnarRecord::get_double_value(std::string_view key) const {
+    auto const* column = find_column(key);
+    if (nullptr == column || ValueType::String == column->type) {
+        return 0.0;
+    }
+    auto const* value = column->values + m_row * sizeof(double);
+    if (ValueType::Int64 == column->type) {
+        int64_t int64_value{};
+        std::memcpy(&int64_value, value, sizeof(int64_value));
+        return static_cast<double>(int64_value);
+    }
+    double double_value{};
+    std::memcpy(&double_value, value, sizeof(double_value));
+    return double_value;
+}
+
+auto ColumnarRecordGroup::ColumnarRecord::find_column(std::string_view key) const
+        -> Column const* {
+    // Batches only have a handful of columns, so a linear search is fastest
+    for (auto const& column : m_batch->columns) {
+        if (column.key == key) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+void ColumnarRecordGroup::ColumnarRecordIterator::reset() {
+    m_batch_ix = 0;
+    m_row = 0;
+    skip_empty_batches();
+}
+
+void ColumnarRecordGroup::ColumnarRecordIterator::next() {
+    ++m_row;
+    if (m_row >= m_batches[m_batch_ix].num_records) {
+        ++m_batch_ix;
+        m_row = 0;
+        skip_empty_batches();
+        return;
+    }
+    m_record.set_position(&m_batches[m_batch_ix], m_row);
+}
+
+void ColumnarRecordGroup::ColumnarRecordIterator::skip_empty_batches() {
+    while (m_batch_ix < m_batches.size() && 0 == m_batches[m_batch_ix].num_records) {
+        ++m_batch_ix;
+    }
+    if (m_batch_ix < m_batches.size()) {
+        m_record.set_position(&m_batches[m_batch_ix], m_row);
+    }
+}
+
+std::vector<uint8_t>
+serialize_columnar_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
+    std::vector<uint8_t> serialized_data;
+    append_value(static_cast<uint32_t>(tags.size()), serialized_data);
+    for (auto const& tag : tags) {
+        append_string(tag, serialized_data);
+    }
+
+    // Reserve space for the number of batches, which is only known once they've been written
+    auto const num_batches_pos = serialized_data.size();
+    append_value(uint32_t{0}, serialized_data);
+
+    Encoder encoder{serialized_data};
+    for (; false == record_it.done(); record_it.next()) {
+        encoder.add_record(record_it.get());
+    }
+    encoder.flush_batch();
+
+    auto const num_batches = encoder.get_num_batches();
+    std::memcpy(&serialized_data[num_batches_pos], &num_batches, sizeof(num_batches));
+    return serialized_data;
+}
+}  // namespace reducer
@@ -0,0 +1,157 @@
+#ifndef REDUCER_COLUMNARRECORDGROUP_HPP
+#define REDUCER_COLUMNARRECORDGROUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "../clp/TraceableException.hpp"
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+/**
+ * Class which decodes a record group serialized by `serialize_columnar_record_group` and exposes
+ * iterators to the underlying data.
+ *
+ * The serialized format stores the group's tags once, followed by the number of batches and the
+ * batches themselves, where each batch contains consecutive records that share the same typed
+ * keys. Each batch stores its keys once, followed by one column of values per key, so records are
+ * read straight out of the serialized data without building intermediate objects.
+ *
+ * NOTE: The serialized data must outlive this object.
+ */
+class ColumnarRecordGroup : public RecordGroup {
+public:
+    // Types
+    class OperationFailed : public clp::TraceableException {
+    public:
+        // Constructors
+        OperationFailed(clp::ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException{error_code, filename, line_number} {}
+
+        // Methods
+        [[nodiscard]] char const* what() const noexcept override {
+            return "reducer::ColumnarRecordGroup operation failed";
+        }
+    };
+
+    // Constructors
+    /**
+     * @param buf
+     * @param len
+     * @throw OperationFailed if the serialized data is corrupt.
+     */
+    ColumnarRecordGroup(char const* buf, size_t len);
+
+    // Disable copy and move construction/assignment since the record iterator references the
+    // batches
+    ColumnarRecordGroup(ColumnarRecordGroup const&) = delete;
+    ColumnarRecordGroup(ColumnarRecordGroup&&) = delete;
+    auto operator=(ColumnarRecordGroup const&) -> ColumnarRecordGroup& = delete;
+    auto operator=(ColumnarRecordGroup&&) -> ColumnarRecordGroup& = delete;
+
+    ~ColumnarRecordGroup() override = default;
+
+    // Methods
+    [[nodiscard]] ConstRecordIterator& record_iter() override { return m_record_it; }
+
+    [[nodiscard]] GroupTags const& get_tags() const override { return m_tags; }
+
+private:
+    // Types
+    struct Column {
+        std::string_view key;
+        ValueType type{ValueType::String};
+        // Fixed-width values for Int64 and Double columns
+        char const* values{nullptr};
+        // Values for String columns
+        std::vector<std::string_view> string_values;
+    };
+
+    struct Batch {
+        size_t num_records{0};
+        std::vector<Column> columns;
+        std::vector<TypedRecordKey> typed_keys;
+    };
+
+    /**
+     * Record implementation which exposes a row of a batch.
+     */
+    class ColumnarRecord : public Record {
+    public:
+        void set_position(Batch const* batch, size_t row) {
+            m_batch = batch;
+            m_row = row;
+        }
+
+        [[nodiscard]] std::string_view get_string_view(std::string_view key) const override;
+
+        [[nodiscard]] int64_t get_int64_value(std::string_view key) const override;
+
+        [[nodiscard]] double get_double_value(std::string_view key) const override;
+
+        [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override {
+            return std::make_unique<VectorTypedKeyIterator>(m_batch->typed_keys);
+        }
+
+    private:
+        [[nodiscard]] Column const* find_column(std::string_view key) const;
+
+        Batch const* m_batch{nullptr};
+        size_t m_row{0};
+    };
+
+    /**
+     * ConstRecordIterator over the rows of all batches.
+     */
+    class ColumnarRecordIterator : public ConstRecordIterator {
+    public:
+        explicit ColumnarRecordIterator(std::vector<Batch> const& batches) : m_batches{batches} {}
+
+        /**
+         * Positions the iterator at the first record.
+         */
+        void reset();
+
+        [[nodiscard]] Record const& get() const override { return m_record; }
+
+        void next() override;
+
+        bool done() override { return m_batch_ix >= m_batches.size(); }
+
+    private:
+        /**
+         * Advances to the next non-empty batch, starting at the current one.
+         */
+        void skip_empty_batches();
+
+        std::vector<Batch> const& m_batches;
+        size_t m_batch_ix{0};
+        size_t m_row{0};
+        ColumnarRecord m_record;
+    };
+
+    // Variables
+    GroupTags m_tags;
+    std::vector<Batch> m_batches;
+    ColumnarRecordIterator m_record_it{m_batches};
+};
+
+/**
+ * Serializes a record group into the format decoded by ColumnarRecordGroup.
+ * @param tags The tags in the record group.
+ * @param record_it An iterator for the records in the record group.
+ * @return The serialized data.
+ */
+std::vector<uint8_t>
+serialize_columnar_record_group(GroupTags const& tags, ConstRecordIterator& record_it);
+}  // namespace reducer
+
+#endif  // REDUCER_COLUMNARRECORDGROUP_HPP
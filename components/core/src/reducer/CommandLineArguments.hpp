@@ -1,6 +1,7 @@
 #ifndef REDUCER_COMMANDLINEARGUMENTS_HPP
 #define REDUCER_COMMANDLINEARGUMENTS_HPP
 
+#include <cstddef>
 #include <string>
 
 #include "../clp/CommandLineArgumentsBase.hpp"
@@ -30,6 +31,8 @@ public:
 
     [[nodiscard]] int get_upsert_interval() const { return m_upsert_interval; }
 
+    [[nodiscard]] size_t get_num_threads() const { return m_num_threads; }
+
 private:
     // Methods
     void print_basic_usage() const override;
@@ -41,6 +44,7 @@ private:
     int m_scheduler_port{7000};
     std::string m_mongodb_uri{"mongodb://localhost:27017/clp-search"};
     int m_upsert_interval{100};  // Milliseconds
+    size_t m_num_threads{1};
 };
 }  // namespace reducer
 
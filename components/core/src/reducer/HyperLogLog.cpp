@@ -0,0 +1,119 @@
+#include "HyperLogLog.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace reducer {
+namespace {
+// Register values are serialized as characters starting from this one so that the serialized
+// sketch is printable
+constexpr char cSerializedRegisterBase{'0'};
+
+/**
+ * Hashes a value with FNV-1a followed by a 64-bit finalizer to spread the bits. The hash must be
+ * the same in every process that produces sketches that are merged, so we can't use std::hash.
+ * @param value
+ * @return The hash.
+ */
+uint64_t hash_value(std::string_view value);
+
+uint64_t hash_value(std::string_view value) {
+    constexpr uint64_t cFnvOffsetBasis{0xcbf2'9ce4'8422'2325ULL};
+    constexpr uint64_t cFnvPrime{0x100'0000'01b3ULL};
+
+    uint64_t hash{cFnvOffsetBasis};
+    for (auto const c : value) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= cFnvPrime;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51'afd7'ed55'8ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ce'b9fe'1a85'ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}  // namespace
+
+HyperLogLog::HyperLogLog(uint8_t precision)
+        : m_precision{precision},
+          m_registers(size_t{1} << precision, 0) {}
+
+void HyperLogLog::add(std::string_view value) {
+    auto const hash = hash_value(value);
+    auto const register_ix = hash >> (64 - m_precision);
+    // The position of the leftmost 1-bit in the remaining bits. The sentinel bit bounds the result
+    // when the remaining bits are all 0.
+    auto const remaining_bits = (hash << m_precision) | (uint64_t{1} << (m_precision - 1));
+    auto const rank = static_cast<uint8_t>(std::countl_zero(remaining_bits) + 1);
+    m_registers[register_ix] = std::max(m_registers[register_ix], rank);
+}
+
+bool HyperLogLog::merge(HyperLogLog const& other) {
+    if (m_precision != other.m_precision) {
+        return false;
+    }
+    for (size_t i = 0; i < m_registers.size(); ++i) {
+        m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+    return true;
+}
+
+int64_t HyperLogLog::estimate() const {
+    auto const num_registers = static_cast<double>(m_registers.size());
+    double sum{0.0};
+    size_t num_zero_registers{0};
+    for (auto const value : m_registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(value));
+        if (0 == value) {
+            ++num_zero_registers;
+        }
+    }
+
+    double const alpha = 0.7213 / (1.0 + 1.079 / num_registers);
+    double estimate = alpha * num_registers * num_registers / sum;
+    if (estimate <= 2.5 * num_registers && num_zero_registers > 0) {
+        // Use linear counting for small cardinalities where the raw estimate is biased
+        estimate = num_registers
+                   * std::log(num_registers / static_cast<double>(num_zero_registers));
+    }
+    return std::llround(estimate);
+}
+
+std::string HyperLogLog::serialize() const {
+    std::string serialized_sketch;
+    serialized_sketch.reserve(m_registers.size());
+    for (auto const value : m_registers) {
+        serialized_sketch.push_back(static_cast<char>(cSerializedRegisterBase + value));
+    }
+    return serialized_sketch;
+}
+
+bool HyperLogLog::merge_serialized(std::string_view serialized_sketch) {
+    if (serialized_sketch.size() != m_registers.size()) {
+        return false;
+    }
+    // The largest possible rank is the number of bits that aren't used to pick a register, plus one
+    auto const max_rank = static_cast<uint8_t>(64 - m_precision + 1);
+    auto const is_valid_register = [&](char c) {
+        return static_cast<uint8_t>(c - cSerializedRegisterBase) <= max_rank;
+    };
+    if (false
+        == std::all_of(serialized_sketch.cbegin(), serialized_sketch.cend(), is_valid_register))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < m_registers.size(); ++i) {
+        auto const value = static_cast<uint8_t>(serialized_sketch[i] - cSerializedRegisterBase);
+        m_registers[i] = std::max(m_registers[i], value);
+    }
+    return true;
+}
+}  // namespace reducer
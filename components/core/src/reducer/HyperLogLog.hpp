@@ -0,0 +1,59 @@
+#ifndef REDUCER_HYPERLOGLOG_HPP
+#define REDUCER_HYPERLOGLOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reducer {
+/**
+ * A HyperLogLog sketch that estimates the number of distinct values added to it. Sketches with
+ * the same precision can be merged, so partial sketches can be computed in different processes and
+ * combined.
+ */
+class HyperLogLog {
+public:
+    // Constants
+    // 2^12 registers gives a standard error of about 1.6%
+    static constexpr uint8_t cDefaultPrecision{12};
+
+    // Constructors
+    explicit HyperLogLog(uint8_t precision = cDefaultPrecision);
+
+    // Methods
+    void add(std::string_view value);
+
+    /**
+     * Merges the given sketch into this one. Sketches with different precisions can't be merged.
+     * @param other
+     * @return Whether the sketches were merged.
+     */
+    bool merge(HyperLogLog const& other);
+
+    /**
+     * @return An estimate of the number of distinct values added to the sketch.
+     */
+    [[nodiscard]] int64_t estimate() const;
+
+    /**
+     * Serializes the sketch into a string of printable characters.
+     * @return The serialized sketch.
+     */
+    [[nodiscard]] std::string serialize() const;
+
+    /**
+     * Merges a sketch serialized by `serialize` into this one.
+     * @param serialized_sketch
+     * @return Whether the serialized sketch was valid and could be merged.
+     */
+    bool merge_serialized(std::string_view serialized_sketch);
+
+private:
+    uint8_t m_precision;
+    std::vector<uint8_t> m_registers;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_HYPERLOGLOG_HPP
@@ -6,6 +6,7 @@
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "RecordTypedKeyIterator.hpp"
 
@@ -94,6 +95,101 @@ private:
     int64_t m_value{};
 };
 
+/**
+ * Record implementation which exposes a fixed set of key-value pairs of any type.
+ *
+ * The values associated with the keys can be updated allowing this class to act as an adapter for
+ * a larger set of data.
+ */
+class MultiValueRecordAdapter : public Record {
+public:
+    /**
+     * Sets the value of the given key, adding the key if it doesn't exist.
+     * @param key
+     * @param value
+     */
+    void set_record_value(std::string_view key, int64_t value) {
+        get_or_add_element(key, ValueType::Int64).value = value;
+    }
+
+    void set_record_value(std::string_view key, double value) {
+        get_or_add_element(key, ValueType::Double).value = value;
+    }
+
+    void set_record_value(std::string_view key, std::string value) {
+        get_or_add_element(key, ValueType::String).value = std::move(value);
+    }
+
+    /**
+     * Removes every key-value pair.
+     */
+    void clear() { m_elements.clear(); }
+
+    [[nodiscard]] std::string_view get_string_view(std::string_view key) const override {
+        auto const* element = find_element(key);
+        if (nullptr == element || ValueType::String != element->type) {
+            return {};
+        }
+        return std::get<std::string>(element->value);
+    }
+
+    [[nodiscard]] int64_t get_int64_value(std::string_view key) const override {
+        auto const* element = find_element(key);
+        if (nullptr == element || ValueType::Int64 != element->type) {
+            return 0;
+        }
+        return std::get<int64_t>(element->value);
+    }
+
+    [[nodiscard]] double get_double_value(std::string_view key) const override {
+        auto const* element = find_element(key);
+        if (nullptr == element || ValueType::Double != element->type) {
+            return 0.0;
+        }
+        return std::get<double>(element->value);
+    }
+
+    [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override {
+        std::vector<TypedRecordKey> typed_keys;
+        typed_keys.reserve(m_elements.size());
+        for (auto const& element : m_elements) {
+            typed_keys.emplace_back(element.key, element.type);
+        }
+        return std::make_unique<VectorTypedKeyIterator>(std::move(typed_keys));
+    }
+
+private:
+    // Types
+    struct Element {
+        std::string key;
+        ValueType type{ValueType::String};
+        std::variant<int64_t, double, std::string> value;
+    };
+
+    // Methods
+    [[nodiscard]] Element const* find_element(std::string_view key) const {
+        for (auto const& element : m_elements) {
+            if (element.key == key) {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+
+    Element& get_or_add_element(std::string_view key, ValueType type) {
+        for (auto& element : m_elements) {
+            if (element.key == key) {
+                element.type = type;
+                return element;
+            }
+        }
+        return m_elements.emplace_back(Element{std::string{key}, type, {}});
+    }
+
+    // Variables
+    std::vector<Element> m_elements;
+};
+
 /**
  * Record implementation for an empty record.
  */
@@ -1,7 +1,7 @@
 #include "RecordReceiverContext.hpp"
 
 #include "../clp/spdlog_with_specializations.hpp"
-#include "DeserializedRecordGroup.hpp"
+#include "ColumnarRecordGroup.hpp"
 #include "types.hpp"
 
 namespace reducer {
@@ -61,8 +61,13 @@ bool RecordReceiverContext::read_record_groups_packet() {
         }
         read_head += sizeof(record_size);
 
-        auto record_group = DeserializedRecordGroup{read_head, record_size};
-        m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
+        try {
+            ColumnarRecordGroup record_group{read_head, record_size};
+            m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
+        } catch (ColumnarRecordGroup::OperationFailed const& e) {
+            SPDLOG_ERROR("Failed to decode record group - {}", e.what());
+            return false;
+        }
         m_buf_num_bytes_occupied -= (record_size + sizeof(record_size));
         read_head += record_size;
     }
@@ -1,7 +1,10 @@
 #ifndef REDUCER_RECORDTYPEDKEYITERATOR_HPP
 #define REDUCER_RECORDTYPEDKEYITERATOR_HPP
 
+#include <cstddef>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace reducer {
 /**
@@ -90,6 +93,25 @@ private:
     ValueType m_type;
     bool m_done{false};
 };
+
+/**
+ * A RecordTypedKeyIterator over a vector of typed keys.
+ */
+class VectorTypedKeyIterator : public RecordTypedKeyIterator {
+public:
+    explicit VectorTypedKeyIterator(std::vector<TypedRecordKey> typed_keys)
+            : m_typed_keys{std::move(typed_keys)} {}
+
+    TypedRecordKey get() override { return m_typed_keys[m_ix]; }
+
+    void next() override { ++m_ix; }
+
+    bool done() override { return m_ix >= m_typed_keys.size(); }
+
+private:
+    std::vector<TypedRecordKey> m_typed_keys;
+    size_t m_ix{0};
+};
 }  // namespace reducer
 
 #endif  // REDUCER_RECORDTYPEDKEYITERATOR_HPP
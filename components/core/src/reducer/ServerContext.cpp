@@ -1,5 +1,15 @@
 #include "ServerContext.hpp"
 
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <bsoncxx/builder/stream/document.hpp>
 #include <mongocxx/bulk_write.hpp>
 #include <mongocxx/client.hpp>
@@ -12,9 +22,11 @@
 #include <nlohmann/json.hpp>
 
 #include "../clp/spdlog_with_specializations.hpp"
+#include "AggregateOperator.hpp"
 #include "CommandLineArguments.hpp"
 #include "CountOperator.hpp"
 #include "DeserializedRecordGroup.hpp"
+#include "RecordGroup.hpp"
 
 using boost::asio::ip::tcp;
 using std::vector;
@@ -52,8 +64,11 @@ vector<uint8_t> serialize_timeline_result(GroupTags const& tags, ConstRecordIter
 // TODO: We should use tcp::v6 and set ip::v6_only to false, but this isn't guaranteed to work; so
 // for now, we use v4 to be safe.
 ServerContext::ServerContext(CommandLineArguments& args)
-        : m_tcp_acceptor{m_ioctx, tcp::endpoint(tcp::v4(), args.get_reducer_port())},
+        : m_control_strand{boost::asio::make_strand(m_ioctx)},
+          m_num_threads{args.get_num_threads()},
+          m_tcp_acceptor{m_ioctx, tcp::endpoint(tcp::v4(), args.get_reducer_port())},
           m_scheduler_socket{m_ioctx},
+          m_pipeline{args.get_num_threads() * cNumPipelineShardsPerThread},
           m_upsert_timer{m_ioctx},
           m_reducer_host{args.get_reducer_host()},
           m_reducer_port{args.get_reducer_port()},
@@ -70,14 +85,44 @@ ServerContext::ServerContext(CommandLineArguments& args)
 
 void ServerContext::reset() {
     m_ioctx.restart();
-    m_pipeline.reset(nullptr);
+    m_pipeline.reset();
     m_status = ServerStatus::Idle;
     m_job_id = -1;
     m_is_timeline_aggregation = false;
-    m_updated_tags.clear();
+    m_results_finalized = false;
     m_num_active_receiver_tasks = 0;
 }
 
+void ServerContext::run() {
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+    auto run_event_loop = [&]() {
+        try {
+            m_ioctx.run();
+        } catch (...) {
+            std::lock_guard const lock{exception_mutex};
+            if (nullptr == exception) {
+                exception = std::current_exception();
+            }
+            m_ioctx.stop();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(m_num_threads - 1);
+    for (size_t i = 1; i < m_num_threads; ++i) {
+        threads.emplace_back(run_event_loop);
+    }
+    run_event_loop();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (nullptr != exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
 void ServerContext::stop_event_loop() {
     m_tcp_acceptor.cancel();
     m_scheduler_socket.close();
@@ -132,57 +177,84 @@ bool ServerContext::ack_query_scheduler() {
 }
 
 void ServerContext::decrement_num_active_receiver_tasks() {
-    --m_num_active_receiver_tasks;
-    if (0 == m_num_active_receiver_tasks && ServerStatus::ReceivedAllResults == m_status) {
-        if (false == try_finalize_results()) {
-            m_status = ServerStatus::UnrecoverableFailure;
-        }
+    if (1 == m_num_active_receiver_tasks.fetch_sub(1)
+        && ServerStatus::ReceivedAllResults == m_status)
+    {
+        boost::asio::post(m_control_strand, [this]() {
+            if (false == try_finalize_results()) {
+                m_status = ServerStatus::UnrecoverableFailure;
+            }
+        });
     }
 }
 
-void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
+bool ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
     m_job_id = query_config[cJobAttributes::JobId];
 
     SPDLOG_INFO("Setting up pipeline for job {}", m_job_id);
 
-    // For now, all pipelines only perform count and optionally, group-by time and count for the
-    // timeline aggregation.
-    // TODO: We'll need to implement more general pipeline initialization once more operators are
-    // needed.
-    m_pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
-    m_pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
-
+    // Pipelines perform either a single aggregation of a field, or a count and optionally,
+    // group-by time and count for the timeline aggregation.
+    std::function<std::shared_ptr<Operator>()> create_operator
+            = []() -> std::shared_ptr<Operator> { return std::make_shared<CountOperator>(); };
+    if (query_config.count(cJobAttributes::AggregationType) > 0
+        && false == query_config[cJobAttributes::AggregationType].is_null())
+    {
+        auto const& type_name = query_config[cJobAttributes::AggregationType];
+        auto const type = type_name.is_string()
+                                  ? parse_aggregation_type(type_name.get<std::string>())
+                                  : std::nullopt;
+        if (false == type.has_value()) {
+            SPDLOG_ERROR("Unknown aggregation type {} for job {}", type_name.dump(), m_job_id);
+            return false;
+        }
+        if (0 == query_config.count(cJobAttributes::AggregationField)
+            || false == query_config[cJobAttributes::AggregationField].is_string())
+        {
+            SPDLOG_ERROR("Missing aggregation field for job {}", m_job_id);
+            return false;
+        }
+        std::string const field = query_config[cJobAttributes::AggregationField];
+        double quantile{0.5};
+        if (query_config.count(cJobAttributes::AggregationQuantile) > 0
+            && query_config[cJobAttributes::AggregationQuantile].is_number())
+        {
+            quantile = query_config[cJobAttributes::AggregationQuantile];
+        }
+        create_operator = [type = type.value(), field, quantile]() {
+            return create_aggregate_operator(type, field, quantile);
+        };
+    }
     if (query_config.count(cJobAttributes::TimeBucketSize) > 0
         && false == query_config[cJobAttributes::TimeBucketSize].is_null())
     {
         m_is_timeline_aggregation = true;
     }
+    m_pipeline.set_up(
+            [&create_operator]() {
+                auto pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
+                pipeline->add_pipeline_stage(create_operator());
+                return pipeline;
+            },
+            m_is_timeline_aggregation
+    );
 
     auto collection_name = std::to_string(m_job_id);
     m_mongodb_results_collection = m_mongodb_results_database[collection_name];
+    return true;
 }
 
 void ServerContext::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
-    if (m_is_timeline_aggregation) {
-        m_updated_tags.insert(tags);
-    }
-    m_pipeline->push_record_group(tags, record_it);
+    m_pipeline.push_record_group(tags, record_it);
 }
 
 bool ServerContext::upsert_timeline_results() {
-    if (m_updated_tags.empty()) {
-        return true;
-    }
-
-    bool any_updates = false;
     auto bulk_write = m_mongodb_results_collection.create_bulk_write();
     vector<vector<uint8_t>> results;
-    for (auto group_it = m_pipeline->finish(m_updated_tags); false == group_it->done();
-         group_it->next())
-    {
-        int64_t timestamp{std::stoll(group_it->get().get_tags().front())};
-
-        auto& group = group_it->get();
+    // NOTE: The updated tags are forgotten once their groups are appended to the bulk write, so if
+    // the write fails, they won't be upserted again. A failed upsert is unrecoverable anyway.
+    bool const any_updates = m_pipeline.finish_updated_groups([&](RecordGroup& group) {
+        int64_t timestamp{std::stoll(group.get_tags().front())};
         results.emplace_back(serialize_timeline_result(group.get_tags(), group.record_iter()));
 
         auto& result = results.back();
@@ -194,13 +266,10 @@ bool ServerContext::upsert_timeline_results() {
         };
         replace_op.upsert(true);
         bulk_write.append(replace_op);
-
-        any_updates = true;
-    }
+    });
     try {
         if (any_updates) {
             bulk_write.execute();
-            m_updated_tags.clear();
         }
     } catch (mongocxx::bulk_write_exception const& e) {
         SPDLOG_ERROR("Failed to upsert timeline results - {}", e.what());
@@ -213,15 +282,14 @@ bool ServerContext::upsert_timeline_results() {
 bool ServerContext::publish_pipeline_results() {
     vector<vector<uint8_t>> results;
     vector<bsoncxx::document::view> result_documents;
-    for (auto group_it = m_pipeline->finish(); false == group_it->done(); group_it->next()) {
-        auto& group = group_it->get();
+    m_pipeline.finish([&](RecordGroup& group) {
         results.push_back(
                 serialize(group.get_tags(), group.record_iter(), nlohmann::json::to_bson)
         );
 
         vector<uint8_t>& encoded_result = results.back();
         result_documents.emplace_back(encoded_result.data(), encoded_result.size());
-    }
+    });
     try {
         if (result_documents.empty() == false) {
             m_mongodb_results_collection.insert_many(result_documents);
@@ -246,6 +314,10 @@ bool ServerContext::try_finalize_results() {
         // We haven't received all results yet
         return true;
     }
+    if (m_results_finalized) {
+        // Both the scheduler update listener and the last receiver may try to finalize the results
+        return true;
+    }
 
     bool published_results_successfully
             = m_is_timeline_aggregation ? upsert_timeline_results() : publish_pipeline_results();
@@ -254,6 +326,8 @@ bool ServerContext::try_finalize_results() {
         return false;
     }
 
+    m_results_finalized = true;
+
     // Notify the query scheduler that the results have been pushed
     return ack_query_scheduler();
 }
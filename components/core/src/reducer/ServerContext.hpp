@@ -1,8 +1,12 @@
 #ifndef REDUCER_SERVERCONTEXT_HPP
 #define REDUCER_SERVERCONTEXT_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <mongocxx/client.hpp>
@@ -12,6 +16,7 @@
 #include "../clp/TraceableException.hpp"
 #include "CommandLineArguments.hpp"
 #include "Pipeline.hpp"
+#include "ShardedPipeline.hpp"
 #include "types.hpp"
 
 namespace reducer {
@@ -26,11 +31,19 @@ enum class ServerStatus : uint8_t {
 namespace cJobAttributes {
 constexpr char JobId[] = "job_id";
 constexpr char TimeBucketSize[] = "count_by_time_bucket_size";
+constexpr char AggregationType[] = "aggregation_type";
+constexpr char AggregationField[] = "aggregation_field";
+constexpr char AggregationQuantile[] = "aggregation_quantile";
 }  // namespace cJobAttributes
 
 /**
  * Class which manages interactions with the jobs database and result cache database. Also holds
  * state for the reducer job this server is handling.
+ *
+ * The event loop runs on a pool of threads. Connections from search workers are serviced
+ * concurrently, and the records they send are aggregated in pipeline shards selected by the hash of
+ * each record group's tags, so that workers sending different groups rarely contend. Tasks that
+ * interact with the scheduler or the results cache are serialized on a control strand.
  */
 class ServerContext {
 public:
@@ -58,9 +71,9 @@ public:
     void reset();
 
     /**
-     * Executes the server event loop until no tasks remain.
+     * Executes the server event loop on the configured number of threads until no tasks remain.
      */
-    void run() { m_ioctx.run(); }
+    void run();
 
     /**
      * Stops the event loop by closing the connection to the scheduler, and cancelling any ongoing
@@ -90,19 +103,22 @@ public:
     void increment_num_active_receiver_tasks() { ++m_num_active_receiver_tasks; }
 
     /**
-     * Decrements the number of active receiver tasks, and calls try_finalize_results if the server
-     * is in the state ReceivedAllResults and there are no remaining active receiver tasks.
+     * Decrements the number of active receiver tasks, and queues try_finalize_results on the
+     * control strand if the server is in the state ReceivedAllResults and there are no remaining
+     * active receiver tasks.
      */
     void decrement_num_active_receiver_tasks();
 
     /**
      * Sets up an in-memory aggregation pipeline according to the given query config.
      * @param query_config
+     * @return Whether the query config specified a valid aggregation.
      */
-    void set_up_pipeline(nlohmann::json const& query_config);
+    bool set_up_pipeline(nlohmann::json const& query_config);
 
     /**
-     * Pushes a record group into the reducer pipeline.
+     * Pushes a record group into the reducer pipeline shard for its tags. This method is
+     * thread-safe.
      * @param group_tags The tags in the record group.
      * @param record_it An iterator for the records in the record group.
      */
@@ -133,6 +149,14 @@ public:
 
     boost::asio::io_context& get_io_context() { return m_ioctx; }
 
+    /**
+     * @return The strand on which tasks that interact with the scheduler or the results cache must
+     * run.
+     */
+    boost::asio::strand<boost::asio::io_context::executor_type>& get_control_strand() {
+        return m_control_strand;
+    }
+
     boost::asio::ip::tcp::acceptor& get_tcp_acceptor() { return m_tcp_acceptor; }
 
     boost::asio::ip::tcp::socket& get_scheduler_update_socket() { return m_scheduler_socket; }
@@ -156,21 +180,27 @@ public:
     [[nodiscard]] int get_upsert_interval() const { return m_upsert_interval; }
 
 private:
+    // Constants
+    static constexpr size_t cNumPipelineShardsPerThread{4};
+
+    // Variables
     boost::asio::io_context m_ioctx;
+    boost::asio::strand<boost::asio::io_context::executor_type> m_control_strand;
+    size_t m_num_threads;
     boost::asio::ip::tcp::acceptor m_tcp_acceptor;
     boost::asio::ip::tcp::socket m_scheduler_socket;
     std::vector<char> m_scheduler_update_buffer;
 
     std::string m_reducer_host;
     int m_reducer_port;
-    int m_num_active_receiver_tasks{0};
+    std::atomic<int> m_num_active_receiver_tasks{0};
 
-    ServerStatus m_status{ServerStatus::Idle};
+    std::atomic<ServerStatus> m_status{ServerStatus::Idle};
     job_id_t m_job_id{-1};
 
-    std::unique_ptr<Pipeline> m_pipeline;
+    ShardedPipeline m_pipeline;
     bool m_is_timeline_aggregation{false};
-    std::set<GroupTags> m_updated_tags;
+    bool m_results_finalized{false};
 
     boost::asio::steady_timer m_upsert_timer;
     int m_upsert_interval;
@@ -0,0 +1,76 @@
+#include "ShardedPipeline.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+
+namespace reducer {
+void ShardedPipeline::set_up(PipelineFactory const& create_pipeline, bool track_updated_tags) {
+    for (auto& shard : m_shards) {
+        std::lock_guard const lock{shard.mutex};
+        shard.pipeline = create_pipeline();
+        shard.updated_tags.clear();
+    }
+    m_track_updated_tags = track_updated_tags;
+}
+
+void ShardedPipeline::reset() {
+    for (auto& shard : m_shards) {
+        std::lock_guard const lock{shard.mutex};
+        shard.pipeline.reset(nullptr);
+        shard.updated_tags.clear();
+    }
+    m_track_updated_tags = false;
+}
+
+void ShardedPipeline::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
+    auto& shard = get_shard(tags);
+    std::lock_guard const lock{shard.mutex};
+    if (m_track_updated_tags) {
+        shard.updated_tags.insert(tags);
+    }
+    shard.pipeline->push_record_group(tags, record_it);
+}
+
+void ShardedPipeline::finish(RecordGroupHandler const& handle_group) {
+    for (auto& shard : m_shards) {
+        std::lock_guard const lock{shard.mutex};
+        for (auto group_it = shard.pipeline->finish(); false == group_it->done(); group_it->next())
+        {
+            handle_group(group_it->get());
+        }
+    }
+}
+
+auto ShardedPipeline::finish_updated_groups(RecordGroupHandler const& handle_group) -> bool {
+    bool any_updates{false};
+    for (auto& shard : m_shards) {
+        std::lock_guard const lock{shard.mutex};
+        if (shard.updated_tags.empty()) {
+            continue;
+        }
+        for (auto group_it = shard.pipeline->finish(shard.updated_tags); false == group_it->done();
+             group_it->next())
+        {
+            handle_group(group_it->get());
+            any_updates = true;
+        }
+        // The shard's updated groups were handled above, so tags updated after this point will be
+        // handled next time.
+        shard.updated_tags.clear();
+    }
+    return any_updates;
+}
+
+auto ShardedPipeline::get_shard(GroupTags const& tags) -> Shard& {
+    size_t hash{0};
+    for (auto const& tag : tags) {
+        hash = hash * 31 + std::hash<std::string>{}(tag);
+    }
+    return m_shards[hash % m_shards.size()];
+}
+}  // namespace reducer
@@ -0,0 +1,95 @@
+#ifndef REDUCER_SHARDEDPIPELINE_HPP
+#define REDUCER_SHARDEDPIPELINE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Pipeline.hpp"
+#include "RecordGroup.hpp"
+
+namespace reducer {
+/**
+ * An aggregation pipeline split into shards which record groups can be pushed into concurrently.
+ *
+ * Each record group is aggregated in the shard selected by the hash of its tags, so that pushers
+ * of different groups rarely contend. Since each group lives in exactly one shard, the shards'
+ * results are disjoint, and the pipeline's results are their concatenation.
+ */
+class ShardedPipeline {
+public:
+    // Types
+    using PipelineFactory = std::function<std::unique_ptr<Pipeline>()>;
+    using RecordGroupHandler = std::function<void(RecordGroup&)>;
+
+    // Constructors
+    /**
+     * @param num_shards The number of shards. A value of 0 is treated as 1.
+     */
+    explicit ShardedPipeline(size_t num_shards) : m_shards(0 == num_shards ? 1 : num_shards) {}
+
+    // Methods
+    /**
+     * Creates a pipeline for each shard.
+     * @param create_pipeline
+     * @param track_updated_tags Whether to track the tags updated since the last call to
+     * `finish_updated_groups`.
+     */
+    void set_up(PipelineFactory const& create_pipeline, bool track_updated_tags);
+
+    /**
+     * Destroys the pipeline of each shard and forgets any updated tags.
+     */
+    void reset();
+
+    [[nodiscard]] auto get_num_shards() const -> size_t { return m_shards.size(); }
+
+    /**
+     * Pushes a record group into the shard for its tags. This method is thread-safe.
+     * @param tags The tags in the record group.
+     * @param record_it An iterator for the records in the record group.
+     */
+    void push_record_group(GroupTags const& tags, ConstRecordIterator& record_it);
+
+    /**
+     * Finishes the pipeline of each shard and passes each resulting record group to the handler.
+     * @param handle_group
+     */
+    void finish(RecordGroupHandler const& handle_group);
+
+    /**
+     * Passes the current result of each record group updated since the last call to the handler,
+     * and forgets the updated tags. Groups updated while this method runs are passed to the handler
+     * in this call or the next one.
+     * @param handle_group
+     * @return Whether any record groups were passed to the handler.
+     */
+    auto finish_updated_groups(RecordGroupHandler const& handle_group) -> bool;
+
+private:
+    // Types
+    /**
+     * A pipeline aggregating the record groups whose tags hash to the shard, along with the tags
+     * updated since the last call to `finish_updated_groups`.
+     */
+    struct Shard {
+        std::mutex mutex;
+        std::unique_ptr<Pipeline> pipeline;
+        std::set<GroupTags> updated_tags;
+    };
+
+    // Methods
+    [[nodiscard]] auto get_shard(GroupTags const& tags) -> Shard&;
+
+    // Variables
+    std::vector<Shard> m_shards;
+    bool m_track_updated_tags{false};
+};
+}  // namespace reducer
+
+#endif  // REDUCER_SHARDEDPIPELINE_HPP
@@ -0,0 +1,229 @@
+#include "TDigest.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace reducer {
+namespace {
+// Buffered values are merged into the centroids once there are this many times the compression
+// of them
+constexpr double cBufferSizeFactor{5.0};
+
+/**
+ * Appends the shortest representation of the given value that round-trips, followed by a space.
+ * @param value
+ * @param str
+ */
+void append_number(double value, std::string& str);
+
+/**
+ * Parses the next space-separated finite number from the given string.
+ * @param str Returns the remainder of the string after the number.
+ * @param value Returns the number.
+ * @return Whether a finite number was parsed. `std::from_chars` also parses "nan" and "inf", which
+ * are rejected since they'd corrupt the digest.
+ */
+bool parse_next_number(std::string_view& str, double& value);
+
+void append_number(double value, std::string& str) {
+    std::array<char, 32> buf{};
+    auto const result = std::to_chars(buf.data(), buf.data() + buf.size(), value);
+    str.append(buf.data(), result.ptr);
+    str.push_back(' ');
+}
+
+bool parse_next_number(std::string_view& str, double& value) {
+    auto const* const end = str.data() + str.size();
+    auto const result = std::from_chars(str.data(), end, value);
+    if (std::errc{} != result.ec || false == std::isfinite(value)) {
+        return false;
+    }
+    str.remove_prefix(result.ptr - str.data());
+    if (false == str.empty()) {
+        if (' ' != str.front()) {
+            return false;
+        }
+        str.remove_prefix(1);
+    }
+    return true;
+}
+}  // namespace
+
+TDigest::TDigest(double compression)
+        : m_compression{compression},
+          m_min{std::numeric_limits<double>::infinity()},
+          m_max{-std::numeric_limits<double>::infinity()} {}
+
+void TDigest::add(double value, double weight) {
+    if (false == std::isfinite(value) || false == std::isfinite(weight) || weight <= 0.0) {
+        return;
+    }
+
+    m_buffer.push_back({value, weight});
+    m_total_weight += weight;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    if (static_cast<double>(m_buffer.size()) >= cBufferSizeFactor * m_compression) {
+        compress();
+    }
+}
+
+void TDigest::merge(TDigest const& other) {
+    m_buffer.insert(m_buffer.end(), other.m_centroids.cbegin(), other.m_centroids.cend());
+    m_buffer.insert(m_buffer.end(), other.m_buffer.cbegin(), other.m_buffer.cend());
+    m_total_weight += other.m_total_weight;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    compress();
+}
+
+double TDigest::estimate_quantile(double quantile) {
+    compress();
+    if (m_centroids.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (1 == m_centroids.size()) {
+        return m_centroids.front().mean;
+    }
+
+    // Each centroid's mean is treated as the value at the centre of its weight. Values between the
+    // centres of adjacent centroids, or between the extreme values and the outermost centroids, are
+    // linearly interpolated.
+    auto const target_weight = std::clamp(quantile, 0.0, 1.0) * m_total_weight;
+    double prev_weight{0.0};
+    double prev_mean{m_min};
+    double cumulative_weight{0.0};
+    for (auto const& centroid : m_centroids) {
+        auto const centre_weight = cumulative_weight + centroid.weight / 2;
+        if (target_weight <= centre_weight) {
+            if (centre_weight == prev_weight) {
+                return centroid.mean;
+            }
+            auto const fraction = (target_weight - prev_weight) / (centre_weight - prev_weight);
+            return prev_mean + fraction * (centroid.mean - prev_mean);
+        }
+        prev_weight = centre_weight;
+        prev_mean = centroid.mean;
+        cumulative_weight += centroid.weight;
+    }
+
+    if (m_total_weight == prev_weight) {
+        return m_max;
+    }
+    auto const fraction = (target_weight - prev_weight) / (m_total_weight - prev_weight);
+    return prev_mean + fraction * (m_max - prev_mean);
+}
+
+std::string TDigest::serialize() {
+    compress();
+
+    std::string serialized_digest;
+    append_number(m_compression, serialized_digest);
+    // An empty digest has no (finite) extreme values
+    if (false == m_centroids.empty()) {
+        append_number(m_min, serialized_digest);
+        append_number(m_max, serialized_digest);
+    }
+    for (auto const& centroid : m_centroids) {
+        append_number(centroid.mean, serialized_digest);
+        append_number(centroid.weight, serialized_digest);
+    }
+    if (false == serialized_digest.empty()) {
+        serialized_digest.pop_back();
+    }
+    return serialized_digest;
+}
+
+bool TDigest::merge_serialized(std::string_view serialized_digest) {
+    // Centroids are only comparable between digests with the same compression
+    double compression{};
+    if (false == parse_next_number(serialized_digest, compression)
+        || compression != m_compression)
+    {
+        return false;
+    }
+    if (serialized_digest.empty()) {
+        return true;
+    }
+
+    double min{};
+    double max{};
+    if (false == parse_next_number(serialized_digest, min)
+        || false == parse_next_number(serialized_digest, max) || min > max)
+    {
+        return false;
+    }
+
+    std::vector<Centroid> centroids;
+    double total_weight{0.0};
+    while (false == serialized_digest.empty()) {
+        Centroid centroid{};
+        if (false == parse_next_number(serialized_digest, centroid.mean)
+            || false == parse_next_number(serialized_digest, centroid.weight)
+            || centroid.weight <= 0.0)
+        {
+            return false;
+        }
+        total_weight += centroid.weight;
+        centroids.push_back(centroid);
+    }
+    if (centroids.empty() || false == std::isfinite(total_weight)) {
+        return false;
+    }
+
+    m_buffer.insert(m_buffer.end(), centroids.cbegin(), centroids.cend());
+    m_total_weight += total_weight;
+    m_min = std::min(m_min, min);
+    m_max = std::max(m_max, max);
+    compress();
+    return true;
+}
+
+void TDigest::compress() {
+    if (m_buffer.empty()) {
+        return;
+    }
+
+    m_buffer.insert(m_buffer.end(), m_centroids.cbegin(), m_centroids.cend());
+    std::sort(m_buffer.begin(), m_buffer.end(), [](Centroid const& lhs, Centroid const& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    // Merge adjacent centroids as long as the merged centroid spans at most one unit of the scale
+    // function k(q) = compression / (2 * pi) * asin(2q - 1), which limits centroids near the tails
+    // to small weights.
+    auto const normalizer = m_compression / (2 * std::numbers::pi);
+    auto const scale = [&](double quantile) {
+        return normalizer * std::asin(std::clamp(2 * quantile - 1, -1.0, 1.0));
+    };
+
+    m_centroids.clear();
+    auto current = m_buffer.front();
+    double weight_before_current{0.0};
+    for (size_t i = 1; i < m_buffer.size(); ++i) {
+        auto const& next = m_buffer[i];
+        auto const merged_weight = current.weight + next.weight;
+        auto const q_left = weight_before_current / m_total_weight;
+        auto const q_right = (weight_before_current + merged_weight) / m_total_weight;
+        if (scale(q_right) - scale(q_left) <= 1.0) {
+            current.mean += (next.mean - current.mean) * next.weight / merged_weight;
+            current.weight = merged_weight;
+        } else {
+            weight_before_current += current.weight;
+            m_centroids.push_back(current);
+            current = next;
+        }
+    }
+    m_centroids.push_back(current);
+    m_buffer.clear();
+}
+}  // namespace reducer
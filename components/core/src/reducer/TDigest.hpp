@@ -0,0 +1,77 @@
+#ifndef REDUCER_TDIGEST_HPP
+#define REDUCER_TDIGEST_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reducer {
+/**
+ * A merging t-digest that estimates quantiles of the values added to it. The digest keeps a
+ * bounded number of weighted centroids, with smaller centroids near the tails so that extreme
+ * quantiles stay accurate. Digests can be merged, so partial digests can be computed in different
+ * processes and combined.
+ */
+class TDigest {
+public:
+    // Constants
+    static constexpr double cDefaultCompression{100.0};
+
+    // Constructors
+    explicit TDigest(double compression = cDefaultCompression);
+
+    // Methods
+    void add(double value, double weight = 1.0);
+
+    void merge(TDigest const& other);
+
+    /**
+     * @param quantile A value in [0, 1].
+     * @return An estimate of the value at the given quantile, or NaN if the digest is empty.
+     */
+    [[nodiscard]] double estimate_quantile(double quantile);
+
+    [[nodiscard]] double get_total_weight() const { return m_total_weight; }
+
+    /**
+     * Serializes the digest into a string of space-separated numbers: the compression, followed by
+     * the minimum and maximum values and the mean and weight of each centroid, if the digest isn't
+     * empty.
+     * @return The serialized digest.
+     */
+    [[nodiscard]] std::string serialize();
+
+    /**
+     * Merges a digest serialized by `serialize` into this one. The serialized digest is invalid if
+     * it has a different compression, or any number that isn't finite or is out of range.
+     * @param serialized_digest
+     * @return Whether the serialized digest was valid. If not, this digest is left unchanged.
+     */
+    bool merge_serialized(std::string_view serialized_digest);
+
+private:
+    // Types
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // Methods
+    /**
+     * Merges any buffered values into the centroids, combining centroids so that their number
+     * stays bounded by the compression.
+     */
+    void compress();
+
+    // Variables
+    double m_compression;
+    std::vector<Centroid> m_centroids;
+    std::vector<Centroid> m_buffer;
+    double m_total_weight{0.0};
+    double m_min;
+    double m_max;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_TDIGEST_HPP
@@ -0,0 +1,54 @@
+#include "aggregates.hpp"
+
+#include <string>
+
+#include "../clp/spdlog_with_specializations.hpp"
+#include "Record.hpp"
+
+namespace reducer {
+void MinAggregate::write_to_record(MultiValueRecordAdapter& record) const {
+    record.set_record_value(cCountRecordElementKey, m_count);
+    if (m_count > 0) {
+        record.set_record_value(cRecordElementKey, m_min);
+    }
+}
+
+void MaxAggregate::write_to_record(MultiValueRecordAdapter& record) const {
+    record.set_record_value(cCountRecordElementKey, m_count);
+    if (m_count > 0) {
+        record.set_record_value(cRecordElementKey, m_max);
+    }
+}
+
+void AvgAggregate::write_to_record(MultiValueRecordAdapter& record) const {
+    record.set_record_value(cSumRecordElementKey, m_sum);
+    record.set_record_value(cCountRecordElementKey, m_count);
+    record.set_record_value(
+            cRecordElementKey,
+            0 == m_count ? 0.0 : m_sum / static_cast<double>(m_count)
+    );
+}
+
+void ApproxCountDistinctAggregate::merge(Record const& record) {
+    if (false == m_sketch.merge_serialized(record.get_string_view(cSketchRecordElementKey))) {
+        SPDLOG_WARN("Ignoring invalid count-distinct sketch.");
+    }
+}
+
+void ApproxCountDistinctAggregate::write_to_record(MultiValueRecordAdapter& record) const {
+    record.set_record_value(cSketchRecordElementKey, m_sketch.serialize());
+    record.set_record_value(cRecordElementKey, m_sketch.estimate());
+}
+
+void ApproxPercentileAggregate::merge(Record const& record) {
+    if (false == m_digest.merge_serialized(record.get_string_view(cDigestRecordElementKey))) {
+        SPDLOG_WARN("Ignoring invalid percentile digest.");
+    }
+}
+
+void ApproxPercentileAggregate::write_to_record(MultiValueRecordAdapter& record) {
+    record.set_record_value(cDigestRecordElementKey, m_digest.serialize());
+    record.set_record_value(cQuantileRecordElementKey, m_quantile);
+    record.set_record_value(cRecordElementKey, m_digest.estimate_quantile(m_quantile));
+}
+}  // namespace reducer
@@ -0,0 +1,185 @@
+#ifndef REDUCER_AGGREGATES_HPP
+#define REDUCER_AGGREGATES_HPP
+
+#include <cstdint>
+#include <string_view>
+
+#include "HyperLogLog.hpp"
+#include "Record.hpp"
+#include "TDigest.hpp"
+
+namespace reducer {
+/**
+ * Sum of the numeric values of a field.
+ */
+class SumAggregate {
+public:
+    static constexpr char cRecordElementKey[] = "sum";
+
+    void add(Record const& record, std::string_view field) {
+        m_sum += record.get_double_value(field);
+    }
+
+    void merge(Record const& record) { m_sum += record.get_double_value(cRecordElementKey); }
+
+    void write_to_record(MultiValueRecordAdapter& record) const {
+        record.set_record_value(cRecordElementKey, m_sum);
+    }
+
+private:
+    double m_sum{0.0};
+};
+
+/**
+ * Minimum of the numeric values of a field. The partial aggregate also contains the number of
+ * values, so that a group without any values has no minimum (rather than an infinite one).
+ */
+class MinAggregate {
+public:
+    static constexpr char cRecordElementKey[] = "min";
+    static constexpr char cCountRecordElementKey[] = "count";
+
+    void add(Record const& record, std::string_view field) {
+        update(record.get_double_value(field), 1);
+    }
+
+    void merge(Record const& record) {
+        update(record.get_double_value(cRecordElementKey),
+               record.get_int64_value(cCountRecordElementKey));
+    }
+
+    /**
+     * Writes the number of values, along with their minimum if there are any.
+     * @param record
+     */
+    void write_to_record(MultiValueRecordAdapter& record) const;
+
+private:
+    void update(double value, int64_t count) {
+        if (count <= 0) {
+            return;
+        }
+        if (0 == m_count || value < m_min) {
+            m_min = value;
+        }
+        m_count += count;
+    }
+
+    double m_min{0.0};
+    int64_t m_count{0};
+};
+
+/**
+ * Maximum of the numeric values of a field. The partial aggregate also contains the number of
+ * values, so that a group without any values has no maximum (rather than an infinite one).
+ */
+class MaxAggregate {
+public:
+    static constexpr char cRecordElementKey[] = "max";
+    static constexpr char cCountRecordElementKey[] = "count";
+
+    void add(Record const& record, std::string_view field) {
+        update(record.get_double_value(field), 1);
+    }
+
+    void merge(Record const& record) {
+        update(record.get_double_value(cRecordElementKey),
+               record.get_int64_value(cCountRecordElementKey));
+    }
+
+    /**
+     * Writes the number of values, along with their maximum if there are any.
+     * @param record
+     */
+    void write_to_record(MultiValueRecordAdapter& record) const;
+
+private:
+    void update(double value, int64_t count) {
+        if (count <= 0) {
+            return;
+        }
+        if (0 == m_count || value > m_max) {
+            m_max = value;
+        }
+        m_count += count;
+    }
+
+    double m_max{0.0};
+    int64_t m_count{0};
+};
+
+/**
+ * Average of the numeric values of a field. The partial aggregate is the sum and count of the
+ * values, since averages can't be combined on their own.
+ */
+class AvgAggregate {
+public:
+    static constexpr char cRecordElementKey[] = "avg";
+    static constexpr char cSumRecordElementKey[] = "sum";
+    static constexpr char cCountRecordElementKey[] = "count";
+
+    void add(Record const& record, std::string_view field) {
+        m_sum += record.get_double_value(field);
+        ++m_count;
+    }
+
+    void merge(Record const& record) {
+        m_sum += record.get_double_value(cSumRecordElementKey);
+        m_count += record.get_int64_value(cCountRecordElementKey);
+    }
+
+    void write_to_record(MultiValueRecordAdapter& record) const;
+
+private:
+    double m_sum{0.0};
+    int64_t m_count{0};
+};
+
+/**
+ * Approximate number of distinct values of a field, estimated with a HyperLogLog sketch of the
+ * string form of each value.
+ */
+class ApproxCountDistinctAggregate {
+public:
+    static constexpr char cRecordElementKey[] = "count_distinct";
+    static constexpr char cSketchRecordElementKey[] = "count_distinct_sketch";
+
+    void add(Record const& record, std::string_view field) {
+        m_sketch.add(record.get_string_view(field));
+    }
+
+    void merge(Record const& record);
+
+    void write_to_record(MultiValueRecordAdapter& record) const;
+
+private:
+    HyperLogLog m_sketch;
+};
+
+/**
+ * Approximate value of a field at a given quantile, estimated with a t-digest of the numeric
+ * values.
+ */
+class ApproxPercentileAggregate {
+public:
+    static constexpr char cRecordElementKey[] = "percentile";
+    static constexpr char cQuantileRecordElementKey[] = "quantile";
+    static constexpr char cDigestRecordElementKey[] = "percentile_digest";
+
+    explicit ApproxPercentileAggregate(double quantile) : m_quantile{quantile} {}
+
+    void add(Record const& record, std::string_view field) {
+        m_digest.add(record.get_double_value(field));
+    }
+
+    void merge(Record const& record);
+
+    void write_to_record(MultiValueRecordAdapter& record);
+
+private:
+    double m_quantile;
+    TDigest m_digest;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_AGGREGATES_HPP
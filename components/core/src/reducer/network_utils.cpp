@@ -9,7 +9,7 @@
 #include "../clp/ErrorCode.hpp"
 #include "../clp/networking/socket_utils.hpp"
 #include "BufferedSocketWriter.hpp"
-#include "DeserializedRecordGroup.hpp"
+#include "ColumnarRecordGroup.hpp"
 #include "RecordGroupIterator.hpp"
 #include "types.hpp"
 
@@ -50,7 +50,8 @@ bool send_pipeline_results(int reducer_socket_fd, std::unique_ptr<RecordGroupIte
 
     for (; false == results->done(); results->next()) {
         auto& group = results->get();
-        auto serialized_result = serialize(group.get_tags(), group.record_iter());
+        auto serialized_result
+                = serialize_columnar_record_group(group.get_tags(), group.record_iter());
         auto serialized_result_size = serialized_result.size();
 
         // Send size
@@ -1,6 +1,7 @@
 #ifndef CLP_S_TEST_UTILS_HPP
 #define CLP_S_TEST_UTILS_HPP
 
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <vector>
@@ -8,6 +9,8 @@
 #include "../src/clp_s/ArchiveWriter.hpp"
 #include "../src/clp_s/InputConfig.hpp"
 
+constexpr size_t cDefaultMinTableSize{1ULL * 1024 * 1024};  // 1 MiB
+
 /**
  * Compresses a file into an archive directory according to a given set of configuration options.
  *
@@ -19,6 +22,9 @@
  * @param retain_float_format
  * @param single_file_archive
  * @param structurize_arrays
+ * @param index_variable_dictionary
+ * @param num_threads
+ * @param min_table_size
  * @return Statistics for every compressed archive.
  */
 [[nodiscard]] auto compress_archive(
@@ -27,6 +33,9 @@
         std::optional<std::string> timestamp_key,
         bool retain_float_format,
         bool single_file_archive,
-        bool structurize_arrays
+        bool structurize_arrays,
+        bool index_variable_dictionary = false,
+        size_t num_threads = 1,
+        size_t min_table_size = cDefaultMinTableSize
 ) -> std::vector<clp_s::ArchiveStats>;
 #endif  // CLP_S_TEST_UTILS_HPP
@@ -0,0 +1,315 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/reducer/AggregateOperator.hpp"
+#include "../src/reducer/aggregates.hpp"
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/HyperLogLog.hpp"
+#include "../src/reducer/Pipeline.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/TDigest.hpp"
+
+using reducer::AggregationType;
+using reducer::GroupTags;
+using reducer::MultiValueRecordAdapter;
+using reducer::Pipeline;
+using reducer::PipelineInputMode;
+
+namespace {
+constexpr char cField[] = "latency";
+
+/**
+ * Aggregates the given values in one pipeline per worker, then combines the workers' partial
+ * aggregates in a final pipeline, as the search workers and reducer do.
+ * @param type
+ * @param values_per_worker
+ * @return The record of the final aggregate.
+ */
+MultiValueRecordAdapter aggregate_in_parts(
+        AggregationType type,
+        std::vector<std::vector<double>> const& values_per_worker
+);
+
+/**
+ * @param record
+ * @param key
+ * @return Whether the record contains the given key.
+ */
+bool has_key(reducer::Record const& record, std::string_view key);
+
+/**
+ * Checks that an extremum aggregate (min or max) without any values has no extremum, and that
+ * merging it into an aggregate with values doesn't change the latter's extremum.
+ * @tparam ExtremumAggregate
+ * @param values
+ * @param expected_extremum
+ */
+template <typename ExtremumAggregate>
+void check_empty_extremum_aggregate(std::vector<double> const& values, double expected_extremum);
+
+MultiValueRecordAdapter aggregate_in_parts(
+        AggregationType type,
+        std::vector<std::vector<double>> const& values_per_worker
+) {
+    constexpr double cQuantile{0.5};
+    GroupTags const tags{"group"};
+
+    Pipeline final_pipeline{PipelineInputMode::IntraStage};
+    final_pipeline.add_pipeline_stage(reducer::create_aggregate_operator(type, cField, cQuantile));
+
+    for (auto const& values : values_per_worker) {
+        Pipeline worker_pipeline{PipelineInputMode::InterStage};
+        worker_pipeline.add_pipeline_stage(
+                reducer::create_aggregate_operator(type, cField, cQuantile)
+        );
+        for (auto const value : values) {
+            MultiValueRecordAdapter record;
+            if (reducer::aggregates_string_values(type)) {
+                record.set_record_value(cField, std::to_string(static_cast<int64_t>(value)));
+            } else {
+                record.set_record_value(cField, value);
+            }
+            reducer::SingleRecordIterator record_it{record};
+            worker_pipeline.push_record_group(tags, record_it);
+        }
+
+        for (auto group_it = worker_pipeline.finish(); false == group_it->done(); group_it->next())
+        {
+            auto& group = group_it->get();
+            final_pipeline.push_record_group(group.get_tags(), group.record_iter());
+        }
+    }
+
+    auto group_it = final_pipeline.finish();
+    REQUIRE_FALSE(group_it->done());
+    auto& group = group_it->get();
+    REQUIRE(tags == group.get_tags());
+    auto& record = group.record_iter().get();
+
+    // Copy the elements since the iterator's record is only valid until the iterator is destroyed
+    MultiValueRecordAdapter result;
+    for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+         typed_key_it->next())
+    {
+        auto const typed_key = typed_key_it->get();
+        auto const key = typed_key.get_key();
+        switch (typed_key.get_type()) {
+            case reducer::ValueType::Int64:
+                result.set_record_value(key, record.get_int64_value(key));
+                break;
+            case reducer::ValueType::Double:
+                result.set_record_value(key, record.get_double_value(key));
+                break;
+            case reducer::ValueType::String:
+                result.set_record_value(key, std::string{record.get_string_view(key)});
+                break;
+        }
+    }
+    group_it->next();
+    REQUIRE(group_it->done());
+    return result;
+}
+
+bool has_key(reducer::Record const& record, std::string_view key) {
+    for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+         typed_key_it->next())
+    {
+        if (typed_key_it->get().get_key() == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename ExtremumAggregate>
+void check_empty_extremum_aggregate(std::vector<double> const& values, double expected_extremum) {
+    ExtremumAggregate const empty_aggregate;
+    MultiValueRecordAdapter empty_record;
+    empty_aggregate.write_to_record(empty_record);
+    REQUIRE(0 == empty_record.get_int64_value(ExtremumAggregate::cCountRecordElementKey));
+    REQUIRE_FALSE(has_key(empty_record, ExtremumAggregate::cRecordElementKey));
+
+    ExtremumAggregate aggregate;
+    for (auto const value : values) {
+        MultiValueRecordAdapter record;
+        record.set_record_value(cField, value);
+        aggregate.add(record, cField);
+    }
+    aggregate.merge(empty_record);
+    MultiValueRecordAdapter record;
+    aggregate.write_to_record(record);
+    REQUIRE(static_cast<int64_t>(values.size())
+            == record.get_int64_value(ExtremumAggregate::cCountRecordElementKey));
+    REQUIRE(expected_extremum == record.get_double_value(ExtremumAggregate::cRecordElementKey));
+}
+}  // namespace
+
+TEST_CASE("Test aggregate operators", "[reducer][AggregateOperator]") {
+    std::vector<std::vector<double>> const values_per_worker{{3, 1, 4}, {1, 5}, {9, 2, 6}};
+
+    SECTION("Exact aggregates are combined across workers") {
+        auto const sum = aggregate_in_parts(AggregationType::Sum, values_per_worker);
+        REQUIRE(31.0 == sum.get_double_value(reducer::SumAggregate::cRecordElementKey));
+
+        auto const min = aggregate_in_parts(AggregationType::Min, values_per_worker);
+        REQUIRE(1.0 == min.get_double_value(reducer::MinAggregate::cRecordElementKey));
+
+        auto const max = aggregate_in_parts(AggregationType::Max, values_per_worker);
+        REQUIRE(9.0 == max.get_double_value(reducer::MaxAggregate::cRecordElementKey));
+
+        REQUIRE(8 == max.get_int64_value(reducer::MaxAggregate::cCountRecordElementKey));
+
+        auto const avg = aggregate_in_parts(AggregationType::Avg, values_per_worker);
+        REQUIRE(8 == avg.get_int64_value(reducer::AvgAggregate::cCountRecordElementKey));
+        REQUIRE(31.0 / 8 == avg.get_double_value(reducer::AvgAggregate::cRecordElementKey));
+    }
+
+    SECTION("Extremum aggregates without values have no extremum") {
+        check_empty_extremum_aggregate<reducer::MinAggregate>({-3, 5}, -3.0);
+        check_empty_extremum_aggregate<reducer::MaxAggregate>({-3, -5}, -3.0);
+    }
+
+    SECTION("Approximate aggregates are combined across workers") {
+        auto const count_distinct
+                = aggregate_in_parts(AggregationType::ApproxCountDistinct, values_per_worker);
+        REQUIRE(7
+                == count_distinct.get_int64_value(
+                        reducer::ApproxCountDistinctAggregate::cRecordElementKey
+                ));
+
+        auto const median
+                = aggregate_in_parts(AggregationType::ApproxPercentile, values_per_worker);
+        auto const estimate
+                = median.get_double_value(reducer::ApproxPercentileAggregate::cRecordElementKey);
+        REQUIRE(3.0 <= estimate);
+        REQUIRE(estimate <= 4.0);
+    }
+
+    SECTION("Unknown aggregation types are rejected") {
+        REQUIRE(AggregationType::Avg == reducer::parse_aggregation_type("avg"));
+        REQUIRE_FALSE(reducer::parse_aggregation_type("median").has_value());
+    }
+}
+
+TEST_CASE("Test HyperLogLog", "[reducer][HyperLogLog]") {
+    constexpr int64_t cNumValues{100'000};
+    reducer::HyperLogLog first_half;
+    reducer::HyperLogLog second_half;
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        (i < cNumValues / 2 ? first_half : second_half).add(std::to_string(i));
+        // Duplicates shouldn't affect the estimate
+        first_half.add(std::to_string(i % 100));
+    }
+
+    reducer::HyperLogLog merged;
+    REQUIRE(merged.merge_serialized(first_half.serialize()));
+    REQUIRE(merged.merge(second_half));
+    auto const relative_error
+            = std::abs(static_cast<double>(merged.estimate() - cNumValues)) / cNumValues;
+    REQUIRE(relative_error < 0.05);
+
+    REQUIRE_FALSE(merged.merge_serialized("invalid"));
+    REQUIRE_FALSE(merged.merge(reducer::HyperLogLog{10}));
+}
+
+TEST_CASE("Test TDigest", "[reducer][TDigest]") {
+    constexpr size_t cNumValues{100'000};
+    reducer::TDigest odd_values;
+    reducer::TDigest even_values;
+    for (size_t i = 1; i <= cNumValues; ++i) {
+        (0 == i % 2 ? even_values : odd_values).add(static_cast<double>(i));
+    }
+
+    reducer::TDigest merged;
+    REQUIRE(merged.merge_serialized(odd_values.serialize()));
+    merged.merge(even_values);
+    REQUIRE(static_cast<double>(cNumValues) == merged.get_total_weight());
+
+    for (auto const quantile : {0.01, 0.5, 0.99}) {
+        auto const expected = quantile * cNumValues;
+        REQUIRE(std::abs(merged.estimate_quantile(quantile) - expected) < 0.01 * cNumValues);
+    }
+    REQUIRE(1.0 == merged.estimate_quantile(0.0));
+    REQUIRE(static_cast<double>(cNumValues) == merged.estimate_quantile(1.0));
+
+    REQUIRE(std::isnan(reducer::TDigest{}.estimate_quantile(0.5)));
+
+    SECTION("Empty digests are merged") {
+        REQUIRE(merged.merge_serialized(reducer::TDigest{}.serialize()));
+        REQUIRE(static_cast<double>(cNumValues) == merged.get_total_weight());
+    }
+
+    SECTION("Malformed digests are rejected") {
+        // Serialized digests are the compression, the min, the max, and each centroid's mean and
+        // weight
+        auto const invalid_serialized_digest = GENERATE(
+                "1 2 x",
+                // Compression which doesn't match the digest's
+                "50 1 2 1.5 1",
+                "nan 1 2 1.5 1",
+                "inf 1 2 1.5 1",
+                // Non-finite min or max
+                "100 nan 2 1.5 1",
+                "100 -inf 2 1.5 1",
+                "100 1 nan 1.5 1",
+                "100 1 inf 1.5 1",
+                "100 2 1 1.5 1",
+                // Non-finite or non-positive means and weights
+                "100 1 2 nan 1",
+                "100 1 2 inf 1",
+                "100 1 2 -inf 1",
+                "100 1 2 1.5 nan",
+                "100 1 2 1.5 inf",
+                "100 1 2 1.5 0",
+                "100 1 2 1.5 -1",
+                // Weights whose total isn't finite
+                "100 1 2 1.5 1e308 1.5 1e308",
+                // Extremes without centroids, and centroids without weights
+                "100 1 2",
+                "100 1 2 1.5"
+        );
+        CAPTURE(invalid_serialized_digest);
+
+        auto const median = merged.estimate_quantile(0.5);
+        REQUIRE_FALSE(merged.merge_serialized(invalid_serialized_digest));
+        REQUIRE(static_cast<double>(cNumValues) == merged.get_total_weight());
+        REQUIRE(median == merged.estimate_quantile(0.5));
+        REQUIRE(1.0 == merged.estimate_quantile(0.0));
+        REQUIRE(static_cast<double>(cNumValues) == merged.estimate_quantile(1.0));
+
+        // The aggregate ignores such digests rather than corrupting its estimate
+        reducer::ApproxPercentileAggregate aggregate{0.5};
+        MultiValueRecordAdapter record;
+        record.set_record_value(
+                reducer::ApproxPercentileAggregate::cDigestRecordElementKey,
+                std::string{invalid_serialized_digest}
+        );
+        aggregate.merge(record);
+        MultiValueRecordAdapter result;
+        aggregate.write_to_record(result);
+        REQUIRE(std::isnan(
+                result.get_double_value(reducer::ApproxPercentileAggregate::cRecordElementKey)
+        ));
+    }
+
+    SECTION("Non-finite values aren't added") {
+        reducer::TDigest digest;
+        digest.add(std::numeric_limits<double>::quiet_NaN());
+        digest.add(std::numeric_limits<double>::infinity());
+        digest.add(1.0, std::numeric_limits<double>::infinity());
+        REQUIRE(0.0 == digest.get_total_weight());
+        digest.add(1.0);
+        REQUIRE(digest.merge_serialized(digest.serialize()));
+        REQUIRE(2.0 == digest.get_total_weight());
+    }
+}
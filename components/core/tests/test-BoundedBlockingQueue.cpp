@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/BoundedBlockingQueue.hpp"
+
+TEST_CASE("Test Bounded Blocking Queue", "[BoundedBlockingQueue]") {
+    SECTION("Items are popped in the order they were pushed") {
+        clp::BoundedBlockingQueue<int> queue{3};
+        REQUIRE(queue.push(1));
+        REQUIRE(queue.push(2));
+        REQUIRE(queue.push(3));
+        REQUIRE(1 == queue.pop());
+        REQUIRE(2 == queue.pop());
+        REQUIRE(3 == queue.pop());
+    }
+
+    SECTION("A closed queue rejects new items but can still be drained") {
+        clp::BoundedBlockingQueue<int> queue{2};
+        REQUIRE(queue.push(1));
+        queue.close();
+        REQUIRE(queue.is_closed());
+        REQUIRE_FALSE(queue.push(2));
+        REQUIRE(1 == queue.pop());
+        REQUIRE(std::nullopt == queue.pop());
+    }
+
+    SECTION("Items pass between threads without being lost or duplicated") {
+        constexpr size_t cNumItems{10'000};
+        constexpr size_t cNumConsumers{4};
+        clp::BoundedBlockingQueue<size_t> queue{8};
+
+        std::vector<std::vector<size_t>> consumed_items(cNumConsumers);
+        std::vector<std::thread> consumers;
+        consumers.reserve(cNumConsumers);
+        for (size_t i = 0; i < cNumConsumers; ++i) {
+            consumers.emplace_back([&queue, &items = consumed_items[i]] {
+                while (auto item = queue.pop()) {
+                    items.push_back(item.value());
+                }
+            });
+        }
+
+        bool all_pushed{true};
+        for (size_t i = 0; i < cNumItems; ++i) {
+            all_pushed = queue.push(i) && all_pushed;
+        }
+        queue.close();
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+        REQUIRE(all_pushed);
+
+        std::vector<size_t> num_times_consumed(cNumItems, 0);
+        for (auto const& items : consumed_items) {
+            for (auto item : items) {
+                ++num_times_consumed[item];
+            }
+        }
+        for (auto num_times : num_times_consumed) {
+            REQUIRE(1 == num_times);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/reducer/ColumnarRecordGroup.hpp"
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/Record.hpp"
+
+using reducer::ColumnarRecordGroup;
+using reducer::GroupTags;
+using reducer::MultiValueRecordAdapter;
+using reducer::ValueType;
+
+namespace {
+/**
+ * A ConstRecordIterator over a vector of MultiValueRecordAdapter.
+ */
+class RecordVectorIterator : public reducer::ConstRecordIterator {
+public:
+    explicit RecordVectorIterator(std::vector<MultiValueRecordAdapter> const& records)
+            : m_records{records} {}
+
+    [[nodiscard]] reducer::Record const& get() const override { return m_records[m_ix]; }
+
+    void next() override { ++m_ix; }
+
+    bool done() override { return m_ix >= m_records.size(); }
+
+private:
+    std::vector<MultiValueRecordAdapter> const& m_records;
+    size_t m_ix{0};
+};
+}  // namespace
+
+TEST_CASE("Test columnar record group round trip", "[reducer][ColumnarRecordGroup]") {
+    GroupTags const tags{"1700000000000", ""};
+
+    // Records with different keys or types are stored in separate batches
+    std::vector<MultiValueRecordAdapter> records(5);
+    records[0].set_record_value("count", int64_t{3});
+    records[1].set_record_value("count", int64_t{-7});
+    records[2].set_record_value("count", 2.5);
+    records[3].set_record_value("sum", 1.25);
+    records[3].set_record_value("sketch", std::string{"abc\0def", 7});
+    records[4].set_record_value("sum", -0.5);
+    records[4].set_record_value("sketch", std::string{});
+
+    RecordVectorIterator records_it{records};
+    auto const serialized_data = reducer::serialize_columnar_record_group(tags, records_it);
+
+    ColumnarRecordGroup group{
+            reinterpret_cast<char const*>(serialized_data.data()),
+            serialized_data.size()
+    };
+    REQUIRE(tags == group.get_tags());
+
+    auto& record_it = group.record_iter();
+    for (auto const& expected_record : records) {
+        REQUIRE_FALSE(record_it.done());
+        auto const& record = record_it.get();
+
+        auto expected_typed_key_it = expected_record.typed_key_iter();
+        auto typed_key_it = record.typed_key_iter();
+        for (; false == expected_typed_key_it->done();
+             expected_typed_key_it->next(), typed_key_it->next())
+        {
+            REQUIRE_FALSE(typed_key_it->done());
+            auto const expected_typed_key = expected_typed_key_it->get();
+            auto const typed_key = typed_key_it->get();
+            auto const key = expected_typed_key.get_key();
+            REQUIRE(key == typed_key.get_key());
+            REQUIRE(expected_typed_key.get_type() == typed_key.get_type());
+            switch (typed_key.get_type()) {
+                case ValueType::Int64:
+                    REQUIRE(expected_record.get_int64_value(key) == record.get_int64_value(key));
+                    break;
+                case ValueType::Double:
+                    REQUIRE(expected_record.get_double_value(key) == record.get_double_value(key));
+                    break;
+                case ValueType::String:
+                    REQUIRE(expected_record.get_string_view(key) == record.get_string_view(key));
+                    break;
+            }
+        }
+        REQUIRE(typed_key_it->done());
+        record_it.next();
+    }
+    REQUIRE(record_it.done());
+
+    // Numeric values can be read as either numeric type
+    ColumnarRecordGroup reread_group{
+            reinterpret_cast<char const*>(serialized_data.data()),
+            serialized_data.size()
+    };
+    REQUIRE(3.0 == reread_group.record_iter().get().get_double_value("count"));
+    REQUIRE(reread_group.record_iter().get().get_string_view("missing").empty());
+
+    SECTION("Corrupt data is rejected") {
+        for (size_t len = 0; len < serialized_data.size(); ++len) {
+            REQUIRE_THROWS_AS(
+                    ColumnarRecordGroup(
+                            reinterpret_cast<char const*>(serialized_data.data()),
+                            len
+                    ),
+                    ColumnarRecordGroup::OperationFailed
+            );
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/ArrayBackedPosIntSet.hpp"
+#include "../src/clp/Defs.h"
+#include "../src/clp/VariableDictionaryReader.hpp"
+#include "../src/clp/VariableDictionaryWriter.hpp"
+#include "TestOutputCleaner.hpp"
+
+using clp::ArrayBackedPosIntSet;
+using clp::segment_id_t;
+using clp::variable_dictionary_id_t;
+
+TEST_CASE("Test reading new dictionary entries incrementally", "[DictionaryReader]") {
+    constexpr std::string_view cVarDictPath{"var.dict"};
+    constexpr std::string_view cVarSegmentIndexPath{"var.segindex"};
+    // The values in each segment, which is written and then read before the next one is written
+    std::vector<std::vector<std::string>> const values_in_segments{
+            {"python2.7.3", "0x1234"},
+            {"0x1234"},
+            {"user1", "python2.7.3", "user2"}
+    };
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cVarDictPath}, std::string{cVarSegmentIndexPath}}
+    };
+
+    clp::VariableDictionaryWriter var_dict_writer;
+    var_dict_writer.open(
+            std::string{cVarDictPath},
+            std::string{cVarSegmentIndexPath},
+            clp::cVariableDictionaryIdMax
+    );
+    clp::VariableDictionaryReader var_dict_reader;
+
+    // The value and the segments containing it, for each ID
+    std::vector<std::string> values;
+    std::vector<std::set<segment_id_t>> segments_containing_values;
+    for (segment_id_t segment_id = 0; segment_id < values_in_segments.size(); ++segment_id) {
+        CAPTURE(segment_id);
+
+        ArrayBackedPosIntSet<variable_dictionary_id_t> ids_in_segment;
+        for (auto const& value : values_in_segments[segment_id]) {
+            variable_dictionary_id_t id{};
+            if (var_dict_writer.add_entry(value, id)) {
+                REQUIRE((values.size() == id));
+                values.emplace_back(value);
+                segments_containing_values.emplace_back();
+            }
+            ids_in_segment.insert(id);
+            segments_containing_values[id].insert(segment_id);
+        }
+        var_dict_writer.index_segment(segment_id, ids_in_segment);
+        var_dict_writer.write_header_and_flush_to_disk();
+
+        if (0 == segment_id) {
+            var_dict_reader.open(std::string{cVarDictPath}, std::string{cVarSegmentIndexPath});
+        }
+        // Each read should only read the entries and segments written since the previous read
+        REQUIRE_NOTHROW(var_dict_reader.read_new_entries());
+
+        REQUIRE((values.size() == var_dict_reader.get_entries().size()));
+        for (variable_dictionary_id_t id = 0; id < values.size(); ++id) {
+            REQUIRE((values[id] == var_dict_reader.get_value(id)));
+            auto const segment_ids = var_dict_reader.get_ids_of_segments_containing_entry(id);
+            REQUIRE((segments_containing_values[id]
+                     == std::set<segment_id_t>{segment_ids.begin(), segment_ids.end()}));
+        }
+    }
+
+    var_dict_reader.close();
+    var_dict_writer.close();
+}
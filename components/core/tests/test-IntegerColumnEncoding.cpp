@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/BufferViewReader.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/IntegerColumnEncoding.hpp"
+#include "../src/clp_s/ZstdCompressor.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+
+using clp_s::BufferViewReader;
+using clp_s::ErrorCodeSuccess;
+using clp_s::IntegerColumnEncoder;
+using clp_s::IntegerEncoding;
+using clp_s::LazyIntegerColumn;
+using clp_s::ZstdCompressor;
+using clp_s::ZstdDecompressor;
+
+namespace {
+constexpr size_t cNumValues = 10'000;
+
+/**
+ * Encodes the given values, checks that the expected encoding was chosen and that the encoded size
+ * is as reported, then decodes the values, both entirely and one at a time, and checks that they're
+ * unchanged.
+ * @tparam T
+ * @param values
+ * @param expected_encoding
+ */
+template <typename T>
+void test_round_trip(std::vector<T> const& values, IntegerEncoding expected_encoding);
+
+/**
+ * @param run_ends
+ * @return A run-length encoded column of zeroes with runs ending at the given indices.
+ */
+auto encode_runs(std::vector<uint64_t> const& run_ends) -> std::vector<char>;
+
+template <typename T>
+void test_round_trip(std::vector<T> const& values, IntegerEncoding expected_encoding) {
+    IntegerColumnEncoder<T> encoder;
+    auto const encoded_size{encoder.choose_encoding(values)};
+    REQUIRE(expected_encoding == encoder.get_encoding());
+
+    std::string compressed_buffer;
+    ZstdCompressor compressor;
+    compressor.open(compressed_buffer);
+    encoder.store(values, compressor);
+    compressor.close();
+
+    std::vector<char> encoded(encoded_size);
+    ZstdDecompressor decompressor;
+    decompressor.open(compressed_buffer.data(), compressed_buffer.size());
+    auto const error{decompressor.try_read_exact_length(encoded.data(), encoded.size())};
+    REQUIRE(ErrorCodeSuccess == error);
+    decompressor.close();
+
+    BufferViewReader reader{encoded.data(), encoded.size()};
+    LazyIntegerColumn<T> column;
+    column.read(reader, values.size());
+    REQUIRE(0 == reader.get_remaining_size());
+    REQUIRE(values.size() == column.size());
+
+    std::vector<T> decoded_values;
+    column.decode(decoded_values);
+    REQUIRE((values == decoded_values));
+
+    // Values can be accessed in any order without decoding the entire column
+    for (size_t i{0}; i < values.size(); ++i) {
+        REQUIRE(values[i] == column[i]);
+    }
+    for (size_t i{values.size()}; i > 0; i -= std::min<size_t>(i, 997)) {
+        REQUIRE(values[i - 1] == column[i - 1]);
+    }
+    auto const lazily_decoded{column.get_values()};
+    REQUIRE(values.size() == lazily_decoded.size());
+    for (size_t i{0}; i < values.size(); ++i) {
+        REQUIRE(values[i] == lazily_decoded[i]);
+    }
+}
+
+auto encode_runs(std::vector<uint64_t> const& run_ends) -> std::vector<char> {
+    uint64_t const num_runs{run_ends.size()};
+    std::vector<char> encoded(1 + sizeof(num_runs) + num_runs * sizeof(int64_t), 0);
+    encoded[0] = static_cast<char>(IntegerEncoding::RunLength);
+    std::memcpy(&encoded[1], &num_runs, sizeof(num_runs));
+    auto const run_ends_offset{encoded.size()};
+    encoded.resize(run_ends_offset + num_runs * sizeof(uint64_t));
+    std::memcpy(&encoded[run_ends_offset], run_ends.data(), num_runs * sizeof(uint64_t));
+    return encoded;
+}
+}  // namespace
+
+TEMPLATE_TEST_CASE(
+        "clp-s-integer-column-encoding",
+        "[clp-s][IntegerColumnEncoding]",
+        int64_t,
+        uint64_t
+) {
+    std::mt19937_64 generator{std::random_device{}()};
+
+    SECTION("Empty columns are stored raw.") {
+        test_round_trip<TestType>({}, IntegerEncoding::Raw);
+    }
+
+    SECTION("Columns spanning the full range of values are stored raw.") {
+        std::uniform_int_distribution<TestType> distribution{
+                std::numeric_limits<TestType>::min(),
+                std::numeric_limits<TestType>::max()
+        };
+        std::vector<TestType> values(cNumValues);
+        for (auto& value : values) {
+            value = distribution(generator);
+        }
+        values.front() = std::numeric_limits<TestType>::min();
+        values.back() = std::numeric_limits<TestType>::max();
+        test_round_trip(values, IntegerEncoding::Raw);
+    }
+
+    SECTION("Columns with a small range of values are bit-packed.") {
+        for (TestType const reference :
+             {std::numeric_limits<TestType>::min(),
+              TestType{0},
+              std::numeric_limits<TestType>::max() - 1000})
+        {
+            for (TestType const range : {1, 2, 7, 1000}) {
+                std::uniform_int_distribution<TestType> distribution{
+                        reference,
+                        static_cast<TestType>(reference + range)
+                };
+                std::vector<TestType> values(cNumValues);
+                for (auto& value : values) {
+                    value = distribution(generator);
+                }
+                values.front() = reference;
+                values.back() = reference + range;
+                test_round_trip(values, IntegerEncoding::BitPacked);
+            }
+        }
+    }
+
+    SECTION("Columns with a single value are bit-packed into zero bits.") {
+        std::vector<TestType> values(cNumValues, TestType{42});
+        test_round_trip(values, IntegerEncoding::BitPacked);
+    }
+
+    SECTION("Columns with long runs are run-length encoded.") {
+        std::vector<TestType> values;
+        while (values.size() < cNumValues) {
+            auto const run_value{static_cast<TestType>(generator())};
+            values.insert(values.end(), 1000, run_value);
+        }
+        test_round_trip(values, IntegerEncoding::RunLength);
+    }
+}
+
+TEST_CASE("clp-s-integer-column-encoding-corrupt", "[clp-s][IntegerColumnEncoding]") {
+    LazyIntegerColumn<int64_t> column;
+
+    SECTION("Unknown encodings are rejected.") {
+        std::vector<char> encoded{static_cast<char>(0xff)};
+        BufferViewReader reader{encoded.data(), encoded.size()};
+        REQUIRE_THROWS_AS(column.read(reader, 1), BufferViewReader::OperationFailed);
+    }
+
+    SECTION("Runs which end past the last value are rejected.") {
+        // The last run ends at the last value, but the first run ends past it
+        auto encoded{encode_runs({3, 2})};
+        BufferViewReader reader{encoded.data(), encoded.size()};
+        REQUIRE_THROWS_AS(column.read(reader, 2), BufferViewReader::OperationFailed);
+    }
+
+    SECTION("Runs which end before they begin are rejected.") {
+        // Every run ends within the column, but the second run ends before the first
+        auto encoded{encode_runs({3, 2, 4})};
+        BufferViewReader reader{encoded.data(), encoded.size()};
+        REQUIRE_THROWS_AS(column.read(reader, 4), BufferViewReader::OperationFailed);
+    }
+
+    SECTION("Runs which don't cover every value are rejected.") {
+        for (std::vector<uint64_t> const& run_ends :
+             {std::vector<uint64_t>{}, std::vector<uint64_t>{1, 3}})
+        {
+            CAPTURE(run_ends.size());
+            auto encoded{encode_runs(run_ends)};
+            BufferViewReader reader{encoded.data(), encoded.size()};
+            REQUIRE_THROWS_AS(column.read(reader, 4), BufferViewReader::OperationFailed);
+        }
+    }
+
+    SECTION("Runs which cover every value in order are accepted.") {
+        auto encoded{encode_runs({1, 1, 4})};
+        BufferViewReader reader{encoded.data(), encoded.size()};
+        REQUIRE_NOTHROW(column.read(reader, 4));
+        REQUIRE((0 == reader.get_remaining_size()));
+        REQUIRE((0 == column[3]));
+    }
+
+    SECTION("Bit widths wider than 64 bits are rejected.") {
+        std::vector<char> encoded(2 + sizeof(int64_t), 0);
+        encoded[0] = static_cast<char>(IntegerEncoding::BitPacked);
+        encoded[1] = static_cast<char>(65);
+        BufferViewReader reader{encoded.data(), encoded.size()};
+        REQUIRE_THROWS_AS(column.read(reader, 1), BufferViewReader::OperationFailed);
+    }
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/ReadAheadReader.hpp"
+#include "../src/clp/ReaderInterface.hpp"
+#include "../src/clp/StringReader.hpp"
+#include "../src/clp/TraceableException.hpp"
+
+namespace {
+/**
+ * A reader that returns some data and then fails, either by returning an error or by throwing.
+ */
+class FailingReader : public clp::ReaderInterface {
+public:
+    // Types
+    class OperationFailed : public clp::TraceableException {
+    public:
+        // Constructors
+        OperationFailed(clp::ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "FailingReader operation failed";
+        }
+    };
+
+    // Constructors
+    FailingReader(std::string data, bool should_throw)
+            : m_data{std::move(data)},
+              m_should_throw{should_throw} {}
+
+    // Methods implementing `clp::ReaderInterface`
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override {
+        num_bytes_read = std::min(num_bytes_to_read, m_data.size() - m_pos);
+        if (0 == num_bytes_read) {
+            if (m_should_throw) {
+                throw OperationFailed(clp::ErrorCode_Corrupt, __FILE__, __LINE__);
+            }
+            return clp::ErrorCode_Corrupt;
+        }
+        std::memcpy(buf, m_data.data() + m_pos, num_bytes_read);
+        m_pos += num_bytes_read;
+        return clp::ErrorCode_Success;
+    }
+
+    [[nodiscard]] auto try_seek_from_begin([[maybe_unused]] size_t pos)
+            -> clp::ErrorCode override {
+        return clp::ErrorCode_Unsupported;
+    }
+
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode_Success;
+    }
+
+private:
+    std::string m_data;
+    size_t m_pos{0};
+    bool m_should_throw;
+};
+
+auto make_string_reader(std::string const& data) -> std::shared_ptr<clp::StringReader> {
+    auto string_reader{std::make_shared<clp::StringReader>()};
+    string_reader->open(data);
+    return string_reader;
+}
+}  // namespace
+
+TEST_CASE("Test Read Ahead Reader", "[ReadAheadReader]") {
+    constexpr size_t cChunkSize{7};
+    constexpr size_t cMaxNumBufferedChunks{2};
+    std::string test_data;
+    for (size_t i = 0; i < 1000; ++i) {
+        test_data += std::to_string(i);
+    }
+
+    SECTION("ReadAheadReader reads the same data as the source reader") {
+        clp::ReadAheadReader reader{
+                make_string_reader(test_data),
+                cChunkSize,
+                cMaxNumBufferedChunks
+        };
+        std::string buf(test_data.size() + 1, '\0');
+        size_t num_bytes_read{};
+        REQUIRE(clp::ErrorCode_Success == reader.try_read(buf.data(), buf.size(), num_bytes_read));
+        REQUIRE(test_data.size() == num_bytes_read);
+        buf.resize(num_bytes_read);
+        REQUIRE(test_data == buf);
+        REQUIRE(test_data.size() == reader.get_pos());
+        REQUIRE(clp::ErrorCode_EndOfFile == reader.try_read(buf.data(), 1, num_bytes_read));
+        REQUIRE(0 == num_bytes_read);
+    }
+
+    SECTION("ReadAheadReader only seeks forwards") {
+        clp::ReadAheadReader reader{
+                make_string_reader(test_data),
+                cChunkSize,
+                cMaxNumBufferedChunks
+        };
+        constexpr size_t cSeekPos{100};
+        REQUIRE(clp::ErrorCode_Success == reader.try_seek_from_begin(cSeekPos));
+        REQUIRE(cSeekPos == reader.get_pos());
+        char c{};
+        size_t num_bytes_read{};
+        REQUIRE(clp::ErrorCode_Success == reader.try_read(&c, 1, num_bytes_read));
+        REQUIRE(test_data[cSeekPos] == c);
+        REQUIRE(clp::ErrorCode_Unsupported == reader.try_seek_from_begin(0));
+        REQUIRE(clp::ErrorCode_OutOfBounds
+                == reader.try_seek_from_begin(test_data.size() + 1));
+    }
+
+    SECTION("ReadAheadReader can be destroyed before the source reader is exhausted") {
+        clp::ReadAheadReader reader{
+                make_string_reader(test_data),
+                cChunkSize,
+                cMaxNumBufferedChunks
+        };
+        char c{};
+        size_t num_bytes_read{};
+        REQUIRE(clp::ErrorCode_Success == reader.try_read(&c, 1, num_bytes_read));
+        REQUIRE(test_data[0] == c);
+    }
+
+    SECTION("ReadAheadReader returns the source reader's error after the data before it") {
+        clp::ReadAheadReader reader{
+                std::make_shared<FailingReader>(test_data, false),
+                cChunkSize,
+                cMaxNumBufferedChunks
+        };
+        std::string buf(test_data.size() + 1, '\0');
+        size_t num_bytes_read{};
+        REQUIRE(clp::ErrorCode_Success == reader.try_read(buf.data(), buf.size(), num_bytes_read));
+        REQUIRE(test_data.size() == num_bytes_read);
+        buf.resize(num_bytes_read);
+        REQUIRE(test_data == buf);
+        REQUIRE(clp::ErrorCode_Corrupt == reader.try_read(buf.data(), 1, num_bytes_read));
+        REQUIRE(0 == num_bytes_read);
+    }
+
+    SECTION("ReadAheadReader rethrows the source reader's exception after the data before it") {
+        clp::ReadAheadReader reader{
+                std::make_shared<FailingReader>(test_data, true),
+                cChunkSize,
+                cMaxNumBufferedChunks
+        };
+        std::string buf(test_data.size() + 1, '\0');
+        size_t num_bytes_read{};
+        REQUIRE(clp::ErrorCode_Success == reader.try_read(buf.data(), buf.size(), num_bytes_read));
+        REQUIRE(test_data.size() == num_bytes_read);
+        REQUIRE_THROWS_AS(
+                std::ignore = reader.try_read(buf.data(), 1, num_bytes_read),
+                FailingReader::OperationFailed
+        );
+        // The exception is sticky since the read ahead has stopped
+        REQUIRE_THROWS_AS(
+                std::ignore = reader.try_seek_from_begin(test_data.size() + 1),
+                FailingReader::OperationFailed
+        );
+    }
+
+    SECTION("ReadAheadReader can be destroyed after the source reader throws") {
+        clp::ReadAheadReader const reader{
+                std::make_shared<FailingReader>(test_data, true),
+                cChunkSize,
+                cMaxNumBufferedChunks
+        };
+    }
+}
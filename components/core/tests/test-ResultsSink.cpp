@@ -0,0 +1,169 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/clg/ResultsSink.hpp"
+
+using clp::clg::ResultsSink;
+
+namespace {
+constexpr size_t cNumArchives{16};
+constexpr size_t cNumThreads{4};
+
+/**
+ * An output stream whose contents are kept in memory.
+ */
+class MemoryOutputStream {
+public:
+    // Constructors
+    MemoryOutputStream() : m_stream{open_memstream(&m_buf, &m_buf_size)} {
+        REQUIRE((nullptr != m_stream));
+    }
+
+    // Delete copy & move constructors and assignment operators
+    MemoryOutputStream(MemoryOutputStream const&) = delete;
+    MemoryOutputStream(MemoryOutputStream&&) = delete;
+    auto operator=(MemoryOutputStream const&) -> MemoryOutputStream& = delete;
+    auto operator=(MemoryOutputStream&&) -> MemoryOutputStream& = delete;
+
+    // Destructor
+    ~MemoryOutputStream() {
+        fclose(m_stream);
+        free(m_buf);
+    }
+
+    // Methods
+    [[nodiscard]] auto get_stream() const -> FILE* { return m_stream; }
+
+    [[nodiscard]] auto get_contents() -> std::string {
+        fflush(m_stream);
+        return {m_buf, m_buf_size};
+    }
+
+private:
+    char* m_buf{nullptr};
+    size_t m_buf_size{0};
+    FILE* m_stream;
+};
+
+/**
+ * @param archive_ix
+ * @return The results of the archive with the given index, which begin with a line identifying the
+ * archive and have a different number of lines for each archive.
+ */
+auto get_archive_results(size_t archive_ix) -> std::string;
+
+/**
+ * Writes the results of `cNumArchives` archives to the sink using `cNumThreads` threads which take
+ * archives in order, like clg's search threads. Every `cNumThreads`-th archive takes longer to
+ * complete so that results arrive out of order.
+ * @param results_sink
+ */
+auto write_archive_results_concurrently(ResultsSink& results_sink) -> void;
+
+auto get_archive_results(size_t archive_ix) -> std::string {
+    auto results{fmt::format("archive {}\n", archive_ix)};
+    for (size_t i{0}; i < archive_ix * 10; ++i) {
+        results += fmt::format("archive {} result {}\n", archive_ix, i);
+    }
+    return results;
+}
+
+auto write_archive_results_concurrently(ResultsSink& results_sink) -> void {
+    std::atomic_size_t next_archive_ix{0};
+    std::vector<std::thread> threads;
+    threads.reserve(cNumThreads);
+    for (size_t i{0}; i < cNumThreads; ++i) {
+        threads.emplace_back([&] {
+            for (auto archive_ix{next_archive_ix++}; archive_ix < cNumArchives;
+                 archive_ix = next_archive_ix++)
+            {
+                if (0 == archive_ix % cNumThreads) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+                }
+                results_sink.write(archive_ix, get_archive_results(archive_ix));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+}  // namespace
+
+TEST_CASE("ResultsSink-ordered", "[clg][ResultsSink]") {
+    // A limit of zero forces every writer but the next archive's to wait
+    auto const max_num_buffered_bytes = GENERATE(
+            size_t{0},
+            size_t{1024},
+            ResultsSink::cDefaultMaxNumBufferedBytes
+    );
+    CAPTURE(max_num_buffered_bytes);
+
+    MemoryOutputStream output_stream;
+    ResultsSink results_sink{output_stream.get_stream(), true, max_num_buffered_bytes};
+    write_archive_results_concurrently(results_sink);
+
+    std::string expected_output;
+    for (size_t archive_ix{0}; archive_ix < cNumArchives; ++archive_ix) {
+        expected_output += get_archive_results(archive_ix);
+    }
+    REQUIRE((expected_output == output_stream.get_contents()));
+}
+
+TEST_CASE("ResultsSink-unordered", "[clg][ResultsSink]") {
+    MemoryOutputStream output_stream;
+    ResultsSink results_sink{output_stream.get_stream(), false};
+    write_archive_results_concurrently(results_sink);
+
+    // Each archive's results should be written once and contiguously, in any order
+    auto const output{output_stream.get_contents()};
+    std::vector<bool> archive_written(cNumArchives, false);
+    size_t pos{0};
+    while (pos < output.size()) {
+        size_t archive_ix{};
+        REQUIRE((1 == std::sscanf(output.c_str() + pos, "archive %zu\n", &archive_ix)));
+        REQUIRE((archive_ix < cNumArchives));
+        REQUIRE_FALSE(archive_written[archive_ix]);
+        archive_written[archive_ix] = true;
+
+        auto const archive_results{get_archive_results(archive_ix)};
+        REQUIRE((0 == output.compare(pos, archive_results.size(), archive_results)));
+        pos += archive_results.size();
+    }
+    REQUIRE((std::vector<bool>(cNumArchives, true) == archive_written));
+}
+
+TEST_CASE("ResultsSink-cancel", "[clg][ResultsSink]") {
+    MemoryOutputStream output_stream;
+    ResultsSink results_sink{output_stream.get_stream(), true, 0};
+
+    // The results of the second archive can't be buffered, so its writer waits for the first
+    // archive's results, which never arrive
+    std::atomic_bool write_returned{false};
+    std::thread writer{[&] {
+        results_sink.write(1, get_archive_results(1));
+        write_returned = true;
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    bool const returned_before_cancel{write_returned};
+
+    results_sink.cancel();
+    writer.join();
+    REQUIRE_FALSE(returned_before_cancel);
+    REQUIRE(write_returned);
+    REQUIRE(output_stream.get_contents().empty());
+
+    // Writes after cancellation are discarded
+    results_sink.write(0, get_archive_results(0));
+    REQUIRE(output_stream.get_contents().empty());
+}
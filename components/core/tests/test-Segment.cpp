@@ -1,10 +1,20 @@
 #include <unistd.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp/streaming_archive/Constants.hpp"
 #include "../src/clp/streaming_archive/reader/Segment.hpp"
 #include "../src/clp/streaming_archive/writer/Segment.hpp"
+#include "../src/clp/streaming_compression/zstd/Compressor.hpp"
 #include "../src/clp/Utils.hpp"
 
 using clp::ErrorCode_Success;
@@ -63,3 +73,68 @@ TEST_CASE("Test writing and reading a segment", "[Segment]") {
     boost::filesystem::remove_all(segments_dir_path, boost_error_code);
     REQUIRE(!boost_error_code);
 }
+
+TEST_CASE("Test reading regions of a segment", "[Segment]") {
+    constexpr size_t cNumBuffers = 16;
+    constexpr size_t cBufferSize = 300 * 1024;
+    constexpr size_t cFrameSize
+            = clp::streaming_archive::cSegmentSeekTable::FrameTargetUncompressedSize;
+
+    std::vector<char> uncompressed_data(cNumBuffers * cBufferSize);
+    for (size_t i = 0; i < uncompressed_data.size(); ++i) {
+        uncompressed_data[i] = static_cast<char>('a' + (i * 7 + i / 26) % 26);
+    }
+
+    string const segments_dir_path = "unit-test-segment/";
+    REQUIRE(ErrorCode_Success == clp::create_directory_structure(segments_dir_path, 0700));
+
+    clp::segment_id_t const seekable_segment_id{0};
+    clp::segment_id_t const unseekable_segment_id{1};
+
+    // Write a segment with a seek table, appending buffers that don't align with frames
+    clp::streaming_archive::writer::Segment writer_segment;
+    writer_segment.open(segments_dir_path, seekable_segment_id, 3);
+    for (size_t i = 0; i < cNumBuffers; ++i) {
+        uint64_t offset{0};
+        writer_segment.append(uncompressed_data.data() + i * cBufferSize, cBufferSize, offset);
+        REQUIRE(i * cBufferSize == offset);
+    }
+    writer_segment.close();
+
+    // Write a segment in the format used before seek tables were added (a single zstd frame)
+    clp::FileWriter file_writer;
+    file_writer.open(
+            segments_dir_path + std::to_string(unseekable_segment_id),
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    clp::streaming_compression::zstd::Compressor compressor;
+    compressor.open(file_writer, 3);
+    compressor.write(uncompressed_data.data(), uncompressed_data.size());
+    compressor.close();
+    file_writer.close();
+
+    std::vector<std::pair<size_t, size_t>> const regions{
+            {0, uncompressed_data.size()},
+            {cFrameSize - 10, 20},
+            {3 * cFrameSize, cFrameSize},
+            {cFrameSize + 5, 100},
+            {uncompressed_data.size() - 1, 1},
+            {0, 1},
+            {2 * cFrameSize + 17, 2 * cFrameSize}
+    };
+    for (auto const segment_id : {seekable_segment_id, unseekable_segment_id}) {
+        clp::streaming_archive::reader::Segment reader_segment;
+        REQUIRE(ErrorCode_Success == reader_segment.try_open(segments_dir_path, segment_id));
+        for (auto const& [pos, length] : regions) {
+            std::vector<char> decompressed_data(length);
+            REQUIRE(ErrorCode_Success
+                    == reader_segment.try_read(pos, decompressed_data.data(), length));
+            REQUIRE(0 == memcmp(uncompressed_data.data() + pos, decompressed_data.data(), length));
+        }
+        reader_segment.close();
+    }
+
+    boost::system::error_code boost_error_code;
+    boost::filesystem::remove_all(segments_dir_path, boost_error_code);
+    REQUIRE(!boost_error_code);
+}
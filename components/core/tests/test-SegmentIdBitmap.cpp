@@ -0,0 +1,62 @@
+#include <set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/SegmentIdBitmap.hpp"
+
+using clp::segment_id_t;
+using clp::SegmentIdBitmap;
+
+namespace {
+SegmentIdBitmap create_bitmap(std::set<segment_id_t> const& segment_ids) {
+    SegmentIdBitmap bitmap;
+    for (auto const segment_id : segment_ids) {
+        bitmap.insert(segment_id);
+    }
+    return bitmap;
+}
+
+std::set<segment_id_t> to_set(SegmentIdBitmap const& bitmap) {
+    return {bitmap.begin(), bitmap.end()};
+}
+}  // namespace
+
+TEST_CASE("Test SegmentIdBitmap", "[SegmentIdBitmap]") {
+    SECTION("An empty bitmap contains nothing") {
+        SegmentIdBitmap bitmap;
+        REQUIRE(bitmap.empty());
+        REQUIRE(0 == bitmap.size());
+        REQUIRE(bitmap.begin() == bitmap.end());
+        REQUIRE_FALSE(bitmap.contains(0));
+    }
+
+    SECTION("Segment IDs are iterated in ascending order") {
+        std::set<segment_id_t> const segment_ids{0, 1, 63, 64, 65, 200};
+        auto const bitmap = create_bitmap(segment_ids);
+        REQUIRE_FALSE(bitmap.empty());
+        REQUIRE(segment_ids.size() == bitmap.size());
+        REQUIRE(segment_ids == to_set(bitmap));
+        REQUIRE(bitmap.contains(64));
+        REQUIRE_FALSE(bitmap.contains(2));
+        REQUIRE_FALSE(bitmap.contains(201));
+        REQUIRE_FALSE(bitmap.contains(10'000));
+    }
+
+    SECTION("Union and intersection match std::set") {
+        std::set<segment_id_t> const a{1, 5, 70, 130};
+        std::set<segment_id_t> const b{5, 6, 130, 300};
+
+        auto union_bitmap = create_bitmap(a);
+        union_bitmap.insert_all(create_bitmap(b));
+        REQUIRE(std::set<segment_id_t>{1, 5, 6, 70, 130, 300} == to_set(union_bitmap));
+
+        auto intersection_bitmap = create_bitmap(b);
+        intersection_bitmap.intersect_with(create_bitmap(a));
+        REQUIRE(std::set<segment_id_t>{5, 130} == to_set(intersection_bitmap));
+
+        intersection_bitmap.intersect_with(SegmentIdBitmap{});
+        REQUIRE(intersection_bitmap.empty());
+    }
+}
@@ -0,0 +1,231 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "../src/reducer/CountOperator.hpp"
+#include "../src/reducer/DeserializedRecordGroup.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/Pipeline.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/RecordGroup.hpp"
+#include "../src/reducer/ShardedPipeline.hpp"
+
+using reducer::CountOperator;
+using reducer::GroupTags;
+using reducer::Pipeline;
+using reducer::PipelineInputMode;
+using reducer::RecordGroup;
+using reducer::ShardedPipeline;
+
+namespace {
+constexpr size_t cNumConnections{4};
+constexpr size_t cNumRounds{3};
+constexpr int64_t cNumTimeBuckets{64};
+constexpr int64_t cTimeBucketSize{1000};
+
+/**
+ * Counts per time bucket's timestamp.
+ */
+using Counts = std::map<int64_t, int64_t>;
+
+/**
+ * @param round
+ * @return The time buckets that every connection sends counts for in the given round. The buckets
+ * of different rounds overlap.
+ */
+auto get_time_buckets(size_t round) -> std::vector<int64_t>;
+
+/**
+ * @param connection_ix
+ * @param round
+ * @param time_bucket
+ * @return The count that the given connection sends for the given time bucket in the given round.
+ */
+auto get_count(size_t connection_ix, size_t round, int64_t time_bucket) -> int64_t;
+
+/**
+ * @param num_rounds
+ * @return The total count of each time bucket after the given number of rounds.
+ */
+auto get_expected_counts(size_t num_rounds) -> Counts;
+
+/**
+ * Sends a round of counts from each of `cNumConnections` concurrent connections, serializing and
+ * deserializing each record group the way a search worker's connection to the reducer does.
+ * @param pipeline
+ * @param round
+ */
+auto send_counts_concurrently(ShardedPipeline& pipeline, size_t round) -> void;
+
+/**
+ * Sets up the pipeline to count records per time bucket, as the reducer does for a timeline.
+ * @param pipeline
+ * @param track_updated_tags
+ */
+auto set_up_count_pipeline(ShardedPipeline& pipeline, bool track_updated_tags) -> void;
+
+/**
+ * Adds the count of the given record group to the given counts, replacing any existing count for
+ * the group's time bucket, like a timeline upsert does.
+ * @param group
+ * @param counts
+ */
+auto upsert_count(RecordGroup& group, Counts& counts) -> void;
+
+auto get_time_buckets(size_t round) -> std::vector<int64_t> {
+    std::vector<int64_t> time_buckets;
+    for (int64_t time_bucket{0}; time_bucket < cNumTimeBuckets; ++time_bucket) {
+        if (0 == time_bucket % static_cast<int64_t>(round + 2)) {
+            time_buckets.emplace_back(time_bucket);
+        }
+    }
+    return time_buckets;
+}
+
+auto get_count(size_t connection_ix, size_t round, int64_t time_bucket) -> int64_t {
+    return static_cast<int64_t>(connection_ix + round + 1) + time_bucket % 7;
+}
+
+auto get_expected_counts(size_t num_rounds) -> Counts {
+    Counts counts;
+    for (size_t round{0}; round < num_rounds; ++round) {
+        for (auto const time_bucket : get_time_buckets(round)) {
+            for (size_t connection_ix{0}; connection_ix < cNumConnections; ++connection_ix) {
+                counts[time_bucket * cTimeBucketSize]
+                        += get_count(connection_ix, round, time_bucket);
+            }
+        }
+    }
+    return counts;
+}
+
+auto send_counts_concurrently(ShardedPipeline& pipeline, size_t round) -> void {
+    std::vector<std::thread> connections;
+    connections.reserve(cNumConnections);
+    for (size_t connection_ix{0}; connection_ix < cNumConnections; ++connection_ix) {
+        connections.emplace_back([&pipeline, round, connection_ix] {
+            for (auto const time_bucket : get_time_buckets(round)) {
+                GroupTags const tags{std::to_string(time_bucket * cTimeBucketSize)};
+                reducer::SingleInt64RecordAdapter record{CountOperator::cRecordElementKey};
+                record.set_record_value(get_count(connection_ix, round, time_bucket));
+                reducer::SingleRecordIterator record_it{record};
+                auto serialized_group{reducer::serialize(tags, record_it)};
+
+                reducer::DeserializedRecordGroup group{serialized_group};
+                pipeline.push_record_group(group.get_tags(), group.record_iter());
+            }
+        });
+    }
+    for (auto& connection : connections) {
+        connection.join();
+    }
+}
+
+auto set_up_count_pipeline(ShardedPipeline& pipeline, bool track_updated_tags) -> void {
+    pipeline.set_up(
+            [] {
+                auto count_pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
+                count_pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+                return count_pipeline;
+            },
+            track_updated_tags
+    );
+}
+
+auto upsert_count(RecordGroup& group, Counts& counts) -> void {
+    auto const timestamp{std::stoll(group.get_tags().front())};
+    int64_t count{0};
+    for (auto& record_it = group.record_iter(); false == record_it.done(); record_it.next()) {
+        count = record_it.get().get_int64_value(CountOperator::cRecordElementKey);
+    }
+    counts[timestamp] = count;
+}
+}  // namespace
+
+TEST_CASE("sharded-pipeline-aggregates-all-groups", "[reducer][ShardedPipeline]") {
+    auto const num_shards = GENERATE(size_t{1}, size_t{8});
+    CAPTURE(num_shards);
+
+    ShardedPipeline pipeline{num_shards};
+    set_up_count_pipeline(pipeline, false);
+    for (size_t round{0}; round < cNumRounds; ++round) {
+        send_counts_concurrently(pipeline, round);
+    }
+
+    // Each group should be aggregated in exactly one shard
+    Counts counts;
+    size_t num_groups{0};
+    pipeline.finish([&](RecordGroup& group) {
+        upsert_count(group, counts);
+        ++num_groups;
+    });
+    REQUIRE((counts.size() == num_groups));
+    REQUIRE((get_expected_counts(cNumRounds) == counts));
+
+    // Without tracking, no groups are considered updated
+    REQUIRE_FALSE(pipeline.finish_updated_groups([](RecordGroup&) {}));
+}
+
+TEST_CASE("sharded-pipeline-upserts-updated-groups", "[reducer][ShardedPipeline]") {
+    auto const num_shards = GENERATE(size_t{1}, size_t{8});
+    CAPTURE(num_shards);
+
+    ShardedPipeline pipeline{num_shards};
+    set_up_count_pipeline(pipeline, true);
+
+    SECTION("Upserts between rounds only contain the groups updated in the round.") {
+        Counts upserted_counts;
+        for (size_t round{0}; round < cNumRounds; ++round) {
+            CAPTURE(round);
+            send_counts_concurrently(pipeline, round);
+
+            std::set<int64_t> updated_timestamps;
+            REQUIRE(pipeline.finish_updated_groups([&](RecordGroup& group) {
+                updated_timestamps.insert(std::stoll(group.get_tags().front()));
+                upsert_count(group, upserted_counts);
+            }));
+            std::set<int64_t> expected_updated_timestamps;
+            for (auto const time_bucket : get_time_buckets(round)) {
+                expected_updated_timestamps.insert(time_bucket * cTimeBucketSize);
+            }
+            REQUIRE((expected_updated_timestamps == updated_timestamps));
+            REQUIRE((get_expected_counts(round + 1) == upserted_counts));
+
+            REQUIRE_FALSE(pipeline.finish_updated_groups([](RecordGroup&) {}));
+        }
+    }
+
+    SECTION("Upserts concurrent with the connections don't lose updates.") {
+        Counts upserted_counts;
+        std::atomic_bool connections_done{false};
+        std::thread upserter{[&] {
+            while (false == connections_done) {
+                pipeline.finish_updated_groups([&](RecordGroup& group) {
+                    upsert_count(group, upserted_counts);
+                });
+            }
+        }};
+        for (size_t round{0}; round < cNumRounds; ++round) {
+            send_counts_concurrently(pipeline, round);
+        }
+        connections_done = true;
+        upserter.join();
+
+        // The final upsert, as done when the reducer finalizes the results
+        pipeline.finish_updated_groups([&](RecordGroup& group) {
+            upsert_count(group, upserted_counts);
+        });
+        REQUIRE((get_expected_counts(cNumRounds) == upserted_counts));
+    }
+
+    pipeline.reset();
+}
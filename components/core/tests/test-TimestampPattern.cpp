@@ -1,10 +1,227 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include "../src/clp/KnownTimestampPatternMatcher.hpp"
 #include "../src/clp/TimestampPattern.hpp"
+#include "../src/clp_s/TimestampPattern.hpp"
 
 using clp::epochtime_t;
+using clp::KnownTimestampPatternMatcher;
 using clp::TimestampPattern;
 using std::string;
+using std::vector;
+
+namespace {
+/**
+ * @return clp's known patterns in order of priority, as listed in `clp::TimestampPattern::init`.
+ */
+auto get_clp_known_patterns() -> vector<TimestampPattern>;
+
+/**
+ * @return clp-s's known patterns in order of priority, as listed in
+ * `clp_s::TimestampPattern::init`.
+ */
+auto get_clp_s_known_patterns() -> vector<clp_s::TimestampPattern>;
+
+/**
+ * @return Example lines containing a timestamp of each of clp's known patterns.
+ */
+auto get_clp_example_lines() -> vector<string>;
+
+/**
+ * @return Example lines containing a timestamp of each of clp-s's known patterns, other than the
+ * patterns it shares with clp.
+ */
+auto get_clp_s_example_lines() -> vector<string>;
+
+/**
+ * @param example_lines
+ * @return Every prefix of each example line, and every variant of each example line with one
+ * character replaced by a digit, letter, space or separator. These include lines which a pattern
+ * almost matches, lines which a different pattern matches, and lines which no pattern matches.
+ */
+auto get_test_lines(vector<string> const& example_lines) -> vector<string>;
+
+/**
+ * Checks that for each of the given lines, the matcher compiled from the given patterns returns
+ * every pattern that parses a timestamp from the line as a candidate, by trying every pattern.
+ * @tparam TimestampPatternType
+ * @param patterns
+ * @param lines
+ */
+template <typename TimestampPatternType>
+auto check_candidates_contain_matching_patterns(
+        vector<TimestampPatternType> const& patterns,
+        vector<string> const& lines
+) -> void;
+
+auto get_clp_known_patterns() -> vector<TimestampPattern> {
+    return {{0, "%Y-%m-%dT%H:%M:%S.%3"},
+            {0, "%Y-%m-%dT%H:%M:%S,%3"},
+            {0, "%Y-%m-%d %H:%M:%S.%3"},
+            {0, "%Y-%m-%d %H:%M:%S,%3"},
+            {0, "%Y/%m/%dT%H:%M:%S.%3"},
+            {0, "%Y/%m/%dT%H:%M:%S,%3"},
+            {0, "%Y/%m/%d %H:%M:%S.%3"},
+            {0, "%Y/%m/%d %H:%M:%S,%3"},
+            {0, "[%Y-%m-%d %H:%M:%S,%3]"},
+            {2, "%Y-%m-%d %H:%M:%S,%3"},
+            {0, "<<<%Y-%m-%d %H:%M:%S:%3"},
+            {0, "%d %b %Y %H:%M:%S,%3"},
+            {0, "%Y-%m-%dT%H:%M:%S"},
+            {0, "%Y-%m-%d %H:%M:%S"},
+            {0, "%Y/%m/%dT%H:%M:%S"},
+            {0, "%Y/%m/%d %H:%M:%S"},
+            {0, "[%Y-%m-%dT%H:%M:%S"},
+            {0, "[%Y%m%d-%H:%M:%S]"},
+            {1, "%Y-%m-%d  %H:%M:%S"},
+            {0, "%y/%m/%d %H:%M:%S"},
+            {0, "%y%m%d %k:%M:%S"},
+            {0, "%b %d, %Y %l:%M:%S %p"},
+            {0, "%B %d, %Y %H:%M"},
+            {1, "[%d/%b/%Y:%H:%M:%S"},
+            {3, "[%d/%b/%Y:%H:%M:%S"},
+            {3, "[%d/%m/%Y:%H:%M:%S"},
+            {6, "%Y-%m-%d %H:%M:%S"},
+            {1, "%Y-%m-%d %H:%M:%S"},
+            {4, "%a %b %e %H:%M:%S %Y"},
+            {0, "%a %b %e %H:%M:%S %Y"},
+            {0, "%b %d %H:%M:%S"},
+            {0, "%m-%d %H:%M:%S.%3"},
+            {0, "%#3"}};
+}
+
+auto get_clp_s_known_patterns() -> vector<clp_s::TimestampPattern> {
+    return {{0, "%E"},
+            {0, "%F"},
+            {0, "%Y-%m-%dT%H:%M:%S.%TZ"},
+            {0, "%Y-%m-%dT%H:%M:%SZ"},
+            {0, "%Y-%m-%d %H:%M:%S.%TZ"},
+            {0, "%Y-%m-%d %H:%M:%SZ"},
+            {0, "%Y/%m/%dT%H:%M:%S.%TZ"},
+            {0, "%Y/%m/%dT%H:%M:%SZ"},
+            {0, "%Y/%m/%d %H:%M:%S.%TZ"},
+            {0, "%Y/%m/%d %H:%M:%SZ"},
+            {0, "%Y-%m-%dT%H:%M:%S.%3"},
+            {0, "%Y-%m-%dT%H:%M:%S,%3"},
+            {0, "%Y-%m-%d %H:%M:%S.%3"},
+            {0, "%Y-%m-%d %H:%M:%S,%3"},
+            {0, "%Y/%m/%dT%H:%M:%S.%3"},
+            {0, "%Y/%m/%dT%H:%M:%S,%3"},
+            {0, "%Y/%m/%d %H:%M:%S.%3"},
+            {0, "%Y/%m/%d %H:%M:%S,%3"},
+            {0, "[%Y-%m-%d %H:%M:%S,%3]"},
+            {2, "%Y-%m-%d %H:%M:%S,%3"},
+            {0, "<<<%Y-%m-%d %H:%M:%S:%3"},
+            {0, "%d %b %Y %H:%M:%S,%3"},
+            {0, "%Y-%m-%dT%H:%M:%S"},
+            {0, "%Y-%m-%d %H:%M:%S"},
+            {0, "%Y/%m/%dT%H:%M:%S"},
+            {0, "%Y/%m/%d %H:%M:%S"},
+            {0, "[%Y-%m-%dT%H:%M:%S"},
+            {0, "[%Y%m%d-%H:%M:%S]"},
+            {1, "%Y-%m-%d  %H:%M:%S"},
+            {0, "%y/%m/%d %H:%M:%S"},
+            {0, "%y%m%d %k:%M:%S"},
+            {0, "%b %d, %Y %l:%M:%S %p"},
+            {0, "%B %d, %Y %H:%M"},
+            {1, "[%d/%b/%Y:%H:%M:%S"},
+            {3, "[%d/%b/%Y:%H:%M:%S"},
+            {3, "[%d/%m/%Y:%H:%M:%S"},
+            {6, "%Y-%m-%d %H:%M:%S"},
+            {1, "%Y-%m-%d %H:%M:%S"},
+            {4, "%a %b %e %H:%M:%S %Y"},
+            {0, "%a %b %e %H:%M:%S %Y"},
+            {0, "%b %d %H:%M:%S"},
+            {0, "%m-%d %H:%M:%S.%3"}};
+}
+
+auto get_clp_example_lines() -> vector<string> {
+    return {"2015-01-31T15:50:45.392 content",
+            "2015-01-31 15:50:45,392",
+            "2015/01/31T15:50:45,123 content",
+            "[2015-01-31 15:50:45,085] content",
+            "INFO [main] 2015-01-31 15:50:45,085 content",
+            "<<<2016-11-10 03:02:29:936 content",
+            "01 Jan 2016 15:50:17,085 content",
+            "[2015-01-31T15:50:45 content",
+            "[20170106-16:56:41] content",
+            "Start-Date: 2015-01-31  15:50:45",
+            "15/01/31 15:50:45 content",
+            "150131  9:50:45 content",
+            "Jan 01, 2016 3:50:17 PM content",
+            "January 31, 2015 15:50 content",
+            "E [31/Jan/2015:15:50:45 content",
+            "192.168.4.5 - - [01/Jan/2016:15:50:17 content",
+            "192.168.4.5 - - [01/01/2016:15:50:17 content",
+            "Started POST \"/api\" for 127.0.0.1 at 2017-06-18 00:20:44 content",
+            "update-alternatives 2015-01-31 15:50:45 content",
+            "ERROR: apport (pid 4557) Sun Jan  1 15:50:45 2015 content",
+            "Sun Jan  1 15:50:45 2015 content",
+            "Jan 21 11:56:42 content",
+            "01-21 11:56:42.392 content",
+            "916321 content"};
+}
+
+auto get_clp_s_example_lines() -> vector<string> {
+    return {"1706980946603",
+            "-1706980946603",
+            "1679711330.789032462",
+            "-1679711330.789032462",
+            "2022-04-06T03:33:23.476Z",
+            "2022-04-06T03:33:23.4Z",
+            "2022-04-06T03:33:23Z",
+            "2022-04-06 03:33:23.47Z",
+            "2022/04/06T03:33:23.476Z",
+            "2022/04/06 03:33:23Z"};
+}
+
+auto get_test_lines(vector<string> const& example_lines) -> vector<string> {
+    vector<string> lines;
+    for (auto const& example_line : example_lines) {
+        for (size_t length = 0; length <= example_line.length(); ++length) {
+            lines.emplace_back(example_line, 0, length);
+        }
+        for (size_t ix = 0; ix < example_line.length(); ++ix) {
+            for (char const c : {' ', '0', '9', 'x', 'J', 'T', 'Z', '-', '/', ':', '.', ','}) {
+                auto& line = lines.emplace_back(example_line);
+                line[ix] = c;
+            }
+        }
+    }
+    return lines;
+}
+
+template <typename TimestampPatternType>
+auto check_candidates_contain_matching_patterns(
+        vector<TimestampPatternType> const& patterns,
+        vector<string> const& lines
+) -> void {
+    using Matcher = KnownTimestampPatternMatcher<TimestampPatternType>;
+    REQUIRE((patterns.size() <= Matcher::cMaxNumPatterns));
+    Matcher matcher;
+    matcher.compile(patterns.data(), patterns.size());
+
+    epochtime_t timestamp;
+    size_t begin_pos;
+    size_t end_pos;
+    for (auto const& line : lines) {
+        CAPTURE(line);
+        auto const candidates = matcher.get_candidates(line);
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            if (false == patterns[i].parse_timestamp(line, timestamp, begin_pos, end_pos)) {
+                continue;
+            }
+            CAPTURE(patterns[i].get_format());
+            REQUIRE((0 != (candidates & (typename Matcher::PatternSet{1} << i))));
+        }
+    }
+}
+}  // namespace
+
 
 TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     TimestampPattern::init();
@@ -549,3 +766,90 @@ TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     specific_pattern.insert_formatted_timestamp(timestamp, content);
     REQUIRE(line == content);
 }
+
+TEST_CASE("Test known timestamp pattern search order", "[KnownTimestampPatterns]") {
+    TimestampPattern::init();
+
+    auto const known_patterns = get_clp_known_patterns();
+
+    // Search truncated and altered versions of each example, so that the search has to pick the
+    // same pattern as trying every known pattern in order, including when none match
+    auto const lines = get_test_lines(get_clp_example_lines());
+
+    epochtime_t timestamp;
+    size_t timestamp_begin_pos;
+    size_t timestamp_end_pos;
+    for (auto const& line : lines) {
+        CAPTURE(line);
+        TimestampPattern const* expected_pattern{nullptr};
+        epochtime_t expected_timestamp{0};
+        size_t expected_begin_pos{string::npos};
+        size_t expected_end_pos{string::npos};
+        for (auto const& known_pattern : known_patterns) {
+            if (known_pattern.parse_timestamp(
+                        line,
+                        expected_timestamp,
+                        expected_begin_pos,
+                        expected_end_pos
+                ))
+            {
+                expected_pattern = &known_pattern;
+                break;
+            }
+        }
+
+        auto const* pattern = TimestampPattern::search_known_ts_patterns(
+                line,
+                timestamp,
+                timestamp_begin_pos,
+                timestamp_end_pos
+        );
+        if (nullptr == expected_pattern) {
+            REQUIRE(nullptr == pattern);
+            REQUIRE(string::npos == timestamp_begin_pos);
+            REQUIRE(string::npos == timestamp_end_pos);
+            continue;
+        }
+        REQUIRE(nullptr != pattern);
+        REQUIRE(*expected_pattern == *pattern);
+        REQUIRE(expected_timestamp == timestamp);
+        REQUIRE(expected_begin_pos == timestamp_begin_pos);
+        REQUIRE(expected_end_pos == timestamp_end_pos);
+    }
+}
+
+TEST_CASE("Test known timestamp pattern matcher candidates", "[KnownTimestampPatterns]") {
+    SECTION("clp's patterns") {
+        check_candidates_contain_matching_patterns(
+                get_clp_known_patterns(),
+                get_test_lines(get_clp_example_lines())
+        );
+    }
+
+    SECTION("clp-s's patterns") {
+        auto example_lines = get_clp_example_lines();
+        auto const clp_s_example_lines = get_clp_s_example_lines();
+        example_lines.insert(
+                example_lines.end(),
+                clp_s_example_lines.begin(),
+                clp_s_example_lines.end()
+        );
+        check_candidates_contain_matching_patterns(
+                get_clp_s_known_patterns(),
+                get_test_lines(example_lines)
+        );
+    }
+
+    SECTION("glt's patterns") {
+        // glt's known patterns are clp's without the relative timestamp pattern. glt's
+        // `TimestampPattern` parses them the same way as clp's (it's a copy), so we check glt's
+        // table using clp's parser rather than linking glt into the unit tests.
+        auto glt_known_patterns = get_clp_known_patterns();
+        REQUIRE((TimestampPattern{0, "%#3"} == glt_known_patterns.back()));
+        glt_known_patterns.pop_back();
+        check_candidates_contain_matching_patterns(
+                glt_known_patterns,
+                get_test_lines(get_clp_example_lines())
+        );
+    }
+}
@@ -0,0 +1,214 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "../src/clp/clp/run.hpp"
+#include "../src/clp/Defs.h"
+#include "../src/clp/streaming_archive/reader/Archive.hpp"
+#include "TestOutputCleaner.hpp"
+
+using clp::segment_id_t;
+using clp::streaming_archive::reader::Archive;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr std::string_view cTestCompressionInputDir{"test-clp-compression-input"};
+constexpr std::string_view cTestCompressionArchivesDirPrefix{"test-clp-compression-archives-"};
+constexpr std::string_view cTestCompressionOutputDirPrefix{"test-clp-compression-output-"};
+constexpr size_t cNumInputFiles{16};
+constexpr size_t cNumMessagesPerFile{2000};
+
+/**
+ * Where (part of) a file was stored, as the archive's path, the segment's ID and the index of the
+ * file split.
+ */
+struct FileLocation {
+    string archive_path;
+    segment_id_t segment_id;
+    size_t split_ix;
+};
+
+/**
+ * Writes `cNumInputFiles` log files with different contents to `cTestCompressionInputDir`.
+ * @return The contents of each file, indexed by file name.
+ */
+auto write_input_files() -> std::map<string, string>;
+
+/**
+ * Runs clp with the given arguments.
+ * @param arguments
+ */
+auto run_clp(vector<string> const& arguments) -> void;
+
+/**
+ * @param dir
+ * @return The contents of each file under `dir`, indexed by the file's path relative to `dir`.
+ */
+auto read_files(string const& dir) -> std::map<string, string>;
+
+/**
+ * @param archives_dir
+ * @return Where each file in the archives in `archives_dir` was stored, indexed by the file's path.
+ */
+auto get_file_locations(string const& archives_dir) -> std::map<string, vector<FileLocation>>;
+
+auto write_input_files() -> std::map<string, string> {
+    std::filesystem::create_directory(cTestCompressionInputDir);
+    std::map<string, string> contents;
+    for (size_t file_ix{0}; file_ix < cNumInputFiles; ++file_ix) {
+        string content;
+        for (size_t i{0}; i < cNumMessagesPerFile; ++i) {
+            auto const timestamp{fmt::format(
+                    "2023-01-{:02} {:02}:{:02}:{:02},000",
+                    file_ix + 1,
+                    i / 3600,
+                    (i / 60) % 60,
+                    i % 60
+            )};
+            switch ((file_ix + i) % 3) {
+                case 0:
+                    content += fmt::format(
+                            "{} INFO Task {} of job {} finished in {} ms\n",
+                            timestamp,
+                            i,
+                            file_ix,
+                            (i * 7) % 1000
+                    );
+                    break;
+                case 1:
+                    content += fmt::format(
+                            "{} WARN Queue file{}-{} is {}.{} percent full\n",
+                            timestamp,
+                            file_ix,
+                            i % 13,
+                            i % 100,
+                            file_ix
+                    );
+                    break;
+                default:
+                    content += fmt::format(
+                            "{} ERROR Lost connection to 192.168.{}.{}\n",
+                            timestamp,
+                            file_ix,
+                            i % 256
+                    );
+                    break;
+            }
+        }
+        auto const file_name{fmt::format("file{}.log", file_ix)};
+        std::ofstream{std::filesystem::path{cTestCompressionInputDir} / file_name} << content;
+        contents.emplace(file_name, std::move(content));
+    }
+    return contents;
+}
+
+auto run_clp(vector<string> const& arguments) -> void {
+    vector<char const*> argv;
+    for (auto const& arg : arguments) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    REQUIRE((0 == clp::clp::run(static_cast<int>(argv.size() - 1), argv.data())));
+}
+
+auto read_files(string const& dir) -> std::map<string, string> {
+    std::map<string, string> contents;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator{dir}) {
+        if (false == entry.is_regular_file()) {
+            continue;
+        }
+        std::ifstream file{entry.path(), std::ios::binary};
+        contents.emplace(
+                std::filesystem::relative(entry.path(), dir).string(),
+                string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}}
+        );
+    }
+    return contents;
+}
+
+auto get_file_locations(string const& archives_dir) -> std::map<string, vector<FileLocation>> {
+    std::map<string, vector<FileLocation>> locations;
+    // The archives directory also contains the global metadata database
+    for (auto const& entry : std::filesystem::directory_iterator{archives_dir}) {
+        if (false == entry.is_directory()) {
+            continue;
+        }
+        Archive archive;
+        archive.open(entry.path().string());
+        for (auto file_it{archive.get_file_iterator()}; file_it->has_next(); file_it->next()) {
+            string path;
+            file_it->get_path(path);
+            locations[path].push_back(
+                    {entry.path().string(), file_it->get_segment_id(), file_it->get_split_ix()}
+            );
+        }
+        archive.close();
+    }
+    return locations;
+}
+}  // namespace
+
+TEST_CASE("clp-compress-multithreaded", "[clp][compression]") {
+    vector<size_t> const nums_threads{1, 4};
+    vector<string> archives_dirs;
+    vector<string> output_dirs;
+    for (auto const num_threads : nums_threads) {
+        archives_dirs.emplace_back(
+                fmt::format("{}{}", cTestCompressionArchivesDirPrefix, num_threads)
+        );
+        output_dirs.emplace_back(fmt::format("{}{}", cTestCompressionOutputDirPrefix, num_threads));
+    }
+    vector<string> paths_to_clean{string{cTestCompressionInputDir}};
+    paths_to_clean.insert(paths_to_clean.end(), archives_dirs.begin(), archives_dirs.end());
+    paths_to_clean.insert(paths_to_clean.end(), output_dirs.begin(), output_dirs.end());
+    TestOutputCleaner const test_cleanup{paths_to_clean};
+
+    auto const input_contents{write_input_files()};
+
+    vector<std::map<string, string>> decompressed_contents;
+    for (size_t i{0}; i < nums_threads.size(); ++i) {
+        auto const num_threads{nums_threads[i]};
+        CAPTURE(num_threads);
+        run_clp(
+                {"main.cpp",
+                 "c",
+                 archives_dirs[i],
+                 string{cTestCompressionInputDir},
+                 "--num-threads",
+                 std::to_string(num_threads)}
+        );
+
+        // Every file should be stored whole in exactly one archive and segment
+        auto const locations{get_file_locations(archives_dirs[i])};
+        REQUIRE((input_contents.size() == locations.size()));
+        for (auto const& [path, file_locations] : locations) {
+            CAPTURE(path);
+            REQUIRE((1 == file_locations.size()));
+            REQUIRE((0 == file_locations.front().split_ix));
+            auto const file_name{std::filesystem::path{path}.filename().string()};
+            REQUIRE(input_contents.contains(file_name));
+        }
+
+        run_clp({"main.cpp", "x", archives_dirs[i], output_dirs[i]});
+        auto const contents{read_files(output_dirs[i])};
+        REQUIRE((input_contents.size() == contents.size()));
+        for (auto const& [path, content] : contents) {
+            auto const file_name{std::filesystem::path{path}.filename().string()};
+            REQUIRE(input_contents.contains(file_name));
+            REQUIRE((input_contents.at(file_name) == content));
+        }
+        decompressed_contents.emplace_back(contents);
+    }
+
+    REQUIRE((decompressed_contents.front() == decompressed_contents.back()));
+}
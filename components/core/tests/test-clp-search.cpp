@@ -0,0 +1,300 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <log_surgeon/Lexer.hpp>
+
+#include "../src/clp/clp/run.hpp"
+#include "../src/clp/Defs.h"
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/Grep.hpp"
+#include "../src/clp/GrepCore.hpp"
+#include "../src/clp/Query.hpp"
+#include "../src/clp/streaming_archive/reader/Archive.hpp"
+#include "../src/clp/streaming_archive/reader/File.hpp"
+#include "../src/clp/streaming_archive/reader/Message.hpp"
+#include "TestOutputCleaner.hpp"
+
+using clp::epochtime_t;
+using clp::Grep;
+using clp::GrepCore;
+using clp::Query;
+using clp::SubQuery;
+using clp::streaming_archive::reader::Archive;
+using clp::streaming_archive::reader::File;
+using clp::streaming_archive::reader::Message;
+using log_surgeon::lexers::ByteLexer;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr std::string_view cTestSearchInputFile{"test-clp-search.log"};
+constexpr std::string_view cTestSearchArchivesDir{"test-clp-search-archives"};
+// Spans several of `File`'s candidate message blocks, with a partial block at the end
+constexpr size_t cNumMessages{3 * File::cSearchBlockSize + 200};
+constexpr epochtime_t cFirstTimestamp{1'672'531'200'000};  // 2023-01-01T00:00:00.000Z
+constexpr epochtime_t cTimestampIncrement{1000};
+
+/**
+ * A match, as the message's index in the file split and the sub-query it matched.
+ */
+using Match = std::pair<size_t, SubQuery const*>;
+
+/**
+ * Writes `cNumMessages` log messages with a few different logtypes to `cTestSearchInputFile`. The
+ * last message of each block of `File::cSearchBlockSize` messages has its own logtype.
+ */
+auto write_input_file() -> void;
+
+/**
+ * Compresses `cTestSearchInputFile` into `cTestSearchArchivesDir` using clp.
+ */
+auto compress_input_file() -> void;
+
+/**
+ * Searches the file by checking every message in order, the way `File` searched before it
+ * filtered messages a block at a time.
+ * @param archive
+ * @param file
+ * @param query
+ * @return The matches in order.
+ */
+auto search_linearly(Archive& archive, File& file, Query const& query) -> vector<Match>;
+
+/**
+ * Searches the file using `Archive::find_message_matching_query`.
+ * @param archive
+ * @param file
+ * @param query
+ * @param interleave_get_next_message Whether to read the message after each match using
+ * `Archive::get_next_message`.
+ * @param messages_read_after_matches Returns the indices of the messages read after each match if
+ * `interleave_get_next_message` is true.
+ * @return The matches in order.
+ */
+auto search(
+        Archive& archive,
+        File& file,
+        Query const& query,
+        bool interleave_get_next_message,
+        vector<size_t>& messages_read_after_matches
+) -> vector<Match>;
+
+auto write_input_file() -> void {
+    std::ofstream input_file{string{cTestSearchInputFile}};
+    for (size_t i{0}; i < cNumMessages; ++i) {
+        auto const timestamp{fmt::format(
+                "2023-01-01T{:02}:{:02}:{:02}.000",
+                i / 3600,
+                (i / 60) % 60,
+                i % 60
+        )};
+        if (File::cSearchBlockSize - 1 == i % File::cSearchBlockSize) {
+            input_file << fmt::format("{} Block boundary reached after {} events\n", timestamp, i);
+            continue;
+        }
+        switch (i % 3) {
+            case 0:
+                input_file << fmt::format(
+                        "{} INFO Request {} served in {} ms\n",
+                        timestamp,
+                        i,
+                        i % 100
+                );
+                break;
+            case 1:
+                input_file << fmt::format(
+                        "{} WARN Disk usage at {}.5 percent on node{}\n",
+                        timestamp,
+                        i % 90,
+                        i % 7
+                );
+                break;
+            default:
+                input_file << fmt::format(
+                        "{} ERROR Connection to 10.0.{}.1 failed with code {}\n",
+                        timestamp,
+                        i % 5,
+                        i % 3 + i % 4
+                );
+                break;
+        }
+    }
+}
+
+auto compress_input_file() -> void {
+    vector<string> const arguments{
+            "main.cpp",
+            "c",
+            string{cTestSearchArchivesDir},
+            string{cTestSearchInputFile}
+    };
+    vector<char const*> argv;
+    for (auto const& arg : arguments) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    REQUIRE((0 == clp::clp::run(static_cast<int>(argv.size() - 1), argv.data())));
+}
+
+auto search_linearly(Archive& archive, File& file, Query const& query) -> vector<Match> {
+    vector<Match> matches;
+    archive.reset_file_indices(file);
+    Message msg;
+    while (archive.get_next_message(file, msg)) {
+        if (false == query.timestamp_is_in_search_time_range(msg.get_ts_in_milli())) {
+            continue;
+        }
+        for (auto const* sub_query : query.get_relevant_sub_queries()) {
+            if (sub_query->matches_logtype(msg.get_logtype_id())
+                && sub_query->matches_vars(msg.get_vars()))
+            {
+                matches.emplace_back(msg.get_ix_in_file_split(), sub_query);
+                break;
+            }
+        }
+    }
+    return matches;
+}
+
+auto search(
+        Archive& archive,
+        File& file,
+        Query const& query,
+        bool interleave_get_next_message,
+        vector<size_t>& messages_read_after_matches
+) -> vector<Match> {
+    vector<Match> matches;
+    archive.reset_file_indices(file);
+    Message msg;
+    while (true) {
+        auto const* sub_query{archive.find_message_matching_query(file, query, msg)};
+        if (nullptr == sub_query) {
+            break;
+        }
+        matches.emplace_back(msg.get_ix_in_file_split(), sub_query);
+        if (interleave_get_next_message && archive.get_next_message(file, msg)) {
+            messages_read_after_matches.emplace_back(msg.get_ix_in_file_split());
+        }
+    }
+    return matches;
+}
+}  // namespace
+
+TEST_CASE("clp-search-matches-linear-scan", "[clp][search]") {
+    TestOutputCleaner const test_cleanup{
+            {string{cTestSearchInputFile}, string{cTestSearchArchivesDir}}
+    };
+    write_input_file();
+    compress_input_file();
+
+    // The archives directory also contains the global metadata database
+    std::optional<string> archive_path;
+    for (auto const& entry : std::filesystem::directory_iterator{cTestSearchArchivesDir}) {
+        if (entry.is_directory()) {
+            REQUIRE_FALSE(archive_path.has_value());
+            archive_path = entry.path().string();
+        }
+    }
+    REQUIRE(archive_path.has_value());
+    Archive archive;
+    archive.open(archive_path.value());
+
+    vector<string> const search_strings{
+            "*failed with code 2*",
+            "*served in 1*",
+            "*on node3*",
+            "*Block boundary*",
+            "*10.0.4.1*",
+            "*percent*"
+    };
+    vector<std::pair<epochtime_t, epochtime_t>> const time_ranges{
+            {clp::cEpochTimeMin, clp::cEpochTimeMax},
+            // Begins and ends partway through blocks
+            {cFirstTimestamp + 500 * cTimestampIncrement,
+             cFirstTimestamp + 2600 * cTimestampIncrement},
+            // Ends on the last message of the first block
+            {cFirstTimestamp,
+             cFirstTimestamp
+                     + static_cast<epochtime_t>(File::cSearchBlockSize - 1) * cTimestampIncrement},
+            // Matches no messages
+            {cFirstTimestamp - 2 * cTimestampIncrement, cFirstTimestamp - cTimestampIncrement}
+    };
+
+    ByteLexer lexer;
+    bool has_query_with_multiple_sub_queries{false};
+    bool matched_last_message_in_block{false};
+    for (auto const& [search_begin_ts, search_end_ts] : time_ranges) {
+        vector<Query> queries;
+        for (auto const& search_string : search_strings) {
+            auto optional_query{GrepCore::process_raw_query(
+                    archive.get_logtype_dictionary(),
+                    archive.get_var_dictionary(),
+                    search_string,
+                    search_begin_ts,
+                    search_end_ts,
+                    false,
+                    lexer,
+                    true
+            )};
+            REQUIRE(optional_query.has_value());
+            REQUIRE(optional_query->contains_sub_queries());
+            has_query_with_multiple_sub_queries
+                    = has_query_with_multiple_sub_queries
+                      || optional_query->get_sub_queries().size() > 1;
+            queries.emplace_back(std::move(optional_query.value()));
+        }
+
+        auto file_metadata_ix{archive.get_file_iterator()};
+        REQUIRE(file_metadata_ix->has_next());
+        File file;
+        REQUIRE((clp::ErrorCode_Success == archive.open_file(file, *file_metadata_ix)));
+        Grep::calculate_sub_queries_relevant_to_file(file, queries);
+
+        for (auto const& query : queries) {
+            auto const expected_matches{search_linearly(archive, file, query)};
+            for (auto const& [msg_ix, sub_query] : expected_matches) {
+                if (File::cSearchBlockSize - 1 == msg_ix % File::cSearchBlockSize) {
+                    matched_last_message_in_block = true;
+                }
+            }
+
+            vector<size_t> messages_read_after_matches;
+            REQUIRE((expected_matches
+                     == search(archive, file, query, false, messages_read_after_matches)));
+
+            // Reading the message after each match with `get_next_message` should skip it in the
+            // search that follows.
+            vector<Match> expected_interleaved_matches;
+            vector<size_t> expected_messages_read_after_matches;
+            for (auto const& match : expected_matches) {
+                auto const msg_ix{match.first};
+                if (false == expected_messages_read_after_matches.empty()
+                    && msg_ix <= expected_messages_read_after_matches.back())
+                {
+                    continue;
+                }
+                expected_interleaved_matches.emplace_back(match);
+                if (msg_ix + 1 < cNumMessages) {
+                    expected_messages_read_after_matches.emplace_back(msg_ix + 1);
+                }
+            }
+            REQUIRE((expected_interleaved_matches
+                     == search(archive, file, query, true, messages_read_after_matches)));
+            REQUIRE((expected_messages_read_after_matches == messages_read_after_matches));
+        }
+
+        archive.close_file(file);
+    }
+    archive.close();
+
+    REQUIRE(has_query_with_multiple_sub_queries);
+    REQUIRE(matched_last_message_in_block);
+}
@@ -0,0 +1,149 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/clp_s/ColumnStatistics.hpp"
+#include "../src/clp_s/ZstdCompressor.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+
+using clp_s::ColumnStatistics;
+
+namespace {
+/**
+ * Writes each of the given statistics to a buffer and reads them back in order, the way the
+ * statistics of a table's columns are stored in an archive.
+ * @param statistics
+ * @return The statistics read back from the buffer.
+ */
+auto write_and_read(std::vector<ColumnStatistics>& statistics) -> std::vector<ColumnStatistics>;
+
+auto write_and_read(std::vector<ColumnStatistics>& statistics) -> std::vector<ColumnStatistics> {
+    std::string buffer;
+    clp_s::ZstdCompressor compressor;
+    compressor.open(buffer);
+    for (auto& column_statistics : statistics) {
+        column_statistics.write(compressor);
+    }
+    compressor.close();
+
+    clp_s::ZstdDecompressor decompressor;
+    decompressor.open(buffer.data(), buffer.size());
+    std::vector<ColumnStatistics> read_statistics(statistics.size());
+    for (auto& column_statistics : read_statistics) {
+        column_statistics.read(decompressor);
+    }
+    uint8_t byte{};
+    REQUIRE((clp_s::ErrorCodeEndOfFile == decompressor.try_read_numeric_value(byte)));
+    decompressor.close();
+    return read_statistics;
+}
+}  // namespace
+
+TEST_CASE("clp-s-column-statistics-round-trip", "[clp-s][ColumnStatistics]") {
+    SECTION("Ranges are merged and round-trip.") {
+        std::vector<ColumnStatistics> statistics(3);
+        statistics[0].add_int_range(5, 10);
+        statistics[0].add_int_range(-3, 7);
+        statistics[0].add_int_range(
+                std::numeric_limits<int64_t>::max(),
+                std::numeric_limits<int64_t>::max()
+        );
+        statistics[1].add_float_range(0.5, 1.5);
+        statistics[1].add_float_range(-2.25, 1.0);
+        // Empty statistics are stored as a column without any statistics
+        REQUIRE(statistics[2].empty());
+
+        auto const read_statistics{write_and_read(statistics)};
+        REQUIRE((read_statistics[0].get_int_range()
+                 == std::make_pair(int64_t{-3}, std::numeric_limits<int64_t>::max())));
+        REQUIRE_FALSE(read_statistics[0].get_float_range().has_value());
+        REQUIRE_FALSE(read_statistics[0].has_bloom_filter());
+        REQUIRE_FALSE(read_statistics[1].get_int_range().has_value());
+        REQUIRE((read_statistics[1].get_float_range() == std::make_pair(-2.25, 1.5)));
+        REQUIRE(read_statistics[2].empty());
+    }
+
+    SECTION("Bloom filters round-trip without false negatives.") {
+        constexpr uint64_t cNumVarIds{5000};
+        // Every other ID, added in several batches with duplicates
+        std::vector<ColumnStatistics> statistics(2);
+        for (uint64_t batch_begin{0}; batch_begin < 2 * cNumVarIds; batch_begin += 2 * 1000) {
+            std::vector<uint64_t> var_ids;
+            for (auto var_id{batch_begin}; var_id < batch_begin + 2 * 1000; var_id += 2) {
+                var_ids.emplace_back(var_id);
+                var_ids.emplace_back(var_id);
+            }
+            statistics[0].add_var_ids(var_ids);
+        }
+        statistics[0].add_int_range(0, 1);
+        statistics[1].add_var_ids({std::numeric_limits<uint64_t>::max()});
+
+        auto const read_statistics{write_and_read(statistics)};
+        REQUIRE(read_statistics[0].has_bloom_filter());
+        REQUIRE((read_statistics[0].get_int_range() == std::make_pair(int64_t{0}, int64_t{1})));
+        size_t num_false_positives{0};
+        for (uint64_t var_id{0}; var_id < 2 * cNumVarIds; ++var_id) {
+            if (0 == var_id % 2) {
+                REQUIRE(read_statistics[0].may_contain_var_id(var_id));
+            } else if (read_statistics[0].may_contain_var_id(var_id)) {
+                ++num_false_positives;
+            }
+        }
+        // With 10 bits per entry and 7 hashes, the false positive rate should be around 1%
+        REQUIRE((num_false_positives < cNumVarIds / 20));
+
+        REQUIRE(read_statistics[1].has_bloom_filter());
+        REQUIRE(read_statistics[1].may_contain_var_id(std::numeric_limits<uint64_t>::max()));
+    }
+
+    SECTION("Columns with too many variables don't get a bloom filter.") {
+        std::vector<ColumnStatistics> statistics(1);
+        std::vector<uint64_t> var_ids(ColumnStatistics::cMaxNumBloomFilterEntries + 1);
+        for (size_t i{0}; i < var_ids.size(); ++i) {
+            var_ids[i] = i;
+        }
+        statistics[0].add_var_ids(var_ids);
+
+        auto const read_statistics{write_and_read(statistics)};
+        REQUIRE_FALSE(read_statistics[0].has_bloom_filter());
+        REQUIRE(read_statistics[0].empty());
+        REQUIRE(read_statistics[0].may_contain_var_id(var_ids.size()));
+    }
+
+    SECTION("Truncated statistics are rejected.") {
+        ColumnStatistics statistics;
+        statistics.add_int_range(1, 2);
+        statistics.add_var_ids({1, 2, 3});
+        std::string buffer;
+        clp_s::ZstdCompressor compressor;
+        compressor.open(buffer);
+        statistics.write(compressor);
+        compressor.close();
+
+        std::string uncompressed;
+        clp_s::ZstdDecompressor decompressor;
+        decompressor.open(buffer.data(), buffer.size());
+        char c{};
+        while (clp_s::ErrorCodeSuccess == decompressor.try_read_numeric_value(c)) {
+            uncompressed.push_back(c);
+        }
+        decompressor.close();
+
+        // Drop the last word of the bloom filter
+        uncompressed.resize(uncompressed.size() - sizeof(uint64_t));
+        std::string truncated_buffer;
+        compressor.open(truncated_buffer);
+        compressor.write(uncompressed.data(), uncompressed.size());
+        compressor.close();
+
+        ColumnStatistics read_statistics;
+        decompressor.open(truncated_buffer.data(), truncated_buffer.size());
+        REQUIRE_THROWS_AS(read_statistics.read(decompressor), ColumnStatistics::OperationFailed);
+        decompressor.close();
+    }
+}
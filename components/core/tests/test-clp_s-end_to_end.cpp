@@ -1,7 +1,12 @@
 #include <sys/wait.h>
 
+#include <cstddef>
 #include <cstdlib>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
 #include <optional>
 #include <set>
 #include <string>
@@ -13,18 +18,28 @@
 #include <catch2/generators/catch_generators.hpp>
 #include <fmt/format.h>
 
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp/ReadAheadReader.hpp"
+#include "../src/clp/streaming_compression/zstd/Compressor.hpp"
 #include "../src/clp_s/archive_constants.hpp"
 #include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/ArchiveReaderAdaptor.hpp"
 #include "../src/clp_s/CommandLineArguments.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
 #include "../src/clp_s/InputConfig.hpp"
 #include "../src/clp_s/JsonConstructor.hpp"
+#include "../src/clp_s/JsonParser.hpp"
 #include "../src/clp_s/SchemaTree.hpp"
+#include "../src/clp_s/TimestampPattern.hpp"
 #include "clp_s_test_utils.hpp"
 #include "TestOutputCleaner.hpp"
 
 constexpr std::string_view cTestEndToEndArchiveDirectory{"test-end-to-end-archive"};
 constexpr std::string_view cTestEndToEndOutputDirectory{"test-end-to-end-out"};
 constexpr std::string_view cTestEndToEndOutputSortedJson{"test-end-to-end_sorted.jsonl"};
+constexpr std::string_view cTestEndToEndParallelArchiveDirectory{
+        "test-end-to-end-parallel-archive"
+};
 constexpr std::string_view cTestEndToEndInputFileDirectory{"test_log_files"};
 constexpr std::string_view cTestEndToEndInputFile{"test_no_floats_sorted.jsonl"};
 constexpr std::string_view cTestEndToEndExpectedOutputSortedFile{
@@ -36,18 +51,65 @@ constexpr std::string_view cTestEndToEndValidFormattedFloatInputFile{
 constexpr std::string_view cTestEndToEndInvalidFormattedFloatInputFile{
         "test_invalid_formatted_float.jsonl"
 };
+constexpr std::string_view cTestEndToEndGeneratedInputFile{"test-end-to-end-generated.jsonl"};
+constexpr std::string_view cTestEndToEndCorruptZstdInputFile{
+        "test-end-to-end-generated-corrupt.jsonl.zst"
+};
+// Small enough that each schema table is stored in its own packed stream, so that compressing with
+// multiple threads compresses the packed streams in parallel
+constexpr size_t cSmallMinTableSize{1};
+// Large enough that `clp::ReadAheadReader` reads the input in several chunks
+constexpr size_t cNumGeneratedRecords{40'000};
 
 namespace {
 auto get_test_input_path_relative_to_tests_dir(std::string_view const test_input_path)
         -> std::filesystem::path;
 auto get_test_input_local_path(std::string_view const test_input_path) -> std::string;
-auto extract() -> std::filesystem::path;
-void compare(std::filesystem::path const& extracted_json_path);
+/**
+ * Extracts every archive in `cTestEndToEndArchiveDirectory`.
+ * @param use_memory_mapping Whether to read the archives through memory mappings, rather than
+ * through the buffered readers that are used when an archive can't be mapped.
+ * @return The path of the extracted JSON.
+ */
+auto extract(bool use_memory_mapping) -> std::filesystem::path;
+/**
+ * Checks that the tables of every archive in `cTestEndToEndArchiveDirectory` are memory mapped iff
+ * memory mapping is requested, so that `extract` exercises the requested read path.
+ * @param use_memory_mapping
+ */
+void check_archives_memory_mapped(bool use_memory_mapping);
+void compare(
+        std::filesystem::path const& extracted_json_path,
+        std::filesystem::path const& expected_sorted_json_path
+);
+/**
+ * Generates `cNumGeneratedRecords` records, formatted and sorted the same way as `compare` formats
+ * and sorts extracted records.
+ * @return The generated records, one per line.
+ */
+auto generate_sorted_records() -> std::string;
+/**
+ * Ingests a single input file with `clp_s::JsonParser`.
+ * @param file_path
+ * @param num_threads
+ * @return Whether ingestion succeeded, or std::nullopt if ingestion threw an exception.
+ */
+auto try_ingest(std::string const& file_path, size_t num_threads) -> std::optional<bool>;
 void literallyCompare(
         std::filesystem::path const& expected_output_json_path,
         std::filesystem::path const& extracted_json_path
 );
 void check_all_leaf_nodes_match_types(std::set<clp_s::NodeType> const& types);
+/**
+ * @param archives_dir A directory containing a single multi-file archive.
+ * @return The path of the archive in the given directory.
+ */
+auto get_only_archive_path(std::string_view archives_dir) -> std::filesystem::path;
+/**
+ * @param path
+ * @return The contents of the file at the given path.
+ */
+auto read_file(std::filesystem::path const& path) -> std::string;
 
 auto get_test_input_path_relative_to_tests_dir(std::string_view const test_input_path)
         -> std::filesystem::path {
@@ -95,7 +157,39 @@ void check_all_leaf_nodes_match_types(std::set<clp_s::NodeType> const& types) {
     }
 }
 
-auto extract() -> std::filesystem::path {
+auto get_only_archive_path(std::string_view archives_dir) -> std::filesystem::path {
+    std::optional<std::filesystem::path> archive_path;
+    for (auto const& entry : std::filesystem::directory_iterator(archives_dir)) {
+        REQUIRE_FALSE(archive_path.has_value());
+        archive_path = entry.path();
+    }
+    REQUIRE(archive_path.has_value());
+    return archive_path.value();
+}
+
+auto read_file(std::filesystem::path const& path) -> std::string {
+    std::ifstream file{path, std::ios::binary};
+    REQUIRE(file.is_open());
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+void check_archives_memory_mapped(bool use_memory_mapping) {
+    for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndArchiveDirectory)) {
+        clp_s::ArchiveReaderAdaptor adaptor{
+                clp_s::Path{
+                        .source = clp_s::InputSource::Filesystem,
+                        .path = entry.path().string()
+                },
+                clp_s::NetworkAuthOption{},
+                use_memory_mapping
+        };
+        REQUIRE((clp_s::ErrorCodeSuccess == adaptor.load_archive_metadata()));
+        REQUIRE((use_memory_mapping
+                 == adaptor.get_mapped_section(clp_s::constants::cArchiveTablesFile).has_value()));
+    }
+}
+
+auto extract(bool use_memory_mapping) -> std::filesystem::path {
     constexpr auto cDefaultOrdered = false;
     constexpr auto cDefaultTargetOrderedChunkSize = 0;
 
@@ -106,6 +200,7 @@ auto extract() -> std::filesystem::path {
     constructor_option.output_dir = cTestEndToEndOutputDirectory;
     constructor_option.ordered = cDefaultOrdered;
     constructor_option.target_ordered_chunk_size = cDefaultTargetOrderedChunkSize;
+    constructor_option.use_memory_mapping = use_memory_mapping;
     for (auto const& entry : std::filesystem::directory_iterator(cTestEndToEndArchiveDirectory)) {
         constructor_option.archive_path = clp_s::Path{
                 .source{clp_s::InputSource::Filesystem},
@@ -122,7 +217,10 @@ auto extract() -> std::filesystem::path {
 
 // Silence the checks below since our use of `std::system` is safe in the context of testing.
 // NOLINTBEGIN(cert-env33-c,concurrency-mt-unsafe)
-void compare(std::filesystem::path const& extracted_json_path) {
+void compare(
+        std::filesystem::path const& extracted_json_path,
+        std::filesystem::path const& expected_sorted_json_path
+) {
     int result{std::system("command -v jq >/dev/null 2>&1")};
     REQUIRE((0 == result));
     auto command = fmt::format(
@@ -140,7 +238,7 @@ void compare(std::filesystem::path const& extracted_json_path) {
     command = fmt::format(
             "diff --unified {} {}  > /dev/null",
             cTestEndToEndOutputSortedJson,
-            get_test_input_local_path(cTestEndToEndInputFile)
+            expected_sorted_json_path.string()
     );
     result = std::system(command.c_str());
     REQUIRE((true == WIFEXITED(result)));
@@ -181,12 +279,73 @@ void literallyCompare(
     REQUIRE((0 == WEXITSTATUS(result)));
 }
 
+auto generate_sorted_records() -> std::string {
+    std::filesystem::path const unsorted_path{
+            std::string{cTestEndToEndGeneratedInputFile} + ".unsorted"
+    };
+    {
+        std::ofstream unsorted_file{unsorted_path};
+        for (size_t i{0}; i < cNumGeneratedRecords; ++i) {
+            unsorted_file << fmt::format(
+                    "{{\"id\":{},\"msg\":\"Request {} from user{} took {} ms\","
+                    "\"nested\":{{\"shard\":\"shard-{}\",\"value\":{}}}}}\n",
+                    i,
+                    i * 7,
+                    i % 113,
+                    i % 1000,
+                    i % 16,
+                    i % 97
+            );
+        }
+    }
+    // Sort with `sort` rather than in C++ so that the order matches `compare`'s locale
+    auto const command{fmt::format(
+            "sort {} > {}",
+            unsorted_path.string(),
+            cTestEndToEndGeneratedInputFile
+    )};
+    auto const result{std::system(command.c_str())};
+    std::filesystem::remove(unsorted_path);
+    REQUIRE((0 == result));
+
+    std::ifstream sorted_file{std::string{cTestEndToEndGeneratedInputFile}};
+    return {std::istreambuf_iterator<char>{sorted_file}, std::istreambuf_iterator<char>{}};
+}
+
 // NOLINTEND(cert-env33-c,concurrency-mt-unsafe)
+
+auto try_ingest(std::string const& file_path, size_t num_threads) -> std::optional<bool> {
+    constexpr auto cDefaultTargetEncodedSize{8ULL * 1024 * 1024 * 1024};  // 8 GiB
+    constexpr auto cDefaultMaxDocumentSize{512ULL * 1024 * 1024};  // 512 MiB
+    constexpr auto cDefaultCompressionLevel{3};
+
+    std::filesystem::create_directory(cTestEndToEndArchiveDirectory);
+    clp_s::JsonParserOption parser_option{};
+    parser_option.input_paths.emplace_back(
+            clp_s::Path{.source = clp_s::InputSource::Filesystem, .path = file_path}
+    );
+    parser_option.archives_dir = cTestEndToEndArchiveDirectory;
+    parser_option.target_encoded_size = cDefaultTargetEncodedSize;
+    parser_option.max_document_size = cDefaultMaxDocumentSize;
+    parser_option.min_table_size = cDefaultMinTableSize;
+    parser_option.compression_level = cDefaultCompressionLevel;
+    parser_option.num_threads = num_threads;
+
+    clp_s::TimestampPattern::init();
+    try {
+        clp_s::JsonParser parser{parser_option};
+        return parser.ingest();
+    } catch (std::exception const&) {
+        return std::nullopt;
+    }
+}
 }  // namespace
 
 TEST_CASE("clp-s-compress-extract-no-floats", "[clp-s][end-to-end]") {
     auto structurize_arrays = GENERATE(true, false);
     auto single_file_archive = GENERATE(true, false);
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    auto use_memory_mapping = GENERATE(true, false);
 
     TestOutputCleaner const test_cleanup{
             {std::string{cTestEndToEndArchiveDirectory},
@@ -201,13 +360,17 @@ TEST_CASE("clp-s-compress-extract-no-floats", "[clp-s][end-to-end]") {
                     std::nullopt,
                     false,
                     single_file_archive,
-                    structurize_arrays
+                    structurize_arrays,
+                    false,
+                    num_threads,
+                    cSmallMinTableSize
             )
     );
 
-    auto extracted_json_path = extract();
+    check_archives_memory_mapped(use_memory_mapping);
+    auto extracted_json_path = extract(use_memory_mapping);
 
-    compare(extracted_json_path);
+    compare(extracted_json_path, get_test_input_local_path(cTestEndToEndInputFile));
 }
 
 /**
@@ -216,6 +379,8 @@ TEST_CASE("clp-s-compress-extract-no-floats", "[clp-s][end-to-end]") {
 TEST_CASE("clp-s-compress-extract-valid-formatted-floats", "[clp-s][end-to-end]") {
     auto structurize_arrays = GENERATE(true, false);
     auto single_file_archive = GENERATE(true, false);
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    auto use_memory_mapping = GENERATE(true, false);
 
     TestOutputCleaner const test_cleanup{
             {std::string{cTestEndToEndArchiveDirectory},
@@ -231,7 +396,10 @@ TEST_CASE("clp-s-compress-extract-valid-formatted-floats", "[clp-s][end-to-end]"
                     std::nullopt,
                     true,
                     single_file_archive,
-                    structurize_arrays
+                    structurize_arrays,
+                    false,
+                    num_threads,
+                    cSmallMinTableSize
             )
     );
 
@@ -244,7 +412,8 @@ TEST_CASE("clp-s-compress-extract-valid-formatted-floats", "[clp-s][end-to-end]"
     };
     check_all_leaf_nodes_match_types(expected_matching_types);
 
-    auto extracted_json_path = extract();
+    check_archives_memory_mapped(use_memory_mapping);
+    auto extracted_json_path = extract(use_memory_mapping);
     literallyCompare(
             get_test_input_local_path(cTestEndToEndValidFormattedFloatInputFile),
             extracted_json_path
@@ -259,6 +428,8 @@ TEST_CASE("clp-s-compress-extract-valid-formatted-floats", "[clp-s][end-to-end]"
 TEST_CASE("clp-s-compress-extract-invalid-formatted-floats", "[clp-s][end-to-end]") {
     auto structurize_arrays = GENERATE(true, false);
     auto single_file_archive = GENERATE(true, false);
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    auto use_memory_mapping = GENERATE(true, false);
 
     TestOutputCleaner const test_cleanup{
             {std::string{cTestEndToEndArchiveDirectory},
@@ -274,7 +445,10 @@ TEST_CASE("clp-s-compress-extract-invalid-formatted-floats", "[clp-s][end-to-end
                     std::nullopt,
                     true,
                     single_file_archive,
-                    structurize_arrays
+                    structurize_arrays,
+                    false,
+                    num_threads,
+                    cSmallMinTableSize
             )
     );
 
@@ -287,9 +461,138 @@ TEST_CASE("clp-s-compress-extract-invalid-formatted-floats", "[clp-s][end-to-end
     };
     check_all_leaf_nodes_match_types(expected_matching_types);
 
-    auto extracted_json_path = extract();
+    check_archives_memory_mapped(use_memory_mapping);
+    auto extracted_json_path = extract(use_memory_mapping);
     literallyCompare(
             get_test_input_local_path(cTestEndToEndInvalidFormattedFloatInputFile),
             extracted_json_path
     );
 }
+
+/**
+ * Tests that pipelined ingestion (which reads the input ahead on a background thread) round-trips
+ * an input that spans several read-ahead chunks.
+ */
+TEST_CASE("clp-s-compress-extract-pipelined", "[clp-s][end-to-end]") {
+    auto num_threads = GENERATE(size_t{1}, size_t{4});
+    auto single_file_archive = GENERATE(true, false);
+    auto use_memory_mapping = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestEndToEndArchiveDirectory},
+             std::string{cTestEndToEndOutputDirectory},
+             std::string{cTestEndToEndOutputSortedJson},
+             std::string{cTestEndToEndGeneratedInputFile}}
+    };
+
+    auto const records{generate_sorted_records()};
+    REQUIRE((records.size() > 2 * clp::ReadAheadReader::cDefaultChunkSize));
+
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    std::string{cTestEndToEndGeneratedInputFile},
+                    std::string{cTestEndToEndArchiveDirectory},
+                    std::nullopt,
+                    false,
+                    single_file_archive,
+                    true,
+                    false,
+                    num_threads
+            )
+    );
+
+    check_archives_memory_mapped(use_memory_mapping);
+    auto extracted_json_path = extract(use_memory_mapping);
+    compare(extracted_json_path, std::string{cTestEndToEndGeneratedInputFile});
+}
+
+/**
+ * Tests that when the input fails to decompress partway through, pipelined ingestion fails the
+ * same way as serial ingestion rather than terminating the process from the read-ahead thread.
+ */
+TEST_CASE("clp-s-compress-pipelined-corrupt-input", "[clp-s][end-to-end]") {
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestEndToEndArchiveDirectory},
+             std::string{cTestEndToEndGeneratedInputFile},
+             std::string{cTestEndToEndCorruptZstdInputFile}}
+    };
+
+    auto const records{generate_sorted_records()};
+    {
+        clp::FileWriter file_writer;
+        file_writer.open(
+                std::string{cTestEndToEndCorruptZstdInputFile},
+                clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+        );
+        clp::streaming_compression::zstd::Compressor compressor;
+        compressor.open(file_writer);
+        compressor.write(records.data(), records.size());
+        compressor.close();
+        file_writer.close();
+    }
+
+    // Overwrite a region in the middle of the compressed stream so that decompression fails after
+    // several chunks have been read
+    constexpr size_t cCorruptRegionSize{4096};
+    auto const compressed_size{std::filesystem::file_size(cTestEndToEndCorruptZstdInputFile)};
+    REQUIRE((compressed_size > 2 * cCorruptRegionSize));
+    {
+        std::fstream compressed_file{
+                std::string{cTestEndToEndCorruptZstdInputFile},
+                std::ios::in | std::ios::out | std::ios::binary
+        };
+        compressed_file.seekp(static_cast<std::streamoff>(compressed_size / 2));
+        std::string const garbage(cCorruptRegionSize, '\xff');
+        compressed_file.write(garbage.data(), static_cast<std::streamsize>(garbage.size()));
+    }
+
+    auto const serial_outcome{try_ingest(std::string{cTestEndToEndCorruptZstdInputFile}, 1)};
+    std::filesystem::remove_all(cTestEndToEndArchiveDirectory);
+    auto const pipelined_outcome{try_ingest(std::string{cTestEndToEndCorruptZstdInputFile}, 4)};
+    REQUIRE((serial_outcome != std::optional<bool>{true}));
+    REQUIRE((serial_outcome == pipelined_outcome));
+}
+
+/**
+ * Tests that compressing packed streams in parallel writes exactly the same tables as compressing
+ * them serially.
+ */
+TEST_CASE("clp-s-compress-parallel-packed-streams", "[clp-s][end-to-end]") {
+    auto structurize_arrays = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{
+            {std::string{cTestEndToEndArchiveDirectory},
+             std::string{cTestEndToEndParallelArchiveDirectory}}
+    };
+
+    for (auto const& [archives_dir, num_threads] :
+         {std::pair{cTestEndToEndArchiveDirectory, size_t{1}},
+          std::pair{cTestEndToEndParallelArchiveDirectory, size_t{4}}})
+    {
+        REQUIRE_NOTHROW(
+                std::ignore = compress_archive(
+                        get_test_input_local_path(cTestEndToEndInputFile),
+                        std::string{archives_dir},
+                        std::nullopt,
+                        false,
+                        false,
+                        structurize_arrays,
+                        false,
+                        num_threads,
+                        cSmallMinTableSize
+                )
+        );
+    }
+
+    auto const serial_archive_path{get_only_archive_path(cTestEndToEndArchiveDirectory)};
+    auto const parallel_archive_path{get_only_archive_path(cTestEndToEndParallelArchiveDirectory)};
+    for (std::string_view const file_name :
+         {clp_s::constants::cArchiveTablesFile, clp_s::constants::cArchiveTableMetadataFile})
+    {
+        CAPTURE(file_name);
+        auto const relative_path{std::filesystem::path{file_name}.relative_path()};
+        auto const serial_file{read_file(serial_archive_path / relative_path)};
+        REQUIRE_FALSE(serial_file.empty());
+        REQUIRE((serial_file == read_file(parallel_archive_path / relative_path)));
+    }
+}
@@ -1,4 +1,11 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <filesystem>
 #include <memory>
@@ -7,6 +14,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -16,7 +24,10 @@
 #include <nlohmann/json.hpp>
 
 #include "../src/clp_s/archive_constants.hpp"
+#include "../src/clp_s/ArchiveCache.hpp"
 #include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/ErrorCode.hpp"
+#include "../src/clp_s/FileWriter.hpp"
 #include "../src/clp_s/InputConfig.hpp"
 #include "../src/clp_s/OutputHandlerImpl.hpp"
 #include "../src/clp_s/search/ast/ColumnDescriptor.hpp"
@@ -33,8 +44,17 @@
 #include "../src/clp_s/search/kql/kql.hpp"
 #include "../src/clp_s/search/Output.hpp"
 #include "../src/clp_s/search/Projection.hpp"
+#include "../src/clp_s/search/QueryRunner.hpp"
 #include "../src/clp_s/search/SchemaMatch.hpp"
+#include "../src/clp_s/search/SearchEngine.hpp"
 #include "../src/clp_s/Utils.hpp"
+#include "../src/clp_s/ZstdCompressor.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+#include "../src/reducer/AggregateOperator.hpp"
+#include "../src/reducer/aggregates.hpp"
+#include "../src/reducer/ColumnarRecordGroup.hpp"
+#include "../src/reducer/Pipeline.hpp"
+#include "../src/reducer/Record.hpp"
 #include "clp_s_test_utils.hpp"
 #include "TestOutputCleaner.hpp"
 
@@ -48,15 +68,109 @@ constexpr std::string_view cTestIdxKey{"idx"};
 constexpr std::string_view cTestTimestampKey{"timestamp"};
 
 namespace {
+/**
+ * What a search with a `LatestResultsOutputHandler` scanned.
+ */
+struct LatestResultsScanCounts {
+    // Number of tables searched, i.e., the number of times the output handler was flushed
+    size_t num_searched_tables{0};
+    // Number of results written to the output handler
+    size_t num_written_results{0};
+    // Number of results written to the output handler whose timestamp was at or before its cutoff
+    size_t num_written_results_past_cutoff{0};
+};
+
+/**
+ * Output handler which, like the results cache output handler, only keeps the results with the
+ * latest timestamps. The handler also counts what the search scanned.
+ */
+class LatestResultsOutputHandler : public clp_s::search::OutputHandler {
+public:
+    // Constructors
+    LatestResultsOutputHandler(
+            std::vector<clp_s::VectorOutputHandler::QueryResult>& results,
+            size_t max_num_results,
+            LatestResultsScanCounts& scan_counts
+    )
+            : clp_s::search::OutputHandler{true, true},
+              m_results{results},
+              m_max_num_results{max_num_results},
+              m_scan_counts{scan_counts} {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            std::string_view message,
+            clp_s::epochtime_t timestamp,
+            std::string_view archive_id,
+            int64_t log_event_idx
+    ) override {
+        ++m_scan_counts.num_written_results;
+        auto const timestamp_cutoff{get_timestamp_cutoff()};
+        if (timestamp_cutoff.has_value() && timestamp <= timestamp_cutoff.value()) {
+            ++m_scan_counts.num_written_results_past_cutoff;
+        }
+
+        // `m_results` is a min-heap by timestamp
+        m_results.emplace_back(message, timestamp, archive_id, log_event_idx);
+        std::push_heap(m_results.begin(), m_results.end(), cLaterTimestamp);
+        if (m_results.size() > m_max_num_results) {
+            std::pop_heap(m_results.begin(), m_results.end(), cLaterTimestamp);
+            m_results.pop_back();
+        }
+    }
+
+    void write(std::string_view message) override { write(message, 0, {}, 0); }
+
+    auto flush() -> clp_s::ErrorCode override {
+        ++m_scan_counts.num_searched_tables;
+        return clp_s::ErrorCode::ErrorCodeSuccess;
+    }
+
+    [[nodiscard]] auto keeps_latest_results() const -> bool override { return true; }
+
+    [[nodiscard]] auto get_timestamp_cutoff() const
+            -> std::optional<clp_s::epochtime_t> override {
+        if (m_results.size() < m_max_num_results) {
+            return std::nullopt;
+        }
+        return m_results.front().timestamp;
+    }
+
+private:
+    static constexpr auto cLaterTimestamp = [](auto const& lhs, auto const& rhs) {
+        return lhs.timestamp > rhs.timestamp;
+    };
+
+    std::vector<clp_s::VectorOutputHandler::QueryResult>& m_results;
+    size_t m_max_num_results;
+    LatestResultsScanCounts& m_scan_counts;
+};
+
 auto get_test_input_path_relative_to_tests_dir(std::string_view test_input_path)
         -> std::filesystem::path;
 auto get_test_input_local_path(std::string_view test_input_path) -> std::string;
 auto create_first_record_match_metadata_query() -> std::shared_ptr<clp_s::search::ast::Expression>;
-void
-search(std::string const& query, bool ignore_case, std::vector<int64_t> const& expected_results);
+void search(
+        std::string const& query,
+        bool ignore_case,
+        std::vector<int64_t> const& expected_results,
+        size_t num_threads = 1,
+        size_t num_prefetched_streams = 0,
+        std::optional<size_t> max_num_latest_results = std::nullopt,
+        LatestResultsScanCounts* latest_results_scan_counts = nullptr
+);
 void search(
         std::shared_ptr<clp_s::search::ast::Expression> expr,
         bool ignore_case,
+        std::vector<int64_t> const& expected_results,
+        size_t num_threads = 1,
+        size_t num_prefetched_streams = 0,
+        std::optional<size_t> max_num_latest_results = std::nullopt,
+        LatestResultsScanCounts* latest_results_scan_counts = nullptr
+);
+void search_with_engine(
+        clp_s::search::SearchEngine& search_engine,
+        std::string const& query,
         std::vector<int64_t> const& expected_results
 );
 void validate_results(
@@ -64,6 +178,45 @@ void validate_results(
         std::vector<int64_t> const& expected_results
 );
 
+/**
+ * Searches the archives for the given query with an `AggregateOutputHandler` per archive, then
+ * combines the partial aggregates that the handlers send, as the reducer does.
+ * @param query
+ * @param type
+ * @param field The field to aggregate.
+ * @param result_key The key of the final aggregate's value in its record.
+ * @return The final aggregate's value, or std::nullopt if there's no final aggregate or it has no
+ * value.
+ */
+auto search_and_aggregate(
+        std::string const& query,
+        reducer::AggregationType type,
+        std::string const& field,
+        std::string_view result_key
+) -> std::optional<double>;
+
+/**
+ * Counts the tables that a search for the given query would decompress, i.e., the tables whose
+ * schemas match the query and which `QueryRunner::schema_init` doesn't rule out.
+ * @param query
+ * @param num_tables Returns the number of tables in the archives.
+ * @param num_tables_with_statistics Returns the number of tables in the archives which have column
+ * statistics.
+ * @return The number of tables searched across all archives.
+ */
+auto count_searched_tables(
+        std::string const& query,
+        size_t& num_tables,
+        size_t& num_tables_with_statistics
+) -> size_t;
+
+/**
+ * Rewrites the table metadata of a multi-file archive without the column statistics section, so
+ * that it matches archives written before column statistics were introduced.
+ * @param archive_path
+ */
+void remove_column_statistics(std::string const& archive_path);
+
 auto get_test_input_path_relative_to_tests_dir(std::string_view test_input_path)
         -> std::filesystem::path {
     return std::filesystem::path{cTestInputFileDirectory} / test_input_path;
@@ -129,17 +282,36 @@ void validate_results(
     REQUIRE(results.size() == expected_results.size());
 }
 
-void
-search(std::string const& query, bool ignore_case, std::vector<int64_t> const& expected_results) {
+void search(
+        std::string const& query,
+        bool ignore_case,
+        std::vector<int64_t> const& expected_results,
+        size_t num_threads,
+        size_t num_prefetched_streams,
+        std::optional<size_t> max_num_latest_results,
+        LatestResultsScanCounts* latest_results_scan_counts
+) {
     auto query_stream = std::istringstream{query};
     auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
-    search(expr, ignore_case, expected_results);
+    search(
+            expr,
+            ignore_case,
+            expected_results,
+            num_threads,
+            num_prefetched_streams,
+            max_num_latest_results,
+            latest_results_scan_counts
+    );
 }
 
 void search(
         std::shared_ptr<clp_s::search::ast::Expression> expr,
         bool ignore_case,
-        std::vector<int64_t> const& expected_results
+        std::vector<int64_t> const& expected_results,
+        size_t num_threads,
+        size_t num_prefetched_streams,
+        std::optional<size_t> max_num_latest_results,
+        LatestResultsScanCounts* latest_results_scan_counts
 ) {
     REQUIRE(nullptr != expr);
     REQUIRE(nullptr == std::dynamic_pointer_cast<clp_s::search::ast::EmptyExpr>(expr));
@@ -156,6 +328,11 @@ void search(
     expr = convert_pass.run(expr);
     REQUIRE(nullptr != expr);
 
+    LatestResultsScanCounts unused_scan_counts;
+    auto& scan_counts{
+            nullptr == latest_results_scan_counts ? unused_scan_counts : *latest_results_scan_counts
+    };
+
     std::vector<clp_s::VectorOutputHandler::QueryResult> results;
     for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
         auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
@@ -186,13 +363,24 @@ void search(
         archive_expr = match_pass->run(archive_expr);
         REQUIRE(nullptr != archive_expr);
 
-        auto output_handler = std::make_unique<clp_s::VectorOutputHandler>(results);
+        std::unique_ptr<clp_s::search::OutputHandler> output_handler;
+        if (max_num_latest_results.has_value()) {
+            output_handler = std::make_unique<LatestResultsOutputHandler>(
+                    results,
+                    max_num_latest_results.value(),
+                    scan_counts
+            );
+        } else {
+            output_handler = std::make_unique<clp_s::VectorOutputHandler>(results);
+        }
         clp_s::search::Output output_pass(
                 match_pass,
                 archive_expr,
                 archive_reader,
                 std::move(output_handler),
-                ignore_case
+                ignore_case,
+                num_threads,
+                num_prefetched_streams
         );
         output_pass.filter();
         archive_reader->close();
@@ -200,6 +388,214 @@ void search(
 
     validate_results(results, expected_results);
 }
+
+void search_with_engine(
+        clp_s::search::SearchEngine& search_engine,
+        std::string const& query,
+        std::vector<int64_t> const& expected_results
+) {
+    auto query_stream = std::istringstream{query};
+    auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
+    REQUIRE(nullptr != expr);
+
+    clp_s::search::SearchOption option;
+    option.query = query;
+
+    std::vector<clp_s::VectorOutputHandler::QueryResult> results;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+        auto archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        REQUIRE(search_engine.search_archive(
+                archive_path,
+                clp_s::NetworkAuthOption{},
+                expr->copy(),
+                option,
+                [&]() { return std::make_unique<clp_s::VectorOutputHandler>(results); }
+        ));
+    }
+
+    validate_results(results, expected_results);
+}
+
+auto search_and_aggregate(
+        std::string const& query,
+        reducer::AggregationType type,
+        std::string const& field,
+        std::string_view result_key
+) -> std::optional<double> {
+    constexpr double cQuantile{0.5};
+
+    auto query_stream = std::istringstream{query};
+    auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
+    REQUIRE(nullptr != expr);
+
+    clp_s::search::SearchOption option;
+    option.query = query;
+
+    // Each archive's handler sends its partial aggregates over one end of the socket pair
+    std::array<int, 2> socket_fds{};
+    REQUIRE((0 == socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds.data())));
+    clp_s::search::SearchEngine search_engine;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+        auto archive_path = clp_s::Path{
+                .source{clp_s::InputSource::Filesystem},
+                .path{entry.path().string()}
+        };
+        REQUIRE(search_engine.search_archive(
+                archive_path,
+                clp_s::NetworkAuthOption{},
+                expr->copy(),
+                option,
+                [&]() {
+                    return std::make_unique<clp_s::AggregateOutputHandler>(
+                            socket_fds[0],
+                            type,
+                            field,
+                            cQuantile
+                    );
+                }
+        ));
+    }
+    close(socket_fds[0]);
+
+    std::string received;
+    std::array<char, 4096> buf{};
+    ssize_t num_bytes_read{};
+    while ((num_bytes_read = read(socket_fds[1], buf.data(), buf.size())) > 0) {
+        received.append(buf.data(), static_cast<size_t>(num_bytes_read));
+    }
+    close(socket_fds[1]);
+    REQUIRE((0 == num_bytes_read));
+
+    // Each partial aggregate is a serialized record group preceded by its size (see
+    // `reducer::send_pipeline_results`)
+    reducer::Pipeline pipeline{reducer::PipelineInputMode::IntraStage};
+    pipeline.add_pipeline_stage(reducer::create_aggregate_operator(type, field, cQuantile));
+    size_t offset{0};
+    while (offset < received.size()) {
+        size_t group_size{};
+        REQUIRE((offset + sizeof(group_size) <= received.size()));
+        std::memcpy(&group_size, received.data() + offset, sizeof(group_size));
+        offset += sizeof(group_size);
+        REQUIRE((offset + group_size <= received.size()));
+        reducer::ColumnarRecordGroup group{received.data() + offset, group_size};
+        pipeline.push_record_group(group.get_tags(), group.record_iter());
+        offset += group_size;
+    }
+
+    auto group_it = pipeline.finish();
+    if (group_it->done()) {
+        return std::nullopt;
+    }
+    auto const& record = group_it->get().record_iter().get();
+    for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+         typed_key_it->next())
+    {
+        if (typed_key_it->get().get_key() == result_key) {
+            return record.get_double_value(result_key);
+        }
+    }
+    return std::nullopt;
+}
+
+auto count_searched_tables(
+        std::string const& query,
+        size_t& num_tables,
+        size_t& num_tables_with_statistics
+) -> size_t {
+    auto query_stream = std::istringstream{query};
+    auto expr = clp_s::search::kql::parse_kql_expression(query_stream);
+    REQUIRE(nullptr != expr);
+    expr = clp_s::search::ast::OrOfAndForm{}.run(expr);
+    expr = clp_s::search::ast::NarrowTypes{}.run(expr);
+    expr = clp_s::search::ast::ConvertToExists{}.run(expr);
+    REQUIRE(nullptr != expr);
+
+    size_t num_searched_tables{0};
+    num_tables = 0;
+    num_tables_with_statistics = 0;
+    for (auto const& entry : std::filesystem::directory_iterator(cTestSearchArchiveDirectory)) {
+        auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
+        archive_reader->open(
+                clp_s::Path{.source{clp_s::InputSource::Filesystem}, .path{entry.path().string()}},
+                clp_s::NetworkAuthOption{}
+        );
+        archive_reader->read_metadata();
+
+        auto match_pass = std::make_shared<clp_s::search::SchemaMatch>(
+                archive_reader->get_schema_tree(),
+                archive_reader->get_schema_map()
+        );
+        auto archive_expr = expr->copy();
+        archive_expr = match_pass->run(archive_expr);
+        REQUIRE(nullptr != archive_expr);
+
+        archive_reader->read_variable_dictionary();
+        archive_reader->read_log_type_dictionary();
+        clp_s::search::QueryRunner query_runner{match_pass, archive_expr, archive_reader, false};
+        query_runner.global_init();
+        for (auto const schema_id : archive_reader->get_schema_ids()) {
+            ++num_tables;
+            if (nullptr != archive_reader->get_table_statistics(schema_id)) {
+                ++num_tables_with_statistics;
+            }
+            if (match_pass->schema_matched(schema_id)
+                && clp_s::EvaluatedValue::False != query_runner.schema_init(schema_id))
+            {
+                ++num_searched_tables;
+            }
+        }
+        archive_reader->close();
+    }
+    return num_searched_tables;
+}
+
+void remove_column_statistics(std::string const& archive_path) {
+    auto const table_metadata_path{
+            archive_path + std::string{clp_s::constants::cArchiveTableMetadataFile}
+    };
+    clp_s::ZstdDecompressor decompressor;
+    REQUIRE((clp_s::ErrorCodeSuccess == decompressor.open(table_metadata_path)));
+    std::string table_metadata;
+    std::array<char, 4096> buf{};
+    size_t num_bytes_read{};
+    auto error{clp_s::ErrorCodeSuccess};
+    while (clp_s::ErrorCodeSuccess == error) {
+        error = decompressor.try_read(buf.data(), buf.size(), num_bytes_read);
+        if (clp_s::ErrorCodeSuccess == error) {
+            table_metadata.append(buf.data(), num_bytes_read);
+        }
+    }
+    REQUIRE((clp_s::ErrorCodeEndOfFile == error));
+    decompressor.close();
+
+    // Skip over the stream and schema table metadata (see `ArchiveWriter::store_tables`)
+    auto read_size = [&](size_t offset) -> size_t {
+        REQUIRE((offset + sizeof(uint64_t) <= table_metadata.size()));
+        uint64_t value{};
+        std::memcpy(&value, table_metadata.data() + offset, sizeof(value));
+        return value;
+    };
+    size_t offset{0};
+    auto const num_streams{read_size(offset)};
+    offset += sizeof(uint64_t) + num_streams * 2 * sizeof(uint64_t);
+    // Number of separate column schemas
+    offset += sizeof(uint64_t);
+    auto const num_schemas{read_size(offset)};
+    offset += sizeof(uint64_t) + num_schemas * (3 * sizeof(uint64_t) + sizeof(int32_t));
+    REQUIRE((offset < table_metadata.size()));
+    table_metadata.resize(offset);
+
+    clp_s::FileWriter file_writer;
+    file_writer.open(table_metadata_path, clp_s::FileWriter::OpenMode::CreateForWriting);
+    clp_s::ZstdCompressor compressor;
+    compressor.open(file_writer);
+    compressor.write(table_metadata.data(), table_metadata.size());
+    compressor.close();
+    file_writer.close();
+}
 }  // namespace
 
 TEST_CASE("clp-s-search", "[clp-s][search]") {
@@ -228,14 +624,36 @@ TEST_CASE("clp-s-search", "[clp-s][search]") {
              {1}},
             {R"aa(ambiguous_varstring: "a*e")aa", {10, 11, 12}},
             {R"aa(ambiguous_varstring: "a\*e")aa", {12}},
+            {R"aa(ambiguous_varstring: "*bcd*")aa", {10}},
+            {R"aa(ambiguous_varstring: "*bcx*")aa", {}},
             {R"aa(idx: * AND NOT idx: null AND idx: 0)aa", {0}},
-            {R"aa(one > 0.9 AND one < 1.1 AND one: 1.0)aa", {13}}
+            {R"aa(one > 0.9 AND one < 1.1 AND one: 1.0)aa", {13}},
+            {R"aa(idx >= 2 AND idx < 5)aa", {2, 3, 4}},
+            {R"aa(idx: 1 OR idx > 11)aa", {1, 12, 13}},
+            {R"aa(NOT idx < 12)aa", {12, 13}},
+            {R"aa(bool: true AND float > 1.0 AND int: 1)aa", {9}},
+            {R"aa(idx > 3 AND msg: "*Abc123*")aa", {4, 5, 6}},
+            {R"aa(idx > 13)aa", {}},
+            {R"aa(idx <= 0)aa", {0}},
+            {R"aa(NOT idx > 0)aa", {0}},
+            {R"aa(idx: 12 OR idx: 9.5)aa", {12}},
+            {R"aa(float < 1.1 OR float > 1.1)aa", {}},
+            {R"aa(float >= 1.1)aa", {9}},
+            {R"aa(ambiguous_varstring: a)aa", {}},
+            {R"aa(ambiguous_varstring: ae AND idx < 12)aa", {11}}
     };
     auto structurize_arrays = GENERATE(true, false);
     auto single_file_archive = GENERATE(true, false);
+    auto num_search_threads = GENERATE(size_t{1}, size_t{4});
+    auto num_prefetched_streams = GENERATE(size_t{0}, size_t{2});
+    auto index_variable_dictionary = GENERATE(true, false);
+    auto num_compression_threads = GENERATE(size_t{1}, size_t{4});
 
     TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
 
+    // Store each schema table in its own packed stream so that the packed streams are compressed in
+    // parallel when compressing with multiple threads
+    constexpr size_t cMinTableSize{1};
     REQUIRE_NOTHROW(
             std::ignore = compress_archive(
                     get_test_input_local_path(cTestSearchInputFile),
@@ -243,18 +661,260 @@ TEST_CASE("clp-s-search", "[clp-s][search]") {
                     std::string{cTestIdxKey},
                     false,
                     single_file_archive,
-                    structurize_arrays
+                    structurize_arrays,
+                    index_variable_dictionary,
+                    num_compression_threads,
+                    cMinTableSize
             )
     );
 
     for (auto const& [query, expected_results] : queries_and_results) {
         CAPTURE(query);
-        REQUIRE_NOTHROW(search(query, false, expected_results));
+        REQUIRE_NOTHROW(search(
+                query,
+                false,
+                expected_results,
+                num_search_threads,
+                num_prefetched_streams
+        ));
     }
 
     std::shared_ptr<clp_s::search::ast::Expression> expr{nullptr};
     REQUIRE_NOTHROW(expr = create_first_record_match_metadata_query());
-    REQUIRE_NOTHROW(search(expr, false, {0}));
+    REQUIRE_NOTHROW(search(expr, false, {0}, num_search_threads, num_prefetched_streams));
+}
+
+TEST_CASE("clp-s-search-column-statistics", "[clp-s][search]") {
+    // Tuples of the query, the expected results, and the number of tables searched with and without
+    // column statistics, where std::nullopt means every table
+    std::vector<
+            std::tuple<std::string, std::vector<int64_t>, size_t, std::optional<size_t>>>
+            queries_and_results{
+                    // Excluded from the tables by the range of `idx`
+                    {R"aa(idx > 13)aa", {}, 0, std::nullopt},
+                    {R"aa(idx >= 13)aa", {13}, 1, std::nullopt},
+                    // Excluded by the range of `float`
+                    {R"aa(float < 1.1 OR float > 1.1)aa", {}, 0, 1},
+                    {R"aa(float >= 1.1)aa", {9}, 1, 1},
+                    // "a" is in the variable dictionary, but excluded by the column's bloom filter
+                    {R"aa(ambiguous_varstring: a)aa", {}, 0, 1},
+                    {R"aa(ambiguous_varstring: ae)aa", {11}, 1, 1}
+            };
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    // Column statistics can only be removed from multi-file archives
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    get_test_input_local_path(cTestSearchInputFile),
+                    std::string{cTestSearchArchiveDirectory},
+                    std::string{cTestIdxKey},
+                    false,
+                    false,
+                    false
+            )
+    );
+
+    for (bool const has_statistics : {true, false}) {
+        CAPTURE(has_statistics);
+        if (false == has_statistics) {
+            for (auto const& entry :
+                 std::filesystem::directory_iterator(cTestSearchArchiveDirectory))
+            {
+                remove_column_statistics(entry.path().string());
+            }
+        }
+
+        for (auto const& [query, expected_results, num_tables_with, num_tables_without] :
+             queries_and_results)
+        {
+            CAPTURE(query);
+            size_t num_tables{};
+            size_t num_tables_with_statistics{};
+            auto const num_searched_tables{
+                    count_searched_tables(query, num_tables, num_tables_with_statistics)
+            };
+            if (has_statistics) {
+                REQUIRE((num_tables_with == num_searched_tables));
+                REQUIRE((0 < num_tables_with_statistics));
+            } else {
+                REQUIRE((num_tables_without.value_or(num_tables) == num_searched_tables));
+                REQUIRE((0 == num_tables_with_statistics));
+            }
+            REQUIRE_NOTHROW(search(query, false, expected_results));
+        }
+    }
+}
+
+TEST_CASE("clp-s-search-latest-results", "[clp-s][search]") {
+    // Tuples of the query, the number of latest results to keep, the expected results, and the
+    // number of tables searched and results written when searching with one thread. Every record
+    // is in the same packed stream, so its tables are searched from the latest (`idx` 13) to the
+    // earliest (`idx` 0), and the search stops once no remaining table can beat the cutoff.
+    std::vector<std::tuple<std::string, size_t, std::vector<int64_t>, size_t, size_t>>
+            queries_and_results{
+                    // The tables of `idx` 13 and 10-12 (out of 7 tables)
+                    {R"aa(idx >= 0)aa", 3, {11, 12, 13}, 2, 4},
+                    // The table of `idx` 13
+                    {R"aa(idx >= 0)aa", 1, {13}, 1, 1},
+                    {R"aa(msg: "*Abc123*")aa", 2, {5, 6}, 1, 6},
+                    // The tables of `idx` 1-6 and 0, since there's no cutoff
+                    {R"aa(idx < 3)aa", 10, {0, 1, 2}, 2, 3}
+            };
+    auto num_search_threads = GENERATE(size_t{1}, size_t{4});
+    auto num_prefetched_streams = GENERATE(size_t{0}, size_t{2});
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    get_test_input_local_path(cTestSearchInputFile),
+                    std::string{cTestSearchArchiveDirectory},
+                    std::string{cTestIdxKey},
+                    false,
+                    false,
+                    false
+            )
+    );
+
+    for (auto const& [query, max_num_results, expected_results, num_tables, num_results] :
+         queries_and_results)
+    {
+        CAPTURE(query);
+        CAPTURE(max_num_results);
+        LatestResultsScanCounts scan_counts;
+        REQUIRE_NOTHROW(search(
+                query,
+                false,
+                expected_results,
+                num_search_threads,
+                num_prefetched_streams,
+                max_num_results,
+                &scan_counts
+        ));
+
+        // Parallel searches read tables ahead of the cutoff and only update it per batch of
+        // results, so only single-threaded searches scan a deterministic amount
+        if (1 == num_search_threads) {
+            REQUIRE((num_tables == scan_counts.num_searched_tables));
+            REQUIRE((num_results == scan_counts.num_written_results));
+            REQUIRE((0 == scan_counts.num_written_results_past_cutoff));
+        }
+    }
+}
+
+TEST_CASE("clp-s-search-cached", "[clp-s][search]") {
+    std::vector<std::pair<std::string, std::vector<int64_t>>> queries_and_results{
+            {R"aa(msg: "*Abc123*")aa", {1, 2, 3, 4, 5, 6}},
+            {R"aa(arr.b > 1000)aa", {7, 8}},
+            {R"aa(ambiguous_varstring: "a*e")aa", {10, 11, 12}},
+            {R"aa(idx >= 2 AND idx < 5)aa", {2, 3, 4}},
+            {R"aa(idx > 13)aa", {}}
+    };
+    auto single_file_archive = GENERATE(true, false);
+    // A capacity of zero exercises a cache that can't hold anything
+    auto cache_capacity = GENERATE(size_t{0}, size_t{64} * 1024 * 1024);
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    get_test_input_local_path(cTestSearchInputFile),
+                    std::string{cTestSearchArchiveDirectory},
+                    std::string{cTestIdxKey},
+                    false,
+                    single_file_archive,
+                    false
+            )
+    );
+
+    auto cache = std::make_shared<clp_s::ArchiveCache>(cache_capacity);
+    clp_s::search::SearchEngine search_engine{cache};
+    // Search every archive twice so that the second search is served from the cache
+    for (int i = 0; i < 2; ++i) {
+        for (auto const& [query, expected_results] : queries_and_results) {
+            CAPTURE(query);
+            REQUIRE_NOTHROW(search_with_engine(search_engine, query, expected_results));
+        }
+    }
+    if (0 == cache_capacity) {
+        REQUIRE(0 == cache->get_size());
+    } else {
+        REQUIRE(0 < cache->get_size());
+    }
+    REQUIRE(cache->get_size() <= cache->get_capacity());
+}
+
+TEST_CASE("clp-s-search-aggregate", "[clp-s][search]") {
+    using reducer::AggregationType;
+
+    // Tuples of the query, the aggregation type, the field to aggregate, the key of the final
+    // aggregate's value, and its expected value
+    std::vector<std::tuple<std::string, AggregationType, std::string, std::string_view, double>>
+            queries_and_results{
+                    {R"aa(idx >= 2 AND idx < 5)aa",
+                     AggregationType::Sum,
+                     std::string{cTestIdxKey},
+                     reducer::SumAggregate::cRecordElementKey,
+                     9.0},
+                    {R"aa(idx >= 2 AND idx < 5)aa",
+                     AggregationType::Min,
+                     std::string{cTestIdxKey},
+                     reducer::MinAggregate::cRecordElementKey,
+                     2.0},
+                    {R"aa(idx >= 2 AND idx < 5)aa",
+                     AggregationType::Max,
+                     std::string{cTestIdxKey},
+                     reducer::MaxAggregate::cRecordElementKey,
+                     4.0},
+                    {R"aa(idx >= 2 AND idx < 5)aa",
+                     AggregationType::Avg,
+                     std::string{cTestIdxKey},
+                     reducer::AvgAggregate::cRecordElementKey,
+                     3.0},
+                    {R"aa(bool: true AND float > 1.0 AND int: 1)aa",
+                     AggregationType::Max,
+                     "float",
+                     reducer::MaxAggregate::cRecordElementKey,
+                     1.1}
+            };
+    // Tuples of the query, the aggregation type, and the field to aggregate, for searches without
+    // any values to aggregate
+    std::vector<std::tuple<std::string, AggregationType, std::string>> queries_without_values{
+            // No results
+            {R"aa(idx > 13)aa", AggregationType::Sum, std::string{cTestIdxKey}},
+            // Results without numeric values for the field
+            {R"aa(msg: "*Abc123*")aa", AggregationType::Min, "msg"},
+            {R"aa(idx >= 2 AND idx < 5)aa", AggregationType::Max, "missing"}
+    };
+    auto single_file_archive = GENERATE(true, false);
+
+    TestOutputCleaner const test_cleanup{{std::string{cTestSearchArchiveDirectory}}};
+
+    REQUIRE_NOTHROW(
+            std::ignore = compress_archive(
+                    get_test_input_local_path(cTestSearchInputFile),
+                    std::string{cTestSearchArchiveDirectory},
+                    std::string{cTestIdxKey},
+                    false,
+                    single_file_archive,
+                    false
+            )
+    );
+
+    for (auto const& [query, type, field, result_key, expected_result] : queries_and_results) {
+        CAPTURE(query);
+        CAPTURE(field);
+        auto const result{search_and_aggregate(query, type, field, result_key)};
+        REQUIRE(result.has_value());
+        REQUIRE((expected_result == result.value()));
+    }
+
+    for (auto const& [query, type, field] : queries_without_values) {
+        CAPTURE(query);
+        CAPTURE(field);
+        REQUIRE_FALSE(search_and_aggregate(query, type, field, field).has_value());
+    }
 }
 
 TEST_CASE("clp-s-search-formatted-float", "[clp-s][search]") {
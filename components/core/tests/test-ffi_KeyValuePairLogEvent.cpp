@@ -461,6 +461,23 @@ TEST_CASE("ffi_KeyValuePairLogEvent_create", "[ffi]") {
             };
             REQUIRE((serialized_auto_gen_kv_pairs == expected));
             REQUIRE((serialized_user_gen_kv_pairs == expected));
+
+            // The JSON strings should be appended to the existing content of the buffer
+            constexpr std::string_view cPrefix{"prefix"};
+            string auto_gen_json_str{cPrefix};
+            REQUIRE_FALSE(
+                    kv_pair_log_event.append_auto_gen_kv_pairs_as_json_str(auto_gen_json_str)
+                            .has_error()
+            );
+            REQUIRE(auto_gen_json_str.starts_with(cPrefix));
+            REQUIRE((nlohmann::json::parse(auto_gen_json_str.substr(cPrefix.size())) == expected));
+
+            string user_gen_json_str;
+            REQUIRE_FALSE(
+                    kv_pair_log_event.append_user_gen_kv_pairs_as_json_str(user_gen_json_str)
+                            .has_error()
+            );
+            REQUIRE((nlohmann::json::parse(user_gen_json_str) == expected));
         }
 
         SECTION("Test duplicated key conflict under node #3") {
@@ -622,3 +639,91 @@ TEST_CASE("ffi_KeyValuePairLogEvent_create", "[ffi]") {
         ));
     }
 }
+
+TEST_CASE("ffi_KeyValuePairLogEvent_append_kv_pairs_as_json_str", "[ffi]") {
+    // Keys are inserted in sorted order so that the serialized string matches
+    // `nlohmann::json::dump`, which sorts keys.
+    auto const schema_tree{std::make_shared<SchemaTree>()};
+    std::vector<std::pair<SchemaTree::NodeLocator, Value>> const locators_and_values{
+            {{SchemaTree::cRootId, "bool", SchemaTree::Node::Type::Bool}, Value{true}},
+            {{SchemaTree::cRootId, "clp_str", SchemaTree::Node::Type::Str},
+             Value{FourByteEncodedTextAst::parse_and_encode_from(cStringToEncode)}},
+            {{SchemaTree::cRootId, "float_exponent", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(1e100)}},
+            {{SchemaTree::cRootId, "float_fraction", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(0.1)}},
+            {{SchemaTree::cRootId, "float_integral", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(-3.0)}},
+            {{SchemaTree::cRootId, "float_large_fixed", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(123'456'789'012'345.0)}},
+            {{SchemaTree::cRootId, "float_large_pow10_15", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(1e15)}},
+            {{SchemaTree::cRootId, "float_large_pow10_16", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(1e16)}},
+            {{SchemaTree::cRootId, "float_pow10_5", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(1e5)}},
+            {{SchemaTree::cRootId, "float_small_pow10_neg4", SchemaTree::Node::Type::Float},
+             Value{static_cast<value_float_t>(1e-4)}},
+            {{SchemaTree::cRootId, "int", SchemaTree::Node::Type::Int},
+             Value{static_cast<value_int_t>(-9'223'372'036'854'775'807)}},
+            {{SchemaTree::cRootId, "null", SchemaTree::Node::Type::Obj}, Value{}},
+            {{SchemaTree::cRootId, "str", SchemaTree::Node::Type::Str},
+             Value{string{"\"quoted\"\t\\\x01é中"}}}
+    };
+
+    KeyValuePairLogEvent::NodeIdValuePairs node_id_value_pairs;
+    for (auto const& [locator, value] : locators_and_values) {
+        node_id_value_pairs.emplace(schema_tree->insert_node(locator), value);
+    }
+    auto const result{KeyValuePairLogEvent::create(
+            schema_tree,
+            schema_tree,
+            node_id_value_pairs,
+            {},
+            UtcOffset{0}
+    )};
+    REQUIRE_FALSE(result.has_error());
+    auto const& kv_pair_log_event{result.value()};
+
+    auto const serialized_json_result{kv_pair_log_event.serialize_to_json()};
+    REQUIRE_FALSE(serialized_json_result.has_error());
+    auto const& [expected_auto_gen_kv_pairs, expected_user_gen_kv_pairs]{
+            serialized_json_result.value()
+    };
+
+    string auto_gen_json_str;
+    REQUIRE_FALSE(
+            kv_pair_log_event.append_auto_gen_kv_pairs_as_json_str(auto_gen_json_str).has_error()
+    );
+    REQUIRE((expected_auto_gen_kv_pairs.dump() == auto_gen_json_str));
+
+    string user_gen_json_str;
+    REQUIRE_FALSE(
+            kv_pair_log_event.append_user_gen_kv_pairs_as_json_str(user_gen_json_str).has_error()
+    );
+    REQUIRE((expected_user_gen_kv_pairs.dump() == user_gen_json_str));
+    // Floats whose shortest representation is in scientific notation are still written in fixed
+    // notation when `dump` would do so.
+    REQUIRE((string::npos != user_gen_json_str.find("\"float_pow10_5\":100000.0")));
+    REQUIRE((string::npos != user_gen_json_str.find("\"float_small_pow10_neg4\":0.0001")));
+
+    SECTION("Test invalid UTF-8 string") {
+        auto const invalid_str_node_id{schema_tree->insert_node(
+                {SchemaTree::cRootId, "invalid_str", SchemaTree::Node::Type::Str}
+        )};
+        auto const invalid_result{KeyValuePairLogEvent::create(
+                schema_tree,
+                schema_tree,
+                {},
+                {{invalid_str_node_id, Value{string{"\xff"}}}},
+                UtcOffset{0}
+        )};
+        REQUIRE_FALSE(invalid_result.has_error());
+        string json_str;
+        auto const append_result{
+                invalid_result.value().append_user_gen_kv_pairs_as_json_str(json_str)
+        };
+        REQUIRE(append_result.has_error());
+        REQUIRE((std::errc::protocol_error == append_result.error()));
+    }
+}
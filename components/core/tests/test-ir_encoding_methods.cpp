@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -21,9 +23,11 @@
 #include "../src/clp/BufferReader.hpp"
 #include "../src/clp/ErrorCode.hpp"
 #include "../src/clp/ffi/encoding_methods.hpp"
+#include "../src/clp/ffi/ir_stream/CheckpointIndex.hpp"
 #include "../src/clp/ffi/ir_stream/decoding_methods.hpp"
 #include "../src/clp/ffi/ir_stream/Deserializer.hpp"
 #include "../src/clp/ffi/ir_stream/encoding_methods.hpp"
+#include "../src/clp/ffi/ir_stream/ir_unit_deserialization_methods.hpp"
 #include "../src/clp/ffi/ir_stream/IrUnitType.hpp"
 #include "../src/clp/ffi/ir_stream/protocol_constants.hpp"
 #include "../src/clp/ffi/ir_stream/search/test/utils.hpp"
@@ -42,9 +46,11 @@ using clp::ffi::decode_integer_var;
 using clp::ffi::decode_message;
 using clp::ffi::encode_float_string;
 using clp::ffi::encode_integer_string;
+using clp::ffi::ir_stream::CheckpointIndex;
 using clp::ffi::ir_stream::cProtocol::EightByteEncodingMagicNumber;
 using clp::ffi::ir_stream::cProtocol::FourByteEncodingMagicNumber;
 using clp::ffi::ir_stream::cProtocol::MagicNumberLength;
+using clp::ffi::ir_stream::DeferredKvPairLogEvent;
 using clp::ffi::ir_stream::deserialize_preamble;
 using clp::ffi::ir_stream::deserialize_tag;
 using clp::ffi::ir_stream::deserialize_utc_offset_change;
@@ -57,6 +63,7 @@ using clp::ffi::ir_stream::serialize_utc_offset_change;
 using clp::ffi::ir_stream::Serializer;
 using clp::ffi::ir_stream::validate_protocol_version;
 using clp::ffi::KeyValuePairLogEvent;
+using clp::ffi::SchemaTree;
 using clp::ffi::wildcard_query_matches_any_encoded_var;
 using clp::ir::eight_byte_encoded_variable_t;
 using clp::ir::epoch_time_ms_t;
@@ -1359,6 +1366,151 @@ TEMPLATE_TEST_CASE(
     REQUIRE((eof_result.has_error() && std::errc::operation_not_permitted == eof_result.error()));
 }
 
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_deferred_kv_pair_log_event",
+        "[clp][ffi][ir_stream]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    using clp::ffi::ir_stream::IrUnitType;
+
+    auto const empty_obj = nlohmann::json::parse("{}");
+    nlohmann::json const basic_obj
+            = {{"int", INT32_MIN},
+               {"float", 1.01},
+               {"true", true},
+               {"string", "short_string"},
+               {"clp_string", "uid=0, CPU usage: 99.99%, \"user_name\"=YScope"},
+               {"null", nullptr},
+               {"empty_object", empty_obj},
+               {"array", {1, "short_string", nullptr}}};
+    nlohmann::json const nested_obj = {{"basic_obj", basic_obj}, {"int", 0}};
+    vector<std::pair<nlohmann::json, nlohmann::json>> const auto_gen_and_user_gen_object_pairs{
+            {empty_obj, empty_obj},
+            {basic_obj, nested_obj},
+            {empty_obj, basic_obj},
+            {nested_obj, empty_obj}
+    };
+
+    vector<int8_t> ir_buf;
+    auto serializer_result{Serializer<TestType>::create()};
+    REQUIRE_FALSE(serializer_result.has_error());
+    auto& serializer{serializer_result.value()};
+    for (auto const& [auto_gen_json_obj, user_gen_json_obj] : auto_gen_and_user_gen_object_pairs) {
+        REQUIRE(unpack_and_serialize_msgpack_bytes(
+                nlohmann::json::to_msgpack(auto_gen_json_obj),
+                nlohmann::json::to_msgpack(user_gen_json_obj),
+                serializer
+        ));
+    }
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+    ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+
+    BufferReader reader{size_checked_pointer_cast<char>(ir_buf.data()), ir_buf.size()};
+    bool is_four_byte_encoded{};
+    REQUIRE((IRErrorCode::IRErrorCode_Success == get_encoding_type(reader, is_four_byte_encoded)));
+    encoded_tag_t metadata_type{};
+    vector<int8_t> metadata;
+    REQUIRE(
+            (IRErrorCode::IRErrorCode_Success
+             == deserialize_preamble(reader, metadata_type, metadata))
+    );
+
+    auto const auto_gen_keys_schema_tree{std::make_shared<SchemaTree>()};
+    auto const user_gen_keys_schema_tree{std::make_shared<SchemaTree>()};
+    DeferredKvPairLogEvent deferred_log_event;
+    size_t num_log_events{0};
+    while (true) {
+        encoded_tag_t tag{};
+        REQUIRE((IRErrorCode::IRErrorCode_Success == deserialize_tag(reader, tag)));
+        auto const optional_ir_unit_type{clp::ffi::ir_stream::get_ir_unit_type_from_tag(tag)};
+        REQUIRE(optional_ir_unit_type.has_value());
+        if (IrUnitType::EndOfStream == optional_ir_unit_type.value()) {
+            break;
+        }
+        if (IrUnitType::SchemaTreeNodeInsertion == optional_ir_unit_type.value()) {
+            string key_name;
+            auto const insertion_result{
+                    clp::ffi::ir_stream::deserialize_ir_unit_schema_tree_node_insertion(
+                            reader,
+                            tag,
+                            key_name
+                    )
+            };
+            REQUIRE_FALSE(insertion_result.has_error());
+            auto const& [is_auto_generated, node_locator]{insertion_result.value()};
+            auto& schema_tree{
+                    is_auto_generated ? *auto_gen_keys_schema_tree : *user_gen_keys_schema_tree
+            };
+            schema_tree.insert_node(node_locator);
+            continue;
+        }
+        REQUIRE((IrUnitType::LogEvent == optional_ir_unit_type.value()));
+
+        // Deserialize the same log event eagerly as a reference
+        BufferReader eager_reader{
+                size_checked_pointer_cast<char>(ir_buf.data()),
+                ir_buf.size(),
+                reader.get_pos()
+        };
+        auto const expected_log_event_result{
+                clp::ffi::ir_stream::deserialize_ir_unit_kv_pair_log_event(
+                        eager_reader,
+                        tag,
+                        auto_gen_keys_schema_tree,
+                        user_gen_keys_schema_tree,
+                        UtcOffset{0}
+                )
+        };
+        REQUIRE_FALSE(expected_log_event_result.has_error());
+        auto const& expected_log_event{expected_log_event_result.value()};
+
+        REQUIRE_FALSE(deferred_log_event.read_ir_unit(reader, tag).has_error());
+        REQUIRE((eager_reader.get_pos() == reader.get_pos()));
+
+        auto const log_event_result{deferred_log_event.deserialize(
+                auto_gen_keys_schema_tree,
+                user_gen_keys_schema_tree,
+                UtcOffset{0}
+        )};
+        REQUIRE_FALSE(log_event_result.has_error());
+        auto const expected_json_result{expected_log_event.serialize_to_json()};
+        REQUIRE_FALSE(expected_json_result.has_error());
+        auto const json_result{log_event_result.value().serialize_to_json()};
+        REQUIRE_FALSE(json_result.has_error());
+        REQUIRE((expected_json_result.value() == json_result.value()));
+
+        // Only the selected values should be deserialized
+        auto const is_selected = [](bool is_auto_generated, SchemaTree::Node::id_t node_id) {
+            return false == is_auto_generated && 0 == node_id % 2;
+        };
+        auto const filtered_log_event_result{deferred_log_event.deserialize(
+                auto_gen_keys_schema_tree,
+                user_gen_keys_schema_tree,
+                UtcOffset{0},
+                is_selected
+        )};
+        REQUIRE_FALSE(filtered_log_event_result.has_error());
+        auto const& filtered_log_event{filtered_log_event_result.value()};
+        REQUIRE(filtered_log_event.get_auto_gen_node_id_value_pairs().empty());
+        std::unordered_set<SchemaTree::Node::id_t> expected_node_ids;
+        for (auto const& [node_id, value] : expected_log_event.get_user_gen_node_id_value_pairs()) {
+            if (is_selected(false, node_id)) {
+                expected_node_ids.emplace(node_id);
+            }
+        }
+        std::unordered_set<SchemaTree::Node::id_t> node_ids;
+        for (auto const& [node_id, value] : filtered_log_event.get_user_gen_node_id_value_pairs()) {
+            node_ids.emplace(node_id);
+        }
+        REQUIRE((expected_node_ids == node_ids));
+
+        ++num_log_events;
+    }
+    REQUIRE((auto_gen_and_user_gen_object_pairs.size() == num_log_events));
+}
+
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 TEMPLATE_TEST_CASE(
         "ffi_ir_stream_serialize_schema_tree_node_id",
@@ -1509,3 +1661,126 @@ TEMPLATE_TEST_CASE(
     REQUIRE(serializer_result.has_error());
     REQUIRE((std::errc::protocol_not_supported == serializer_result.error()));
 }
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+TEMPLATE_TEST_CASE(
+        "ffi_ir_stream_kv_pair_log_events_checkpoints",
+        "[clp][ffi][ir_stream][CheckpointIndex]",
+        four_byte_encoded_variable_t,
+        eight_byte_encoded_variable_t
+) {
+    constexpr size_t cNumLogEvents{50};
+    constexpr size_t cCheckpointInterval{8};
+    constexpr size_t cNumDistinctKeys{16};
+    constexpr UtcOffset cBeijingUtcOffset{8 * 60 * 60 * 1000};
+
+    auto result{Serializer<TestType>::create()};
+    REQUIRE((false == result.has_error()));
+    auto& serializer{result.value()};
+    serializer.set_checkpoint_interval(cCheckpointInterval);
+
+    // Serialize log events whose keys (and thus schema tree nodes) keep growing, changing the UTC
+    // offset partway through the stream.
+    vector<int8_t> ir_buf;
+    vector<nlohmann::json> expected_user_gen_json_objs;
+    auto const empty_obj = nlohmann::json::parse("{}");
+    for (size_t idx{0}; idx < cNumLogEvents; ++idx) {
+        if (cNumLogEvents / 2 == idx) {
+            serializer.change_utc_offset(cBeijingUtcOffset);
+        }
+        nlohmann::json const user_gen_json_obj
+                = {{"idx", idx},
+                   {"key_" + std::to_string(idx % cNumDistinctKeys), "value"},
+                   {"obj", {{"key_" + std::to_string(idx / cCheckpointInterval), idx}}}};
+        REQUIRE(unpack_and_serialize_msgpack_bytes(
+                nlohmann::json::to_msgpack(empty_obj),
+                nlohmann::json::to_msgpack(user_gen_json_obj),
+                serializer
+        ));
+        expected_user_gen_json_objs.emplace_back(user_gen_json_obj);
+        // Flush periodically so that checkpoint positions span multiple IR buffers
+        if (0 == idx % 3) {
+            flush_and_clear_serializer_buffer(serializer, ir_buf);
+        }
+    }
+    flush_and_clear_serializer_buffer(serializer, ir_buf);
+    ir_buf.push_back(clp::ffi::ir_stream::cProtocol::Eof);
+
+    auto const serialized_index{serializer.serialize_checkpoint_index()};
+    auto index_result{CheckpointIndex::deserialize(serialized_index)};
+    REQUIRE_FALSE(index_result.has_error());
+    auto const& checkpoint_index{index_result.value()};
+    auto const& checkpoints{checkpoint_index.get_checkpoints()};
+    REQUIRE(((cNumLogEvents + cCheckpointInterval - 1) / cCheckpointInterval == checkpoints.size()));
+
+    for (size_t checkpoint_idx{0}; checkpoint_idx < checkpoints.size(); ++checkpoint_idx) {
+        auto const& checkpoint{checkpoints.at(checkpoint_idx)};
+        REQUIRE((checkpoint_idx * cCheckpointInterval == checkpoint.log_event_idx));
+        REQUIRE((checkpoint_index.find_checkpoint(checkpoint.log_event_idx) == checkpoint));
+        REQUIRE(
+                (checkpoint_index.find_checkpoint(
+                         checkpoint.log_event_idx + cCheckpointInterval - 1
+                 )
+                 == checkpoint)
+        );
+
+        // Deserialize the range of log events between this checkpoint and the next one.
+        auto const end_log_event_idx{std::min(
+                checkpoint.log_event_idx + cCheckpointInterval,
+                cNumLogEvents
+        )};
+        BufferReader reader{size_checked_pointer_cast<char>(ir_buf.data()), ir_buf.size()};
+        auto deserializer_result{Deserializer<IrUnitHandler>::create_from_checkpoint(
+                reader,
+                IrUnitHandler{},
+                checkpoint_index,
+                checkpoint
+        )};
+        REQUIRE_FALSE(deserializer_result.has_error());
+        auto& deserializer{deserializer_result.value()};
+        REQUIRE((checkpoint.log_event_idx == deserializer.get_num_log_events_deserialized()));
+        while (deserializer.get_num_log_events_deserialized() < end_log_event_idx) {
+            auto const ir_unit_result{deserializer.deserialize_next_ir_unit(reader)};
+            REQUIRE_FALSE(ir_unit_result.has_error());
+            REQUIRE((clp::ffi::ir_stream::IrUnitType::EndOfStream != ir_unit_result.value()));
+        }
+
+        auto const& ir_unit_handler{deserializer.get_ir_unit_handler()};
+        auto const& deserialized_log_events{ir_unit_handler.get_deserialized_log_events()};
+        auto const& deserialized_log_event_indices{
+                ir_unit_handler.get_deserialized_log_event_indices()
+        };
+        REQUIRE((end_log_event_idx - checkpoint.log_event_idx == deserialized_log_events.size()));
+        for (size_t i{0}; i < deserialized_log_events.size(); ++i) {
+            auto const log_event_idx{checkpoint.log_event_idx + i};
+            REQUIRE((log_event_idx == deserialized_log_event_indices.at(i)));
+            auto const& deserialized_log_event{deserialized_log_events.at(i)};
+            auto const expected_utc_offset{
+                    log_event_idx < cNumLogEvents / 2 ? UtcOffset{0} : cBeijingUtcOffset
+            };
+            REQUIRE((expected_utc_offset == deserialized_log_event.get_utc_offset()));
+            auto const serialized_json_result{deserialized_log_event.serialize_to_json()};
+            REQUIRE_FALSE(serialized_json_result.has_error());
+            REQUIRE((expected_user_gen_json_objs.at(log_event_idx)
+                     == serialized_json_result.value().second));
+        }
+    }
+
+    // Checkpoints referring to schema trees that aren't in the index should be rejected.
+    auto invalid_checkpoint{checkpoints.back()};
+    invalid_checkpoint.user_gen_keys_schema_tree_size
+            = checkpoint_index.get_user_gen_keys_schema_tree().get_size() + 1;
+    BufferReader reader{size_checked_pointer_cast<char>(ir_buf.data()), ir_buf.size()};
+    auto const invalid_deserializer_result{Deserializer<IrUnitHandler>::create_from_checkpoint(
+            reader,
+            IrUnitHandler{},
+            checkpoint_index,
+            invalid_checkpoint
+    )};
+    REQUIRE(invalid_deserializer_result.has_error());
+    REQUIRE((std::errc::invalid_argument == invalid_deserializer_result.error()));
+
+    // Corrupted indices should be rejected.
+    auto const truncated_index{std::span{serialized_index}.first(serialized_index.size() / 2)};
+    REQUIRE(CheckpointIndex::deserialize(truncated_index).has_error());
+}
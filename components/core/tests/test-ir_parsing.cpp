@@ -1,3 +1,10 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "../src/clp/ir/parsing.hpp"
@@ -9,6 +16,54 @@ using std::string;
 using std::string_view;
 using std::vector;
 
+namespace {
+/**
+ * Reference implementation of `get_bounds_of_next_var` which checks one character at a time.
+ * @param str
+ * @param begin_pos
+ * @param end_pos
+ * @return Same as `get_bounds_of_next_var`
+ */
+bool get_bounds_of_next_var_per_char(string_view str, size_t& begin_pos, size_t& end_pos);
+
+bool get_bounds_of_next_var_per_char(string_view str, size_t& begin_pos, size_t& end_pos) {
+    auto const msg_length = str.length();
+    if (msg_length <= end_pos) {
+        return false;
+    }
+
+    while (true) {
+        begin_pos = end_pos;
+        for (; begin_pos < msg_length && clp::ir::is_delim(str[begin_pos]); ++begin_pos) {}
+        if (msg_length == begin_pos) {
+            return false;
+        }
+
+        bool contains_decimal_digit = false;
+        bool contains_alphabet = false;
+        end_pos = begin_pos;
+        for (; end_pos < msg_length; ++end_pos) {
+            auto const c = str[end_pos];
+            if ('0' <= c && c <= '9') {
+                contains_decimal_digit = true;
+            } else if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z')) {
+                contains_alphabet = true;
+            } else if (clp::ir::is_delim(c)) {
+                break;
+            }
+        }
+
+        auto const token = str.substr(begin_pos, end_pos - begin_pos);
+        if (contains_decimal_digit
+            || (0 < begin_pos && '=' == str[begin_pos - 1] && contains_alphabet)
+            || clp::ir::could_be_multi_digit_hex_value(token))
+        {
+            return true;
+        }
+    }
+}
+}  // namespace
+
 TEST_CASE("ir::get_bounds_of_next_var", "[ir][get_bounds_of_next_var]") {
     string str;
     size_t begin_pos;
@@ -100,3 +155,58 @@ TEST_CASE("ir::get_bounds_of_next_var", "[ir][get_bounds_of_next_var]") {
     REQUIRE(get_bounds_of_next_var(str, begin_pos, end_pos) == true);
     REQUIRE("var123" == str.substr(begin_pos, end_pos - begin_pos));
 }
+
+TEST_CASE(
+        "ir::VariableTokenizer matches per-character tokenization",
+        "[ir][get_bounds_of_next_var]"
+) {
+    // Characters from every class the tokenizer distinguishes, including non-ASCII bytes
+    constexpr std::string_view cAlphabet{"09afAFgzGZ+-.\\_ =/:,;~\x11\x12\x13\x7f\x80\xff"};
+    constexpr size_t cMaxLength = 300;
+    constexpr int cNumStringsPerLength = 20;
+
+    std::mt19937 generator{0};
+    std::uniform_int_distribution<size_t> char_ix_distribution{0, cAlphabet.length() - 1};
+    std::uniform_int_distribution<size_t> run_length_distribution{1, 70};
+
+    string str;
+    for (size_t length = 0; length <= cMaxLength; ++length) {
+        for (int i = 0; i < cNumStringsPerLength; ++i) {
+            // Generate runs of the same character so that tokens span blocks
+            str.clear();
+            while (str.length() < length) {
+                auto const c = cAlphabet[char_ix_distribution(generator)];
+                auto const run_length = 0 == i % 2 ? 1 : run_length_distribution(generator);
+                str.append(std::min(run_length, length - str.length()), c);
+            }
+            CAPTURE(str);
+
+            clp::ir::VariableTokenizer tokenizer{str};
+            size_t begin_pos{0};
+            size_t end_pos{0};
+            size_t tokenizer_begin_pos{0};
+            size_t tokenizer_end_pos{0};
+            size_t expected_begin_pos{0};
+            size_t expected_end_pos{0};
+            while (true) {
+                auto const found = get_bounds_of_next_var(str, begin_pos, end_pos);
+                auto const tokenizer_found
+                        = tokenizer.get_bounds_of_next_var(tokenizer_begin_pos, tokenizer_end_pos);
+                auto const expected_found = get_bounds_of_next_var_per_char(
+                        str,
+                        expected_begin_pos,
+                        expected_end_pos
+                );
+                REQUIRE(expected_found == found);
+                REQUIRE(expected_begin_pos == begin_pos);
+                REQUIRE(expected_end_pos == end_pos);
+                REQUIRE(expected_found == tokenizer_found);
+                REQUIRE(expected_begin_pos == tokenizer_begin_pos);
+                REQUIRE(expected_end_pos == tokenizer_end_pos);
+                if (false == found) {
+                    break;
+                }
+            }
+        }
+    }
+}
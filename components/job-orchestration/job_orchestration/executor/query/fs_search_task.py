@@ -147,6 +147,14 @@ def _make_command_and_env_vars(
         if aggregation_config.count_by_time_bucket_size is not None:
             command.append("--count-by-time")
             command.append(str(aggregation_config.count_by_time_bucket_size))
+        if aggregation_config.aggregation_type is not None:
+            command.append("--aggregate")
+            command.append(aggregation_config.aggregation_type)
+            command.append("--aggregate-field")
+            command.append(aggregation_config.aggregation_field)
+            if aggregation_config.aggregation_quantile is not None:
+                command.append("--quantile")
+                command.append(str(aggregation_config.aggregation_quantile))
 
         # fmt: off
         command.extend((
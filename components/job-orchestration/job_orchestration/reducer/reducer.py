@@ -58,6 +58,7 @@ def main(argv: list[str]) -> int:
         "--scheduler-port", str(clp_config.query_scheduler.port),
         "--mongodb-uri", clp_config.results_cache.get_uri(),
         "--upsert-interval", str(parsed_args.upsert_interval),
+        "--num-threads", str(clp_config.reducer.num_threads),
         "--reducer-host", clp_config.reducer.host,
         "--reducer-port",
     ]
@@ -64,6 +64,9 @@ class AggregationConfig(BaseModel):
     reducer_port: int | None = None
     do_count_aggregation: bool | None = None
     count_by_time_bucket_size: int | None = None  # Milliseconds
+    aggregation_type: str | None = None  # sum | min | max | avg | count-distinct | percentile
+    aggregation_field: str | None = None
+    aggregation_quantile: float | None = None
 
 
 class QueryJobConfig(BaseModel):
@@ -166,6 +166,9 @@ async def handle_reducer_connection(
                         {
                             "job_id": job_id,
                             "count_by_time_bucket_size": time_bucket_size,
+                            "aggregation_type": aggregation_config.aggregation_type,
+                            "aggregation_field": aggregation_config.aggregation_field,
+                            "aggregation_quantile": aggregation_config.aggregation_quantile,
                         }
                     ),
                     writer,